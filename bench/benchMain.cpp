@@ -0,0 +1,54 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+#include <string.h>
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+#include "zoneBench.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Results file when --benchmark_out is not given */
+#define BENCH_RESULTS_FILE                      "bench_results.json"
+
+/** @brief Web log entries, as in the bridge sketch */
+#define BENCH_WEBLOG_ENTRIES                    (50U)
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+int main(int argc, char ** argv) {
+    std::vector<char *> args(argv, argv + argc);
+    char outArg[] = "--benchmark_out=" BENCH_RESULTS_FILE;
+    char formatArg[] = "--benchmark_out_format=json";
+    bool outGiven = false;
+
+    /* Results always go to a JSON file, so runs can be compared across library revisions */
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--benchmark_out=", strlen("--benchmark_out=")) == 0) {
+            outGiven = true;
+        }
+    }
+    if (outGiven == false) {
+        args.push_back(outArg);
+        args.push_back(formatArg);
+    }
+
+    homeSpan.enableWebLog(BENCH_WEBLOG_ENTRIES);
+    testBenchBegin();
+    zoneBenchRegister();
+
+    int nbArgs = (int)args.size();
+    benchmark::Initialize(&nbArgs, args.data());
+    if (benchmark::ReportUnrecognizedArguments(nbArgs, args.data())) {
+        return (1);
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return (0);
+}
@@ -0,0 +1,392 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+/* Local files */
+#include "HAP.h"
+#include "spanTestAccess.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief aid of the first synthetic accessory, clear of the zones of the test bench */
+#define BENCH_AID_FIRST                         (1000U)
+
+/** @brief Instance IDs of a synthetic zone accessory, in creation order */
+#define BENCH_IID_CURRENT_TEMPERATURE           (7)
+#define BENCH_IID_TARGET_TEMPERATURE            (8)
+
+/** @brief Largest buffer for the requests and records below */
+#define BENCH_BUFFER_LEN                        (512U)
+
+/** @brief Records of the pairing messages, and their largest VALUE */
+#define BENCH_TLV_RECORDS                       (3)
+#define BENCH_TLV_MAX_VALUE                     (384U)
+
+/** @brief Header sent ahead of the encrypted payloads */
+#define BENCH_HTTP_HEADER                       "HTTP/1.1 200 OK\r\nContent-Type: application/hap+json\r\nContent-Length: 8000\r\n\r\n"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief TLV8 record of a pairing message */
+typedef struct {
+    kTLVType tag;                       /**< TAG */
+    int len;                            /**< Length of the VALUE */
+} t_benchTlvRecord;
+
+/** @brief Pairing message for the TLV8 benchmarks */
+typedef struct {
+    t_benchTlvRecord records[BENCH_TLV_RECORDS];                /**< Records in message order */
+    TLV<kTLVType, BENCH_TLV_RECORDS> tlv;                       /**< Same records as TLV<> */
+    bool created;                                               /**< Records of tlv created */
+} t_benchTlvMessage;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Pair-setup M4: state, SRP public key in two fragments and proof */
+static t_benchTlvMessage pairingM4 = {{{kTLVType_State, 1}, {kTLVType_PublicKey, 384}, {kTLVType_Proof, 64}}, {}, false};
+
+/** @brief Decrypted sub-TLV of pair-setup M5, as parsed in place by HAP */
+static t_benchTlvMessage pairingM5 = {{{kTLVType_Identifier, 36}, {kTLVType_PublicKey, 32}, {kTLVType_Signature, 64}}, {}, false};
+
+/** @brief VALUE of every TLV record, long enough for the largest one */
+static uint8_t tlvPattern[BENCH_TLV_MAX_VALUE];
+
+/** @brief aid of the synthetic accessories, the bridge accessory is not in the list */
+static std::vector<uint32_t> zoneAids;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/**
+ * @brief Resize the synthetic bridge
+ * @details
+ *  Every bridged accessory looks like a zone thermostat: accessory
+ *  information and a thermostat service, 7 characteristics in all. Its
+ *  current temperature is subscribed on connection 0, as the Home app does.
+ *
+ * @param nbBridged     Number of accessories behind the bridge accessory
+ */
+static void bridgeResize(const size_t nbBridged) {
+    while (zoneAids.size() > nbBridged) {
+        (void)homeSpan.deleteAccessory(zoneAids.back());
+        zoneAids.pop_back();
+    }
+
+    while (zoneAids.size() < nbBridged) {
+        uint32_t aid = BENCH_AID_FIRST + (uint32_t)zoneAids.size();
+        new SpanAccessory(aid);
+            new Service::AccessoryInformation();
+                new Characteristic::Identify();
+                new Characteristic::Name("Zone");
+            new Service::Thermostat();
+                new Characteristic::CurrentHeatingCoolingState();
+                new Characteristic::TargetHeatingCoolingState();
+                new Characteristic::CurrentTemperature(20.0);
+                new Characteristic::TargetTemperature(21.0);
+                new Characteristic::TemperatureDisplayUnits();
+        zoneAids.push_back(aid);
+
+        char body[BENCH_BUFFER_LEN];
+        SpanBuf update;
+        snprintf(body, sizeof(body), "{\"characteristics\":[{\"aid\":%u,\"iid\":%d,\"ev\":true}]}",
+                 (unsigned int)aid, BENCH_IID_CURRENT_TEMPERATURE);
+        HAPClient::conNum = 0;
+        (void)SpanTestAccess::updateCharacteristics(body, &update);
+    }
+}
+
+/** @brief Build the synthetic bridge for the benchmark argument and report its size */
+static bool bridgeSetup(benchmark::State & state) {
+    bridgeResize((size_t)state.range(0));
+    state.counters["accessories"] = (double)(zoneAids.size() + 1U);
+
+    for (uint32_t aid : zoneAids) {
+        if (SpanTestAccess::find(aid, BENCH_IID_CURRENT_TEMPERATURE) == NULL) {
+            state.SkipWithError("synthetic accessory layout changed");
+            return (false);
+        }
+    }
+
+    return (true);
+}
+
+/** @brief Remove the synthetic bridge after each run, the zone benchmarks need the accessory room */
+static void bridgeRelease(const benchmark::State & state) {
+    (void)state;
+    bridgeResize(0U);
+}
+
+/** @brief Bridged accessory counts, up to the 150 accessories HAP allows with the bridge */
+static void bridgeSizes(benchmark::internal::Benchmark * bench) {
+    for (int64_t nbBridged : {1, 2, 5, 10, 20, 40, 75, 100, 149}) {
+        bench->Arg(nbBridged);
+    }
+}
+
+/** @brief Encrypted session between an accessory and a controller over a socket pair */
+class BenchSession {
+public:
+    HAPClient accessory;
+    HAPClient controller;
+
+    BenchSession() {
+        int fds[2];
+
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0) {
+            accessory.client = WiFiClient(fds[0]);
+            controller.client = WiFiClient(fds[1]);
+        }
+
+        /* Both directions share the keys of the other end, as after pair-verify */
+        for (int i = 0; i < 32; i++) {
+            accessory.a2cKey[i] = (uint8_t)i;
+            accessory.c2aKey[i] = (uint8_t)(0xFF - i);
+        }
+        memcpy(controller.c2aKey, accessory.a2cKey, sizeof(controller.c2aKey));
+        memcpy(controller.a2cKey, accessory.c2aKey, sizeof(controller.a2cKey));
+    }
+
+    ~BenchSession() {
+        accessory.client.stop();
+        controller.client.stop();
+    }
+
+    /** @brief Read and drop whatever the accessory sent */
+    void drain(void) {
+        uint8_t discard[4096];
+        while (recv(controller.client.fd(), discard, sizeof(discard), MSG_DONTWAIT) > 0) {
+        }
+    }
+};
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* aid and iid lookup of one characteristic per accessory, as for each record of a PUT */
+static void BM_SpanFind(benchmark::State & state) {
+    if (bridgeSetup(state) == false) {
+        return;
+    }
+
+    for (auto _ : state) {
+        for (uint32_t aid : zoneAids) {
+            benchmark::DoNotOptimize(SpanTestAccess::find(aid, BENCH_IID_CURRENT_TEMPERATURE));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)zoneAids.size());
+}
+BENCHMARK(BM_SpanFind)->Apply(bridgeSizes)->Teardown(bridgeRelease);
+
+/* PUT /characteristics with a setpoint write to the last accessory: parsing, lookup and update() */
+static void BM_UpdateCharacteristics(benchmark::State & state) {
+    char request[BENCH_BUFFER_LEN];
+    char body[BENCH_BUFFER_LEN];
+    SpanBuf objects[1];
+
+    if (bridgeSetup(state) == false) {
+        return;
+    }
+    int len = snprintf(request, sizeof(request), "{\"characteristics\":[{\"aid\":%u,\"iid\":%d,\"value\":21.5}]}",
+                       (unsigned int)zoneAids.back(), BENCH_IID_TARGET_TEMPERATURE);
+
+    for (auto _ : state) {
+        /* The parser tokenizes in place */
+        memcpy(body, request, (size_t)len + 1U);
+        benchmark::DoNotOptimize(SpanTestAccess::updateCharacteristics(body, objects));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_UpdateCharacteristics)->Apply(bridgeSizes)->Teardown(bridgeRelease);
+
+/* GET /accessories: sizing then printing the full attribute database */
+static void BM_SprintfAttributes(benchmark::State & state) {
+    if (bridgeSetup(state) == false) {
+        return;
+    }
+    int len = SpanTestAccess::sprintfAttributes(NULL, GET_VALUE | GET_META | GET_PERMS | GET_TYPE | GET_DESC);
+    std::vector<char> database((size_t)len + 1U);
+
+    for (auto _ : state) {
+        int size = SpanTestAccess::sprintfAttributes(NULL, GET_VALUE | GET_META | GET_PERMS | GET_TYPE | GET_DESC);
+        benchmark::DoNotOptimize(SpanTestAccess::sprintfAttributes(database.data(), GET_VALUE | GET_META | GET_PERMS | GET_TYPE | GET_DESC));
+        benchmark::DoNotOptimize(size);
+    }
+    state.counters["db_bytes"] = (double)len;
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_SprintfAttributes)->Apply(bridgeSizes)->Teardown(bridgeRelease);
+
+/* Event notification for a new temperature on every accessory, sizing then printing */
+static void BM_SprintfNotify(benchmark::State & state) {
+    char value[] = "20.5";
+
+    if (bridgeSetup(state) == false) {
+        return;
+    }
+    std::vector<SpanBuf> objects(zoneAids.size());
+    for (size_t i = 0; i < zoneAids.size(); i++) {
+        objects[i].aid = zoneAids[i];
+        objects[i].iid = BENCH_IID_CURRENT_TEMPERATURE;
+        objects[i].val = value;
+        objects[i].status = StatusCode::OK;
+        objects[i].characteristic = SpanTestAccess::find(zoneAids[i], BENCH_IID_CURRENT_TEMPERATURE);
+    }
+    int len = SpanTestAccess::sprintfNotify(objects.data(), (int)objects.size(), NULL, 0);
+    std::vector<char> notification((size_t)len + 1U);
+
+    for (auto _ : state) {
+        int size = SpanTestAccess::sprintfNotify(objects.data(), (int)objects.size(), NULL, 0);
+        benchmark::DoNotOptimize(SpanTestAccess::sprintfNotify(objects.data(), (int)objects.size(), notification.data(), 0));
+        benchmark::DoNotOptimize(size);
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)objects.size());
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_SprintfNotify)->Apply(bridgeSizes)->Teardown(bridgeRelease);
+
+/* ChaCha20-Poly1305 framing of a response: header frame plus 1024 byte payload frames */
+static void BM_SendEncrypted(benchmark::State & state) {
+    BenchSession session;
+    std::vector<uint8_t> payload((size_t)state.range(0), 0x5A);
+    char header[] = BENCH_HTTP_HEADER;
+
+    for (auto _ : state) {
+        session.accessory.sendEncrypted(header, payload.data(), (int)payload.size());
+        session.drain();
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)payload.size());
+}
+BENCHMARK(BM_SendEncrypted)->Arg(64)->Arg(1024)->Arg(4096)->Arg(7936);
+
+/* Reading and decrypting a request of the same framing, up to the HTTP buffer size */
+static void BM_ReceiveEncrypted(benchmark::State & state) {
+    BenchSession session;
+    std::vector<uint8_t> payload((size_t)state.range(0), 0xA5);
+    char header[] = BENCH_HTTP_HEADER;
+    int expected = (int)(strlen(header) + payload.size());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        session.controller.sendEncrypted(header, payload.data(), (int)payload.size());
+        state.ResumeTiming();
+        if (session.accessory.receiveEncrypted() != expected) {
+            state.SkipWithError("frames not decrypted");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)payload.size());
+}
+BENCHMARK(BM_ReceiveEncrypted)->Arg(64)->Arg(1024)->Arg(4096)->Arg(7936);
+
+/**
+ * @brief Fill the TLV<> of a pairing message
+ * @details
+ *  The records are created on first use, TLV<> never frees them. Every VALUE is
+ *  filled with the same pattern as the TLV8Writer benchmarks write, a byte counter
+ *  so that a misplaced fragment shows.
+ */
+static TLV<kTLVType, BENCH_TLV_RECORDS> & pairingTlv(t_benchTlvMessage & message) {
+    if (message.created == false) {
+        for (size_t i = 0U; i < sizeof(tlvPattern); i++) {
+            tlvPattern[i] = (uint8_t)i;
+        }
+        for (const t_benchTlvRecord & record : message.records) {
+            message.tlv.create(record.tag, record.len, "BENCH");
+        }
+        message.created = true;
+    }
+    message.tlv.clear();
+    for (const t_benchTlvRecord & record : message.records) {
+        memcpy(message.tlv.buf(record.tag, record.len), tlvPattern, (size_t)record.len);
+    }
+
+    return (message.tlv);
+}
+
+static void BM_TlvPack(benchmark::State & state, t_benchTlvMessage * message) {
+    TLV<kTLVType, BENCH_TLV_RECORDS> & tlv = pairingTlv(*message);
+    uint8_t packed[BENCH_BUFFER_LEN];
+    int len = tlv.pack(NULL);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tlv.pack(packed));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_CAPTURE(BM_TlvPack, m4, &pairingM4);
+BENCHMARK_CAPTURE(BM_TlvPack, m5_sub, &pairingM5);
+
+/* Same records serialized straight into the output buffer, the result must match TLV<>::pack() */
+static void BM_Tlv8WriterPack(benchmark::State & state, t_benchTlvMessage * message) {
+    uint8_t expected[BENCH_BUFFER_LEN];
+    uint8_t packed[BENCH_BUFFER_LEN];
+    int len = pairingTlv(*message).pack(expected);
+
+    for (auto _ : state) {
+        TLV8Writer<kTLVType> writer(packed, sizeof(packed));
+        for (const t_benchTlvRecord & record : message->records) {
+            (void)writer.add(record.tag, tlvPattern, record.len);
+        }
+        benchmark::DoNotOptimize(writer.len());
+    }
+    if (memcmp(packed, expected, (size_t)len) != 0) {
+        state.SkipWithError("TLV8Writer output differs from TLV<>::pack()");
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_CAPTURE(BM_Tlv8WriterPack, m4, &pairingM4);
+BENCHMARK_CAPTURE(BM_Tlv8WriterPack, m5_sub, &pairingM5);
+
+static void BM_TlvUnpack(benchmark::State & state, t_benchTlvMessage * message) {
+    TLV<kTLVType, BENCH_TLV_RECORDS> & tlv = pairingTlv(*message);
+    uint8_t packed[BENCH_BUFFER_LEN];
+    int len = tlv.pack(packed);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tlv.unpack(packed, len));
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_CAPTURE(BM_TlvUnpack, m4, &pairingM4);
+BENCHMARK_CAPTURE(BM_TlvUnpack, m5_sub, &pairingM5);
+
+/* Indexing the same records in place and reading every VALUE; the copy of the message is counted, buf() stitches fragments over it */
+static void BM_Tlv8ViewParse(benchmark::State & state, t_benchTlvMessage * message) {
+    uint8_t packed[BENCH_BUFFER_LEN];
+    uint8_t work[BENCH_BUFFER_LEN];
+    int len = pairingTlv(*message).pack(packed);
+    TLV8View<kTLVType, BENCH_TLV_RECORDS> view;
+
+    for (auto _ : state) {
+        memcpy(work, packed, (size_t)len);
+        benchmark::DoNotOptimize(view.parse(work, len));
+        for (const t_benchTlvRecord & record : message->records) {
+            benchmark::DoNotOptimize(view.buf(record.tag));
+        }
+    }
+    for (const t_benchTlvRecord & record : message->records) {
+        if ((view.len(record.tag) != record.len) || (memcmp(view.buf(record.tag), tlvPattern, (size_t)record.len) != 0)) {
+            state.SkipWithError("TLV8View record differs from the packed one");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK_CAPTURE(BM_Tlv8ViewParse, m4, &pairingM4);
+BENCHMARK_CAPTURE(BM_Tlv8ViewParse, m5_sub, &pairingM5);
+
+/* A WEBLOG() line as the zones write them, with the ring of entries full */
+static void BM_WebLogVLog(benchmark::State & state) {
+    for (auto _ : state) {
+        homeSpan.addWebLog(false, "%s %s relay %s after %u ms", "Zone 12", "heating", "CLOSE", 120U);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WebLogVLog);
@@ -0,0 +1,139 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+
+/* Local files */
+#include "history/historyStore.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Seconds between two raw samples, one per THERMOSTAT_STATUS_UPDATE_POLLING_TIME as in the zone scheduler */
+#define BENCH_HISTORY_SAMPLE_PERIOD             (30U)
+
+/** @brief Recorded days, the depth of the 1-hour tier */
+#define BENCH_HISTORY_DAYS                      (30U)
+
+/** @brief Seconds in a day */
+#define BENCH_HISTORY_DAY                       (24U * 3600U)
+
+/** @brief First sample, 2026-01-01 00:00 UTC */
+#define BENCH_HISTORY_START                     (1767225600U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Simulated room feeding the store */
+typedef struct {
+    uint32_t time;                      /**< Time of the next sample, seconds since epoch */
+    int16_t temperature;                /**< 1/100 °C */
+    bool heating;                       /**< Relay closed */
+} t_benchRoom;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Record the room for a duration: day and night setpoints, a relay with 0.3 °C hysteresis */
+static void record(HistoryStore & store, t_benchRoom & room, const uint32_t seconds) {
+    uint32_t end = room.time + seconds;
+
+    for (; room.time < end; room.time += BENCH_HISTORY_SAMPLE_PERIOD) {
+        uint32_t hour = (room.time % BENCH_HISTORY_DAY) / 3600U;
+        t_historySample sample;
+
+        sample.setpoint = ((hour >= 7U) && (hour < 22U)) ? 190 : 160;
+        if (room.temperature < sample.setpoint * 10 - 30) {
+            room.heating = true;
+        } else if (room.temperature > sample.setpoint * 10 + 30) {
+            room.heating = false;
+        }
+        room.temperature += room.heating ? 2 : -1;
+
+        sample.temperature = room.temperature;
+        sample.humidity = 450U + (uint16_t)(hour * 5U);
+        sample.relayDuty = room.heating ? 100U : 0U;
+        sample.reserved = 0U;
+        store.addSample(room.time, sample);
+    }
+}
+
+/** @brief Store holding a full 30 days, filled on first use */
+static const HistoryStore & filledStore(void) {
+    static HistoryStore store;
+    static t_benchRoom room = {BENCH_HISTORY_START, 1800, false};
+
+    if (room.time == BENCH_HISTORY_START) {
+        record(store, room, (BENCH_HISTORY_DAYS + 1U) * BENCH_HISTORY_DAY);
+    }
+    return (store);
+}
+
+static bool sumTemperature(const t_historyPoint & point, void * arg) {
+    *(int32_t *)arg += point.sample.temperature;
+    return (true);
+}
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* Cost of one raw sample from the zone scheduler, the periods it closes included */
+static void BM_HistoryAddSample(benchmark::State & state) {
+    static HistoryStore store;
+    static t_benchRoom room = {BENCH_HISTORY_START, 1800, false};
+
+    for (auto _ : state) {
+        record(store, room, BENCH_HISTORY_SAMPLE_PERIOD);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HistoryAddSample);
+
+/* Recording 30 days, then the memory the store holds them in */
+static void BM_HistoryRecord30Days(benchmark::State & state) {
+    static HistoryStore store;
+    static t_benchRoom room = {BENCH_HISTORY_START, 1800, false};
+    static const uint32_t depths[E_HISTORY_NB_TIERS] = {HISTORY_DEPTH_1MIN, HISTORY_DEPTH_15MIN, HISTORY_DEPTH_1HOUR};
+    static const char * const names[E_HISTORY_NB_TIERS] = {"samples_1min", "samples_15min", "samples_1hour"};
+
+    /* One day ahead, so the last period of each tier still being averaged does not leave it short */
+    if (room.time == BENCH_HISTORY_START) {
+        record(store, room, BENCH_HISTORY_DAY);
+    }
+
+    for (auto _ : state) {
+        record(store, room, BENCH_HISTORY_DAYS * BENCH_HISTORY_DAY);
+    }
+
+    /* Every tier holds at least its configured depth */
+    for (uint8_t tier = 0U; tier < E_HISTORY_NB_TIERS; tier++) {
+        int32_t sum = 0;
+        uint32_t nbSamples = store.query((t_historyTier)tier, 0U, UINT32_MAX, sumTemperature, &sum);
+        if (nbSamples < depths[tier]) {
+            state.SkipWithError("tier shorter than its depth");
+        }
+        state.counters[names[tier]] = (double)nbSamples;
+    }
+    state.counters["bytes"] = (double)store.getMemoryUsage();
+    state.counters["bytes_per_day"] = (double)store.getMemoryUsage() / BENCH_HISTORY_DAYS;
+}
+BENCHMARK(BM_HistoryRecord30Days)->Unit(benchmark::kMillisecond);
+
+/* Range query over 30 days of history */
+static void BM_HistoryQuery(benchmark::State & state, const t_historyTier tier, const uint32_t seconds) {
+    const HistoryStore & store = filledStore();
+    uint32_t to = BENCH_HISTORY_START + (BENCH_HISTORY_DAYS + 1U) * BENCH_HISTORY_DAY;
+    uint32_t nbPoints = 0U;
+
+    for (auto _ : state) {
+        int32_t sum = 0;
+        nbPoints = store.query(tier, to - seconds, to, sumTemperature, &sum);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * nbPoints);
+    state.counters["points"] = (double)nbPoints;
+}
+BENCHMARK_CAPTURE(BM_HistoryQuery, 1min_3hours, E_HISTORY_TIER_1MIN, 3U * 3600U)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_HistoryQuery, 15min_3days, E_HISTORY_TIER_15MIN, 3U * BENCH_HISTORY_DAY)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_HistoryQuery, 1hour_30days, E_HISTORY_TIER_1HOUR, BENCH_HISTORY_DAYS * BENCH_HISTORY_DAY)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_HistoryQuery, 1hour_last_day, E_HISTORY_TIER_1HOUR, BENCH_HISTORY_DAY)->Unit(benchmark::kMicrosecond);
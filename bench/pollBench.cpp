@@ -0,0 +1,555 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <errno.h>
+#include <fcntl.h>
+#include <functional>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sodium.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+/* Local files */
+#include "HAP.h"
+#include "spanTestAccess.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Measurement window of one iteration, ms */
+#define BENCH_POLL_WINDOW                       (1000U)
+
+/** @brief Sleep between two passes before pollTask() waited in select(), the vTaskDelay() of autoPoll(), ms */
+#define BENCH_POLL_QUANTUM                      (5U)
+
+/** @brief Connected controllers that send nothing, as Home hubs between requests */
+#define BENCH_POLL_IDLE_CLIENTS                 (4U)
+
+/** @brief Period of the probe requests, plus up to one quantum so they land anywhere in it, ms */
+#define BENCH_POLL_PROBE_PERIOD                 (20U)
+
+/** @brief pollCallback interval, the ZONE_POLL_INTERVAL of the bridge */
+#define BENCH_POLL_CALLBACK_INTERVAL            (100U)
+
+/** @brief Longest wait for a response, ms */
+#define BENCH_POLL_RESPONSE_TIMEOUT             (1000U)
+
+/** @brief Time given to pollTask() to accept or release connections, ms */
+#define BENCH_POLL_SETTLE_TIME                  (50U)
+
+/** @brief Connections a flood keeps open, more than the HAP slots so new ones always evict old ones */
+#define BENCH_POLL_FLOOD_OPEN                   (32U)
+
+/** @brief Request of the paired controller, a read of the Identify characteristic of the bridge */
+#define BENCH_POLL_CONTROLLER_REQUEST           "GET /characteristics?id=1.2 HTTP/1.1\r\n\r\n"
+
+/** @brief Probe request: pair-verify M1 on an unpaired accessory, answered with an error TLV on the same connection */
+#define BENCH_POLL_PROBE_REQUEST                "POST /pair-verify HTTP/1.1\r\n" \
+                                                "Content-Type: application/pairing+tlv8\r\n" \
+                                                "Content-Length: 3\r\n\r\n" \
+                                                "\x06\x01\x01"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief How pollTask() waits between two passes */
+typedef enum {
+    E_BENCH_POLL_SELECT = 0,            /**< select() on all sockets until a request or a deadline, current pollTask() */
+    E_BENCH_POLL_QUANTUM                /**< Every slot checked with available(), then a fixed sleep, pollTask() before select() */
+} t_benchPollMode;
+
+/** @brief What the poll loop did during the measurement windows */
+typedef struct {
+    double wallSeconds;                 /**< Length of the windows */
+    double cpuSeconds;                  /**< CPU time of the poll loop */
+    uint64_t passes;                    /**< Passes of pollTask() */
+    uint64_t callbacks;                 /**< Calls of pollCallback */
+    uint64_t connections;               /**< Connections opened by the flood */
+    std::vector<double> latencies;      /**< Round trip of every probe request, us */
+} t_benchPollStats;
+
+/** @brief Controller end of a verified session, keys swapped with the accessory end */
+typedef struct {
+    int fd;                             /**< Socket */
+    uint8_t c2aKey[32];                 /**< Key of the requests */
+    uint8_t a2cKey[32];                 /**< Key of the responses */
+    uint32_t c2aCount;                  /**< Frames sent */
+    uint32_t a2cCount;                  /**< Frames received */
+} t_benchPollSession;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Port the HAP server listens on, picked by the system */
+static uint16_t pollPort = 0U;
+
+/** @brief Calls of pollCallback */
+static std::atomic<uint32_t> pollCallbacks(0U);
+
+/** @brief Paired admin controller the measured connection is verified with */
+static Controller pollController = {true, true, {0}, {0}};
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void countCallback(void) {
+    pollCallbacks++;
+}
+
+static double threadCpuSeconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return (now.tv_sec + now.tv_nsec / 1e9);
+}
+
+/** @brief Start the HAP server on a free port, once */
+static bool pollServerStart(void) {
+    if (pollPort == 0U) {
+        HapServer * server = SpanTestAccess::hapServer();
+        struct sockaddr_in address;
+        socklen_t len = sizeof(address);
+
+        server->port = 0U;
+        server->begin();
+        if ((server->sockfd >= 0) && (getsockname(server->sockfd, (struct sockaddr *)&address, &len) == 0)) {
+            pollPort = ntohs(address.sin_port);
+        }
+        homeSpan.setPollCallback(countCallback, BENCH_POLL_CALLBACK_INTERVAL);
+    }
+
+    return (pollPort != 0U);
+}
+
+/** @brief Connect a controller to the HAP server, -1 on failure */
+static int pollConnect(void) {
+    struct sockaddr_in address = {};
+    struct timeval timeout = {BENCH_POLL_RESPONSE_TIMEOUT / 1000U, (BENCH_POLL_RESPONSE_TIMEOUT % 1000U) * 1000U};
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(pollPort);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if ((fd < 0) || (connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0)) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return (-1);
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    return (fd);
+}
+
+/** @brief Whether the HTTP response received so far is complete, header and Content-Length bytes of body */
+static bool pollResponseComplete(const char * response, const size_t received) {
+    const char * body = strstr(response, "\r\n\r\n");
+    const char * length = strstr(response, "Content-Length: ");
+
+    return ((body != NULL) && (length != NULL) &&
+            (received >= (size_t)(body + 4 - response) + (size_t)atoi(length + strlen("Content-Length: "))));
+}
+
+/**
+ * @brief Send the probe request and read the whole response, false on error or timeout
+ * @details
+ *  HapServer turns Nagle on as WiFiServer does, so the body of the response waits for the
+ *  ACK of its header. Quick ACKs, re-armed before every read as Linux drops them, keep the
+ *  40 ms delayed ACK of the host out of the round trip.
+ */
+static bool pollRoundTrip(const int fd) {
+    static const char request[] = BENCH_POLL_PROBE_REQUEST;
+    char response[512];
+    size_t received = 0U;
+    int enable = 1;
+
+    if (send(fd, request, sizeof(request) - 1U, 0) != (ssize_t)(sizeof(request) - 1U)) {
+        return (false);
+    }
+
+    for (;;) {
+        setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &enable, sizeof(enable));
+        ssize_t n = recv(fd, response + received, sizeof(response) - 1U - received, 0);
+        if (n <= 0) {
+            return (false);
+        }
+        received += (size_t)n;
+        response[received] = '\0';
+
+        if (pollResponseComplete(response, received)) {
+            return (true);
+        }
+        if (received == sizeof(response) - 1U) {
+            return (false);
+        }
+    }
+}
+
+/** @brief Read exactly len bytes, false on error or timeout */
+static bool pollRecvAll(const int fd, uint8_t * buffer, const size_t len) {
+    size_t received = 0U;
+    int enable = 1;
+
+    while (received < len) {
+        setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &enable, sizeof(enable));
+        ssize_t n = recv(fd, buffer + received, len - received, 0);
+        if (n <= 0) {
+            return (false);
+        }
+        received += (size_t)n;
+    }
+
+    return (true);
+}
+
+/** @brief ChaCha20-Poly1305 nonce of a frame, the counter in the layout of HomeSpan's Nonce */
+static void pollNonce(uint8_t nonce[12], const uint32_t count) {
+    memset(nonce, 0, 12U);
+    for (int i = 0; i < 4; i++) {
+        nonce[4 + i] = (uint8_t)(count >> (8 * i));
+    }
+}
+
+/** @brief Send the controller request in one encrypted frame and decrypt the whole response, false on error or timeout */
+static bool pollEncryptedRoundTrip(t_benchPollSession & session) {
+    static const char request[] = BENCH_POLL_CONTROLLER_REQUEST;
+    uint8_t frame[2U + 1024U + 16U];
+    uint8_t nonce[12];
+    char response[1024];
+    size_t received = 0U;
+
+    frame[0] = (uint8_t)(sizeof(request) - 1U);
+    frame[1] = 0U;
+    pollNonce(nonce, session.c2aCount++);
+    crypto_aead_chacha20poly1305_ietf_encrypt(frame + 2, NULL, (const uint8_t *)request, sizeof(request) - 1U,
+                                              frame, 2, NULL, nonce, session.c2aKey);
+    if (send(session.fd, frame, 2U + sizeof(request) - 1U + 16U, 0) != (ssize_t)(2U + sizeof(request) - 1U + 16U)) {
+        return (false);
+    }
+
+    for (;;) {
+        if (pollRecvAll(session.fd, frame, 2U) == false) {
+            return (false);
+        }
+        size_t len = frame[0] + frame[1] * 256U;
+        if ((len > 1024U) || (received + len >= sizeof(response)) || (pollRecvAll(session.fd, frame + 2, len + 16U) == false)) {
+            return (false);
+        }
+        pollNonce(nonce, session.a2cCount++);
+        if (crypto_aead_chacha20poly1305_ietf_decrypt((uint8_t *)response + received, NULL, NULL, frame + 2, len + 16U,
+                                                      frame, 2, nonce, session.a2cKey) != 0) {
+            return (false);
+        }
+        received += len;
+        response[received] = '\0';
+
+        if (pollResponseComplete(response, received)) {
+            return (true);
+        }
+    }
+}
+
+/**
+ * @brief Verify the connection of a controller, as the end of pair-verify does
+ * @details
+ *  Looks up the slot by port, then gives it a paired controller and fresh session keys.
+ *
+ * @return false if pollTask() has not accepted the connection
+ */
+static bool pollVerify(t_benchPollSession & session) {
+    struct sockaddr_in address;
+    socklen_t len = sizeof(address);
+
+    if (getsockname(session.fd, (struct sockaddr *)&address, &len) != 0) {
+        return (false);
+    }
+    randombytes_buf(session.c2aKey, sizeof(session.c2aKey));
+    randombytes_buf(session.a2cKey, sizeof(session.a2cKey));
+    session.c2aCount = 0U;
+    session.a2cCount = 0U;
+
+    for (int i = 0; i < SpanTestAccess::maxConnections(); i++) {
+        if (hap[i]->client && (hap[i]->client.remotePort() == ntohs(address.sin_port))) {
+            hap[i]->cPair = &pollController;
+            memcpy(hap[i]->c2aKey, session.c2aKey, sizeof(session.c2aKey));
+            memcpy(hap[i]->a2cKey, session.a2cKey, sizeof(session.a2cKey));
+            hap[i]->c2aNonce.zero();
+            hap[i]->a2cNonce.zero();
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/** @brief Clients evicted from all slots so far */
+static uint32_t pollEvictions(void) {
+    uint32_t evictions = 0U;
+
+    for (int i = 0; i < SpanTestAccess::maxConnections(); i++) {
+        evictions += hap[i]->nEvictions;
+    }
+
+    return (evictions);
+}
+
+/**
+ * @brief Open rate connections per second until stopped, each sending the probe request and never reading
+ * @details
+ *  Like a scanner or a misbehaving device on the LAN. At most BENCH_POLL_FLOOD_OPEN
+ *  connections stay open, the oldest is closed to open a new one.
+ */
+static void pollFlood(const uint32_t rate, std::atomic<bool> & running, std::atomic<uint32_t> & opened) {
+    static const char request[] = BENCH_POLL_PROBE_REQUEST;
+    std::deque<std::pair<int, bool>> open;
+    auto next = std::chrono::steady_clock::now();
+
+    while (running) {
+        next += std::chrono::microseconds(1000000U / rate);
+        std::this_thread::sleep_until(next);
+
+        if (open.size() == BENCH_POLL_FLOOD_OPEN) {
+            close(open.front().first);
+            open.pop_front();
+        }
+
+        struct sockaddr_in address = {};
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        address.sin_family = AF_INET;
+        address.sin_port = htons(pollPort);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd >= 0) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            if ((connect(fd, (struct sockaddr *)&address, sizeof(address)) == 0) || (errno == EINPROGRESS)) {
+                open.push_back(std::make_pair(fd, false));
+                opened++;
+            } else {
+                close(fd);
+            }
+        }
+
+        /* The request goes out once the connection is established */
+        for (auto & connection : open) {
+            if ((connection.second == false) &&
+                (send(connection.first, request, sizeof(request) - 1U, MSG_NOSIGNAL) == (ssize_t)(sizeof(request) - 1U))) {
+                connection.second = true;
+            }
+        }
+    }
+
+    for (auto & connection : open) {
+        close(connection.first);
+    }
+}
+
+/** @brief One pass of pollTask() as it waits in the given mode */
+static void pollPass(const t_benchPollMode mode) {
+    if (mode == E_BENCH_POLL_QUANTUM) {
+        SpanTestAccess::pollAll();
+        homeSpan.poll();
+        delay(BENCH_POLL_QUANTUM);
+    } else {
+        homeSpan.poll();
+    }
+}
+
+/** @brief Run pollTask() for a while, so it accepts or releases connections */
+static void pollSettle(const t_benchPollMode mode) {
+    uint32_t start = millis();
+
+    while (millis() - start < BENCH_POLL_SETTLE_TIME) {
+        pollPass(mode);
+    }
+}
+
+/**
+ * @brief Run pollTask() for one window, optionally with a client timing requests and a flood of connections
+ *
+ * @param mode          How pollTask() waits between passes
+ * @param request       Round trip of the timed client, none if empty
+ * @param floodRate     Connections per second of the flood, 0 for none
+ * @param stats         Statistics to add to
+ *
+ * @return false if a timed request failed
+ */
+static bool pollWindow(const t_benchPollMode mode, const std::function<bool(void)> & request, const uint32_t floodRate,
+                       t_benchPollStats & stats) {
+    std::atomic<bool> running(true);
+    std::atomic<bool> done(!request);
+    std::atomic<bool> failed(false);
+    std::atomic<uint32_t> opened(0U);
+    std::thread prober;
+    std::thread flood;
+
+    if (request) {
+        prober = std::thread([&]() {
+            unsigned int seed = 1U;
+
+            /* The first request may wait for the connection to be accepted, not timed */
+            if (request() == false) {
+                failed = true;
+            }
+            while (running && !failed) {
+                usleep((BENCH_POLL_PROBE_PERIOD + rand_r(&seed) % BENCH_POLL_QUANTUM) * 1000U + rand_r(&seed) % 1000U);
+                auto start = std::chrono::steady_clock::now();
+                if (request() == false) {
+                    failed = true;
+                    break;
+                }
+                stats.latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+            done = true;
+        });
+    }
+    if (floodRate > 0U) {
+        flood = std::thread(pollFlood, floodRate, std::ref(running), std::ref(opened));
+    }
+
+    uint32_t callbacks = pollCallbacks;
+    double cpuStart = threadCpuSeconds();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    while (std::chrono::steady_clock::now() - wallStart < std::chrono::milliseconds(BENCH_POLL_WINDOW)) {
+        pollPass(mode);
+        stats.passes++;
+    }
+
+    stats.cpuSeconds += threadCpuSeconds() - cpuStart;
+    stats.wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    stats.callbacks += pollCallbacks - callbacks;
+
+    /* Keep serving the last request until the prober stops */
+    running = false;
+    while (!done) {
+        pollPass(mode);
+    }
+    if (prober.joinable()) {
+        prober.join();
+    }
+    if (flood.joinable()) {
+        flood.join();
+    }
+    stats.connections += opened;
+    pollSettle(mode);
+
+    return (!failed);
+}
+
+/** @brief Report the statistics of the windows as counters */
+static void pollReport(benchmark::State & state, t_benchPollStats & stats) {
+    state.counters["cpu_pct"] = 100.0 * stats.cpuSeconds / stats.wallSeconds;
+    state.counters["passes_per_s"] = stats.passes / stats.wallSeconds;
+    state.counters["callbacks_per_s"] = stats.callbacks / stats.wallSeconds;
+
+    if (stats.latencies.empty() == false) {
+        std::sort(stats.latencies.begin(), stats.latencies.end());
+        double sum = 0.0;
+        for (double latency : stats.latencies) {
+            sum += latency;
+        }
+        state.counters["requests"] = (double)stats.latencies.size();
+        state.counters["latency_mean_us"] = sum / stats.latencies.size();
+        state.counters["latency_p99_us"] = stats.latencies[(stats.latencies.size() * 99U) / 100U];
+        state.counters["latency_max_us"] = stats.latencies.back();
+    }
+}
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* pollTask() with idle controllers connected, and with one more sending a request every 20 to 25 ms */
+static void BM_PollTask(benchmark::State & state, const t_benchPollMode mode, const bool probe) {
+    t_benchPollStats stats = {};
+    std::vector<int> idle;
+    int fd = -1;
+
+    if (pollServerStart() == false) {
+        state.SkipWithError("HAP server not started");
+        return;
+    }
+    homeSpan.setLogLevel(-1);
+
+    for (uint32_t i = 0U; i < BENCH_POLL_IDLE_CLIENTS; i++) {
+        idle.push_back(pollConnect());
+    }
+    if (probe) {
+        fd = pollConnect();
+    }
+    pollSettle(mode);
+
+    for (auto _ : state) {
+        if (pollWindow(mode, probe ? std::function<bool(void)>([fd]() { return (pollRoundTrip(fd)); }) : nullptr, 0U, stats) == false) {
+            state.SkipWithError("probe request failed");
+            break;
+        }
+    }
+
+    idle.push_back(fd);
+    for (int client : idle) {
+        if (client >= 0) {
+            close(client);
+        }
+    }
+    pollSettle(mode);
+    homeSpan.setLogLevel(0);
+
+    pollReport(state, stats);
+}
+BENCHMARK_CAPTURE(BM_PollTask, quantum_idle, E_BENCH_POLL_QUANTUM, false)->Iterations(2)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PollTask, select_idle, E_BENCH_POLL_SELECT, false)->Iterations(2)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PollTask, quantum_requests, E_BENCH_POLL_QUANTUM, true)->Iterations(2)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_PollTask, select_requests, E_BENCH_POLL_SELECT, true)->Iterations(2)->Unit(benchmark::kMillisecond);
+
+/*
+ * A paired controller sending an encrypted request every 20 to 25 ms while unverified clients
+ * open state.range(0) connections per second, each sending a request. Every slot stays busy,
+ * so each new connection evicts one: getEvictSlot() must never pick the controller, and the
+ * poll budget must keep its latency bounded.
+ */
+static void BM_PollFlood(benchmark::State & state) {
+    t_benchPollStats stats = {};
+    t_benchPollSession session = {};
+
+    if (pollServerStart() == false) {
+        state.SkipWithError("HAP server not started");
+        return;
+    }
+    homeSpan.setLogLevel(-1);
+
+    session.fd = pollConnect();
+    pollSettle(E_BENCH_POLL_SELECT);
+    if ((session.fd < 0) || (pollVerify(session) == false)) {
+        state.SkipWithError("controller not connected");
+        homeSpan.setLogLevel(0);
+        return;
+    }
+    uint32_t evictions = pollEvictions();
+
+    for (auto _ : state) {
+        if (pollWindow(E_BENCH_POLL_SELECT, [&session]() { return (pollEncryptedRoundTrip(session)); }, (uint32_t)state.range(0), stats) == false) {
+            state.SkipWithError("controller evicted or request failed");
+            break;
+        }
+    }
+    evictions = pollEvictions() - evictions;
+
+    close(session.fd);
+    pollSettle(E_BENCH_POLL_SELECT);
+    homeSpan.setLogLevel(0);
+
+    pollReport(state, stats);
+    state.counters["connections_per_s"] = stats.connections / stats.wallSeconds;
+    state.counters["evictions"] = evictions;
+}
+BENCHMARK(BM_PollFlood)->Arg(0)->Arg(100)->Arg(500)->Arg(2000)->Iterations(2)->Unit(benchmark::kMillisecond);
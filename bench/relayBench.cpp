@@ -0,0 +1,86 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+
+/* Local files */
+#include "fakeRelay.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Shared HMAC key of the UDP relay */
+#define BENCH_RELAY_KEY                         "bench-relay-key"
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* Round trip of a relay command to a stand-in relay on localhost, the state toggles every time */
+static void BM_RelayCommand(benchmark::State & state, const t_esp01sRelayTransport transport) {
+    FakeRelay relay;
+    t_esp01sRelayState command = E_ESP01S_RELAY_CLOSE;
+
+    if (relay.begin(transport, BENCH_RELAY_KEY) == false) {
+        state.SkipWithError("stand-in relay not started");
+        return;
+    }
+    Esp01sRelay client("127.0.0.1", relay.getPort(), transport, BENCH_RELAY_KEY);
+
+    for (auto _ : state) {
+        if (client.sendEsp01sRelayCommand(command) != E_REQUEST_SUCCESS) {
+            state.SkipWithError("relay command failed");
+            break;
+        }
+        command = (command == E_ESP01S_RELAY_CLOSE) ? E_ESP01S_RELAY_OPEN : E_ESP01S_RELAY_CLOSE;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_RelayCommand, http, E_ESP01S_RELAY_HTTP)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RelayCommand, udp, E_ESP01S_RELAY_UDP)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/* Round trip of the periodic status query */
+static void BM_RelayStatus(benchmark::State & state, const t_esp01sRelayTransport transport) {
+    FakeRelay relay;
+    t_esp01sRelayState current;
+
+    if (relay.begin(transport, BENCH_RELAY_KEY) == false) {
+        state.SkipWithError("stand-in relay not started");
+        return;
+    }
+    Esp01sRelay client("127.0.0.1", relay.getPort(), transport, BENCH_RELAY_KEY);
+
+    for (auto _ : state) {
+        if (client.getEsp01sRelayState(&current) != E_REQUEST_SUCCESS) {
+            state.SkipWithError("relay status failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_CAPTURE(BM_RelayStatus, http, E_ESP01S_RELAY_HTTP)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RelayStatus, udp, E_ESP01S_RELAY_UDP)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+/* A command whose first datagram or connection is lost: UDP retransmits, HTTP fails the request */
+static void BM_RelayCommandFirstLost(benchmark::State & state, const t_esp01sRelayTransport transport) {
+    FakeRelay relay;
+    t_esp01sRelayState command = E_ESP01S_RELAY_CLOSE;
+    int64_t nbFailed = 0;
+
+    if (relay.begin(transport, BENCH_RELAY_KEY) == false) {
+        state.SkipWithError("stand-in relay not started");
+        return;
+    }
+    Esp01sRelay client("127.0.0.1", relay.getPort(), transport, BENCH_RELAY_KEY);
+
+    for (auto _ : state) {
+        relay.push(E_FAKE_RELAY_DROP);
+        if (client.sendEsp01sRelayCommand(command) != E_REQUEST_SUCCESS) {
+            nbFailed++;
+        }
+        command = (command == E_ESP01S_RELAY_CLOSE) ? E_ESP01S_RELAY_OPEN : E_ESP01S_RELAY_CLOSE;
+        relay.reset();
+    }
+    state.counters["failed"] = benchmark::Counter((double)nbFailed, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_CAPTURE(BM_RelayCommandFirstLost, http, E_ESP01S_RELAY_HTTP)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_RelayCommandFirstLost, udp, E_ESP01S_RELAY_UDP)->UseRealTime()->Unit(benchmark::kMicrosecond);
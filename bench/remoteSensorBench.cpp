@@ -0,0 +1,107 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <vector>
+
+/* Local files */
+#include "devices/remoteSensor.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Most sensor nodes of a bench, far beyond the zones of a house */
+#define BENCH_REMOTE_MAX_NODES                  (64U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Sensor node as the radio of the bridge sees it */
+typedef struct {
+    uint8_t mac[6];                     /**< MAC address, frames are demultiplexed on it */
+    RemoteSensor * sensor;              /**< Bridge end */
+} t_benchRemoteNode;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Nodes created so far, SpanPoints are never deleted so they are shared by the benches */
+static std::vector<t_benchRemoteNode> remoteNodes;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief At least nbNodes nodes, the first ones are those searched first by SpanPoint */
+static void remoteNodesSetup(const size_t nbNodes) {
+    while (remoteNodes.size() < nbNodes) {
+        t_benchRemoteNode node;
+        char mac[18];
+
+        snprintf(mac, sizeof(mac), "24:0A:C4:01:00:%02X", (unsigned int)remoteNodes.size());
+        sscanf(mac, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", &node.mac[0], &node.mac[1], &node.mac[2], &node.mac[3], &node.mac[4], &node.mac[5]);
+        node.sensor = new RemoteSensor(mac);
+        remoteNodes.push_back(node);
+    }
+}
+
+static t_remoteSensorFrame remoteFrame(const uint16_t sequence) {
+    t_remoteSensorFrame frame = {};
+
+    frame.version = REMOTE_SENSOR_FRAME_VERSION;
+    frame.flags = REMOTE_SENSOR_FLAG_HUMIDITY_VALID;
+    frame.sequence = sequence;
+    frame.temperature = (int16_t)(2000 + sequence % 300U);
+    frame.humidity = 4500U;
+    frame.batteryMv = 3000U;
+
+    return (frame);
+}
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* Validation and conversion of one frame */
+static void BM_RemoteSensorDecode(benchmark::State & state) {
+    t_remoteSensorFrame frame = remoteFrame(1U);
+    t_remoteSensorSample sample;
+    uint16_t sequence = 0U;
+
+    for (auto _ : state) {
+        frame.temperature = (int16_t)(2000 + (sequence++ & 0xFFU));
+        benchmark::DoNotOptimize(RemoteSensor::decodeFrame(&frame, &sample));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RemoteSensorDecode);
+
+/*
+ * Frames of state.range(0) nodes in turn, from the radio callback to the samples: SpanPoint
+ * demultiplexing on the MAC address, queueing, then draining by the control task. The last
+ * node is the one searched longest.
+ */
+static void BM_RemoteSensorIngest(benchmark::State & state) {
+    const size_t nbNodes = (size_t)state.range(0);
+    /* Kept across runs, a node drops a frame repeating the sequence number of the last one */
+    static uint16_t sequence = 0U;
+    int64_t stored = 0;
+
+    remoteNodesSetup(nbNodes);
+
+    for (auto _ : state) {
+        t_remoteSensorFrame frame = remoteFrame(sequence++);
+        for (size_t i = 0U; i < nbNodes; i++) {
+            nativeEspNowReceive(remoteNodes[i].mac, (const uint8_t *)&frame, sizeof(frame));
+        }
+        for (size_t i = 0U; i < nbNodes; i++) {
+            stored += remoteNodes[i].sensor->receive();
+        }
+    }
+
+    if (stored != state.iterations() * (int64_t)nbNodes) {
+        state.SkipWithError("frames lost or dropped");
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)nbNodes);
+}
+BENCHMARK(BM_RemoteSensorIngest)->Arg(1)->Arg(8)->Arg(BENCH_REMOTE_MAX_NODES);
@@ -0,0 +1,112 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+#include <sodium.h>
+
+/* Local files */
+#include "HAP.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Setup code of the verifier, the HomeSpan default */
+#define BENCH_SRP_SETUP_CODE                    "46637726"
+
+/** @brief Longest wait for keyTask() to pre-compute a key pair, ms */
+#define BENCH_SRP_KEY_TIMEOUT                   (10U * 1000U)
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Load a verifier and start keyTask(), as HAPClient::init() does for an unpaired accessory */
+static SRP6A & srpSetup(void) {
+    static bool loaded = false;
+    SRP6A & srp = HAPClient::srp;
+
+    if (loaded == false) {
+        uint8_t verifyCode[384];
+        uint8_t salt[16];
+        srp.createVerifyCode(BENCH_SRP_SETUP_CODE, verifyCode, salt);
+        srp.precomputeKeys();
+        loaded = true;
+    }
+
+    return (srp);
+}
+
+/** @brief Wait for keyTask() to have a key pair ready */
+static bool srpKeysReady(SRP6A & srp) {
+    for (uint32_t waited = 0U; waited < BENCH_SRP_KEY_TIMEOUT; waited++) {
+        bool ready = false;
+        if (xSemaphoreTake(srp.keyMutex, portMAX_DELAY) == pdTRUE) {
+            ready = srp.keyReady;
+            xSemaphoreGive(srp.keyMutex);
+        }
+        if (ready) {
+            return (true);
+        }
+        delay(1);
+    }
+
+    return (false);
+}
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/* Pair-setup M2 on the poll task without pre-computed keys: b, then B = k*v + g^b %N */
+static void BM_SrpPublicKeyInline(benchmark::State & state) {
+    SRP6A & srp = srpSetup();
+
+    /* Holding the mutex keeps the pre-computed keys out of reach, as when keyTask() is still busy */
+    if (xSemaphoreTake(srp.keyMutex, portMAX_DELAY) != pdTRUE) {
+        state.SkipWithError("SRP key mutex");
+        return;
+    }
+    for (auto _ : state) {
+        srp.createPublicKey();
+    }
+    xSemaphoreGive(srp.keyMutex);
+}
+BENCHMARK(BM_SrpPublicKeyInline)->Unit(benchmark::kMillisecond);
+
+/* Pair-setup M2 on the poll task with the key pair pre-computed by keyTask() */
+static void BM_SrpPublicKeyPrecomputed(benchmark::State & state) {
+    SRP6A & srp = srpSetup();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        if (srpKeysReady(srp) == false) {
+            state.SkipWithError("keyTask() did not pre-compute the keys");
+            break;
+        }
+        state.ResumeTiming();
+        srp.createPublicKey();
+    }
+}
+BENCHMARK(BM_SrpPublicKeyPrecomputed)->Unit(benchmark::kMicrosecond)->Iterations(200);
+
+/* Pair-setup M4 on the poll task: u and S = (A*v^u)^b %N from the public key of the controller, never pre-computed */
+static void BM_SrpSessionKey(benchmark::State & state) {
+    SRP6A & srp = srpSetup();
+    mbedtls_mpi a;
+    mbedtls_mpi rr;
+    uint8_t privateKey[32];
+
+    /* Public key of a controller, A = g^a %N */
+    mbedtls_mpi_init(&a);
+    mbedtls_mpi_init(&rr);
+    randombytes_buf(privateKey, sizeof(privateKey));
+    mbedtls_mpi_read_binary(&a, privateKey, sizeof(privateKey));
+    mbedtls_mpi_exp_mod(&srp.A, &srp.g, &a, &srp.N, &rr);
+    srp.createPublicKey();
+
+    for (auto _ : state) {
+        srp.createSessionKey();
+    }
+
+    mbedtls_mpi_free(&a);
+    mbedtls_mpi_free(&rr);
+}
+BENCHMARK(BM_SrpSessionKey)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <benchmark/benchmark.h>
+
+/* Local files */
+#include "zoneBench.h"
+#include "testBench.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Simulated time run after adding zones, every periodic job runs once before measuring */
+#define ZONE_BENCH_WARMUP                       (GET_STATUS_REFRESH_TIME_IN_MS + 10U * ZONE_CONTROL_PERIOD)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Stand-in relay shared by every zone */
+static FakeRelay relay;
+
+static t_zoneConfig configs[MAX_NB_ZONES];
+static char names[MAX_NB_ZONES][16];
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Grow the zone table to nbZones zones, they cannot be removed */
+static bool zoneSetup(benchmark::State & state) {
+    uint8_t nbZones = (uint8_t)state.range(0);
+
+    if ((relay.getPort() == 0U) && (relay.begin() == false)) {
+        state.SkipWithError("stand-in relay not started");
+        return (false);
+    }
+    if (zoneTable.getNbZones() > nbZones) {
+        state.SkipWithError("zone table already larger, run the sizes in increasing order");
+        return (false);
+    }
+
+    while (zoneTable.getNbZones() < nbZones) {
+        uint8_t i = zoneTable.getNbZones();
+        snprintf(names[i], sizeof(names[i]), "Room %u", (unsigned int)(i + 1U));
+        configs[i] = testBenchZoneConfig(names[i], relay.getPort());
+        if (zoneTable.addZone(&configs[i]) == NULL) {
+            state.SkipWithError("zone not added");
+            return (false);
+        }
+    }
+    testBenchRun(ZONE_BENCH_WARMUP);
+
+    state.counters["zones"] = (double)nbZones;
+    return (true);
+}
+
+/************************************************
+ *  Benchmarks
+ ***********************************************/
+/**
+ * @brief One scheduler pass over the zone table, every ZONE_CONTROL_PERIOD of simulated time
+ * @details
+ *  The pass includes the control side (sensor and relay polling, the relay
+ *  I/O amortized over its period) and the HomeKit side of every zone. The
+ *  cost per zone is items_per_second, the fitted complexity shows the
+ *  scaling.
+ */
+static void BM_ZonePass(benchmark::State & state) {
+    if (zoneSetup(state) == false) {
+        return;
+    }
+
+    for (auto _ : state) {
+        nativeAdvanceClock(ZONE_CONTROL_PERIOD);
+        zoneTable.run();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void zoneBenchRegister(void) {
+    benchmark::RegisterBenchmark("BM_ZonePass", BM_ZonePass)
+        ->DenseRange(1, 8, 1)
+        ->DenseRange(12, MAX_NB_ZONES, 4)
+        ->Complexity(benchmark::oN);
+}
@@ -0,0 +1,15 @@
+#ifndef ZONE_BENCH_H
+#define ZONE_BENCH_H
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @brief Register the zone table benchmarks
+ * @details
+ *  The zone table only grows, so these run after every statically registered
+ *  benchmark, once the synthetic HAP bridge has been removed.
+ */
+void zoneBenchRegister(void);
+
+#endif /* ZONE_BENCH_H */
@@ -0,0 +1,76 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local files */
+#include "esp01sRelay.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Stop the run on a broken parser invariant, libFuzzer then saves the input */
+#define FUZZ_CHECK(cond)                        do { if (!(cond)) { abort(); } } while (0)
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static bool sameStatus(const t_esp01sRelayStatus & a, const t_esp01sRelayStatus & b) {
+    return ((a.state == b.state) && (a.uptime == b.uptime) && (a.rssi == b.rssi));
+}
+
+/************************************************
+ *  Fuzz target
+ ***********************************************/
+/**
+ * @brief Feed one relay answer to Esp01sRelay::parseStatus
+ * @details
+ *  The body is parsed from a buffer of exactly size bytes, so AddressSanitizer reports
+ *  any read past len. On top of memory safety it checks that:
+ *   - a rejected body leaves the status untouched,
+ *   - an accepted body gives a valid relay state,
+ *   - the bytes after len never change the result,
+ *   - trailing whitespace never changes the result.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size) {
+    const t_esp01sRelayStatus untouched = {E_ESP01S_RELAY_CLOSE, 0xDEADBEEFU, 42};
+    t_esp01sRelayStatus status = untouched;
+    t_esp01sRelayStatus other = untouched;
+    char * body = (char *)malloc(size + 2U);
+    bool valid;
+
+    if (body == NULL) {
+        return (0);
+    }
+    memcpy(body, data, size);
+
+    /* Exact size, nothing readable past the body */
+    char * exact = (char *)malloc((size > 0U) ? size : 1U);
+    FUZZ_CHECK(exact != NULL);
+    memcpy(exact, data, size);
+    valid = Esp01sRelay::parseStatus(exact, size, &status);
+    free(exact);
+
+    if (valid) {
+        FUZZ_CHECK((status.state == E_ESP01S_RELAY_OPEN) || (status.state == E_ESP01S_RELAY_CLOSE));
+    } else {
+        FUZZ_CHECK(sameStatus(status, untouched));
+    }
+
+    /* A digit right after the body must not be seen */
+    body[size] = '1';
+    FUZZ_CHECK(Esp01sRelay::parseStatus(body, size, &other) == valid);
+    FUZZ_CHECK(sameStatus(status, other));
+
+    /* The relay may end its answer with a newline */
+    body[size] = '\r';
+    body[size + 1U] = '\n';
+    other = untouched;
+    FUZZ_CHECK(Esp01sRelay::parseStatus(body, size + 2U, &other) == valid);
+    FUZZ_CHECK(sameStatus(status, other));
+
+    free(body);
+    return (0);
+}
@@ -0,0 +1,188 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+/* Local files */
+#include "HAP.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Stop the run on a broken parser invariant, libFuzzer then saves the input */
+#define FUZZ_CHECK(cond)                        do { if (!(cond)) { abort(); } } while (0)
+
+/** @brief Records indexed by the view, as many as the largest sub-TLV of pair-setup */
+#define FUZZ_MAX_RECORDS                        (5)
+
+/** @brief Largest TLV8 body the view and the writer are given */
+#define FUZZ_MAX_LEN                            (1024U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Record reassembled from its fragments */
+typedef struct {
+    uint8_t tag;                        /**< TAG */
+    std::vector<uint8_t> value;         /**< VALUE of all fragments */
+} t_fuzzRecord;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/**
+ * @brief Reference TLV8 decoder
+ * @details
+ *  A record of 255 bytes followed by one with the same TAG continues into it.
+ *
+ * @return false if a header or a VALUE runs past size, or if there are too many records
+ */
+static bool decode(const uint8_t * data, const size_t size, std::vector<t_fuzzRecord> & records) {
+    size_t i = 0U;
+    size_t lastLen = 0U;
+
+    while (i < size) {
+        if ((size - i < 2U) || (size - i - 2U < data[i + 1U])) {
+            return (false);
+        }
+        uint8_t tag = data[i];
+        size_t len = data[i + 1U];
+
+        if ((records.empty() == false) && (records.back().tag == tag) && (lastLen == 255U)) {
+            records.back().value.insert(records.back().value.end(), data + i + 2U, data + i + 2U + len);
+        } else {
+            if (records.size() == FUZZ_MAX_RECORDS) {
+                return (false);
+            }
+            records.push_back({tag, std::vector<uint8_t>(data + i + 2U, data + i + 2U + len)});
+        }
+        lastLen = len;
+        i += 2U + len;
+    }
+
+    return (true);
+}
+
+/** @brief First record of a TAG, as the view finds it */
+static const t_fuzzRecord * first(const std::vector<t_fuzzRecord> & records, const uint8_t tag) {
+    for (const t_fuzzRecord & record : records) {
+        if (record.tag == tag) {
+            return (&record);
+        }
+    }
+    return (NULL);
+}
+
+/** @brief VALUE of a record, never NULL even when empty as HAP always passes a buffer */
+static const uint8_t * valueOf(const t_fuzzRecord & record) {
+    static const uint8_t empty = 0U;
+    return (record.value.empty() ? &empty : record.value.data());
+}
+
+/** @brief Check every TAG of a view against the reference records */
+static void checkView(TLV8View<uint8_t, FUZZ_MAX_RECORDS> & view, const uint8_t * start, const size_t size,
+                      const std::vector<t_fuzzRecord> & records) {
+    for (int tag = 0; tag < 256; tag++) {
+        const t_fuzzRecord * record = first(records, (uint8_t)tag);
+
+        if (record == NULL) {
+            FUZZ_CHECK(view.buf((uint8_t)tag) == NULL);
+            FUZZ_CHECK(view.len((uint8_t)tag) == -1);
+            FUZZ_CHECK(view.val((uint8_t)tag) == -1);
+            continue;
+        }
+
+        /* VALUE stitched in place, inside the viewed buffer */
+        uint8_t * value = view.buf((uint8_t)tag);
+        FUZZ_CHECK(view.len((uint8_t)tag) == (int)record->value.size());
+        FUZZ_CHECK((value >= start) && (value + record->value.size() <= start + size));
+        FUZZ_CHECK(memcmp(value, valueOf(*record), record->value.size()) == 0);
+        FUZZ_CHECK(view.val((uint8_t)tag) == (record->value.empty() ? -1 : record->value[0]));
+
+        /* Stitching only happens once */
+        FUZZ_CHECK(view.buf((uint8_t)tag) == value);
+        FUZZ_CHECK(memcmp(value, valueOf(*record), record->value.size()) == 0);
+    }
+}
+
+/************************************************
+ *  Fuzz target
+ ***********************************************/
+/**
+ * @brief Feed one TLV8 body to TLV8View, then write it back with TLV8Writer
+ * @details
+ *  The body is viewed in a buffer of exactly size bytes, so AddressSanitizer reports
+ *  any access past it, including while fragments are stitched. On top of memory
+ *  safety it checks that:
+ *   - the view accepts the same bodies as a reference decoder,
+ *   - every TAG gives the reassembled VALUE of its first record,
+ *   - the records written back by TLV8Writer view the same,
+ *   - the writer fails rather than overflow a buffer one byte too short.
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t * data, size_t size) {
+    std::vector<t_fuzzRecord> records;
+    TLV8View<uint8_t, FUZZ_MAX_RECORDS> view;
+
+    if (size > FUZZ_MAX_LEN) {
+        return (0);
+    }
+
+    uint8_t * body = (uint8_t *)malloc((size > 0U) ? size : 1U);
+    FUZZ_CHECK(body != NULL);
+    memcpy(body, data, size);
+
+    bool valid = decode(data, size, records);
+    FUZZ_CHECK((view.parse(body, (int)size) == 1) == valid);
+    if (valid == false) {
+        free(body);
+        return (0);
+    }
+    checkView(view, body, size, records);
+    free(body);
+
+    /* Records in a row with the same TAG are ambiguous once written back, HAP always separates them */
+    for (size_t i = 1U; i < records.size(); i++) {
+        if (records[i].tag == records[i - 1U].tag) {
+            return (0);
+        }
+    }
+
+    int needed = 0;
+    for (const t_fuzzRecord & record : records) {
+        needed += TLV8Writer<uint8_t>::size((int)record.value.size());
+    }
+
+    /* One byte short, the last record does not fit */
+    if (needed > 0) {
+        uint8_t * shortBuf = (uint8_t *)malloc((size_t)needed - 1U);
+        FUZZ_CHECK(shortBuf != NULL);
+        TLV8Writer<uint8_t> writer(shortBuf, needed - 1);
+        int written = 1;
+        for (const t_fuzzRecord & record : records) {
+            written &= writer.add(record.tag, valueOf(record), (int)record.value.size());
+        }
+        FUZZ_CHECK(written == 0);
+        FUZZ_CHECK(writer.len() <= needed - 1);
+        free(shortBuf);
+    }
+
+    uint8_t * out = (uint8_t *)malloc((needed > 0) ? (size_t)needed : 1U);
+    FUZZ_CHECK(out != NULL);
+    TLV8Writer<uint8_t> writer(out, needed);
+    for (const t_fuzzRecord & record : records) {
+        FUZZ_CHECK(writer.add(record.tag, valueOf(record), (int)record.value.size()) == 1);
+    }
+    FUZZ_CHECK(writer.len() == needed);
+
+    std::vector<t_fuzzRecord> written;
+    FUZZ_CHECK(decode(out, (size_t)needed, written));
+    FUZZ_CHECK(written.size() == records.size());
+    FUZZ_CHECK(view.parse(out, needed) == 1);
+    checkView(view, out, (size_t)needed, records);
+    free(out);
+
+    return (0);
+}
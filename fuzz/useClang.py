@@ -0,0 +1,5 @@
+# libFuzzer only ships with clang, build the fuzz target with it
+Import("env")
+
+env.Replace(CC="clang", CXX="clang++", AR="llvm-ar", RANLIB="llvm-ranlib")
+env.Append(LINKFLAGS=["-fsanitize=fuzzer,address,undefined"])
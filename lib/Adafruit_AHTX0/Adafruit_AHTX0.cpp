@@ -83,8 +83,8 @@ bool Adafruit_AHTX0::begin(TwoWire *wire, int32_t sensor_id,
   }
   delay(20);
 
-  while (getStatus() & AHTX0_STATUS_BUSY) {
-    delay(10);
+  if (!waitWhileBusy()) {
+    return false;
   }
 
   cmd[0] = AHTX0_CMD_CALIBRATE;
@@ -92,8 +92,8 @@ bool Adafruit_AHTX0::begin(TwoWire *wire, int32_t sensor_id,
   cmd[2] = 0x00;
   i2c_dev->write(cmd, 3); // may not 'succeed' on newer AHT20s
 
-  while (getStatus() & AHTX0_STATUS_BUSY) {
-    delay(10);
+  if (!waitWhileBusy()) {
+    return false;
   }
   if (!(getStatus() & AHTX0_STATUS_CALIBRATED)) {
     return false;
@@ -106,6 +106,23 @@ bool Adafruit_AHTX0::begin(TwoWire *wire, int32_t sensor_id,
   return true;
 }
 
+/**
+ * @brief  Waits for the busy bit to clear. A sensor that stopped answering
+ *         reads as 0xFF, which looks busy forever, so the wait is bounded.
+ *
+ * @returns True if the sensor is ready, false after AHTX0_BUSY_TIMEOUT_MS
+ */
+bool Adafruit_AHTX0::waitWhileBusy(void) {
+  uint32_t start = millis();
+  while (getStatus() & AHTX0_STATUS_BUSY) {
+    if (millis() - start > AHTX0_BUSY_TIMEOUT_MS) {
+      return false;
+    }
+    delay(10);
+  }
+  return true;
+}
+
 /**
  * @brief  Gets the status (first byte) from AHT10/AHT20
  *
@@ -138,8 +155,8 @@ bool Adafruit_AHTX0::getEvent(sensors_event_t *humidity,
     return false;
   }
 
-  while (getStatus() & AHTX0_STATUS_BUSY) {
-    delay(10);
+  if (!waitWhileBusy()) {
+    return false;
   }
 
   uint8_t data[6];
@@ -31,6 +31,7 @@
 #define AHTX0_CMD_SOFTRESET 0xBA     ///< Soft reset command
 #define AHTX0_STATUS_BUSY 0x80       ///< Status bit for busy
 #define AHTX0_STATUS_CALIBRATED 0x08 ///< Status bit for calibrated
+#define AHTX0_BUSY_TIMEOUT_MS 200    ///< Longest wait for the busy bit to clear
 
 class Adafruit_AHTX0;
 
@@ -102,6 +103,7 @@ protected:
       NULL; ///< Humidity sensor data object
 
 private:
+  bool waitWhileBusy(void);
   void _fetchTempCalibrationValues(void);
   void _fetchHumidityCalibrationValues(void);
   friend class Adafruit_AHTX0_Temp;     ///< Gives access to private members to
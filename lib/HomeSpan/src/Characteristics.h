@@ -198,4 +198,4 @@ struct HapCharacteristics {
 
 };
 
-extern HapCharacteristics hapChars;
+extern const HapCharacteristics hapChars;          // const so the table of all HAP Characteristics is placed in flash rather than RAM
@@ -36,16 +36,20 @@
 
 void HAPClient::init(){
 
-  size_t len;             // not used but required to read blobs from NVS
+  size_t len;             // size of destination buffer, required to read strings and blobs from NVS
 
   nvs_open("SRP",NVS_READWRITE,&srpNVS);        // open SRP data namespace in NVS 
   nvs_open("HAP",NVS_READWRITE,&hapNVS);        // open HAP data namespace in NVS
 
+  // Records below have a fixed size, so each one is read with a single NVS lookup into its destination rather than
+  // a size query followed by a read, and records created on first boot are committed together at the end
+
+  boolean commit=false;
+
   if(strlen(homeSpan.spanOTA.otaPwd)==0){                                 // OTA password has not been specified in sketch
-    if(!nvs_get_str(homeSpan.otaNVS,"OTADATA",NULL,&len)){                // if found OTA data in NVS...
-    nvs_get_str(homeSpan.otaNVS,"OTADATA",homeSpan.spanOTA.otaPwd,&len);  // ...retrieve data.
-    } else {                                                              // otherwise...
-    homeSpan.spanOTA.setPassword(DEFAULT_OTA_PASSWORD);                   // ...use default password
+    len=sizeof(homeSpan.spanOTA.otaPwd);
+    if(nvs_get_str(homeSpan.otaNVS,"OTADATA",homeSpan.spanOTA.otaPwd,&len)){   // if OTA data not found in NVS...
+      homeSpan.spanOTA.setPassword(DEFAULT_OTA_PASSWORD);                 // ...use default password
     }
   }
 
@@ -58,8 +62,8 @@ void HAPClient::init(){
     uint8_t verifyCode[384];
   } verifyData;
  
-  if(!nvs_get_blob(srpNVS,"VERIFYDATA",NULL,&len)){                   // if found verification code data in NVS
-    nvs_get_blob(srpNVS,"VERIFYDATA",&verifyData,&len);                  // retrieve data
+  len=sizeof(verifyData);
+  if(!nvs_get_blob(srpNVS,"VERIFYDATA",&verifyData,&len)){            // if found verification code data in NVS, retrieve data
     srp.loadVerifyCode(verifyData.verifyCode,verifyData.salt);           // load verification code and salt into SRP structure
   } else {
     LOG0("Generating SRP verification data for default Setup Code: %.3s-%.2s-%.3s\n",homeSpan.defaultSetupCode,homeSpan.defaultSetupCode+3,homeSpan.defaultSetupCode+5);
@@ -70,16 +74,14 @@ void HAPClient::init(){
   }
 
   if(!strlen(homeSpan.qrID)){                                      // Setup ID has not been specified in sketch
-    if(!nvs_get_str(hapNVS,"SETUPID",NULL,&len)){                    // check for saved value
-      nvs_get_str(hapNVS,"SETUPID",homeSpan.qrID,&len);                 // retrieve data
-    } else {
-      sprintf(homeSpan.qrID,"%s",DEFAULT_QR_ID);                     // use default
-   }
+    len=sizeof(homeSpan.qrID);
+    if(nvs_get_str(hapNVS,"SETUPID",homeSpan.qrID,&len)){            // retrieve saved value, if any...
+      sprintf(homeSpan.qrID,"%s",DEFAULT_QR_ID);                     // ...otherwise use default
+    }
   }
   
-  if(!nvs_get_blob(hapNVS,"ACCESSORY",NULL,&len)){                    // if found long-term Accessory data in NVS
-    nvs_get_blob(hapNVS,"ACCESSORY",&accessory,&len);                 // retrieve data
-  } else {      
+  len=sizeof(accessory);
+  if(nvs_get_blob(hapNVS,"ACCESSORY",&accessory,&len)){               // if long-term Accessory data not found in NVS
     LOG0("Generating new random Accessory ID and Long-Term Ed25519 Signature Keys...\n");
     uint8_t buf[6];
     char cBuf[18];
@@ -92,20 +94,22 @@ void HAPClient::init(){
     crypto_sign_keypair(accessory.LTPK,accessory.LTSK);                  // generate new random set of keys using libsodium public-key signature
     
     nvs_set_blob(hapNVS,"ACCESSORY",&accessory,sizeof(accessory));    // update data
-    nvs_commit(hapNVS);                                               // commit to NVS
+    commit=true;
   }
 
-  if(!nvs_get_blob(hapNVS,"CONTROLLERS",NULL,&len)){                 // if found long-term Controller Pairings data from NVS
-    nvs_get_blob(hapNVS,"CONTROLLERS",controllers,&len);             // retrieve data
-  } else {
+  len=sizeof(controllers);
+  if(nvs_get_blob(hapNVS,"CONTROLLERS",controllers,&len)){           // if long-term Controller Pairings data not found in NVS
     LOG0("Initializing storage for Paired Controllers data...\n\n");               
     
     HAPClient::removeControllers();                                             // clear all Controller data
         
     nvs_set_blob(hapNVS,"CONTROLLERS",controllers,sizeof(controllers));      // update data
-    nvs_commit(hapNVS);                                                      // commit to NVS
+    commit=true;
   }
 
+  if(commit)
+    nvs_commit(hapNVS);                                                      // commit Accessory and Controller data to NVS in one go
+
   LOG0("Accessory ID:      ");
   charPrintRow(accessory.ID,17);
   LOG0("                               LTPK: ");
@@ -114,6 +118,9 @@ void HAPClient::init(){
 
   printControllers();                                                         
 
+  if(!nAdminControllers())                                                    // device is not paired
+    srp.precomputeKeys();                                                     // pre-compute SRP keys in background so Pair-Setup does not stall the poll loop
+
   // create broadcaset name from server base name plus accessory ID (without ':')
   
   int nChars=snprintf(NULL,0,"%s-%2.2s%2.2s%2.2s%2.2s%2.2s%2.2s",homeSpan.hostNameBase,accessory.ID,accessory.ID+3,accessory.ID+6,accessory.ID+9,accessory.ID+12,accessory.ID+15);       
@@ -316,6 +323,20 @@ void HAPClient::processRequest(){
       return;
     }    
 
+    for(auto route=homeSpan.webLog.routes.begin(); route!=homeSpan.webLog.routes.end(); route++){                // USER-DEFINED WEB ROUTES - AN OPTIONAL, NON-HAP-R2 FEATURE
+      int len=route->url.length();
+      if(!strncmp(body,route->url.c_str(),len) && (body[len]==' ' || body[len]=='?')){
+        LOG2("\n>>>>>>>>>> ");
+        LOG2(client.remoteIP());
+        LOG2(" >>>>>>>>>> (web route %s)\n",route->url.c_str()+4);
+        route->handler(client,body+len);
+        LOG2("------------ SENT! --------------\n");
+        delay(1);
+        client.stop();
+        return;
+      }
+    }
+
     notFoundError();
     LOG0("\n*** ERROR:  Bad GET request - URL not found\n\n");
     return;                  
@@ -389,6 +410,7 @@ int HAPClient::postPairSetupURL(){
   
   int tlvState=tlv8.val(kTLVType_State);
   char buf[64];
+  unsigned long tStart;                                       // used to log time spent computing SRP responses
 
   if(tlvState==-1){                                           // missing STATE TLV
     LOG0("\n*** ERROR: Missing <M#> State TLV\n\n");
@@ -431,11 +453,13 @@ int HAPClient::postPairSetupURL(){
         return(0);
       };
 
+      tStart=millis();
       tlv8.clear();
       tlv8.val(kTLVType_State,pairState_M2);            // set State=<M2>
       srp.createPublicKey();                          // create accessory public key from random Pair-Setup code (displayed to user)
       srp.loadTLV(kTLVType_PublicKey,&srp.B,384);         // load server public key, B
       srp.loadTLV(kTLVType_Salt,&srp.s,16);              // load salt, s
+      LOG1("M2 computed in %lu ms...",millis()-tStart);
       tlvRespond();                                   // send response to client
 
       pairStatus=pairState_M3;                        // set next expected pair-state request from client
@@ -457,6 +481,10 @@ int HAPClient::postPairSetupURL(){
         return(0);
       };
 
+      // S depends on the Client's A, so unlike B it cannot be pre-computed: this is the one SRP exponentiation still done on the poll task.
+      // Deferring it would mean deferring the M4 response, which HAPClient does not support (see BM_SrpSessionKey in bench/srpBench.cpp).
+
+      tStart=millis();
       srp.createSessionKey();                               // create session key, K, from receipt of HAP Client public key, A
 
       if(!srp.verifyProof()){                               // verify proof, M1, received from HAP Client
@@ -473,6 +501,7 @@ int HAPClient::postPairSetupURL(){
       tlv8.clear();                                         // clear TLV records
       tlv8.val(kTLVType_State,pairState_M4);                // set State=<M4>
       srp.loadTLV(kTLVType_Proof,&srp.M2,64);               // load M2 counter-proof
+      LOG1("M4 computed in %lu ms...",millis()-tStart);
       tlvRespond();                                       // send response to client
 
       pairStatus=pairState_M5;                            // set next expected pair-state request from client
@@ -502,8 +531,8 @@ int HAPClient::postPairSetupURL(){
 
       hkdf.create(sessionKey, srp.sharedSecret,64,"Pair-Setup-Encrypt-Salt","Pair-Setup-Encrypt-Info");       // create SessionKey
 
-      uint8_t decrypted[1024];                    // temporary storage for decrypted data
-      unsigned long long decryptedLen;            // length (in bytes) of decrypted data
+      uint8_t *decrypted=tlv8.buf(kTLVType_EncryptedData);      // decrypt in place - plaintext is always shorter than the ciphertext it replaces
+      unsigned long long decryptedLen;                            // length (in bytes) of decrypted data
       
       if(crypto_aead_chacha20poly1305_ietf_decrypt(                                  // use SessionKey to decrypt encryptedData TLV with padded nonce="PS-Msg05"
         decrypted, &decryptedLen, NULL,
@@ -519,7 +548,9 @@ int HAPClient::postPairSetupURL(){
         return(0);        
       }
 
-      if(!tlv8.unpack(decrypted,decryptedLen)){
+      TLV8View<kTLVType,5> subTLV;                // index sub-TLV records in place without copying them out of the EncryptedData buffer
+
+      if(!subTLV.parse(decrypted,decryptedLen)){
         LOG0("\n*** ERROR: Can't parse decrypted data into separate TLV records\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M6);                // set State=<M6>
@@ -529,10 +560,10 @@ int HAPClient::postPairSetupURL(){
         return(0);
       }
 
-      tlv8.print(2);             // print decrypted TLV data
+      subTLV.print(2);           // print decrypted TLV data
       LOG2("------- END DECRYPTED TLVS! -------\n");
        
-      if(!tlv8.buf(kTLVType_Identifier) || !tlv8.buf(kTLVType_PublicKey) || !tlv8.buf(kTLVType_Signature)){            
+      if(subTLV.len(kTLVType_Identifier)!=36 || subTLV.len(kTLVType_PublicKey)!=32 || subTLV.len(kTLVType_Signature)!=64){            
         LOG0("\n*** ERROR: One or more of required 'Identifier,' 'PublicKey,' and 'Signature' TLV records for this step is bad or missing\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M6);                // set State=<M6>
@@ -551,11 +582,11 @@ int HAPClient::postPairSetupURL(){
       hkdf.create(iosDeviceX,srp.sharedSecret,64,"Pair-Setup-Controller-Sign-Salt","Pair-Setup-Controller-Sign-Info");       // derive iosDeviceX from SRP Shared Secret using HKDF 
       size_t iosDeviceXLen=32;
 
-      uint8_t *iosDevicePairingID = tlv8.buf(kTLVType_Identifier);        // set iosDevicePairingID from TLV record
-      size_t iosDevicePairingIDLen = tlv8.len(kTLVType_Identifier);
+      uint8_t *iosDevicePairingID = subTLV.buf(kTLVType_Identifier);      // set iosDevicePairingID from TLV record
+      size_t iosDevicePairingIDLen = subTLV.len(kTLVType_Identifier);
 
-      uint8_t *iosDeviceLTPK = tlv8.buf(kTLVType_PublicKey);              // set iosDeviceLTPK (Ed25519 long-term public key) from TLV record
-      size_t iosDeviceLTPKLen = tlv8.len(kTLVType_PublicKey);
+      uint8_t *iosDeviceLTPK = subTLV.buf(kTLVType_PublicKey);            // set iosDeviceLTPK (Ed25519 long-term public key) from TLV record
+      size_t iosDeviceLTPKLen = subTLV.len(kTLVType_PublicKey);
 
       size_t iosDeviceInfoLen=iosDeviceXLen+iosDevicePairingIDLen+iosDeviceLTPKLen;             // total size of re-constituted message, iosDeviceInfo
       uint8_t iosDeviceInfo[iosDeviceInfoLen];
@@ -564,7 +595,7 @@ int HAPClient::postPairSetupURL(){
       memcpy(iosDeviceInfo+iosDeviceXLen,iosDevicePairingID,iosDevicePairingIDLen);                        // +iosDevicePairingID
       memcpy(iosDeviceInfo+iosDeviceXLen+iosDevicePairingIDLen,iosDeviceLTPK,iosDeviceLTPKLen);            // +iosDeviceLTPK
 
-      uint8_t *iosDeviceSignature = tlv8.buf(kTLVType_Signature);                               // set iosDeviceSignature from TLV record (an Ed25519 should always be 64 bytes)
+      uint8_t *iosDeviceSignature = subTLV.buf(kTLVType_Signature);                             // set iosDeviceSignature from TLV record (an Ed25519 should always be 64 bytes)
 
       if(crypto_sign_verify_detached(iosDeviceSignature, iosDeviceInfo, iosDeviceInfoLen, iosDeviceLTPK) != 0){         // verify signature of iosDeviceInfo using iosDeviceLTPK   
         LOG0("\n*** ERROR: LPTK Signature Verification Failed\n\n");
@@ -602,26 +633,23 @@ int HAPClient::postPairSetupURL(){
 
       tlv8.clear();       // clear existing TLV records
 
-      crypto_sign_detached(tlv8.buf(kTLVType_Signature,64),NULL,accessoryInfo,accessoryInfoLen,accessory.LTSK);  // produce signature of accessoryInfo using AccessoryLTSK (Ed25519 long-term secret key)
+      uint8_t *encrypted=tlv8.buf(kTLVType_EncryptedData);                                        // sub-TLV is written directly into the EncryptedData buffer and then encrypted in place
+      TLV8Writer<kTLVType> subTLVOut(encrypted,1024-crypto_aead_chacha20poly1305_IETF_ABYTES);    // leave room for the Authentication Tag
 
-      memcpy(tlv8.buf(kTLVType_Identifier,accessoryPairingIDLen),accessoryPairingID,accessoryPairingIDLen);   // set Identifier TLV record as accessoryPairingID
-      memcpy(tlv8.buf(kTLVType_PublicKey,accessoryLTPKLen),accessoryLTPK,accessoryLTPKLen);                   // set PublicKey TLV record as accessoryLTPK
+      subTLVOut.add(kTLVType_PublicKey,accessoryLTPK,accessoryLTPKLen);                                                  // set PublicKey TLV record as accessoryLTPK
+      crypto_sign_detached(subTLVOut.add(kTLVType_Signature,64),NULL,accessoryInfo,accessoryInfoLen,accessory.LTSK);    // produce signature of accessoryInfo using AccessoryLTSK (Ed25519 long-term secret key)
+      subTLVOut.add(kTLVType_Identifier,accessoryPairingID,accessoryPairingIDLen);                                       // set Identifier TLV record as accessoryPairingID
 
       LOG2("------- ENCRYPTING SUB-TLVS -------\n");
 
-      tlv8.print(2);
-
-      size_t subTLVLen=tlv8.pack(NULL);                 // get size of buffer needed to store sub-TLV 
-      uint8_t subTLV[subTLVLen];
-      subTLVLen=tlv8.pack(subTLV);                      // create sub-TLV by packing Identifier, PublicKey, and Signature TLV records together
-
-      tlv8.clear();         // clear existing TLV records
+      hexPrintRow(encrypted,subTLVOut.len(),2);
+      LOG2("\n");
 
       // Final step is to encrypt the subTLV data using the same sessionKey as above with ChaCha20-Poly1305 
       
       unsigned long long edLen;
 
-      crypto_aead_chacha20poly1305_ietf_encrypt(tlv8.buf(kTLVType_EncryptedData),&edLen,subTLV,subTLVLen,NULL,0,NULL,(unsigned char *)"\x00\x00\x00\x00PS-Msg06",sessionKey);
+      crypto_aead_chacha20poly1305_ietf_encrypt(encrypted,&edLen,encrypted,subTLVOut.len(),NULL,0,NULL,(unsigned char *)"\x00\x00\x00\x00PS-Msg06",sessionKey);
                                               
       LOG2("---------- END SUB-TLVS! ----------\n");
 
@@ -715,19 +743,16 @@ int HAPClient::postPairVerifyURL(){
 
         tlv8.clear();       // clear existing TLV records
 
-        crypto_sign_detached(tlv8.buf(kTLVType_Signature,64),NULL,accessoryInfo,accessoryInfoLen,accessory.LTSK);  // produce signature of accessoryInfo using AccessoryLTSK (Ed25519 long-term secret key)
+        uint8_t *encrypted=tlv8.buf(kTLVType_EncryptedData);                                        // sub-TLV is written directly into the EncryptedData buffer and then encrypted in place
+        TLV8Writer<kTLVType> subTLVOut(encrypted,1024-crypto_aead_chacha20poly1305_IETF_ABYTES);    // leave room for the Authentication Tag
 
-        memcpy(tlv8.buf(kTLVType_Identifier,accessoryPairingIDLen),accessoryPairingID,accessoryPairingIDLen);   // set Identifier TLV record as accessoryPairingID
+        crypto_sign_detached(subTLVOut.add(kTLVType_Signature,64),NULL,accessoryInfo,accessoryInfoLen,accessory.LTSK);    // produce signature of accessoryInfo using AccessoryLTSK (Ed25519 long-term secret key)
+        subTLVOut.add(kTLVType_Identifier,accessoryPairingID,accessoryPairingIDLen);                                       // set Identifier TLV record as accessoryPairingID
 
         LOG2("------- ENCRYPTING SUB-TLVS -------\n");
 
-        tlv8.print(2);
-
-        size_t subTLVLen=tlv8.pack(NULL);                 // get size of buffer needed to store sub-TLV 
-        uint8_t subTLV[subTLVLen];
-        subTLVLen=tlv8.pack(subTLV);                      // create sub-TLV by packing Identifier and Signature TLV records together
-
-        tlv8.clear();         // clear existing TLV records
+        hexPrintRow(encrypted,subTLVOut.len(),2);
+        LOG2("\n");
 
         // create SessionKey from Curve25519 SharedSecret using HKDF-SHA-512, then encrypt subTLV data with SessionKey using ChaCha20-Poly1305.  Output stored in EncryptedData TLV
       
@@ -735,7 +760,7 @@ int HAPClient::postPairVerifyURL(){
 
         hkdf.create(sessionKey,sharedCurveKey,32,"Pair-Verify-Encrypt-Salt","Pair-Verify-Encrypt-Info");       // create SessionKey (32 bytes)
 
-        crypto_aead_chacha20poly1305_ietf_encrypt(tlv8.buf(kTLVType_EncryptedData),&edLen,subTLV,subTLVLen,NULL,0,NULL,(unsigned char *)"\x00\x00\x00\x00PV-Msg02",sessionKey);
+        crypto_aead_chacha20poly1305_ietf_encrypt(encrypted,&edLen,encrypted,subTLVOut.len(),NULL,0,NULL,(unsigned char *)"\x00\x00\x00\x00PV-Msg02",sessionKey);
                                               
         LOG2("---------- END SUB-TLVS! ----------\n");
         
@@ -760,8 +785,8 @@ int HAPClient::postPairVerifyURL(){
         return(0);
       };
 
-      uint8_t decrypted[1024];                    // temporary storage for decrypted data
-      unsigned long long decryptedLen;            // length (in bytes) of decrypted data
+      uint8_t *decrypted=tlv8.buf(kTLVType_EncryptedData);      // decrypt in place - plaintext is always shorter than the ciphertext it replaces
+      unsigned long long decryptedLen;                            // length (in bytes) of decrypted data
       
       if(crypto_aead_chacha20poly1305_ietf_decrypt(                                            // use SessionKey to decrypt encrypytedData TLV with padded nonce="PV-Msg03"
         decrypted, &decryptedLen, NULL,
@@ -776,7 +801,9 @@ int HAPClient::postPairVerifyURL(){
         return(0);        
       }
 
-      if(!tlv8.unpack(decrypted,decryptedLen)){
+      TLV8View<kTLVType,5> subTLV;                // index sub-TLV records in place without copying them out of the EncryptedData buffer
+
+      if(!subTLV.parse(decrypted,decryptedLen)){
         LOG0("\n*** ERROR: Can't parse decrypted data into separate TLV records\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M4);                // set State=<M4>
@@ -785,10 +812,10 @@ int HAPClient::postPairVerifyURL(){
         return(0);
       }
 
-      tlv8.print(2);             // print decrypted TLV data
+      subTLV.print(2);           // print decrypted TLV data
       LOG2("------- END DECRYPTED TLVS! -------\n");
 
-      if(!tlv8.buf(kTLVType_Identifier) || !tlv8.buf(kTLVType_Signature)){            
+      if(subTLV.len(kTLVType_Identifier)!=36 || subTLV.len(kTLVType_Signature)!=64){            
         LOG0("\n*** ERROR: One or more of required 'Identifier,' and 'Signature' TLV records for this step is bad or missing\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M4);                // set State=<M4>
@@ -799,7 +826,7 @@ int HAPClient::postPairVerifyURL(){
 
       Controller *tPair;                                  // temporary pointer to Controller
 
-      if(!(tPair=findController(tlv8.buf(kTLVType_Identifier)))){
+      if(!(tPair=findController(subTLV.buf(kTLVType_Identifier)))){
         LOG0("\n*** ERROR: Unrecognized Controller PairingID\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M4);                // set State=<M4>
@@ -815,7 +842,7 @@ int HAPClient::postPairVerifyURL(){
       memcpy(iosDeviceInfo+32,tPair->ID,36);
       memcpy(iosDeviceInfo+32+36,publicCurveKey,32);
       
-      if(crypto_sign_verify_detached(tlv8.buf(kTLVType_Signature), iosDeviceInfo, iosDeviceInfoLen, tPair->LTPK) != 0){         // verify signature of iosDeviceInfo using iosDeviceLTPK   
+      if(crypto_sign_verify_detached(subTLV.buf(kTLVType_Signature), iosDeviceInfo, iosDeviceInfoLen, tPair->LTPK) != 0){         // verify signature of iosDeviceInfo using iosDeviceLTPK   
         LOG0("\n*** ERROR: LPTK Signature Verification Failed\n\n");
         tlv8.clear();                                         // clear TLV records
         tlv8.val(kTLVType_State,pairState_M4);                // set State=<M4>
@@ -1003,6 +1030,7 @@ int HAPClient::postPairingsURL(){
         LOG1("*** Terminating Client #");
         LOG1(i);
         LOG1("\n");
+        hap[i]->sendPending(true);         // deliver the TLV response before closing, since this connection itself may be terminated
         hap[i]->client.stop();
       }
       
@@ -1192,7 +1220,7 @@ int HAPClient::putPrepareURL(char *json){
   StatusCode status=StatusCode::OK;
 
   if(ttl>0 && pid>0){                           // found required elements
-    homeSpan.TimedWrites[pid]=ttl+millis();     // store this pid/alarmTime combination 
+    homeSpan.TimedWrites.add(pid,ttl);          // store this pid/alarmTime combination 
   } else {                                      // problems parsing request
     status=StatusCode::InvalidValue;
   }
@@ -1305,10 +1333,22 @@ int HAPClient::getStatusURL(){
 
   response+="<tr><td>HomeKit Status:</td><td>" + String(nAdminControllers()?"PAIRED":"NOT PAIRED") + "</td></tr>\n";   
   response+="<tr><td>Max Log Entries:</td><td>" + String(homeSpan.webLog.maxEntries) + "</td></tr>\n"; 
+
+  uint32_t maxRequestTime=0;
+  for(int i=0;i<homeSpan.maxConnections;i++)
+    if(hap[i]->client && hap[i]->maxRequestTime>maxRequestTime)
+      maxRequestTime=hap[i]->maxRequestTime;
+  response+="<tr><td>Max HAP Request Time:</td><td>" + String(maxRequestTime) + " ms</td></tr>\n";
+  response+="<tr><td>First HAP Response:</td><td>" + (homeSpan.firstResponseTime?String(homeSpan.firstResponseTime) + " ms after boot":String("none yet")) + "</td></tr>\n";
+
+  if(homeSpan.weblogCallback)
+    homeSpan.weblogCallback(response);
+
   response+="</table>\n";
   response+="<p></p>";
 
   if(homeSpan.webLog.maxEntries>0){
+    xSemaphoreTake(homeSpan.webLog.logMutex,portMAX_DELAY);
     response+="<table class=tab2><tr><th>Entry</th><th>Up Time</th><th>Log Time</th><th>Client</th><th>Message</th></tr>\n";
     int lastIndex=homeSpan.webLog.nEntries-homeSpan.webLog.maxEntries;
     if(lastIndex<0)
@@ -1330,6 +1370,7 @@ int HAPClient::getStatusURL(){
       
       response+="<tr><td>" + String(i+1) + "</td><td>" + String(uptime) + "</td><td>" + String(clocktime) + "</td><td>" + homeSpan.webLog.log[index].clientIP + "</td><td>" + String(homeSpan.webLog.log[index].message) + "</td/tr>\n";
     }
+    xSemaphoreGive(homeSpan.webLog.logMutex);
     response+="</table>\n";
   }
   
@@ -1363,20 +1404,7 @@ void HAPClient::checkNotifications(){
 
 void HAPClient::checkTimedWrites(){
 
-  unsigned long cTime=millis();                                       // get current time
-
-  char c[64];
-
-  auto tw=homeSpan.TimedWrites.begin();
-  while(tw!=homeSpan.TimedWrites.end()){
-    if(cTime>tw->second){                                                               // timer has expired
-       sprintf(c,"Removing PID=%llu  ALARM=%u\n",tw->first,tw->second);
-       LOG2(c);
-       tw=homeSpan.TimedWrites.erase(tw);
-      }
-    else
-      tw++; 
-  }
+  homeSpan.TimedWrites.purge();
  
 }
 
@@ -1522,12 +1550,113 @@ void HAPClient::sendEncrypted(char *body, uint8_t *dataBuf, int dataLen){
     count+=2+n+16;             // increment count by 2-byte AAD record + length of JSON + 16-byte authentication tag
   }
  
-  client.write(tBuf.buf,count);   // transmit all encrypted frames to Client
+  transmit(tBuf.buf,count);       // transmit all encrypted frames to Client, without blocking pollTask() if the socket buffer is full
 
   LOG2("-------- SENT ENCRYPTED! --------\n");
       
 } // sendEncrypted
 
+/////////////////////////////////////////////////////////////////////////////////
+
+void HAPClient::transmit(uint8_t *buf, int len){
+
+  int sent=0;
+
+  if(txPending.empty()){                                      // nothing queued ahead of these bytes - send what the socket accepts right away
+    sent=send(client.fd(),buf,len,MSG_DONTWAIT);
+    if(sent<0){
+      if(errno!=EAGAIN && errno!=EWOULDBLOCK){
+        LOG1("** Send failed (errno=%d), disconnecting client\n",errno);
+        client.stop();
+        return;
+      }
+      sent=0;
+    }
+  } else if(txPending.size()+len>MAX_PENDING){               // client has not read the previous responses - give up on it
+    LOG0("\n*** WARNING:  Client not reading, %d bytes pending.  Disconnecting\n\n",(int)txPending.size());
+    dropPending();
+    client.stop();
+    return;
+  }
+
+  if(sent==len)
+    return;
+
+  if(!reservePending(len-sent))                              // this client is the furthest behind of all - give up on it
+    return;
+
+  txPending.insert(txPending.end(),buf+sent,buf+len);        // queue the remainder, sent by pollTask() once the socket is writable
+  pendingTotal+=len-sent;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+
+boolean HAPClient::reservePending(int len){
+
+  while(pendingTotal+len>MAX_PENDING_TOTAL){
+
+    HAPClient *slowest=this;                                  // client with the most bytes queued, counting the ones this client is about to queue
+    size_t most=txPending.size()+len;
+
+    for(int i=0;i<homeSpan.maxConnections;i++){
+      if(hap[i]!=this && hap[i]->txPending.size()>most){
+        slowest=hap[i];
+        most=hap[i]->txPending.size();
+      }
+    }
+
+    LOG0("\n*** WARNING:  %d bytes pending across all clients.  Disconnecting client with %d bytes pending\n\n",pendingTotal,(int)slowest->txPending.size());
+    slowest->dropPending();
+    slowest->client.stop();
+
+    if(slowest==this)
+      return(false);
+  }
+
+  return(true);
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+
+void HAPClient::sendPending(boolean block){
+
+  if(txPending.empty())
+    return;
+
+  if(block){                                                 // must be delivered before the connection is closed
+    client.write(txPending.data(),txPending.size());
+    dropPending();
+    return;
+  }
+
+  int sent=send(client.fd(),txPending.data(),txPending.size(),MSG_DONTWAIT);
+
+  if(sent<0){
+    if(errno!=EAGAIN && errno!=EWOULDBLOCK){
+      LOG1("** Send failed (errno=%d), disconnecting client\n",errno);
+      dropPending();
+      client.stop();
+    }
+    return;
+  }
+
+  if(sent==(int)txPending.size()){                           // all caught up - release the queue memory
+    dropPending();
+    return;
+  }
+
+  txPending.erase(txPending.begin(),txPending.begin()+sent);
+  pendingTotal-=sent;
+}
+
+/////////////////////////////////////////////////////////////////////////////////
+
+void HAPClient::dropPending(){
+
+  pendingTotal-=txPending.size();
+  vector<uint8_t>().swap(txPending);                         // clear() alone would keep the capacity of the largest backlog allocated
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////////////////////////
 
@@ -1652,6 +1781,7 @@ void HAPClient::removeController(uint8_t *id){
       removeControllers();
       LOG1("That was last Admin Controller!  Removing any remaining Regular Controllers and unpairing Accessory\n");  
       mdns_service_txt_item_set("_hap","_tcp","sf","1");           // set Status Flag = 1 (Table 6-8)
+      srp.precomputeKeys();                                        // pre-compute SRP keys in background for upcoming Pair-Setup
 
       STATUS_UPDATE(start(LED_PAIRING_NEEDED),HS_PAIRING_NEEDED)
 
@@ -1729,4 +1859,5 @@ Accessory HAPClient::accessory;
 Controller HAPClient::controllers[MAX_CONTROLLERS];    
 SRP6A HAPClient::srp;
 int HAPClient::conNum;
+int HAPClient::pendingTotal=0;
  
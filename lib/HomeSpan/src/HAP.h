@@ -75,7 +75,9 @@ struct HAPClient {
 
   static const int MAX_HTTP=8095;                     // max number of bytes in HTTP message buffer
   static const int MAX_CONTROLLERS=16;                // maximum number of paired controllers (HAP requires at least 16)
-  static const int MAX_ACCESSORIES=41;                // maximum number of allowed Acessories (HAP limit=150, but not enough memory in ESP32 to run that many)
+  static const int MAX_ACCESSORIES=HS_MAX_ACCESSORIES; // maximum number of allowed Acessories (HAP limit=150, but not enough memory in ESP32 to run that many)
+  static const int MAX_PENDING=32768;                 // maximum number of encrypted bytes queued for a client that stopped reading; a client falling further behind is disconnected
+  static const int MAX_PENDING_TOTAL=49152;           // maximum number of encrypted bytes queued across all clients; beyond it the client with the most bytes queued is disconnected
   
   static TLV<kTLVType,10> tlv8;                       // TLV8 structure (HAP Section 14.1) with space for 10 TLV records of type kTLVType (HAP Table 5-6)
   static nvs_handle hapNVS;                           // handle for non-volatile-storage of HAP data
@@ -87,11 +89,24 @@ struct HAPClient {
   static Accessory accessory;                         // Accessory ID and Ed25519 public and secret keys- permanently stored
   static Controller controllers[MAX_CONTROLLERS];     // Paired Controller IDs and ED25519 long-term public keys - permanently stored
   static int conNum;                                  // connection number - used to keep track of per-connection EV notifications
+  static int pendingTotal;                            // number of encrypted bytes queued in txPending across all clients
 
   // individual structures and data defined for each Hap Client connection
   
   WiFiClient client;              // handle to client
   Controller *cPair;              // pointer to info on current, session-verified Paired Controller (NULL=un-verified, and therefore un-encrypted, connection)
+
+  // Connection statistics for this slot.  Used to select a slot for eviction when all slots are busy, and reported with the 's' command
+
+  unsigned long connectTime=0;    // time (in millis) at which current client was connected to this slot
+  unsigned long lastTime=0;       // time (in millis) of most recent activity (connection or request) on this slot
+  uint32_t nRequests=0;           // number of requests processed for current client
+  uint32_t maxRequestTime=0;      // longest time (in millis) taken to process a single request for current client
+  uint32_t nEvictions=0;          // cumulative number of clients evicted from this slot to make room for new connections
+
+  vector<uint8_t> txPending;      // encrypted bytes not yet accepted by the socket, sent by pollTask() once select() finds the socket writable
+
+  ~HAPClient(){dropPending();}    // keep pendingTotal in step when a client structure is discarded
    
   // These keys are generated in the first call to pair-verify and used in the second call to pair-verify so must persist for a short period
     
@@ -121,6 +136,10 @@ struct HAPClient {
 
   void tlvRespond();                                                // respond to client with HTTP OK header and all defined TLV data records (those with length>0)
   void sendEncrypted(char *body, uint8_t *dataBuf, int dataLen);    // send client complete ChaCha20-Poly1305 encrypted HTTP mesage comprising a null-terminated 'body' and 'dataBuf' with 'dataLen' bytes
+  void transmit(uint8_t *buf, int len);                             // sends 'len' bytes of buf without blocking, queueing in txPending whatever the socket does not accept
+  void sendPending(boolean block=false);                            // sends as many queued bytes as the socket accepts (all of them if block=true); disconnects client on socket error
+  void dropPending();                                               // discards all queued bytes and releases their memory
+  boolean reservePending(int len);                                  // makes room for 'len' more queued bytes within MAX_PENDING_TOTAL by disconnecting the client with the most bytes queued (returns false if that is this client)
   int receiveEncrypted();                                           // decrypt HTTP request (HAP Section 6.5)
 
   int notFoundError();           // return 404 error
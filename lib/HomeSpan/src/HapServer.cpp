@@ -0,0 +1,145 @@
+/*********************************************************************************
+ *  MIT License
+ *  
+ *  Copyright (c) 2020-2023 Gregg E. Berman
+ *  
+ *  https://github.com/HomeSpan/HomeSpan
+ *  
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *  
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  
+ ********************************************************************************/
+ 
+#include "HapServer.h"
+#include "HomeSpan.h"
+
+//////////////////////////////////////
+
+void HapServer::begin(){
+
+  if(sockfd>=0)                                     // already listening
+    return;
+
+  struct sockaddr_in server;
+  int enable=1;
+
+  if((sockfd=socket(AF_INET,SOCK_STREAM,0))<0){
+    LOG0("\n*** ERROR:  Can't create HAP Server socket (errno=%d)\n\n",errno);
+    return;
+  }
+
+  setsockopt(sockfd,SOL_SOCKET,SO_REUSEADDR,&enable,sizeof(enable));
+
+  server.sin_family=AF_INET;
+  server.sin_addr.s_addr=INADDR_ANY;
+  server.sin_port=htons(port);
+
+  if(bind(sockfd,(struct sockaddr *)&server,sizeof(server))<0 || listen(sockfd,CONFIG_LWIP_MAX_SOCKETS)<0){
+    LOG0("\n*** ERROR:  Can't start HAP Server on port %d (errno=%d)\n\n",port,errno);
+    close(sockfd);
+    sockfd=-1;
+    return;
+  }
+
+  fcntl(sockfd,F_SETFL,fcntl(sockfd,F_GETFL,0)|O_NONBLOCK);     // accept() must never block pollTask()
+}
+
+//////////////////////////////////////
+
+void HapServer::end(){
+
+  if(sockfd>=0)
+    close(sockfd);
+
+  sockfd=-1;
+  FD_ZERO(&readySet);
+  FD_ZERO(&writeReadySet);
+}
+
+//////////////////////////////////////
+
+void HapServer::watch(int fd, boolean write){
+
+  if(fd<0)
+    return;
+
+  FD_SET(fd,write?&writeWatchSet:&watchSet);
+  if(fd>maxFd)
+    maxFd=fd;
+}
+
+//////////////////////////////////////
+
+int HapServer::wait(uint32_t timeout){
+
+  int n=0;
+
+  FD_ZERO(&readySet);
+  FD_ZERO(&writeReadySet);
+
+  if(sockfd>=0)
+    watch(sockfd);
+
+  if(maxFd<0){                                      // nothing to wait on (e.g. WiFi not yet connected) - just sleep for timeout period
+    vTaskDelay(pdMS_TO_TICKS(timeout));
+  } else {
+    struct timeval tv;
+    tv.tv_sec=timeout/1000;
+    tv.tv_usec=(timeout%1000)*1000;
+
+    readySet=watchSet;
+    writeReadySet=writeWatchSet;
+    n=select(maxFd+1,&readySet,&writeReadySet,NULL,&tv);
+
+    if(n<0){                                        // a socket was closed underneath select() - treat all watched sockets as ready so pollTask() checks each of them
+      readySet=watchSet;
+      writeReadySet=writeWatchSet;
+      n=0;
+    }
+  }
+
+  FD_ZERO(&watchSet);
+  FD_ZERO(&writeWatchSet);
+  maxFd=-1;
+
+  return(n);
+}
+
+//////////////////////////////////////
+
+WiFiClient HapServer::available(){
+
+  if(!ready(sockfd))
+    return(WiFiClient());
+
+  struct sockaddr_in client;
+  socklen_t len=sizeof(client);
+  int fd=accept(sockfd,(struct sockaddr *)&client,&len);
+
+  if(fd<0)
+    return(WiFiClient());
+
+  int enable=1;
+  setsockopt(fd,SOL_SOCKET,SO_KEEPALIVE,&enable,sizeof(enable));      // same socket options WiFiServer applies to accepted clients
+  enable=0;
+  setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,&enable,sizeof(enable));
+
+  return(WiFiClient(fd));
+}
+
+//////////////////////////////////////
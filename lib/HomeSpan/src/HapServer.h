@@ -0,0 +1,64 @@
+/*********************************************************************************
+ *  MIT License
+ *  
+ *  Copyright (c) 2020-2023 Gregg E. Berman
+ *  
+ *  https://github.com/HomeSpan/HomeSpan
+ *  
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *  
+ *  The above copyright notice and this permission notice shall be included in all
+ *  copies or substantial portions of the Software.
+ *  
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *  SOFTWARE.
+ *  
+ ********************************************************************************/
+ 
+#pragma once
+
+#include <WiFi.h>
+#include <lwip/sockets.h>
+
+/////////////////////////////////////////////////
+// HAP Server Structure
+//
+// Replaces WiFiServer for the HAP listening socket so that
+// its file descriptor can be included, along with all HAP Client
+// sockets, in a single call to select().  This allows pollTask()
+// to sleep until a new connection or request actually arrives, a
+// client with queued responses can take more bytes, or its next
+// deadline is due, instead of repeatedly checking every slot with
+// available().  Accept, read and write readiness are all reported
+// by that one select() call.
+
+struct HapServer {
+
+  uint16_t port;                  // TCP port to listen on
+  int sockfd=-1;                  // file descriptor of listening socket (-1 if not listening)
+  fd_set watchSet;                // set of client file descriptors to monitor for reading in the next call to wait()
+  fd_set readySet;                // set of file descriptors found ready for reading by the most recent call to wait()
+  fd_set writeWatchSet;           // set of client file descriptors to monitor for writing in the next call to wait()
+  fd_set writeReadySet;           // set of file descriptors found ready for writing by the most recent call to wait()
+  int maxFd=-1;                   // largest file descriptor in watchSet or writeWatchSet
+
+  HapServer(uint16_t port) : port{port} {FD_ZERO(&watchSet);FD_ZERO(&readySet);FD_ZERO(&writeWatchSet);FD_ZERO(&writeReadySet);}
+
+  void begin();                                                         // creates non-blocking listening socket on port
+  void end();                                                           // closes listening socket
+  void watch(int fd, boolean write=false);                              // adds client socket fd to the set to be monitored for reading (or writing if write=true) in the next call to wait()
+  int wait(uint32_t timeout);                                           // waits up to 'timeout' millis for the listening socket or any watched client socket to become readable or writable, then clears watch sets; returns number of ready sockets
+  boolean ready(int fd){return(fd>=0 && FD_ISSET(fd,&readySet));}       // returns true if fd was found ready for reading by the most recent call to wait()
+  boolean writable(int fd){return(fd>=0 && FD_ISSET(fd,&writeReadySet));}     // returns true if fd was found ready for writing by the most recent call to wait()
+  WiFiClient available();                                               // accepts a new connection if one was found ready by the most recent call to wait() and returns it as a WiFiClient (which evaluates to false if there was no new connection)
+};
@@ -32,6 +32,7 @@
 #include <driver/ledc.h>
 #include <mbedtls/version.h>
 #include <mbedtls/sha256.h>
+#include <mbedtls/sha512.h>
 #include <esp_task_wdt.h>
 #include <esp_sntp.h>
 #include <esp_ota_ops.h>
@@ -46,7 +47,7 @@ using namespace Utils;
 
 HAPClient **hap;                    // HAP Client structure containing HTTP client connections, parsing routines, and state variables (global-scoped variable)
 Span homeSpan;                      // HAP Attributes database and all related control functions for this Accessory (global-scoped variable)
-HapCharacteristics hapChars;        // Instantiation of all HAP Characteristics (used to create SpanCharacteristics)
+const HapCharacteristics hapChars;  // Instantiation of all HAP Characteristics (used to create SpanCharacteristics) - constant-initialized, so it lives in flash
 
 ///////////////////////////////
 //         Span              //
@@ -72,7 +73,7 @@ void Span::begin(Category catID, const char *displayName, const char *hostNameBa
   for(int i=0;i<maxConnections;i++)
     hap[i]=new HAPClient;
 
-  hapServer=new WiFiServer(tcpPortNum);
+  hapServer=new HapServer(tcpPortNum);
 
   nvs_flash_init();                             // initialize non-volatile-storage partition in flash  
   nvs_open("CHAR",NVS_READWRITE,&charNVS);      // open Characteristic data namespace in NVS
@@ -211,13 +212,24 @@ void Span::pollTask() {
     processSerialCommand(cBuf);
   }
 
+  for(int i=0;i<maxConnections;i++){                          // monitor the sockets of all connected HAP Clients
+    hapServer->watch(hap[i]->client.fd());
+    if(!hap[i]->txPending.empty())                            // and whether those with queued responses can take more bytes
+      hapServer->watch(hap[i]->client.fd(),true);
+  }
+
+  hapServer->wait(pollTimeout());                             // sleep until a new connection or request arrives, a socket can take queued bytes, or the earliest deadline is due
+
+  boolean checkAll=pollAll;                                   // if true, check every slot with available() this pass, regardless of socket readiness
+  pollAll=false;
+
   WiFiClient newClient;
 
   if(newClient=hapServer->available()){                        // found a new HTTP client
     int freeSlot=getFreeSlot();                                // get next free slot
 
     if(freeSlot==-1){                                          // no available free slots
-      freeSlot=randombytes_uniform(maxConnections);
+      freeSlot=getEvictSlot();
       LOG2("=======================================\n");
       LOG1("** Freeing Client #");
       LOG1(freeSlot);
@@ -225,11 +237,18 @@ void Span::pollTask() {
       LOG1(millis()/1000);
       LOG1(" sec) ");
       LOG1(hap[freeSlot]->client.remoteIP());
-      LOG1("\n");
-      hap[freeSlot]->client.stop();                     // disconnect client from first slot and re-use
+      LOG1(hap[freeSlot]->cPair?" verified":" unverified");
+      LOG1(", idle %lu sec\n",(millis()-hap[freeSlot]->lastTime)/1000);
+      hap[freeSlot]->client.stop();                     // disconnect client from selected slot and re-use
+      hap[freeSlot]->nEvictions++;
     }
 
     hap[freeSlot]->client=newClient;             // copy new client handle into free slot
+    hap[freeSlot]->dropPending();                // drop anything left over for the previous client
+    hap[freeSlot]->connectTime=millis();         // reset connection statistics for this slot
+    hap[freeSlot]->lastTime=hap[freeSlot]->connectTime;
+    hap[freeSlot]->nRequests=0;
+    hap[freeSlot]->maxRequestTime=0;
 
     LOG2("=======================================\n");
     LOG1("** Client #");
@@ -250,14 +269,57 @@ void Span::pollTask() {
     HAPClient::pairStatus=pairState_M1;         // reset starting PAIR STATE (which may be needed if Accessory failed in middle of pair-setup)
   }
 
-  for(int i=0;i<maxConnections;i++){                     // loop over all HAP Connection slots
+  for(int i=0;i<maxConnections;i++){                     // send queued responses to clients whose socket became writable
+    if(hapServer->writable(hap[i]->client.fd()))
+      hap[i]->sendPending();
+  }
+
+  unsigned long budgetStart=millis();                    // start of time budget for processing HAP requests in this pass
+  int startSlot=nextSlot;
+
+  nextSlot=(startSlot+1)%maxConnections;                 // by default, start with the following slot on the next pass so no slot is always served first
+
+  for(int n=0;n<maxConnections;n++){                     // loop over all HAP Connection slots, round-robin starting from startSlot
+
+    int i=(startSlot+n)%maxConnections;
+
+    if(!checkAll && !hapServer->ready(hap[i]->client.fd()))      // nothing waiting on this socket
+      continue;
+
+    if(!hap[i]->client && hap[i]->client.fd()>=0){                // socket is readable only because client closed the connection
+      LOG2("** Client #%d closed connection\n",i);
+      hap[i]->dropPending();                                     // nobody left to read queued responses
+      hap[i]->client.stop();                                     // release socket so it is no longer monitored
+      continue;
+    }
     
     if(hap[i]->client && hap[i]->client.available()){       // if connection exists and data is available
 
+      if(millis()-budgetStart>=pollBudget){                 // time budget for this pass is used up
+        nextSlot=i;                                         // start with this slot on the next pass
+        pollAll=true;                                       // and don't wait for socket readiness, since this slot's data may already be buffered by WiFiClient
+        break;
+      }
+
+      unsigned long requestStart=millis();
+      
       HAPClient::conNum=i;                                          // set connection number
       homeSpan.lastClientIP=hap[i]->client.remoteIP().toString();   // store IP Address for web logging
       hap[i]->processRequest();                                     // process HAP request
       homeSpan.lastClientIP="0.0.0.0";                              // reset stored IP address to show "0.0.0.0" if homeSpan.getClientIP() is used in any other context
+
+      hap[i]->lastTime=millis();                                    // update connection statistics
+      hap[i]->nRequests++;
+      if(hap[i]->lastTime-requestStart>hap[i]->maxRequestTime)
+        hap[i]->maxRequestTime=hap[i]->lastTime-requestStart;
+
+      if(!homeSpan.firstResponseTime){                      // measures how fast the device is back in HomeKit after a reset
+        homeSpan.firstResponseTime=Utils::uptime();
+        LOG1("First HAP response %u ms after boot\n",homeSpan.firstResponseTime);
+      }
+
+      if(hap[i]->client && hap[i]->client.available())      // another request was received along with this one and may already be buffered by WiFiClient, where select() cannot see it
+        pollAll=true;
       
       if(!hap[i]->client){                                 // client disconnected by server
         LOG1("** Disconnecting Client #");
@@ -272,13 +334,19 @@ void Span::pollTask() {
     } // process HAP Client 
   } // for-loop over connection slots
 
-  snapTime=millis();                                     // snap the current time for use in ALL loop routines
+  snapTime=Utils::uptime();                              // snap the current time for use in ALL loop routines
+  loopTime=snapTime;
   
   for(auto it=Loops.begin();it!=Loops.end();it++)                 // call loop() for all Services with over-ridden loop() methods
     (*it)->loop();                           
 
   for(auto it=PushButtons.begin();it!=PushButtons.end();it++)     // check for SpanButton presses
     (*it)->check();
+
+  if(pollCallback && snapTime-pollCallbackTime>=pollInterval){  // every pollInterval millis, not on every request that wakes pollTask()
+    pollCallbackTime=snapTime;
+    pollCallback();
+  }
     
   HAPClient::checkNotifications();  
   HAPClient::checkTimedWrites();
@@ -300,13 +368,32 @@ void Span::pollTask() {
   }
 
   statusLED->check();
-
-  vTaskDelay(5);
     
 } // poll
 
 ///////////////////////////////
 
+uint32_t Span::pollTimeout(){
+
+  if(pollAll)                                                     // requests are still pending from the last pass - don't sleep
+    return(0);
+
+  uint64_t cTime=Utils::uptime();
+  uint64_t deadline=cTime+maxPollWait;
+
+  if(!Loops.empty() || !PushButtons.empty() || controlButton)     // Service loop() methods and buttons are checked every loopInterval millis
+    deadline=std::min(deadline,loopTime+loopInterval);
+
+  if(pollCallback)
+    deadline=std::min(deadline,pollCallbackTime+pollInterval);
+
+  deadline=std::min(deadline,TimedWrites.nextAlarm());           // purge timed writes as they expire
+
+  return(deadline>cTime?deadline-cTime:0);
+}
+
+///////////////////////////////
+
 int Span::getFreeSlot(){
   
   for(int i=0;i<maxConnections;i++){
@@ -317,6 +404,30 @@ int Span::getFreeSlot(){
   return(-1);          
 }
 
+///////////////////////////////
+
+int Span::getEvictSlot(){
+
+  int slot=0;
+  unsigned long maxIdle=millis()-hap[0]->lastTime;
+
+  for(int i=1;i<maxConnections;i++){
+    unsigned long idle=millis()-hap[i]->lastTime;            // unsigned subtraction remains correct across millis() rollover
+
+    if((hap[i]->cPair==NULL)!=(hap[slot]->cPair==NULL)){      // one slot is verified and the other is not
+      if(hap[i]->cPair==NULL){                                // un-verified slots are always evicted before verified slots
+        slot=i;
+        maxIdle=idle;
+      }
+    } else if(idle>maxIdle){                                  // otherwise evict the least-recently active slot
+      slot=i;
+      maxIdle=idle;
+    }
+  }
+
+  return(slot);
+}
+
 //////////////////////////////////////
 
 void Span::commandMode(){
@@ -330,10 +441,10 @@ void Span::commandMode(){
   int mode=1;
   boolean done=false;
   STATUS_UPDATE(start(500,0.3,mode,1000),static_cast<HS_STATUS>(HS_ENTERING_CONFIG_MODE+mode))
-  unsigned long alarmTime=millis()+comModeLife;
+  uint64_t alarmTime=Utils::uptime()+comModeLife;
 
   while(!done){
-    if(millis()>alarmTime){
+    if(Utils::uptime()>alarmTime){
       LOG0("*** Command Mode: Timed Out (%ld seconds)",comModeLife/1000);
       mode=1;
       done=true;
@@ -396,7 +507,7 @@ void Span::checkConnect(){
     }
 
   if(WiFi.status()!=WL_CONNECTED){
-    if(millis()<alarmConnect)         // not yet time to try to try connecting
+    if(Utils::uptime()<alarmConnect)  // not yet time to try to try connecting
       return;
 
     if(waitTime==60000)
@@ -412,7 +523,7 @@ void Span::checkConnect(){
       WiFi.begin(network.wifiData.ssid,network.wifiData.pwd);
     }
 
-    alarmConnect=millis()+waitTime;
+    alarmConnect=Utils::uptime()+waitTime;
 
     return;
   }
@@ -583,11 +694,16 @@ void Span::processSerialCommand(const char *c){
           } else {
             LOG0("  (unverified)");
           }
+
+          LOG0("  Up=%lus Idle=%lus Requests=%u MaxTime=%ums",(millis()-hap[i]->connectTime)/1000,(millis()-hap[i]->lastTime)/1000,hap[i]->nRequests,hap[i]->maxRequestTime);
       
         } else {
           LOG0("(unconnected)");
         }
 
+        if(hap[i]->nEvictions)
+          LOG0("  Evictions=%u",hap[i]->nEvictions);
+
         LOG0("\n");
       }
 
@@ -698,6 +814,7 @@ void Span::processSerialCommand(const char *c){
       
       LOG0("\nDEVICE NOT YET PAIRED -- PLEASE PAIR WITH HOMEKIT APP\n\n");
       mdns_service_txt_item_set("_hap","_tcp","sf","1");                                                        // set Status Flag = 1 (Table 6-8)
+      HAPClient::srp.precomputeKeys();                                                                          // pre-compute SRP keys in background for upcoming Pair-Setup
 
       if(homeSpan.pairCallback)
         homeSpan.pairCallback(false);
@@ -841,6 +958,12 @@ void Span::processSerialCommand(const char *c){
     }
     break;       
 
+    case 'b': {
+      int nIter=atoi(c+1);
+      benchmark(nIter>0?nIter:100);
+    }
+    break;
+
     case 'i':{
 
       LOG0("\n*** HomeSpan Info ***\n\n");
@@ -874,11 +997,11 @@ void Span::processSerialCommand(const char *c){
           else if((*acc)->aid==1)            // this is an Accessory with aid=1, but it has more than just AccessoryInfo.  So...
             isBridge=false;                  // ...this is not a bridge device          
 
-          unordered_set<HapChar *> hapChar;
+          unordered_set<const HapChar *> hapChar;
         
           for(auto chr=(*svc)->Characteristics.begin(); chr!=(*svc)->Characteristics.end(); chr++){
             LOG0("      \u21e8 Characteristic %s(%s):  IID=%d, %sUUID=\"%s\", %sPerms=",
-              (*chr)->hapName,(*chr)->uvPrint((*chr)->value).c_str(),(*chr)->iid,(*chr)->isCustom?"Custom-":"",(*chr)->type,(*chr)->perms!=(*chr)->hapChar->perms?"Custom-":"");
+              (*chr)->hapChar->hapName,(*chr)->uvPrint((*chr)->value).c_str(),(*chr)->iid,(*chr)->isCustom?"Custom-":"",(*chr)->hapChar->type,(*chr)->perms!=(*chr)->hapChar->perms?"Custom-":"");
 
             int foundPerms=0;
             for(uint8_t i=0;i<7;i++){
@@ -887,12 +1010,15 @@ void Span::processSerialCommand(const char *c){
             }           
             
             if((*chr)->format!=FORMAT::STRING && (*chr)->format!=FORMAT::BOOL && (*chr)->format!=FORMAT::DATA){
-              if((*chr)->validValues)
-                LOG0(", Valid Values=%s",(*chr)->validValues);
-              else if((*chr)->uvGet<double>((*chr)->stepValue)>0)
-                LOG0(", %sRange=[%s,%s,%s]",(*chr)->customRange?"Custom-":"",(*chr)->uvPrint((*chr)->minValue).c_str(),(*chr)->uvPrint((*chr)->maxValue).c_str(),(*chr)->uvPrint((*chr)->stepValue).c_str());
+              if((*chr)->validValues){
+                char vv[(*chr)->sprintfValidValues(NULL)+1];
+                (*chr)->sprintfValidValues(vv);
+                LOG0(", Valid Values=%s",vv);
+              }
+              else if((*chr)->uvGet<double>((*chr)->range->step)>0)
+                LOG0(", %sRange=[%s,%s,%s]",(*chr)->customRange?"Custom-":"",(*chr)->uvPrint((*chr)->range->min).c_str(),(*chr)->uvPrint((*chr)->range->max).c_str(),(*chr)->uvPrint((*chr)->range->step).c_str());
               else
-                LOG0(", %sRange=[%s,%s]",(*chr)->customRange?"Custom-":"",(*chr)->uvPrint((*chr)->minValue).c_str(),(*chr)->uvPrint((*chr)->maxValue).c_str());
+                LOG0(", %sRange=[%s,%s]",(*chr)->customRange?"Custom-":"",(*chr)->uvPrint((*chr)->range->min).c_str(),(*chr)->uvPrint((*chr)->range->max).c_str());
             }
             
             if((*chr)->nvsKey)
@@ -902,7 +1028,7 @@ void Span::processSerialCommand(const char *c){
             if(!(*chr)->isCustom && !(*svc)->isCustom  && (*svc)->req.find((*chr)->hapChar)==(*svc)->req.end() && (*svc)->opt.find((*chr)->hapChar)==(*svc)->opt.end())
               LOG0("          *** WARNING #%d!  Service does not support this Characteristic ***\n",++nWarnings);
             else
-            if(invalidUUID((*chr)->type,(*chr)->isCustom))
+            if(invalidUUID((*chr)->hapChar->type,(*chr)->isCustom))
               LOG0("          *** ERROR #%d!  Format of UUID is invalid ***\n",++nErrors);
             else       
             if(hapChar.find((*chr)->hapChar)!=hapChar.end())
@@ -914,8 +1040,8 @@ void Span::processSerialCommand(const char *c){
             if((*chr)->setValidValuesError)
               LOG0("          *** WARNING #%d!  Attempt to set Custom Valid Values for this Characteristic ignored ***\n",++nWarnings);
 
-            if((*chr)->format!=STRING && ((*chr)->uvGet<double>((*chr)->value) < (*chr)->uvGet<double>((*chr)->minValue) || (*chr)->uvGet<double>((*chr)->value) > (*chr)->uvGet<double>((*chr)->maxValue)))
-              LOG0("          *** WARNING #%d!  Value of %g is out of range [%g,%g] ***\n",++nWarnings,(*chr)->uvGet<double>((*chr)->value),(*chr)->uvGet<double>((*chr)->minValue),(*chr)->uvGet<double>((*chr)->maxValue));
+            if((*chr)->format!=STRING && ((*chr)->uvGet<double>((*chr)->value) < (*chr)->uvGet<double>((*chr)->range->min) || (*chr)->uvGet<double>((*chr)->value) > (*chr)->uvGet<double>((*chr)->range->max)))
+              LOG0("          *** WARNING #%d!  Value of %g is out of range [%g,%g] ***\n",++nWarnings,(*chr)->uvGet<double>((*chr)->value),(*chr)->uvGet<double>((*chr)->range->min),(*chr)->uvGet<double>((*chr)->range->max));
 
             hapChar.insert((*chr)->hapChar);
           
@@ -1090,6 +1216,7 @@ void Span::processSerialCommand(const char *c){
       LOG0("  i - print summary information about the HAP Database\n");
       LOG0("  d - print the full HAP Accessory Attributes Database in JSON format\n");
       LOG0("  m - print free heap memory\n");
+      LOG0("  b <n> - benchmark HAP request processing on this database over <n> iterations (default 100), results in JSON\n");
       LOG0("\n");      
       LOG0("  W - configure WiFi Credentials and restart\n");      
       LOG0("  X - delete WiFi Credentials and restart\n");      
@@ -1370,11 +1497,12 @@ int Span::updateCharacteristics(char *buf, SpanBuf *pObj){
       } else 
       if(!strcmp(t2,"pid") && (t3=strtok_r(t1,"}[]:, \"\t\n\r",&p2))){        
         uint64_t pid=strtoull(t3,NULL,0);        
-        if(!TimedWrites.count(pid)){
+        int twStatus=TimedWrites.check(pid);
+        if(twStatus<0){
           LOG0("\n*** ERROR:  Timed Write PID not found\n\n");
           twFail=true;
         } else        
-        if(millis()>TimedWrites[pid]){
+        if(twStatus==0){
           LOG0("\n*** ERROR:  Timed Write Expired\n\n");
           twFail=true;
         }        
@@ -1395,7 +1523,7 @@ int Span::updateCharacteristics(char *buf, SpanBuf *pObj){
       
   } // parse objects
 
-  snapTime=millis();                                           // timestamp for this series of updates, assigned to each characteristic in loadUpdate()
+  snapTime=Utils::uptime();                                    // timestamp for this series of updates, assigned to each characteristic in loadUpdate()
 
   for(int i=0;i<nObj;i++){                                     // PASS 1: loop over all objects, identify characteristics, and initialize update for those found
 
@@ -1452,12 +1580,98 @@ int Span::updateCharacteristics(char *buf, SpanBuf *pObj){
 
 ///////////////////////////////
 
+void Span::benchmark(int nIter){
+
+  // Only read-only paths are timed so the command can run on a live bridge:  PUT parsing is fed an unknown aid,
+  // and notification records are timed through the per-Characteristic formatting that sprintfNotify() relies on
+
+  vector<SpanCharacteristic *> chars;
+  for(auto acc=Accessories.begin(); acc!=Accessories.end(); acc++)
+    for(auto svc=(*acc)->Services.begin(); svc!=(*acc)->Services.end(); svc++)
+      for(auto chr=(*svc)->Characteristics.begin(); chr!=(*svc)->Characteristics.end(); chr++)
+        chars.push_back(*chr);
+
+  if(chars.empty()){
+    LOG0("*** No Characteristics to benchmark\n");
+    return;
+  }
+
+  struct {
+    const char *name;
+    int nOps;                   // operations per iteration
+    int64_t elapsed=0;          // microseconds over all iterations
+  } results[]={{"find",(int)chars.size()},{"attributes_db",1},{"attributes_chr",(int)chars.size()},{"notify_chr",(int)chars.size()},{"put_parse",1},{"tlv_pack_unpack",1}};
+
+  int dbLen=sprintfAttributes(NULL);
+  TempBuffer <char> dbBuf(dbLen+1);
+  char chrBuf[512];
+
+  const char putBody[]="{\"characteristics\":[{\"aid\":0,\"iid\":9,\"value\":1},{\"aid\":0,\"iid\":10,\"ev\":true}]}";
+  char putBuf[sizeof(putBody)];
+  SpanBuf pObj[2];
+
+  static TLV<kTLVType,3> tlv;               // created once, TLV records are never freed
+  static boolean tlvCreated=false;
+  uint8_t tlvBuf[512];
+  if(!tlvCreated){
+    tlv.create(kTLVType_State,1,"STATE");
+    tlv.create(kTLVType_PublicKey,384,"PUBKEY");
+    tlv.create(kTLVType_Proof,64,"PROOF");
+    tlvCreated=true;
+  }
+  tlv.clear();
+  tlv.val(kTLVType_State,3);
+  memset(tlv.buf(kTLVType_PublicKey,384),0x5A,384);
+  memset(tlv.buf(kTLVType_Proof,64),0xA5,64);
+
+  int64_t heapBefore=heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+
+  for(int n=0;n<nIter;n++){
+    int64_t t0=esp_timer_get_time();
+    for(auto chr : chars)
+      find(chr->aid,chr->iid);
+    int64_t t1=esp_timer_get_time();
+    sprintfAttributes(NULL);
+    sprintfAttributes(dbBuf.buf);
+    int64_t t2=esp_timer_get_time();
+    for(auto chr : chars)
+      if(chr->sprintfAttributes(NULL,GET_META|GET_PERMS|GET_TYPE|GET_DESC)<(int)sizeof(chrBuf))
+        chr->sprintfAttributes(chrBuf,GET_META|GET_PERMS|GET_TYPE|GET_DESC);
+    int64_t t3=esp_timer_get_time();
+    for(auto chr : chars)
+      if(chr->sprintfAttributes(NULL,GET_VALUE|GET_AID|GET_NV)<(int)sizeof(chrBuf))
+        chr->sprintfAttributes(chrBuf,GET_VALUE|GET_AID|GET_NV);
+    int64_t t4=esp_timer_get_time();
+    memcpy(putBuf,putBody,sizeof(putBody));
+    updateCharacteristics(putBuf,pObj);
+    int64_t t5=esp_timer_get_time();
+    int nBytes=tlv.pack(tlvBuf);
+    tlv.unpack(tlvBuf,nBytes);
+    int64_t t6=esp_timer_get_time();
+
+    results[0].elapsed+=t1-t0;
+    results[1].elapsed+=t2-t1;
+    results[2].elapsed+=t3-t2;
+    results[3].elapsed+=t4-t3;
+    results[4].elapsed+=t5-t4;
+    results[5].elapsed+=t6-t5;
+  }
+
+  LOG0("{\"homespan\":\"%s\",\"accessories\":%d,\"characteristics\":%d,\"db_bytes\":%d,\"iterations\":%d,\"chr_bytes\":%d,\"heap_delta\":%lld,\"results\":[",
+    HOMESPAN_VERSION,(int)Accessories.size(),(int)chars.size(),dbLen,nIter,(int)sizeof(SpanCharacteristic),heapBefore-heap_caps_get_free_size(MALLOC_CAP_DEFAULT));
+  for(int i=0;i<sizeof(results)/sizeof(results[0]);i++)
+    LOG0("%s{\"name\":\"%s\",\"ns_per_op\":%lld}",i?",":"",results[i].name,results[i].elapsed*1000/((int64_t)nIter*results[i].nOps));
+  LOG0("]}\n");
+}
+
+///////////////////////////////
+
 void Span::clearNotify(int slotNum){
   
   for(int i=0;i<Accessories.size();i++){
     for(int j=0;j<Accessories[i]->Services.size();j++){
       for(int k=0;k<Accessories[i]->Services[j]->Characteristics.size();k++){
-        Accessories[i]->Services[j]->Characteristics[k]->ev[slotNum]=false;
+        Accessories[i]->Services[j]->Characteristics[k]->setEv(slotNum,false);
       }
     }
   }
@@ -1476,7 +1690,7 @@ int Span::sprintfNotify(SpanBuf *pObj, int nObj, char *cBuf, int conNum){
     
     if(pObj[i].status==StatusCode::OK && pObj[i].val){           // characteristic was successfully updated with a new value (i.e. not just an EV request)
       
-      if(pObj[i].characteristic->ev[conNum]){           // if notifications requested for this characteristic by specified connection number
+      if(pObj[i].characteristic->evEnabled(conNum)){           // if notifications requested for this characteristic by specified connection number
       
         if(notifyFlag)                                                           // already printed at least one other characteristic
           nChars+=snprintf(cBuf?(cBuf+nChars):NULL,cBuf?64:0,",");               // add preceeding comma before printing next characteristic
@@ -1573,9 +1787,27 @@ int Span::sprintfAttributes(char **ids, int numIDs, int flags, char *cBuf){
 boolean Span::updateDatabase(boolean updateMDNS){
 
   uint8_t tHash[48];
-  TempBuffer <char> tBuf(sprintfAttributes(NULL,GET_META|GET_PERMS|GET_TYPE|GET_DESC)+1);
-  sprintfAttributes(tBuf.buf,GET_META|GET_PERMS|GET_TYPE|GET_DESC);  
-  mbedtls_sha512_ret((uint8_t *)tBuf.buf,tBuf.len(),tHash,1);     // create SHA-384 hash of JSON (can be any hash - just looking for a unique key)
+  mbedtls_sha512_context ctx;                                  // create SHA-384 hash of JSON (can be any hash - just looking for a unique key)
+  mbedtls_sha512_init(&ctx);
+  mbedtls_sha512_starts_ret(&ctx,1);
+
+  // The JSON is hashed one Accessory at a time, which yields exactly the same hash as sprintfAttributes(cBuf,...)
+  // but only needs a buffer as large as the biggest Accessory instead of one holding the whole database
+
+  const int flags=GET_META|GET_PERMS|GET_TYPE|GET_DESC;
+  mbedtls_sha512_update_ret(&ctx,(uint8_t *)"{\"accessories\":[",16);
+
+  for(int i=0;i<Accessories.size();i++){
+    TempBuffer <char> tBuf(Accessories[i]->sprintfAttributes(NULL,flags)+1);
+    Accessories[i]->sprintfAttributes(tBuf.buf,flags);
+    mbedtls_sha512_update_ret(&ctx,(uint8_t *)tBuf.buf,tBuf.len()-1);
+    if(i+1<Accessories.size())
+      mbedtls_sha512_update_ret(&ctx,(uint8_t *)",",1);
+  }
+
+  mbedtls_sha512_update_ret(&ctx,(uint8_t *)"]}",3);        // includes null terminator, as did the hash of the full buffer
+  mbedtls_sha512_finish_ret(&ctx,tHash);
+  mbedtls_sha512_free(&ctx);
 
   boolean changed=false;
 
@@ -1781,18 +2013,19 @@ int SpanService::sprintfAttributes(char *cBuf, int flags){
 //    SpanCharacteristic     //
 ///////////////////////////////
 
-SpanCharacteristic::SpanCharacteristic(HapChar *hapChar, boolean isCustom){
+SpanCharacteristic::SpanCharacteristic(const HapChar *hapChar, boolean isCustom){
 
-  type=hapChar->type;
   perms=hapChar->perms;
-  hapName=hapChar->hapName;
   format=hapChar->format;
-  staticRange=hapChar->staticRange;
   this->isCustom=isCustom;
   this->hapChar=hapChar;
+  customRange=false;
+  setRangeError=false;
+  setValidValuesError=false;
+  isUpdated=false;
 
   if(homeSpan.Accessories.empty() || homeSpan.Accessories.back()->Services.empty()){
-    LOG0("\nFATAL ERROR!  Can't create new Characteristic '%s' without a defined Service ***\n",hapName);
+    LOG0("\nFATAL ERROR!  Can't create new Characteristic '%s' without a defined Service ***\n",hapChar->hapName);
     LOG0("\n=== PROGRAM HALTED ===");
     while(1);
   }
@@ -1801,8 +2034,6 @@ SpanCharacteristic::SpanCharacteristic(HapChar *hapChar, boolean isCustom){
   iid=++(homeSpan.Accessories.back()->iidCount);
   service=homeSpan.Accessories.back()->Services.back();
   aid=homeSpan.Accessories.back()->aid;
-
-  ev=(boolean *)calloc(homeSpan.maxConnections,sizeof(boolean));
 }
 
 ///////////////////////////////
@@ -1814,7 +2045,6 @@ SpanCharacteristic::~SpanCharacteristic(){
     chr++;
   service->Characteristics.erase(chr);
 
-  free(ev);
   free(desc);
   free(unit);
   free(validValues);
@@ -1840,7 +2070,7 @@ int SpanCharacteristic::sprintfAttributes(char *cBuf, int flags){
   nBytes+=snprintf(cBuf,cBuf?64:0,"{\"iid\":%d",iid);
 
   if(flags&GET_TYPE)  
-    nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"type\":\"%s\"",type);
+    nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"type\":\"%s\"",hapChar->type);
 
   if((perms&PR) && (flags&GET_VALUE)){    
     if(perms&NV && !(flags&GET_NV))
@@ -1853,10 +2083,10 @@ int SpanCharacteristic::sprintfAttributes(char *cBuf, int flags){
     nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"format\":\"%s\"",formatCodes[format]);
     
     if(customRange && (flags&GET_META)){
-      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"minValue\":%s,\"maxValue\":%s",uvPrint(minValue).c_str(),uvPrint(maxValue).c_str());
+      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"minValue\":%s,\"maxValue\":%s",uvPrint(range->min).c_str(),uvPrint(range->max).c_str());
         
-      if(uvGet<float>(stepValue)>0)
-        nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"minStep\":%s",uvPrint(stepValue).c_str());
+      if(uvGet<float>(range->step)>0)
+        nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"minStep\":%s",uvPrint(range->step).c_str());
     }
 
     if(unit){
@@ -1867,7 +2097,8 @@ int SpanCharacteristic::sprintfAttributes(char *cBuf, int flags){
     }
 
     if(validValues){
-      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"valid-values\":%s",validValues);      
+      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?128:0,",\"valid-values\":");
+      nBytes+=sprintfValidValues(cBuf?(cBuf+nBytes):NULL);
     }
   }
     
@@ -1891,7 +2122,7 @@ int SpanCharacteristic::sprintfAttributes(char *cBuf, int flags){
     nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"aid\":%u",aid);
   
   if(flags&GET_EV)
-    nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"ev\":%s",ev[HAPClient::conNum]?"true":"false");
+    nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,",\"ev\":%s",evEnabled(HAPClient::conNum)?"true":"false");
 
   nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?64:0,"}");
 
@@ -1922,7 +2153,7 @@ StatusCode SpanCharacteristic::loadUpdate(char *val, char *ev){
     LOG1(": ");
     LOG1(evFlag?"true":"false");
     LOG1("\n");
-    this->ev[HAPClient::conNum]=evFlag;
+    setEv(HAPClient::conNum,evFlag);
   }
 
   if(!val)                // no request to update value
@@ -2009,47 +2240,85 @@ StatusCode SpanCharacteristic::loadUpdate(char *val, char *ev){
 ///////////////////////////////
 
 unsigned long SpanCharacteristic::timeVal(){
-  
-  return(homeSpan.snapTime-updateTime);
+
+  uint64_t elapsed=homeSpan.snapTime-updateTime;
+  return(elapsed>ULONG_MAX?ULONG_MAX:elapsed);
 }
 
 ///////////////////////////////
 
 SpanCharacteristic *SpanCharacteristic::setValidValues(int n, ...){
- 
-  String s="[";
+
+  if(format!=FORMAT::UINT8 && format!=FORMAT::UINT16 && format!=FORMAT::UINT32 && format!=FORMAT::INT){
+    setValidValuesError=true;
+    return(this);
+  }
+
+  if(n<=0 || n>UINT8_MAX){                    // an empty list removes any previously set valid values
+    free(validValues);
+    validValues=NULL;
+    nValidValues=0;
+    return(this);
+  }
+
+  validValues=(int32_t *)realloc(validValues,n*sizeof(int32_t));
+  nValidValues=n;
+
   va_list vl;
   va_start(vl,n);
   for(int i=0;i<n;i++){
     switch(format){
       case FORMAT::UINT8:
-        s+=(uint8_t)va_arg(vl,uint32_t);
+        validValues[i]=(uint8_t)va_arg(vl,uint32_t);
         break;
       case FORMAT::UINT16:
-        s+=(uint16_t)va_arg(vl,uint32_t);
+        validValues[i]=(uint16_t)va_arg(vl,uint32_t);
         break;
       case FORMAT::UINT32:
-        s+=(uint32_t)va_arg(vl,uint32_t);
-        break;
-      case FORMAT::INT:
-        s+=(int)va_arg(vl,uint32_t);
+        validValues[i]=(int32_t)va_arg(vl,uint32_t);     // stored as raw bits, printed back as unsigned
         break;
       default:
-        setValidValuesError=true;
-        return(this);      
+        validValues[i]=(int)va_arg(vl,uint32_t);
+        break;
     }
-    if(i!=n-1)
-      s+=",";
   }
   va_end(vl);
-  s+="]";
-
-  validValues=(char *)realloc(validValues, strlen(s.c_str()) + 1);
-  strcpy(validValues,s.c_str());
 
   return(this);
 }
 
+///////////////////////////////
+
+int SpanCharacteristic::sprintfValidValues(char *cBuf){
+
+  int nBytes=0;
+
+  for(int i=0;i<nValidValues;i++){
+    if(format==FORMAT::UINT32)
+      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?16:0,"%c%u",i?',':'[',(uint32_t)validValues[i]);
+    else
+      nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?16:0,"%c%d",i?',':'[',validValues[i]);
+  }
+  nBytes+=snprintf(cBuf?(cBuf+nBytes):NULL,cBuf?2:0,"]");
+
+  return(nBytes);
+}
+
+///////////////////////////////
+
+vector<const SpanCharacteristic::range_t *> SpanCharacteristic::rangePool;
+
+const SpanCharacteristic::range_t *SpanCharacteristic::findRange(const range_t &r){
+
+  for(auto it=rangePool.begin(); it!=rangePool.end(); it++){     // most Characteristics share a handful of ranges
+    if(!memcmp(*it,&r,sizeof(range_t)))
+      return(*it);
+  }
+
+  rangePool.push_back(new range_t(r));
+  return(rangePool.back());
+}
+
 ///////////////////////////////
 //        SpanRange          //
 ///////////////////////////////
@@ -2119,6 +2388,112 @@ SpanUserCommand::SpanUserCommand(char c, const char *s, void (*f)(const char *,
   homeSpan.UserCommands[c]=this;
 }
 
+///////////////////////////////
+//     SpanTimedWrites       //
+///////////////////////////////
+
+int SpanTimedWrites::find(uint64_t pid){
+
+  for(int i=0;i<nEntries;i++){
+    if(heap[i].pid==pid)
+      return(i);
+  }
+
+  return(-1);
+}
+
+///////////////////////////////
+
+void SpanTimedWrites::add(uint64_t pid, uint32_t ttl){
+
+  uint64_t alarmTime=Utils::uptime()+ttl;
+  int index=find(pid);
+
+  if(index<0){                                          // new PID
+    if(nEntries==MAX_TIMED_WRITES){                     // no room - drop PID closest to expiring
+      LOG0("\n*** WARNING:  Too many Timed Writes.  Dropping PID=%llu\n\n",(unsigned long long)heap[0].pid);
+      remove(0);
+    }
+    index=nEntries++;
+    heap[index].pid=pid;
+    heap[index].alarmTime=alarmTime;
+    siftUp(index);
+  } else {                                              // existing PID - update alarm time
+    boolean earlier=alarmTime<heap[index].alarmTime;
+    heap[index].alarmTime=alarmTime;
+    if(earlier)
+      siftUp(index);
+    else
+      siftDown(index);
+  }
+}
+
+///////////////////////////////
+
+int SpanTimedWrites::check(uint64_t pid){
+
+  int index=find(pid);
+
+  if(index<0)
+    return(-1);
+
+  return(Utils::uptime()<heap[index].alarmTime?1:0);
+}
+
+///////////////////////////////
+
+void SpanTimedWrites::purge(){
+
+  uint64_t cTime=Utils::uptime();
+
+  while(nEntries>0 && cTime>=heap[0].alarmTime){                  // first PID has expired
+    LOG2("Removing PID=%llu  ALARM=%llu\n",(unsigned long long)heap[0].pid,(unsigned long long)heap[0].alarmTime);
+    remove(0);
+  }
+}
+
+///////////////////////////////
+
+void SpanTimedWrites::remove(int index){
+
+  heap[index]=heap[--nEntries];                      // move last entry into vacated position
+
+  if(index<nEntries){
+    siftDown(index);
+    siftUp(index);
+  }
+}
+
+///////////////////////////////
+
+void SpanTimedWrites::siftUp(int index){
+
+  while(index>0){
+    int parent=(index-1)/2;
+    if(heap[index].alarmTime>=heap[parent].alarmTime)
+      break;
+    std::swap(heap[index],heap[parent]);
+    index=parent;
+  }
+}
+
+///////////////////////////////
+
+void SpanTimedWrites::siftDown(int index){
+
+  for(;;){
+    int child=2*index+1;
+    if(child>=nEntries)
+      break;
+    if(child+1<nEntries && heap[child+1].alarmTime<heap[child].alarmTime)
+      child++;
+    if(heap[child].alarmTime>=heap[index].alarmTime)
+      break;
+    std::swap(heap[index],heap[child]);
+    index=child;
+  }
+}
+
 ///////////////////////////////
 //        SpanWebLog         //
 ///////////////////////////////
@@ -2130,6 +2505,7 @@ void SpanWebLog::init(uint16_t maxEntries, const char *serv, const char *tz, con
   timeZone=tz;
   statusURL="GET /" + String(url) + " ";
   log = (log_t *)calloc(maxEntries,sizeof(log_t));
+  logMutex = xSemaphoreCreateMutex();
   if(timeServer)
     homeSpan.reserveSocketConnections(1);
 }
@@ -2167,6 +2543,7 @@ void SpanWebLog::vLog(boolean sysMsg, const char *fmt, va_list ap){
     LOG1("WEBLOG: %s\n",buf);
   
   if(maxEntries>0){
+    xSemaphoreTake(logMutex,portMAX_DELAY);
     int index=nEntries%maxEntries;
   
     log[index].upTime=esp_timer_get_time();
@@ -2180,6 +2557,7 @@ void SpanWebLog::vLog(boolean sysMsg, const char *fmt, va_list ap){
     
     log[index].clientIP=homeSpan.lastClientIP;  
     nEntries++;
+    xSemaphoreGive(logMutex);
   }
 
   free(buf);
@@ -48,6 +48,7 @@
 #include "Settings.h"
 #include "Utils.h"
 #include "Network.h"
+#include "HapServer.h"
 #include "HAPConstants.h"
 #include "HapQR.h"
 #include "Characteristics.h"
@@ -139,6 +140,28 @@ struct SpanBuf{                               // temporary storage buffer for us
   
 ///////////////////////////////
 
+struct SpanTimedWrites{                       // fixed-capacity min-heap of timed-write PIDs ordered by alarm time (HAP Section 6.7.2.4)
+
+  static const int MAX_TIMED_WRITES=16;       // maximum number of simultaneous timed-write PIDs; if full, the PID closest to expiring is dropped to make room
+
+  struct timedWrite_t {
+    uint64_t pid;                             // timed-write PID
+    uint64_t alarmTime;                       // time (in Utils::uptime() millis) after which PID expires
+  } heap[MAX_TIMED_WRITES];                   // heap[0] always holds the PID that expires first
+  int nEntries=0;                             // number of PIDs currently stored
+
+  int find(uint64_t pid);                     // returns heap index of pid, or -1 if not found (linear scan of compact array - faster than hashing for so few entries)
+  void add(uint64_t pid, uint32_t ttl);       // adds pid with alarm time ttl millis from now, or updates alarm time if pid already stored
+  int check(uint64_t pid);                    // returns 1 if pid is stored and not expired, 0 if expired, or -1 if not found
+  uint64_t nextAlarm(){return(nEntries>0?heap[0].alarmTime:UINT64_MAX);}     // returns alarm time of the PID that expires first, or UINT64_MAX if none
+  void purge();                               // removes all expired PIDs - returns immediately if first PID has not yet expired
+  void remove(int index);                     // removes PID at heap index
+  void siftUp(int index);                     // restores heap order by moving entry at index towards root
+  void siftDown(int index);                   // restores heap order by moving entry at index towards leaves
+};
+
+///////////////////////////////
+
 struct SpanWebLog{                            // optional web status/log data
   boolean isEnabled=false;                    // flag to inidicate WebLog has been enabled
   uint16_t maxEntries=0;                      // max number of log entries;
@@ -158,6 +181,13 @@ struct SpanWebLog{                            // optional web status/log data
     String clientIP;                          // IP address of client making request (or "0.0.0.0" if not applicable)
   } *log=NULL;                                // array of log entries 
 
+  struct route_t {                            // user-defined web route served next to the status log
+    String url;                               // request prefix, "GET /<url>"
+    void (*handler)(WiFiClient &client, const char *args);    // writes the complete HTTP response; args points to the query string ('?...') or to the space after the URL
+  };
+  vector<route_t> routes;                     // user-defined web routes
+  SemaphoreHandle_t logMutex=NULL;            // guards log entries, which may be written from tasks other than pollTask()
+
   void init(uint16_t maxEntries, const char *serv, const char *tz, const char *url);
   static void initTime(void *args);  
   void vLog(boolean sysMsg, const char *fmr, va_list ap);
@@ -198,6 +228,7 @@ class Span{
   friend class SpanOTA;
   friend class Network;
   friend class HAPClient;
+  friend class SpanTestAccess;                  // host tests and benchmarks, see lib/TestBench
   
   const char *displayName;                      // display name for this device - broadcast as part of Bonjour MDNS
   const char *hostNameBase;                     // base of hostName of this device - full host name broadcast by Bonjour MDNS will have 6-byte accessoryID as well as '.local' automatically appended
@@ -205,7 +236,7 @@ class Span{
   char *hostName;                               // full host name of this device - constructed from hostNameBase and 6-byte AccessoryID
   const char *modelName;                        // model name of this device - broadcast as Bonjour field "md" 
   char category[3]="";                          // category ID of primary accessory - broadcast as Bonjour field "ci" (HAP Section 13)
-  unsigned long snapTime;                       // current time (in millis) snapped before entering Service loops() or updates()
+  uint64_t snapTime;                            // current time (in Utils::uptime() millis) snapped before entering Service loops() or updates()
   boolean isInitialized=false;                  // flag indicating HomeSpan has been initialized
   boolean isBridge=true;                        // flag indicating whether device is configured as a bridge (i.e. first Accessory contains nothing but AccessoryInformation and HAPProtocolInformation)
   HapQR qrCode;                                 // optional QR Code to use for pairing
@@ -220,7 +251,8 @@ class Span{
   
   int connected=0;                              // WiFi connection status (increments upon each connect and disconnect)
   unsigned long waitTime=60000;                 // time to wait (in milliseconds) between WiFi connection attempts
-  unsigned long alarmConnect=0;                 // time after which WiFi connection attempt should be tried again
+  uint64_t alarmConnect=0;                      // time (in Utils::uptime() millis) after which WiFi connection attempt should be tried again
+  uint32_t firstResponseTime=0;                 // time (in Utils::uptime() millis) at which the first HAP request since boot was answered (0 if none yet)
   
   const char *defaultSetupCode=DEFAULT_SETUP_CODE;            // Setup Code used for pairing
   uint16_t autoOffLED=0;                                      // automatic turn-off duration (in seconds) for Status LED
@@ -229,14 +261,24 @@ class Span{
   uint8_t requestedMaxCon=CONFIG_LWIP_MAX_SOCKETS-2;          // requested maximum number of simultaneous HAP connections
   unsigned long comModeLife=DEFAULT_COMMAND_TIMEOUT*1000;     // length of time (in milliseconds) to keep Command Mode alive before resuming normal operations
   uint16_t tcpPortNum=DEFAULT_TCP_PORT;                       // port for TCP communications between HomeKit and HomeSpan
+  uint16_t pollBudget=DEFAULT_POLL_BUDGET;                    // time (in millis) after which no further HAP requests are processed in a single pass of pollTask()
+  uint16_t loopInterval=DEFAULT_LOOP_INTERVAL;                // time (in millis) between two calls of Service loop() methods and SpanButton checks when no request wakes pollTask() earlier
+  uint16_t pollInterval=DEFAULT_POLL_INTERVAL;                // time (in millis) between two calls of pollCallback
+  uint16_t maxPollWait=DEFAULT_MAX_POLL_WAIT;                 // longest time (in millis) pollTask() sleeps, so serial input, OTA, WiFi and the control button are still checked
+  uint64_t loopTime=0;                                        // time (in Utils::uptime() millis) Service loop() methods were last called
+  uint64_t pollCallbackTime=0;                                // time (in Utils::uptime() millis) pollCallback was last called
+  uint8_t nextSlot=0;                                         // HAPClient slot from which pollTask() starts processing requests (rotates round-robin)
   char qrID[5]="";                                            // Setup ID used for pairing with QR Code
   void (*wifiCallback)()=NULL;                                // optional callback function to invoke once WiFi connectivity is established
   void (*pairCallback)(boolean isPaired)=NULL;                // optional callback function to invoke when pairing is established (true) or lost (false)
   boolean autoStartAPEnabled=false;                           // enables auto start-up of Access Point when WiFi Credentials not found
   void (*apFunction)()=NULL;                                  // optional function to invoke when starting Access Point
   void (*statusCallback)(HS_STATUS status)=NULL;              // optional callback when HomeSpan status changes
+  void (*weblogCallback)(String &htmlText)=NULL;              // optional callback to add rows to the Web Log status table
+  void (*pollCallback)()=NULL;                                // optional callback invoked at the end of every pass of pollTask()
   
-  WiFiServer *hapServer;                            // pointer to the HAP Server connection
+  HapServer *hapServer;                             // pointer to the HAP Server connection
+  boolean pollAll=false;                            // flag indicating pollTask() should check all HAP Clients on its next pass without waiting for socket readiness
   Blinker *statusLED;                               // indicates HomeSpan status
   Blinkable *statusDevice = NULL;                   // the device used for the Blinker
   PushButton *controlButton = NULL;                 // controls HomeSpan configuration and resets
@@ -250,12 +292,14 @@ class Span{
   vector<SpanService *> Loops;                      // vector of pointer to all Services that have over-ridden loop() methods
   vector<SpanBuf> Notifications;                    // vector of SpanBuf objects that store info for Characteristics that are updated with setVal() and require a Notification Event
   vector<SpanButton *> PushButtons;                 // vector of pointer to all PushButtons
-  unordered_map<uint64_t, uint32_t> TimedWrites;    // map of timed-write PIDs and Alarm Times (based on TTLs)
+  SpanTimedWrites TimedWrites;                      // timed-write PIDs and Alarm Times (based on TTLs)
   
   unordered_map<char, SpanUserCommand *> UserCommands;           // map of pointers to all UserCommands
 
   void pollTask();                              // poll HAP Clients and process any new HAP requests
+  uint32_t pollTimeout();                       // returns time (in millis) pollTask() may sleep in select() before the earliest of its deadlines is due
   int getFreeSlot();                            // returns free HAPClient slot number. HAPClients slot keep track of each active HAPClient connection
+  int getEvictSlot();                           // returns HAPClient slot to free when all slots are in use: least-recently active un-verified slot if any, else least-recently active slot
   void checkConnect();                          // check WiFi connection; connect if needed
   void commandMode();                           // allows user to control and reset HomeSpan settings with the control button
   void resetStatus();                           // resets statusLED and calls statusCallback based on current HomeSpan status
@@ -271,6 +315,7 @@ class Span{
   int sprintfAttributes(char **ids, int numIDs, int flags, char *cBuf);   // prints accessory.characteristic ids into buf, unless buf=NULL; return number of characters printed, excluding null terminator, even if buf=NULL
   void clearNotify(int slotNum);                                          // set ev notification flags for connection 'slotNum' to false across all characteristics 
   int sprintfNotify(SpanBuf *pObj, int nObj, char *cBuf, int conNum);     // prints notification JSON into buf based on SpanBuf objects and specified connection number
+  void benchmark(int nIter);                                              // times the HAP request hot paths against the current database and prints the results as one JSON line
 
   static boolean invalidUUID(const char *uuid, boolean isCustom){
     int x=0;
@@ -315,9 +360,13 @@ class Span{
   void reserveSocketConnections(uint8_t n){maxConnections-=n;}            // reserves n socket connections *not* to be used for HAP
   void setHostNameSuffix(const char *suffix){hostNameSuffix=suffix;}      // sets the hostName suffix to be used instead of the 6-byte AccessoryID
   void setPortNum(uint16_t port){tcpPortNum=port;}                        // sets the TCP port number to use for communications between HomeKit and HomeSpan
+  void setPollBudget(uint16_t ms){pollBudget=ms;}                         // sets the time (in millis) after which pollTask() defers any remaining HAP requests to its next pass
+  void setLoopInterval(uint16_t ms){loopInterval=ms;}                     // sets the time (in millis) between two calls of Service loop() methods, pollTask() sleeps no longer while any Service has one
+  void setMaxPollWait(uint16_t ms){maxPollWait=ms;}                       // sets the longest time (in millis) pollTask() sleeps waiting for HAP requests
   void setQRID(const char *id);                                           // sets the Setup ID for optional pairing with a QR Code
   void setSketchVersion(const char *sVer){sketchVersion=sVer;}            // set optional sketch version number
   const char *getSketchVersion(){return sketchVersion;}                   // get sketch version number
+  uint32_t getFirstResponseTime(){return firstResponseTime;}              // get time (in millis since boot) at which the first HAP request was answered, or 0 if none yet
   void setWifiCallback(void (*f)()){wifiCallback=f;}                      // sets an optional user-defined function to call once WiFi connectivity is established
   void setPairCallback(void (*f)(boolean isPaired)){pairCallback=f;}      // sets an optional user-defined function to call when Pairing is established (true) or lost (false)
   void setApFunction(void (*f)()){apFunction=f;}                          // sets an optional user-defined function to call when activating the WiFi Access Point  
@@ -344,6 +393,9 @@ class Span{
   }
 
   void setWebLogCSS(const char *css){webLog.css="\n" + String(css) + "\n";}
+  void setPollCallback(void (*f)(), uint16_t ms=DEFAULT_POLL_INTERVAL){pollCallback=f;pollInterval=ms;}     // sets an optional user-defined function called every 'ms' millis, in the same task as Service loop() methods, whether poll() or autoPoll() is used
+  void setWebLogCallback(void (*f)(String &htmlText)){weblogCallback=f;}     // sets an optional user-defined function that appends "<tr><td>...</td><td>...</td></tr>" rows to the Web Log status table
+  void addWebRoute(const char *url, void (*f)(WiFiClient &client, const char *args)){webLog.routes.push_back({"GET /" + String(url), f});}     // serves "GET /<url>[?args]" with a user-defined handler
 
   void autoPoll(uint32_t stackSize=8192, uint32_t priority=1, uint32_t cpu=0){     // start pollTask()
     xTaskCreateUniversal([](void *parms){for(;;)homeSpan.pollTask();}, "pollTask", stackSize, NULL, priority, &pollTaskHandle, cpu);
@@ -365,6 +417,7 @@ class SpanAccessory{
   friend class SpanCharacteristic;
   friend class SpanButton;
   friend class SpanRange;
+  friend class SpanTestAccess;                            // host tests and benchmarks, see lib/TestBench
     
   uint32_t aid=0;                                         // Accessory Instance ID (HAP Table 6-1)
   int iidCount=0;                                         // running count of iid to use for Services and Characteristics associated with this Accessory                                 
@@ -389,6 +442,7 @@ class SpanService{
   friend class SpanAccessory;
   friend class SpanCharacteristic;
   friend class SpanRange;
+  friend class SpanTestAccess;                            // host tests and benchmarks, see lib/TestBench
 
   int iid=0;                                              // Instance ID (HAP Table 6-2)
   const char *type;                                       // Service Type
@@ -405,8 +459,8 @@ class SpanService{
   protected:
   
   virtual ~SpanService();                                 // destructor
-  unordered_set<HapChar *> req;                           // unordered set of pointers to all required HAP Characteristic Types for this Service
-  unordered_set<HapChar *> opt;                           // unordered set of pointers to all optional HAP Characteristic Types for this Service
+  unordered_set<const HapChar *> req;                     // unordered set of pointers to all required HAP Characteristic Types for this Service
+  unordered_set<const HapChar *> opt;                     // unordered set of pointers to all optional HAP Characteristic Types for this Service
 
   public:
   
@@ -427,6 +481,7 @@ class SpanCharacteristic{
 
   friend class Span;
   friend class SpanService;
+  friend class SpanTestAccess;             // host tests and benchmarks, see lib/TestBench
 
   union UVal {                                  
     BOOL_t BOOL;
@@ -439,37 +494,50 @@ class SpanCharacteristic{
     STRING_t STRING = NULL;
   };
 
-  int iid=0;                               // Instance ID (HAP Table 6-3)
-  HapChar *hapChar;                        // pointer to HAP Characteristic structure
-  const char *type;                        // Characteristic Type
-  const char *hapName;                     // HAP Name
+  struct range_t {                         // Characteristic minimum, maximum and step size (not applicable for STRING)
+    UVal min;
+    UVal max;
+    UVal step;
+    range_t(){min.UINT64=0;max.UINT64=0;step.UINT64=0;}   // UINT64 spans the whole union, so unused bytes are zero and identical ranges are found in the pool
+  };
+
+  static vector<const range_t *> rangePool;               // range descriptors shared by all Characteristics with identical ranges (never freed)
+  static const range_t *findRange(const range_t &r);      // returns the pooled descriptor identical to r, adding a copy of r to the pool if not found
+
+  static_assert(CONFIG_LWIP_MAX_SOCKETS<=32,"evBits cannot hold one bit per HAP connection");
+
+  // Fields are ordered largest first so the compiler adds no padding; type, name and static-range flag are read from hapChar
+
   UVal value;                              // Characteristic Value
-  uint8_t perms;                           // Characteristic Permissions
-  FORMAT format;                           // Characteristic Format        
+  UVal newValue;                           // the updated value requested by PUT /characteristic
+  uint64_t updateTime=0;                   // last time value was updated (in Utils::uptime() millis) either by PUT /characteristic OR by setVal()
+  int iid=0;                               // Instance ID (HAP Table 6-3)
+  const HapChar *hapChar;                  // pointer to HAP Characteristic structure (in flash)
+  const range_t *range=NULL;               // pointer to shared range descriptor
   char *desc=NULL;                         // Characteristic Description (optional)
   char *unit=NULL;                         // Characteristic Unit (optional)
-  UVal minValue;                           // Characteristic minimum (not applicable for STRING)
-  UVal maxValue;                           // Characteristic maximum (not applicable for STRING)
-  UVal stepValue;                          // Characteristic step size (not applicable for STRING)
-  boolean staticRange;                     // Flag that indicates whether Range is static and cannot be changed with setRange()
-  boolean customRange=false;               // Flag for custom ranges
-  char *validValues=NULL;                  // Optional JSON array of valid values.  Applicable only to uint8 Characteristics
-  boolean *ev;                             // Characteristic Event Notify Enable (per-connection)
+  int32_t *validValues=NULL;               // Optional array of valid values.  Applicable only to INT, UINT8, UINT16 and UINT32 Characteristics
   char *nvsKey=NULL;                       // key for NVS storage of Characteristic value
-  boolean isCustom;                        // flag to indicate this is a Custom Characteristic
-  boolean setRangeError=false;             // flag to indicate attempt to set Range on Characteristic that does not support changes to Range
-  boolean setValidValuesError=false;       // flag to indicate attempt to set Valid Values on Characteristic that does not support changes to Valid Values
-  
   uint32_t aid=0;                          // Accessory ID - passed through from Service containing this Characteristic
-  boolean isUpdated=false;                 // set to true when new value has been requested by PUT /characteristic
-  unsigned long updateTime=0;              // last time value was updated (in millis) either by PUT /characteristic OR by setVal()
-  UVal newValue;                           // the updated value requested by PUT /characteristic
+  uint32_t evBits=0;                       // Characteristic Event Notify Enable (one bit per connection)
   SpanService *service=NULL;               // pointer to Service containing this Characteristic
+  uint8_t perms;                           // Characteristic Permissions
+  FORMAT format:8;                         // Characteristic Format
+  uint8_t nValidValues=0;                  // number of entries in validValues
+  boolean customRange:1;                   // Flag for custom ranges
+  boolean isCustom:1;                      // flag to indicate this is a Custom Characteristic
+  boolean setRangeError:1;                 // flag to indicate attempt to set Range on Characteristic that does not support changes to Range
+  boolean setValidValuesError:1;           // flag to indicate attempt to set Valid Values on Characteristic that does not support changes to Valid Values
+  boolean isUpdated:1;                     // set to true when new value has been requested by PUT /characteristic
    
   int sprintfAttributes(char *cBuf, int flags);   // prints Characteristic JSON records into buf, according to flags mask; return number of characters printed, excluding null terminator  
+  int sprintfValidValues(char *cBuf);             // prints validValues as a JSON array into buf, unless buf=NULL; return number of characters printed, excluding null terminator
   StatusCode loadUpdate(char *val, char *ev);     // load updated val/ev from PUT /characteristic JSON request.  Return intitial HAP status code (checks to see if characteristic is found, is writable, etc.)  
+
+  boolean evEnabled(int conNum){return((evBits>>conNum)&1);}                            // returns Event Notify Enable for connection conNum
+  void setEv(int conNum, boolean on){if(on) evBits|=(1<<conNum); else evBits&=~(1<<conNum);}   // sets Event Notify Enable for connection conNum
     
-  String uvPrint(UVal &u){
+  String uvPrint(const UVal &u){
     char c[64];
     switch(format){
       case FORMAT::BOOL:
@@ -496,7 +564,7 @@ class SpanCharacteristic{
     return(String());       // included to prevent compiler warnings
   }
 
-  void uvSet(UVal &dest, UVal &src){
+  void uvSet(UVal &dest, const UVal &src){
     if(format==FORMAT::STRING || format==FORMAT::DATA)
       uvSet(dest,(const char *)src.STRING);
     else
@@ -537,7 +605,7 @@ class SpanCharacteristic{
     } // switch
   }
  
-  template <class T> T uvGet(UVal &u){
+  template <class T> T uvGet(const UVal &u){
   
     switch(format){   
       case FORMAT::BOOL:
@@ -572,7 +640,7 @@ class SpanCharacteristic{
     if(nvsStore){
       nvsKey=(char *)malloc(16);
       uint16_t t;
-      sscanf(type,"%hx",&t);
+      sscanf(hapChar->type,"%hx",&t);
       sprintf(nvsKey,"%04X%08X%03X",t,aid,iid&0xFFF);
       size_t len;    
 
@@ -599,17 +667,20 @@ class SpanCharacteristic{
   
     uvSet(newValue,value);
 
+    range_t r;
+
     if(format!=FORMAT::STRING && format!=FORMAT::DATA) {
-        uvSet(minValue,min);
-        uvSet(maxValue,max);
-        uvSet(stepValue,0);
+        uvSet(r.min,min);
+        uvSet(r.max,max);
     }
+
+    range=findRange(r);
           
   } // init()
 
   public:
 
-  SpanCharacteristic(HapChar *hapChar, boolean isCustom=false);           // constructor
+  SpanCharacteristic(const HapChar *hapChar, boolean isCustom=false);           // constructor
 
   template <class T=int> T getVal(){
     return(uvGet<T>(value));
@@ -636,7 +707,7 @@ class SpanCharacteristic{
   void setString(const char *val){
 
     if((perms & EV) == 0){
-      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setString() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapName);
+      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setString() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapChar->hapName);
       return;
     }
 
@@ -670,9 +741,9 @@ class SpanCharacteristic{
       return(olen);
       
     if(ret==MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL)
-      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Destination buffer is too small (%d out of %d bytes needed)\n\n",hapName,len,olen);
+      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Destination buffer is too small (%d out of %d bytes needed)\n\n",hapChar->hapName,len,olen);
     else if(ret==MBEDTLS_ERR_BASE64_INVALID_CHARACTER)
-      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Data is not in base-64 format\n\n",hapName);
+      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Data is not in base-64 format\n\n",hapChar->hapName);
       
     return(olen);
   }
@@ -688,9 +759,9 @@ class SpanCharacteristic{
       return(olen);
       
     if(ret==MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL)
-      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Destination buffer is too small (%d out of %d bytes needed)\n\n",hapName,len,olen);
+      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Destination buffer is too small (%d out of %d bytes needed)\n\n",hapChar->hapName,len,olen);
     else if(ret==MBEDTLS_ERR_BASE64_INVALID_CHARACTER)
-      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Data is not in base-64 format\n\n",hapName);
+      LOG0("\n*** WARNING:  Can't decode Characteristic::%s with getData().  Data is not in base-64 format\n\n",hapChar->hapName);
       
     return(olen);
   }  
@@ -698,12 +769,12 @@ class SpanCharacteristic{
   void setData(uint8_t *data, size_t len){
 
     if((perms & EV) == 0){
-      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setData() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapName);
+      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setData() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapChar->hapName);
       return;
     }
 
     if(len<1){
-      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setData() ignored.  Size of data buffer must be greater than zero\n\n",hapName);
+      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setData() ignored.  Size of data buffer must be greater than zero\n\n",hapChar->hapName);
       return;      
     }
 
@@ -717,13 +788,13 @@ class SpanCharacteristic{
   template <typename T> void setVal(T val, boolean notify=true){
 
     if((perms & EV) == 0){
-      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setVal() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapName);
+      LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setVal() ignored.  No NOTIFICATION permission on this characteristic\n\n",hapChar->hapName);
       return;
     }
 
-    if(val < uvGet<T>(minValue) || val > uvGet<T>(maxValue)){
+    if(val < uvGet<T>(range->min) || val > uvGet<T>(range->max)){
       LOG0("\n*** WARNING:  Attempt to update Characteristic::%s with setVal(%g) is out of range [%g,%g].  This may cause device to become non-reponsive!\n\n",
-      hapName,(double)val,uvGet<double>(minValue),uvGet<double>(maxValue));
+      hapChar->hapName,(double)val,uvGet<double>(range->min),uvGet<double>(range->max));
     }
    
     uvSet(value,val);
@@ -748,16 +819,18 @@ class SpanCharacteristic{
   } // setVal()
 
   boolean updated(){return(isUpdated);}             // returns isUpdated
-  unsigned long timeVal();                          // returns time elapsed (in millis) since value was last updated
+  unsigned long timeVal();                          // returns time elapsed (in millis) since value was last updated, saturating at ULONG_MAX
   
   SpanCharacteristic *setValidValues(int n, ...);   // sets a list of 'n' valid values allowed for a Characteristic and returns pointer to self.  Only applicable if format=INT, UINT8, UINT16, or UINT32
 
   template <typename A, typename B, typename S=int> SpanCharacteristic *setRange(A min, B max, S step=0){
 
-    if(!staticRange){
-      uvSet(minValue,min);
-      uvSet(maxValue,max);
-      uvSet(stepValue,step);  
+    if(!hapChar->staticRange){
+      range_t r;
+      uvSet(r.min,min);
+      uvSet(r.max,max);
+      uvSet(r.step,step);  
+      range=findRange(r);
       customRange=true; 
     } else
       setRangeError=true;
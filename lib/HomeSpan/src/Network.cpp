@@ -129,7 +129,7 @@ void Network::apConfigure(){
   dnsServer.start(DNS_PORT, "*", apIP);       // start DNS server that resolves every request to the address of this device
   apServer.begin();
 
-  alarmTimeOut=millis()+lifetime;            // Access Point will shut down when alarmTimeOut is reached
+  alarmTimeOut=Utils::uptime()+lifetime;     // Access Point will shut down when alarmTimeOut is reached
   apStatus=0;                                // status will be "timed out" unless changed
 
   LOG0("\nReady.\n");
@@ -143,7 +143,7 @@ void Network::apConfigure(){
       homeSpan.reboot();
     }
 
-    if(millis()>alarmTimeOut){
+    if(Utils::uptime()>alarmTimeOut){
       WiFi.softAPdisconnect(true);           // terminate connections and shut down captive access point
       delay(100);
       if(apStatus==1){
@@ -264,7 +264,7 @@ void Network::processRequest(char *body, char *formData){
 
     if(allowedCode(setupCode)){
       responseBody+="<p><b>Settings saved!</b></p><p>Restarting HomeSpan.</p><p>Closing window...</p>";
-      alarmTimeOut=millis()+2000;
+      alarmTimeOut=Utils::uptime()+2000;
       apStatus=1;
       
     } else {
@@ -276,7 +276,7 @@ void Network::processRequest(char *body, char *formData){
 
   if(!strncmp(body,"GET /cancel ",12)){                                   // GET CANCEL
     responseBody+="<p><b>Configuration Canceled!</b></p><p>Restarting HomeSpan.</p><p>Closing window...</p>";
-    alarmTimeOut=millis()+2000;
+    alarmTimeOut=Utils::uptime()+2000;
     apStatus=-1;
   } else
 
@@ -291,7 +291,7 @@ void Network::processRequest(char *body, char *formData){
       responseHead+="Refresh: " + String(waitTime) + "\r\n";     
       responseBody+="<p>Re-initiating connection to:</p><p><b>" + String(wifiData.ssid) + "</b></p>";
       responseBody+="<p>(waiting " + String(waitTime) + " seconds to check for response)</p>";
-      responseBody+="<p>Access Point termination in " + String((alarmTimeOut-millis())/1000) + " seconds.</p>";
+      responseBody+="<p>Access Point termination in " + String((uint32_t)((alarmTimeOut-Utils::uptime())/1000)) + " seconds.</p>";
       responseBody+="<center><button onclick=\"document.location='/hotspot-detect.html'\">Cancel</button></center>";
       WiFi.begin(wifiData.ssid,wifiData.pwd);
       
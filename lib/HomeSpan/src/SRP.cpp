@@ -73,6 +73,8 @@ SRP6A::SRP6A(){
   mbedtls_mpi_init(&t1);
   mbedtls_mpi_init(&t2);
   mbedtls_mpi_init(&t3);
+  mbedtls_mpi_init(&bNext);
+  mbedtls_mpi_init(&BNext);
 
   // load N and g into mpi structures
   
@@ -109,34 +111,133 @@ void SRP6A::createVerifyCode(const char *setupCode, uint8_t *verifyCode, uint8_t
   mbedtls_mpi_read_binary(&x,tHash,64);                          // load hash result into mpi structure x
 
   // compute v = g^x % N
+
+  if(keyMutex)
+    xSemaphoreTake(keyMutex,portMAX_DELAY);
   
   mbedtls_mpi_exp_mod(&v,&g,&x,&N,&_rr);                         // create verifier, v (_rr is an internal "helper" structure that mbedtls uses to speed up subsequent exponential calculations)
   mbedtls_mpi_write_binary(&v,verifyCode,384);                   // write v into verifyCode
+  keyReady=false;                                                // any pre-computed keys were based on the old verifier and can no longer be used
+  keyGen++;
+
+  if(keyMutex){
+    xSemaphoreGive(keyMutex);
+    xTaskNotifyGive(keyTaskHandle);                              // request new keys based on the new verifier
+  }
   
 }
 
 //////////////////////////////////////
 
 void SRP6A::loadVerifyCode(uint8_t *verifyCode, uint8_t *salt){
+
+  if(keyMutex)
+    xSemaphoreTake(keyMutex,portMAX_DELAY);
   
   mbedtls_mpi_read_binary(&s,salt,16);
   mbedtls_mpi_read_binary(&v,verifyCode,384);
+  keyReady=false;
+  keyGen++;
+
+  if(keyMutex){
+    xSemaphoreGive(keyMutex);
+    xTaskNotifyGive(keyTaskHandle);
+  }
 
 }
 
 //////////////////////////////////////
 
 void SRP6A::createPublicKey(){
+
+  boolean loaded=false;
+
+  if(keyMutex && xSemaphoreTake(keyMutex,0)==pdTRUE){   // never wait for keyTask() - if it is busy, just compute the keys below
+    if(keyReady){
+      mbedtls_mpi_swap(&b,&bNext);                      // use keys pre-computed by keyTask()
+      mbedtls_mpi_swap(&B,&BNext);
+      keyReady=false;
+      loaded=true;
+    }
+    xSemaphoreGive(keyMutex);
+  }
+
+  if(!loaded){
+    LOG2("(SRP keys not pre-computed)...");
     
-  getPrivateKey();           // create and load b (random 32 bytes)
+    getPrivateKey();           // create and load b (random 32 bytes)
+      
+    // compute B = kv + g^b %N
     
-  // compute B = kv + g^b %N
-  
-  mbedtls_mpi_mul_mpi(&t1,&k,&v);                     // t1 = k*v
-  mbedtls_mpi_exp_mod(&t2,&g,&b,&N,&_rr);             // t2 = g^b %N
-  mbedtls_mpi_add_mpi(&t3,&t1,&t2);                   // t3 = t1 + t2
-  mbedtls_mpi_mod_mpi(&B,&t3,&N);                     // B = t3 %N      = ACCESSORY PUBLIC KEY
+    mbedtls_mpi_mul_mpi(&t1,&k,&v);                     // t1 = k*v
+    mbedtls_mpi_exp_mod(&t2,&g,&b,&N,&_rr);             // t2 = g^b %N
+    mbedtls_mpi_add_mpi(&t3,&t1,&t2);                   // t3 = t1 + t2
+    mbedtls_mpi_mod_mpi(&B,&t3,&N);                     // B = t3 %N      = ACCESSORY PUBLIC KEY
+  }
+
+  precomputeKeys();            // start pre-computing a fresh set of keys in case this Pair-Setup fails and needs to be repeated
+
+}
 
+//////////////////////////////////////
+
+void SRP6A::precomputeKeys(){
+
+  if(!keyTaskHandle){
+    keyMutex=xSemaphoreCreateMutex();
+    xTaskCreateUniversal(keyTask,"srpKeyTask",4096,this,tskIDLE_PRIORITY,&keyTaskHandle,tskNO_AFFINITY);     // lowest priority - only runs when all other tasks are idle
+  }
+
+  xTaskNotifyGive(keyTaskHandle);
+}
+
+//////////////////////////////////////
+
+void SRP6A::keyTask(void *args){
+
+  SRP6A *srp=(SRP6A *)args;
+
+  mbedtls_mpi kv, gb, bk, Bk, rr;                     // keyTask() uses its own temporary structures (including its own _rr helper) so it never interferes with the HAP poll loop
+  uint8_t privateKey[32];
+  uint32_t gen;
+
+  mbedtls_mpi_init(&kv);
+  mbedtls_mpi_init(&gb);
+  mbedtls_mpi_init(&bk);
+  mbedtls_mpi_init(&Bk);
+  mbedtls_mpi_init(&rr);
+
+  for(;;){
+
+    ulTaskNotifyTake(pdTRUE,portMAX_DELAY);           // wait for a request to pre-compute keys
+
+    xSemaphoreTake(srp->keyMutex,portMAX_DELAY);
+    if(srp->keyReady){                                // keys are already available
+      xSemaphoreGive(srp->keyMutex);
+      continue;
+    }
+    mbedtls_mpi_mul_mpi(&kv,&srp->k,&srp->v);         // kv = k*v (fast - computed while holding the mutex since v may be changed by createVerifyCode() or loadVerifyCode())
+    gen=srp->keyGen;
+    xSemaphoreGive(srp->keyMutex);
+
+    unsigned long tStart=millis();
+
+    randombytes_buf(privateKey,32);                   // generate 32 random bytes for bNext
+    mbedtls_mpi_read_binary(&bk,privateKey,32);
+    mbedtls_mpi_exp_mod(&gb,&srp->g,&bk,&srp->N,&rr); // gb = g^bNext %N  (slow - computed without holding the mutex)
+    mbedtls_mpi_add_mpi(&kv,&kv,&gb);                 // kv = k*v + g^bNext
+    mbedtls_mpi_mod_mpi(&Bk,&kv,&srp->N);             // BNext = kv %N
+
+    xSemaphoreTake(srp->keyMutex,portMAX_DELAY);
+    if(gen==srp->keyGen){                             // only store keys if verifier has not changed in the meantime
+      mbedtls_mpi_swap(&srp->bNext,&bk);
+      mbedtls_mpi_swap(&srp->BNext,&Bk);
+      srp->keyReady=true;
+    }
+    xSemaphoreGive(srp->keyMutex);
+
+    LOG2("\n*** Pre-computed SRP keys for next Pair-Setup in %lu ms\n",millis()-tStart);
+  }
 }
 
 //////////////////////////////////////
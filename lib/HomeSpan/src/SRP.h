@@ -30,6 +30,8 @@
 #include <mbedtls/sha512.h>
 #include <mbedtls/bignum.h>
 #include <mbedtls/base64.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 
 #include "HAPConstants.h"
 
@@ -65,6 +67,14 @@ struct SRP6A {
 
   mbedtls_mpi _rr;        // _rr                          - temporary "helper" for large exponential modulus calculations
 
+  mbedtls_mpi bNext;      // bNext                        - private key pre-computed in background by keyTask() for use in the next Pair-Setup (32 bytes)
+  mbedtls_mpi BNext;      // BNext = k*v + g^bNext %N     - public key pre-computed in background by keyTask() for use in the next Pair-Setup (max 384 bytes)
+
+  SemaphoreHandle_t keyMutex=NULL;      // guards v, bNext, BNext, keyReady, and keyGen between the HAP poll loop and keyTask()
+  TaskHandle_t keyTaskHandle=NULL;      // handle for low-priority background task that pre-computes bNext and BNext
+  boolean keyReady=false;               // flag indicating bNext and BNext are ready to be used
+  uint32_t keyGen=0;                    // incremented whenever v changes so that keys pre-computed from a stale verifier are discarded
+
   char I[11]="Pair-Setup";  // I                          - userName pre-defined by HAP pairing setup protocol
   char g3072[2]="\x05";     // g                          - 3072-bit Group generator
 
@@ -78,7 +88,9 @@ struct SRP6A {
   void getSalt();                                  // generates and stores random 16-byte salt, s
   void getPrivateKey();                            // generates and stores random 32-byte private key, b
   void getSetupCode(char *c);                      // generates and displays random 8-digit Pair-Setup code, P, in format XXX-XX-XXX
-  void createPublicKey();                          // computes x, v, and B from random s, P, and b
+  void createPublicKey();                          // loads b and B from pre-computed bNext and BNext if ready, else computes B from v and random b
+  void precomputeKeys();                           // starts keyTask() if needed and requests it to pre-compute bNext and BNext in the background
+  static void keyTask(void *args);                 // low-priority background task that pre-computes bNext and BNext whenever requested
   void createSessionKey();                         // computes u from A and B, and then S from A, v, u, and b
   
   int loadTLV(kTLVType tag, mbedtls_mpi *mpi, int nBytes);     // load binary contents of mpi into a TLV record and set its length
@@ -84,6 +84,15 @@
 
 #define     DEFAULT_WEBLOG_URL        "status"            // change with optional fourth argument in homeSpan.enableWebLog()
 
+#define     DEFAULT_POLL_BUDGET       50                  // change with homeSpan.setPollBudget(ms)
+#define     DEFAULT_LOOP_INTERVAL     5                   // change with homeSpan.setLoopInterval(ms)
+#define     DEFAULT_POLL_INTERVAL     5                   // change with optional second argument in homeSpan.setPollCallback()
+#define     DEFAULT_MAX_POLL_WAIT     100                 // change with homeSpan.setMaxPollWait(ms)
+
+#ifndef     HS_MAX_ACCESSORIES
+#define     HS_MAX_ACCESSORIES        41                  // HAP allows 150 but the ESP32 runs out of memory first; host benchmarks build with -DHS_MAX_ACCESSORIES=150
+#endif
+
 /////////////////////////////////////////////////////
 //              OTA PARTITION INFO                 //
 
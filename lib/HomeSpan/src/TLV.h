@@ -312,3 +312,245 @@ int TLV<tagType, maxTags>::unpack(uint8_t *tlvBuf, int nBytes){
   clear();
   return(0);              // return fail
 }
+
+/////////////////////////////////////////////////
+// TLV8 View
+//
+// Zero-copy alternative to TLV::unpack().  Rather than copying each record
+// into its own pre-allocated buffer, parse() only indexes the records in place,
+// and buf() returns a pointer directly into the parsed buffer.  Records longer
+// than 255 bytes arrive as consecutive fragments with the same TAG; these are
+// stitched together in place (by shifting the fragments over their 2-byte
+// headers) only when buf() is first called for that TAG.  Note this means the
+// viewed buffer is modified and must remain valid while the view is in use.
+
+template <class tagType, int maxRecords>
+class TLV8View {
+
+  struct rec_t {
+    tagType tag;         // TAG
+    int len;             // total LENGTH across all fragments
+    uint8_t *val;        // pointer to start of VALUE of first fragment inside the viewed buffer
+    int nFrags;          // number of fragments still to be stitched together (1 once record is contiguous)
+  };
+
+  rec_t rec[maxRecords];        // array of indexed records
+  int numRecs=0;                // number of records indexed
+  rec_t *find(tagType tag);     // returns pointer to record with matching TAG (or NULL if no match)
+
+public:
+
+  int parse(uint8_t *tlvBuf, int nBytes);   // indexes nBytes of TLV content in tlvBuf without copying (return 1 on success, 0 if fail)
+  uint8_t *buf(tagType tag);                // returns pointer to VALUE for TLV with matching TAG, stitching fragments together in place if needed (or NULL if no match)
+  int len(tagType tag);                     // returns total LEN for TLV with matching TAG (or -1 if no match)
+  int val(tagType tag);                     // returns first byte of VALUE for TLV with matching TAG (or -1 if no match or LEN=0)
+  void print(int minLogLevel=0);            // prints all indexed TLVs, subject to specified minimum log level
+  
+}; // TLV8View
+
+//////////////////////////////////////
+// TLV8View find(tag)
+
+template<class tagType, int maxRecords>
+typename TLV8View<tagType, maxRecords>::rec_t *TLV8View<tagType, maxRecords>::find(tagType tag){
+
+  for(int i=0;i<numRecs;i++){
+    if(rec[i].tag==tag)
+      return(rec+i);
+  }
+  
+  return(NULL);
+}
+
+//////////////////////////////////////
+// TLV8View parse(tlvBuf, nBytes)
+
+template<class tagType, int maxRecords>
+int TLV8View<tagType, maxRecords>::parse(uint8_t *tlvBuf, int nBytes){
+
+  numRecs=0;
+  int lastLen=0;                                  // length of previous fragment
+
+  for(int i=0;i<nBytes;){
+
+    if(i+2>nBytes || i+2+tlvBuf[i+1]>nBytes){     // TAG/LEN header or VALUE extends past end of buffer
+      numRecs=0;
+      return(0);
+    }
+
+    tagType tag=(tagType)tlvBuf[i];
+    int tagLen=tlvBuf[i+1];
+
+    if(numRecs>0 && rec[numRecs-1].tag==tag && lastLen==255){     // continuation fragment of previous record
+      rec[numRecs-1].len+=tagLen;
+      rec[numRecs-1].nFrags++;
+    } else {
+      if(numRecs==maxRecords){
+        numRecs=0;
+        return(0);
+      }
+      rec[numRecs].tag=tag;
+      rec[numRecs].len=tagLen;
+      rec[numRecs].val=tlvBuf+i+2;
+      rec[numRecs].nFrags=1;
+      numRecs++;
+    }
+
+    lastLen=tagLen;
+    i+=2+tagLen;
+  }
+
+  return(1);
+}
+
+//////////////////////////////////////
+// TLV8View buf(tag)
+
+template<class tagType, int maxRecords>
+uint8_t *TLV8View<tagType, maxRecords>::buf(tagType tag){
+
+  rec_t *r=find(tag);
+
+  if(!r)
+    return(NULL);
+
+  if(r->nFrags>1){                                // stitch fragments together in place (only needed the first time)
+    uint8_t *dest=r->val+255;                     // end of first (full) fragment
+    uint8_t *src=dest+2;                          // VALUE of second fragment, just past its TAG/LEN header
+    int remaining=r->len-255;
+
+    while(remaining>0){
+      int fragLen=src[-1];
+      memmove(dest,src,fragLen);
+      dest+=fragLen;
+      src+=fragLen+2;
+      remaining-=fragLen;
+    }
+    
+    r->nFrags=1;
+  }
+  
+  return(r->val);
+}
+
+//////////////////////////////////////
+// TLV8View len(tag)
+
+template<class tagType, int maxRecords>
+int TLV8View<tagType, maxRecords>::len(tagType tag){
+
+  rec_t *r=find(tag);
+
+  return(r?r->len:-1);
+}
+
+//////////////////////////////////////
+// TLV8View val(tag)
+
+template<class tagType, int maxRecords>
+int TLV8View<tagType, maxRecords>::val(tagType tag){
+
+  rec_t *r=find(tag);
+
+  if(r && r->len>0)
+    return(r->val[0]);
+
+  return(-1);
+}
+
+//////////////////////////////////////
+// TLV8View print()
+
+template<class tagType, int maxRecords>
+void TLV8View<tagType, maxRecords>::print(int minLogLevel){
+
+  if(homeSpan.getLogLevel()<minLogLevel)
+    return;
+    
+  for(int i=0;i<numRecs;i++){
+    uint8_t *val=buf(rec[i].tag);
+    Serial.printf("TAG-%d(%d) ",rec[i].tag,rec[i].len);
+    
+    for(int j=0;j<rec[i].len;j++)
+      Serial.printf("%02X",val[j]);
+
+    Serial.printf("\n");
+  }
+}
+
+/////////////////////////////////////////////////
+// TLV8 Writer
+//
+// Serializes TLV records directly into a caller-supplied buffer, splitting
+// VALUES longer than 255 bytes into consecutive fragments as it goes.  Used to
+// build sub-TLVs in place, without first staging each record in a TLV buffer
+// and then packing all records into a separate buffer.
+
+template <class tagType>
+class TLV8Writer {
+
+  uint8_t *tlvBuf;              // buffer being written
+  int maxLen;                   // size of buffer
+  int n=0;                      // number of bytes written so far
+
+public:
+
+  TLV8Writer(uint8_t *tlvBuf, int maxLen) : tlvBuf{tlvBuf}, maxLen{maxLen} {}
+
+  static int size(int len){return(len+2*(len>0?(len+254)/255:1));}   // returns number of bytes needed to write a TLV record with a VALUE of 'len' bytes
+
+  uint8_t *add(tagType tag, int len);                 // appends TAG/LEN header for a VALUE of 'len'<=255 bytes and returns pointer to VALUE for caller to fill in (or NULL if no room)
+  int add(tagType tag, const uint8_t *val, int len);  // appends TLV record with VALUE copied from val, fragmenting as needed (return 1 on success, 0 if no room)
+  int add(tagType tag, uint8_t val);                  // appends single-byte TLV record (return 1 on success, 0 if no room)
+  int len(){return(n);}                               // returns number of bytes written
+
+}; // TLV8Writer
+
+//////////////////////////////////////
+// TLV8Writer add(tag, len)
+
+template<class tagType>
+uint8_t *TLV8Writer<tagType>::add(tagType tag, int len){
+
+  if(len>255 || n+2+len>maxLen)
+    return(NULL);
+
+  tlvBuf[n++]=tag;
+  tlvBuf[n++]=len;
+  n+=len;
+
+  return(tlvBuf+n-len);
+}
+
+//////////////////////////////////////
+// TLV8Writer add(tag, val, len)
+
+template<class tagType>
+int TLV8Writer<tagType>::add(tagType tag, const uint8_t *val, int len){
+
+  if(n+size(len)>maxLen)
+    return(0);
+
+  do {
+    int fragLen=len>255?255:len;
+    memcpy(add(tag,fragLen),val,fragLen);
+    val+=fragLen;
+    len-=fragLen;
+  } while(len>0);
+
+  return(1);
+}
+
+//////////////////////////////////////
+// TLV8Writer add(tag, val)
+
+template<class tagType>
+int TLV8Writer<tagType>::add(tagType tag, uint8_t val){
+
+  uint8_t *buf=add(tag,1);
+
+  if(buf)
+    *buf=val;
+    
+  return(buf!=NULL);
+}
@@ -28,12 +28,15 @@
 #include "Utils.h"
 #include "HomeSpan.h"
 
+#include <esp_timer.h>
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  Contains various generic utility functions and classes:
 //
 //  Utils::readSerial       - reads all characters from Serial port and saves only up to max specified
 //  Utils::mask             - masks a string with asterisks (good for displaying passwords)
+//  Utils::uptime           - 64-bit monotonic time since boot, in milliseconds
 //
 //  class PushButton        - tracks Single, Double, and Long Presses of a pushbutton that connects a specified pin to ground
 //
@@ -87,6 +90,13 @@ String Utils::mask(char *c, int n){
   return(s);  
 } // mask
 
+//////////////////////////////////////
+
+uint64_t Utils::uptime(){
+
+  return(esp_timer_get_time()/1000);           // esp_timer counts microseconds since boot in 64 bits, so it will not roll over for 292,000 years
+}
+
 ////////////////////////////////
 //         PushButton         //
 ////////////////////////////////
@@ -133,7 +143,7 @@ PushButton::PushButton(int pin, triggerType_t triggerType){
 
 boolean PushButton::triggered(uint16_t singleTime, uint16_t longTime, uint16_t doubleTime){
 
-  unsigned long cTime=millis();
+  uint64_t cTime=Utils::uptime();
 
   switch(status){
     
@@ -210,7 +220,7 @@ boolean PushButton::triggered(uint16_t singleTime, uint16_t longTime, uint16_t d
 
 boolean PushButton::toggled(uint16_t toggleTime){
 
-  unsigned long cTime=millis();
+  uint64_t cTime=Utils::uptime();
 
   switch(toggleStatus){
     
@@ -250,7 +260,7 @@ boolean PushButton::toggled(uint16_t toggleTime){
 
 boolean PushButton::primed(){
  
-  if(millis()>singleAlarm && status==1){
+  if(Utils::uptime()>singleAlarm && status==1){
     status=2;
     return(true);
   }
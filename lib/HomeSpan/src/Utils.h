@@ -34,6 +34,7 @@ namespace Utils {
 
 char *readSerial(char *c, int max);   // read serial port into 'c' until <newline>, but storing only first 'max' characters (the rest are discarded)
 String mask(char *c, int n);          // simply utility that creates a String from 'c' with all except the first and last 'n' characters replaced by '*'
+uint64_t uptime();                    // returns time since boot (in millis) as a 64-bit monotonic count that, unlike millis(), does not roll over after 49.7 days
   
 }
 
@@ -82,9 +83,9 @@ class PushButton{
   int status;
   int toggleStatus;
   boolean doubleCheck;
-  uint32_t singleAlarm;
-  uint32_t doubleAlarm;
-  uint32_t longAlarm;
+  uint64_t singleAlarm;
+  uint64_t doubleAlarm;
+  uint64_t longAlarm;
   
   static touch_value_t threshold;
   static const int calibCount=20;
@@ -0,0 +1,159 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <malloc.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Heap size reported to the firmware, what malloc() handed out is taken off it */
+#define NATIVE_HEAP_SIZE                        (1024UL * 1024UL * 1024UL)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Start of the host clock */
+static const std::chrono::steady_clock::time_point clockStart = std::chrono::steady_clock::now();
+
+/** @brief Offset added by nativeAdvanceClock(), in microseconds */
+static std::atomic<uint64_t> clockOffset(0U);
+
+/** @brief Generator behind random() and esp_random(), seeded for reproducible runs */
+static std::mt19937 generator(0x5EED);
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+HardwareSerial Serial;
+EspClass ESP;
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+int64_t esp_timer_get_time(void) {
+    auto elapsed = std::chrono::steady_clock::now() - clockStart;
+    return ((int64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + (int64_t)clockOffset.load());
+}
+
+void nativeAdvanceClock(const uint64_t ms) {
+    clockOffset += ms * 1000U;
+}
+
+unsigned long millis(void) {
+    return ((uint32_t)(esp_timer_get_time() / 1000));
+}
+
+unsigned long micros(void) {
+    return ((uint32_t)esp_timer_get_time());
+}
+
+void delay(const uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(const uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield(void) {
+    std::this_thread::yield();
+}
+
+void pinMode(const uint8_t pin, const uint8_t mode) {
+    (void)pin;
+    (void)mode;
+}
+
+int digitalRead(const uint8_t pin) {
+    (void)pin;
+    return (HIGH);
+}
+
+void digitalWrite(const uint8_t pin, const uint8_t value) {
+    (void)pin;
+    (void)value;
+}
+
+uint16_t analogRead(const uint8_t pin) {
+    (void)pin;
+    return (0U);
+}
+
+long random(const long max) {
+    return ((max > 0) ? (long)(generator() % (unsigned long)max) : 0);
+}
+
+long random(const long min, const long max) {
+    return ((max > min) ? min + random(max - min) : min);
+}
+
+void randomSeed(const unsigned long seed) {
+    generator.seed((uint32_t)seed);
+}
+
+uint32_t esp_random(void) {
+    return ((uint32_t)generator());
+}
+
+void esp_fill_random(void * buffer, size_t length) {
+    uint8_t * bytes = (uint8_t *)buffer;
+    for (size_t i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)generator();
+    }
+}
+
+void esp_restart(void) {
+    fflush(stdout);
+    exit(0);
+}
+
+size_t heap_caps_get_free_size(const uint32_t caps) {
+    (void)caps;
+    return (NATIVE_HEAP_SIZE - mallinfo2().uordblks);
+}
+
+void heap_caps_get_info(multi_heap_info_t * info, const uint32_t caps) {
+    struct mallinfo2 usage = mallinfo2();
+
+    *info = {};
+    info->total_free_bytes = heap_caps_get_free_size(caps);
+    info->total_allocated_bytes = usage.uordblks;
+    info->largest_free_block = info->total_free_bytes;
+    info->minimum_free_bytes = info->total_free_bytes;
+}
+
+esp_reset_reason_t esp_reset_reason(void) {
+    return (ESP_RST_POWERON);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+size_t HardwareSerial::write(const uint8_t * buffer, size_t size) {
+    return (fwrite(buffer, 1U, size, stdout));
+}
+
+int HardwareSerial::read(void) {
+    if (input.length() == 0U) {
+        return (-1);
+    }
+    int c = (uint8_t)input[0];
+    input = input.substring(1U);
+    return (c);
+}
+
+uint32_t EspClass::getFreeHeap(void) {
+    return ((uint32_t)std::min(heap_caps_get_free_size(MALLOC_CAP_DEFAULT), (size_t)UINT32_MAX));
+}
+
+void EspClass::restart(void) {
+    esp_restart();
+}
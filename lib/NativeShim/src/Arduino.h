@@ -0,0 +1,167 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <limits.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+
+/* Local files */
+#include "sdkconfig.h"
+#include "core_version.h"
+#include "WString.h"
+#include "Print.h"
+#include "IPAddress.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_sntp.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Normally set by the build, libraries test them before including Arduino.h */
+#ifndef ARDUINO
+#define ARDUINO                                 (10819)
+#endif
+#ifndef ARDUINO_ARCH_ESP32
+#define ARDUINO_ARCH_ESP32
+#endif
+#ifndef ESP32
+#define ESP32
+#endif
+#define ARDUINO_BOARD                           "native"
+
+#define LOW                                     (0x0)
+#define HIGH                                    (0x1)
+#define INPUT                                   (0x01)
+#define OUTPUT                                  (0x03)
+#define PULLUP                                  (0x04)
+#define INPUT_PULLUP                            (0x05)
+#define PULLDOWN                                (0x08)
+#define INPUT_PULLDOWN                          (0x09)
+
+#define LSBFIRST                                (0)
+#define MSBFIRST                                (1)
+
+/** @brief Fast pin access lands in the GPIO stand-in registers */
+#define digitalPinToPort(pin)                   (((pin) > 31) ? 1 : 0)
+#define digitalPinToBitMask(pin)                (1UL << ((pin) % 32))
+#define portOutputRegister(port)                ((volatile uint32_t *)((port) ? &GPIO.out1_w1ts.val : &GPIO.out_w1ts))
+#define portInputRegister(port)                 ((volatile uint32_t *)((port) ? &GPIO.out1_w1tc.val : &GPIO.out_w1tc))
+
+#define IRAM_ATTR
+#define PROGMEM
+#define F(str)                                  (str)
+
+#define bitRead(value, bit)                     (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)                      ((value) |= (1UL << (bit)))
+#define bitClear(value, bit)                    ((value) &= ~(1UL << (bit)))
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+using std::min;
+using std::max;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the serial port.
+ * @details
+ *  Output goes to stdout. Input is empty unless a test pushes characters
+ *  with inject(), e.g. to drive the HomeSpan command line.
+ */
+class HardwareSerial : public Stream {
+private:
+    /** @brief Characters pushed by inject() and not read yet */
+    String input;
+
+public:
+    void begin(const unsigned long baud) { (void)baud; }
+    void end(void) {}
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int available(void) override { return ((int)input.length()); }
+    int read(void) override;
+    int peek(void) override { return ((input.length() > 0U) ? (int)(uint8_t)input[0] : -1); }
+    void inject(const char * const text) { input += text; }
+    operator bool(void) const { return (true); }
+};
+
+/** @brief Host stand-in for the ESP object of the Arduino core */
+class EspClass {
+public:
+    void restart(void);
+    /** @brief Follows what malloc() handed out, so allocation deltas are real */
+    uint32_t getFreeHeap(void);
+    uint32_t getMinFreeHeap(void) { return (256U * 1024U); }
+    uint32_t getMaxAllocHeap(void) { return (110U * 1024U); }
+    uint32_t getFlashChipSize(void) { return (4U * 1024U * 1024U); }
+    const char * getChipModel(void) { return ("native"); }
+    uint8_t getChipRevision(void) { return (0U); }
+    uint8_t getChipCores(void) { return (2U); }
+    const char * getSdkVersion(void) { return ("native"); }
+};
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Milliseconds since start, 32 bits wide as on the ESP32 */
+unsigned long millis(void);
+unsigned long micros(void);
+
+/** @brief Sleep for real, the clock offset of nativeAdvanceClock() is kept */
+void delay(const uint32_t ms);
+void delayMicroseconds(const uint32_t us);
+void yield(void);
+
+/**
+ * @brief Move the host clock forward
+ * @details
+ *  millis(), micros(), esp_timer_get_time() and so Utils::uptime() jump by ms
+ *  without sleeping, so tests can cover hours of control passes, or wrap
+ *  points of 32-bit counters, in a few milliseconds.
+ */
+void nativeAdvanceClock(const uint64_t ms);
+
+/** @brief GPIO stand-ins, every input reads HIGH so pull-up buttons are released */
+void pinMode(const uint8_t pin, const uint8_t mode);
+int digitalRead(const uint8_t pin);
+void digitalWrite(const uint8_t pin, const uint8_t value);
+uint16_t analogRead(const uint8_t pin);
+
+/** @brief Peripheral clock HomeSpan sizes its PWM timers from */
+inline uint32_t getApbFrequency(void) { return (80000000U); }
+
+long random(const long max);
+long random(const long min, const long max);
+void randomSeed(const unsigned long seed);
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern HardwareSerial Serial;
+extern EspClass ESP;
+
+#endif /* ARDUINO_H */
@@ -0,0 +1,56 @@
+#ifndef ARDUINO_OTA_H
+#define ARDUINO_OTA_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <functional>
+
+/* Local files */
+#include "Arduino.h"
+#include "MD5Builder.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    OTA_AUTH_ERROR,
+    OTA_BEGIN_ERROR,
+    OTA_CONNECT_ERROR,
+    OTA_RECEIVE_ERROR,
+    OTA_END_ERROR
+} ota_error_t;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the Update object, nothing is ever flashed */
+class UpdateClass {
+public:
+    void abort(void) {}
+};
+
+/** @brief Host stand-in for ArduinoOTA, it never receives an image */
+class ArduinoOTAClass {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+    typedef std::function<void(uint32_t, uint32_t)> THandlerFunction_Progress;
+    typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+
+    ArduinoOTAClass & setHostname(const char * hostname) { (void)hostname; return (*this); }
+    ArduinoOTAClass & setPasswordHash(const char * hash) { (void)hash; return (*this); }
+    ArduinoOTAClass & onStart(THandlerFunction fn) { (void)fn; return (*this); }
+    ArduinoOTAClass & onEnd(THandlerFunction fn) { (void)fn; return (*this); }
+    ArduinoOTAClass & onProgress(THandlerFunction_Progress fn) { (void)fn; return (*this); }
+    ArduinoOTAClass & onError(THandlerFunction_Error fn) { (void)fn; return (*this); }
+    void begin(void) {}
+    void handle(void) {}
+};
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern UpdateClass Update;
+extern ArduinoOTAClass ArduinoOTA;
+
+#endif /* ARDUINO_OTA_H */
@@ -0,0 +1,26 @@
+#ifndef DNS_SERVER_H
+#define DNS_SERVER_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the captive portal DNS server, it answers nothing */
+class DNSServer {
+public:
+    bool start(const uint16_t port, const String & domain, const IPAddress & ip) {
+        (void)port;
+        (void)domain;
+        (void)ip;
+        return (true);
+    }
+    void processNextRequest(void) {}
+    void stop(void) {}
+};
+
+#endif /* DNS_SERVER_H */
@@ -0,0 +1,38 @@
+#ifndef ESP_MDNS_H
+#define ESP_MDNS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+#include "esp_err.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the mDNS responder, nothing is advertised */
+class MDNSResponder {
+public:
+    bool begin(const char * hostname) { (void)hostname; return (true); }
+    void end(void) {}
+    void setInstanceName(const char * name) { (void)name; }
+    bool addService(const char * service, const char * proto, const uint16_t port) {
+        (void)service;
+        (void)proto;
+        (void)port;
+        return (true);
+    }
+};
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t mdns_service_txt_item_set(const char * service, const char * proto, const char * key, const char * value);
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern MDNSResponder MDNS;
+
+#endif /* ESP_MDNS_H */
@@ -0,0 +1,120 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <strings.h>
+
+/* Local files */
+#include "HTTPClient.h"
+
+/************************************************
+ *  Private Method Implementation
+ ***********************************************/
+bool HTTPClient::readLine(String & line) {
+    unsigned long start = millis();
+    std::string text;
+
+    while ((millis() - start) < responseTimeout) {
+        int c = client.read();
+        if (c < 0) {
+            if (client.connected() == false) {
+                return (false);
+            }
+            delay(1);
+        } else if (c == '\n') {
+            if (!text.empty() && (text.back() == '\r')) {
+                text.pop_back();
+            }
+            line = String(text);
+            return (true);
+        } else {
+            text += (char)c;
+        }
+    }
+
+    return (false);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+bool HTTPClient::begin(const String & url) {
+    const char * text = url.c_str();
+    const char * prefix = "http://";
+
+    end();
+    if (strncmp(text, prefix, strlen(prefix)) != 0) {
+        return (false);
+    }
+    text += strlen(prefix);
+
+    const char * slash = strchr(text, '/');
+    std::string authority = (slash != NULL) ? std::string(text, slash - text) : std::string(text);
+    path = String((slash != NULL) ? slash : "/");
+
+    size_t colon = authority.find(':');
+    port = 80U;
+    if (colon != std::string::npos) {
+        port = (uint16_t)atoi(authority.c_str() + colon + 1U);
+        authority.resize(colon);
+    }
+    host = String(authority);
+
+    return (host.length() > 0U);
+}
+
+int HTTPClient::GET(void) {
+    String line;
+    int code;
+
+    size = -1;
+    if (client.connect(host.c_str(), port, connectTimeout) == 0) {
+        return (HTTPC_ERROR_CONNECTION_REFUSED);
+    }
+    client.setTimeout(responseTimeout);
+
+    String request = String("GET ") + path + (http10 ? " HTTP/1.0\r\n" : " HTTP/1.1\r\n") +
+                     "Host: " + host + "\r\nUser-Agent: ESP32HTTPClient\r\nConnection: close\r\n\r\n";
+    if (client.print(request) != request.length()) {
+        return (HTTPC_ERROR_SEND_HEADER_FAILED);
+    }
+
+    if (readLine(line) == false) {
+        return (client.connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST);
+    }
+    if ((sscanf(line.c_str(), "HTTP/%*d.%*d %d", &code) != 1) || (code <= 0)) {
+        return (HTTPC_ERROR_CONNECTION_LOST);
+    }
+
+    /* Headers end with an empty line */
+    while (true) {
+        if (readLine(line) == false) {
+            return (client.connected() ? HTTPC_ERROR_READ_TIMEOUT : HTTPC_ERROR_CONNECTION_LOST);
+        }
+        if (line.length() == 0U) {
+            break;
+        }
+        if (strncasecmp(line.c_str(), "Content-Length:", 15U) == 0) {
+            size = atoi(line.c_str() + 15U);
+        }
+    }
+
+    return (code);
+}
+
+String HTTPClient::getString(void) {
+    std::string body;
+    unsigned long start = millis();
+
+    while (((size < 0) || (body.size() < (size_t)size)) && ((millis() - start) < responseTimeout)) {
+        int c = client.read();
+        if (c >= 0) {
+            body += (char)c;
+        } else if (client.connected() == false) {
+            break;
+        } else {
+            delay(1);
+        }
+    }
+
+    return (String(body));
+}
@@ -0,0 +1,65 @@
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+#include "WiFiClient.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Error codes of the Arduino-ESP32 client, HTTP status codes are positive */
+#define HTTPC_ERROR_CONNECTION_REFUSED          (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED          (-2)
+#define HTTPC_ERROR_NOT_CONNECTED               (-4)
+#define HTTPC_ERROR_CONNECTION_LOST             (-5)
+#define HTTPC_ERROR_READ_TIMEOUT                (-11)
+
+#define HTTP_CODE_OK                            (200)
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the Arduino-ESP32 HTTP client, GET only.
+ * @details
+ *  The request always asks the server to close the connection, the body is
+ *  left on the stream for getStreamPtr() or read whole by getString().
+ */
+class HTTPClient {
+private:
+    WiFiClient client;
+    String host;
+    uint16_t port = 80U;
+    String path;
+    int32_t connectTimeout = 5000;
+    uint16_t responseTimeout = 5000U;
+    bool http10 = false;
+    /** @brief Content-Length of the last response, -1 when absent */
+    int size = -1;
+
+    /** @brief Read one header line without its CRLF, false on timeout or closed connection */
+    bool readLine(String & line);
+
+public:
+    ~HTTPClient() { end(); }
+
+    /** @brief Parse an http:// URL, nothing is sent before GET() */
+    bool begin(const String & url);
+    void end(void) { client.stop(); }
+    int GET(void);
+
+    void setConnectTimeout(const int32_t ms) { connectTimeout = ms; }
+    void setTimeout(const uint16_t ms) { responseTimeout = ms; }
+    void useHTTP10(const bool enable = true) { http10 = enable; }
+
+    int getSize(void) const { return (size); }
+    WiFiClient * getStreamPtr(void) { return (client.connected() ? &client : NULL); }
+    WiFiClient & getStream(void) { return (client); }
+    String getString(void);
+};
+
+#endif /* HTTP_CLIENT_H */
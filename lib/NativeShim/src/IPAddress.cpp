@@ -0,0 +1,42 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdio.h>
+
+/* Local files */
+#include "IPAddress.h"
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+IPAddress::IPAddress(const uint32_t address) {
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (uint8_t)(address >> (8 * i));
+    }
+}
+
+bool IPAddress::fromString(const char * const address) {
+    unsigned int a, b, c, d;
+    char extra;
+
+    if ((address == NULL) || (sscanf(address, "%u.%u.%u.%u%c", &a, &b, &c, &d, &extra) != 4) ||
+        (a > 255U) || (b > 255U) || (c > 255U) || (d > 255U)) {
+        return (false);
+    }
+    bytes[0] = (uint8_t)a;
+    bytes[1] = (uint8_t)b;
+    bytes[2] = (uint8_t)c;
+    bytes[3] = (uint8_t)d;
+
+    return (true);
+}
+
+String IPAddress::toString(void) const {
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return (String(buffer));
+}
+
+IPAddress::operator uint32_t(void) const {
+    return ((uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24));
+}
@@ -0,0 +1,38 @@
+#ifndef IP_ADDRESS_H
+#define IP_ADDRESS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/* Local files */
+#include "WString.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the Arduino IPv4 address, stored in network order like lwIP */
+class IPAddress {
+private:
+    /** @brief Address bytes, most significant first */
+    uint8_t bytes[4];
+
+public:
+    IPAddress() : bytes{0, 0, 0, 0} {}
+    IPAddress(const uint8_t a, const uint8_t b, const uint8_t c, const uint8_t d) : bytes{a, b, c, d} {}
+    IPAddress(const uint32_t address);
+
+    /** @brief Parse a dotted quad, the address is left untouched on failure */
+    bool fromString(const char * const address);
+    bool fromString(const String & address) { return (fromString(address.c_str())); }
+    String toString(void) const;
+
+    /** @brief Address as stored by lwIP, first byte in the lowest bits */
+    operator uint32_t(void) const;
+    uint8_t operator[](const int index) const { return (bytes[index]); }
+    bool operator==(const IPAddress & other) const { return ((uint32_t)*this == (uint32_t)other); }
+    bool operator!=(const IPAddress & other) const { return !(*this == other); }
+};
+
+#endif /* IP_ADDRESS_H */
@@ -0,0 +1,33 @@
+#ifndef MD5_BUILDER_H
+#define MD5_BUILDER_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the Arduino MD5 helper */
+class MD5Builder {
+private:
+    /** @brief OpenSSL digest context */
+    void * context = NULL;
+    uint8_t digest[16] = {};
+
+public:
+    ~MD5Builder();
+    void begin(void);
+    void add(const uint8_t * data, const size_t length);
+    void add(const char * data) { add((const uint8_t *)data, strlen(data)); }
+    void add(const String & data) { add(data.c_str()); }
+    void calculate(void);
+    void getBytes(uint8_t * output) const { memcpy(output, digest, sizeof(digest)); }
+    /** @brief Lowercase hex digest, output holds at least 33 characters */
+    void getChars(char * output) const;
+    String toString(void) const;
+};
+
+#endif /* MD5_BUILDER_H */
@@ -0,0 +1,74 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+size_t Print::write(const char * const str) {
+    return ((str != NULL) ? write((const uint8_t *)str, strlen(str)) : 0U);
+}
+
+size_t Print::printf(const char * format, ...) {
+    va_list args;
+    va_start(args, format);
+    size_t len = vprintf(format, args);
+    va_end(args);
+    return (len);
+}
+
+size_t Print::vprintf(const char * format, va_list args) {
+    va_list copy;
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (len <= 0) {
+        return (0U);
+    }
+
+    std::string buffer(len + 1, '\0');
+    vsnprintf(&buffer[0], buffer.size(), format, args);
+    return (write((const uint8_t *)buffer.data(), (size_t)len));
+}
+
+size_t Stream::readBytes(uint8_t * buffer, size_t length) {
+    size_t count = 0;
+    unsigned long start = millis();
+
+    while ((count < length) && ((millis() - start) < timeout)) {
+        int c = read();
+        if (c < 0) {
+            delay(1);
+            continue;
+        }
+        buffer[count++] = (uint8_t)c;
+    }
+
+    return (count);
+}
+
+String Stream::readString(void) {
+    std::string text;
+    unsigned long start = millis();
+
+    while ((millis() - start) < timeout) {
+        int c = read();
+        if (c < 0) {
+            if (available() < 0) {
+                break;
+            }
+            delay(1);
+            continue;
+        }
+        text += (char)c;
+        start = millis();
+    }
+
+    return (String(text));
+}
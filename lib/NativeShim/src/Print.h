@@ -0,0 +1,73 @@
+#ifndef PRINT_H
+#define PRINT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+
+/* Local files */
+#include "WString.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define DEC                                     (10)
+#define HEX                                     (16)
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the Arduino Print and Stream classes.
+ * @details
+ *  Every print flavour ends up in write(buffer, size), the only method a
+ *  derived class has to provide.
+ */
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(const uint8_t * buffer, size_t size) = 0;
+    virtual size_t write(uint8_t c) { return (write(&c, 1U)); }
+    virtual void flush(void) {}
+
+    size_t write(const char * const str);
+    size_t printf(const char * format, ...) __attribute__((format(printf, 2, 3)));
+    size_t vprintf(const char * format, va_list args);
+
+    size_t print(const String & str) { return (write((const uint8_t *)str.c_str(), str.length())); }
+    size_t print(const char * const str) { return (write(str)); }
+    size_t print(const char c) { return (write((uint8_t)c)); }
+    size_t print(const int value, const int base = DEC) { return (print(String((long)value, (unsigned char)base))); }
+    size_t print(const unsigned int value, const int base = DEC) { return (print(String((unsigned long)value, (unsigned char)base))); }
+    size_t print(const long value, const int base = DEC) { return (print(String(value, (unsigned char)base))); }
+    size_t print(const unsigned long value, const int base = DEC) { return (print(String(value, (unsigned char)base))); }
+    size_t print(const long long value, const int base = DEC) { return (print(String(value, (unsigned char)base))); }
+    size_t print(const unsigned long long value, const int base = DEC) { return (print(String(value, (unsigned char)base))); }
+    size_t print(const double value, const int decimals = 2) { return (print(String(value, (unsigned int)decimals))); }
+
+    size_t println(void) { return (write("\r\n")); }
+    template <typename T> size_t println(const T & value) { return (print(value) + println()); }
+    template <typename T> size_t println(const T & value, const int format) { return (print(value, format) + println()); }
+};
+
+class Stream : public Print {
+protected:
+    /** @brief Time in ms readBytes() waits for data */
+    unsigned long timeout = 1000UL;
+
+public:
+    virtual int available(void) = 0;
+    virtual int read(void) = 0;
+    virtual int peek(void) { return (-1); }
+
+    void setTimeout(const unsigned long ms) { timeout = ms; }
+    size_t readBytes(uint8_t * buffer, size_t length);
+    size_t readBytes(char * buffer, size_t length) { return (readBytes((uint8_t *)buffer, length)); }
+    String readString(void);
+};
+
+#endif /* PRINT_H */
@@ -0,0 +1,54 @@
+#ifndef SPI_H
+#define SPI_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define SPI_LSBFIRST                            (0)
+#define SPI_MSBFIRST                            (1)
+#define SPI_MODE0                               (0)
+#define SPI_MODE1                               (1)
+#define SPI_MODE2                               (2)
+#define SPI_MODE3                               (3)
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+class SPISettings {
+public:
+    SPISettings(const uint32_t clock = 1000000U, const uint8_t bitOrder = SPI_MSBFIRST, const uint8_t dataMode = SPI_MODE0) {
+        (void)clock;
+        (void)bitOrder;
+        (void)dataMode;
+    }
+};
+
+/** @brief Host stand-in for the SPI bus, nothing is wired to it and reads return 0xFF */
+class SPIClass {
+public:
+    void begin(void) {}
+    void end(void) {}
+    void beginTransaction(const SPISettings settings) { (void)settings; }
+    void endTransaction(void) {}
+    uint8_t transfer(const uint8_t data) { (void)data; return (0xFFU); }
+    void transfer(uint8_t * data, const uint32_t size) { memset(data, 0xFF, size); }
+    void transferBytes(const uint8_t * data, uint8_t * out, const uint32_t size) {
+        (void)data;
+        if (out != NULL) {
+            memset(out, 0xFF, size);
+        }
+    }
+};
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern SPIClass SPI;
+
+#endif /* SPI_H */
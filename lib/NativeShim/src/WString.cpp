@@ -0,0 +1,67 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <ctype.h>
+#include <stdio.h>
+#include <algorithm>
+
+/* Local files */
+#include "WString.h"
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void String::toUpperCase(void) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return ((char)toupper(c)); });
+}
+
+void String::toLowerCase(void) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return ((char)tolower(c)); });
+}
+
+void String::trim(void) {
+    size_t first = text.find_first_not_of(" \t\r\n");
+    size_t last = text.find_last_not_of(" \t\r\n");
+    text = (first == std::string::npos) ? std::string() : text.substr(first, last - first + 1);
+}
+
+void String::replace(const String & find, const String & with) {
+    if (find.text.empty()) {
+        return;
+    }
+    for (size_t pos = text.find(find.text); pos != std::string::npos; pos = text.find(find.text, pos + with.text.length())) {
+        text.replace(pos, find.text.length(), with.text);
+    }
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+std::string String::format(const long long value, const unsigned char base) {
+    if (value < 0) {
+        return ("-" + format((unsigned long long)(-value), base));
+    }
+    return (format((unsigned long long)value, base));
+}
+
+std::string String::format(const unsigned long long value, const unsigned char base) {
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    std::string out;
+    unsigned long long rest = value;
+
+    if ((base < 2) || (base > 36)) {
+        return (out);
+    }
+    do {
+        out.insert(out.begin(), digits[rest % base]);
+        rest /= base;
+    } while (rest > 0);
+
+    return (out);
+}
+
+std::string String::format(const double value, const unsigned int decimals) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, value);
+    return (std::string(buffer));
+}
@@ -0,0 +1,93 @@
+#ifndef WSTRING_H
+#define WSTRING_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the Arduino String class.
+ * @details
+ *  Backed by std::string, with the constructors, operators and methods
+ *  used by the bridge and HomeSpan.
+ */
+class String {
+private:
+    /** @brief Characters */
+    std::string text;
+
+public:
+    String(const char * const cstr = "") : text((cstr != NULL) ? cstr : "") {}
+    String(const std::string & str) : text(str) {}
+    explicit String(const char c) : text(1, c) {}
+    explicit String(const int value, const unsigned char base = 10) : text(format((long long)value, base)) {}
+    explicit String(const unsigned int value, const unsigned char base = 10) : text(format((unsigned long long)value, base)) {}
+    explicit String(const long value, const unsigned char base = 10) : text(format((long long)value, base)) {}
+    explicit String(const unsigned long value, const unsigned char base = 10) : text(format((unsigned long long)value, base)) {}
+    explicit String(const long long value, const unsigned char base = 10) : text(format(value, base)) {}
+    explicit String(const unsigned long long value, const unsigned char base = 10) : text(format(value, base)) {}
+    explicit String(const float value, const unsigned int decimals = 2) : text(format((double)value, decimals)) {}
+    explicit String(const double value, const unsigned int decimals = 2) : text(format(value, decimals)) {}
+
+    const char * c_str(void) const { return (text.c_str()); }
+    unsigned int length(void) const { return ((unsigned int)text.length()); }
+    void reserve(const unsigned int size) { text.reserve(size); }
+    char charAt(const unsigned int index) const { return ((index < text.length()) ? text[index] : 0); }
+    char operator[](const unsigned int index) const { return (charAt(index)); }
+    bool startsWith(const String & prefix) const { return (text.compare(0, prefix.text.length(), prefix.text) == 0); }
+    bool endsWith(const String & suffix) const {
+        return ((text.length() >= suffix.text.length()) &&
+                (text.compare(text.length() - suffix.text.length(), suffix.text.length(), suffix.text) == 0));
+    }
+    int indexOf(const char c, const unsigned int from = 0) const { return (position(text.find(c, from))); }
+    int indexOf(const String & str, const unsigned int from = 0) const { return (position(text.find(str.text, from))); }
+    String substring(const unsigned int from) const { return ((from < text.length()) ? String(text.substr(from)) : String()); }
+    String substring(const unsigned int from, const unsigned int to) const {
+        return ((from < text.length()) && (from < to)) ? String(text.substr(from, to - from)) : String();
+    }
+    long toInt(void) const { return (strtol(text.c_str(), NULL, 10)); }
+    float toFloat(void) const { return (strtof(text.c_str(), NULL)); }
+    void toUpperCase(void);
+    void toLowerCase(void);
+    void trim(void);
+    void replace(const String & find, const String & with);
+
+    bool concat(const String & str) { text += str.text; return (true); }
+    String & operator+=(const String & str) { text += str.text; return (*this); }
+    String & operator+=(const char * const cstr) { text += (cstr != NULL) ? cstr : ""; return (*this); }
+    String & operator+=(const char c) { text += c; return (*this); }
+    String & operator+=(const int value) { text += format((long long)value, 10); return (*this); }
+    String & operator+=(const unsigned int value) { text += format((unsigned long long)value, 10); return (*this); }
+    String & operator+=(const long value) { text += format((long long)value, 10); return (*this); }
+    String & operator+=(const unsigned long value) { text += format((unsigned long long)value, 10); return (*this); }
+
+    bool operator==(const String & other) const { return (text == other.text); }
+    bool operator==(const char * const cstr) const { return (text == ((cstr != NULL) ? cstr : "")); }
+    bool operator!=(const String & other) const { return (text != other.text); }
+    bool operator!=(const char * const cstr) const { return !(*this == cstr); }
+    bool operator<(const String & other) const { return (text < other.text); }
+    bool equals(const String & other) const { return (text == other.text); }
+
+    friend String operator+(const String & lhs, const String & rhs) { return (String(lhs.text + rhs.text)); }
+    friend String operator+(const String & lhs, const char * const rhs) { return (String(lhs.text + ((rhs != NULL) ? rhs : ""))); }
+    friend String operator+(const char * const lhs, const String & rhs) { return (String(std::string((lhs != NULL) ? lhs : "") + rhs.text)); }
+    friend String operator+(const String & lhs, const char rhs) { return (String(lhs.text + rhs)); }
+    friend String operator+(const String & lhs, const int rhs) { return (String(lhs.text + format((long long)rhs, 10))); }
+    friend String operator+(const String & lhs, const unsigned int rhs) { return (String(lhs.text + format((unsigned long long)rhs, 10))); }
+    friend String operator+(const String & lhs, const long rhs) { return (String(lhs.text + format((long long)rhs, 10))); }
+    friend String operator+(const String & lhs, const unsigned long rhs) { return (String(lhs.text + format((unsigned long long)rhs, 10))); }
+
+private:
+    static int position(const size_t pos) { return ((pos == std::string::npos) ? -1 : (int)pos); }
+    static std::string format(const long long value, const unsigned char base);
+    static std::string format(const unsigned long long value, const unsigned char base);
+    static std::string format(const double value, const unsigned int decimals);
+};
+
+#endif /* WSTRING_H */
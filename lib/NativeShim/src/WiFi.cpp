@@ -0,0 +1,120 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "WiFi.h"
+#include "esp_now.h"
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Radio channel, only reported back */
+static uint8_t wifiChannel = 1U;
+static wifi_config_t apConfig = {};
+static esp_now_recv_cb_t espNowReceive = NULL;
+static esp_now_send_cb_t espNowSent = NULL;
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+WiFiClass WiFi;
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+wl_status_t WiFiClass::begin(const char * ssid, const char * password) {
+    (void)ssid;
+    (void)password;
+    if (wifiMode == WIFI_OFF) {
+        wifiMode = WIFI_STA;
+    }
+    wifiStatus = WL_CONNECTED;
+    return (wifiStatus);
+}
+
+bool WiFiClass::disconnect(const bool wifiOff) {
+    wifiStatus = WL_DISCONNECTED;
+    if (wifiOff == true) {
+        wifiMode = WIFI_OFF;
+    }
+    return (true);
+}
+
+bool WiFiClass::softAP(const char * ssid, const char * password) {
+    (void)ssid;
+    (void)password;
+    wifiMode = (wifiMode == WIFI_STA) ? WIFI_AP_STA : WIFI_AP;
+    return (true);
+}
+
+bool WiFiClass::softAPdisconnect(const bool wifiOff) {
+    (void)wifiOff;
+    wifiMode = (wifiMode == WIFI_AP_STA) ? WIFI_STA : WIFI_OFF;
+    return (true);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+esp_err_t esp_wifi_get_channel(uint8_t * primary, wifi_second_chan_t * second) {
+    *primary = wifiChannel;
+    *second = WIFI_SECOND_CHAN_NONE;
+    return (ESP_OK);
+}
+
+esp_err_t esp_wifi_set_channel(const uint8_t primary, const wifi_second_chan_t second) {
+    (void)second;
+    wifiChannel = primary;
+    return (ESP_OK);
+}
+
+esp_err_t esp_wifi_get_config(const wifi_interface_t interface, wifi_config_t * config) {
+    (void)interface;
+    *config = apConfig;
+    return (ESP_OK);
+}
+
+esp_err_t esp_wifi_set_config(const wifi_interface_t interface, wifi_config_t * config) {
+    (void)interface;
+    apConfig = *config;
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_init(void) {
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_set_pmk(const uint8_t * pmk) {
+    (void)pmk;
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t * peer) {
+    (void)peer;
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback) {
+    espNowReceive = callback;
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback) {
+    espNowSent = callback;
+    return (ESP_OK);
+}
+
+esp_err_t esp_now_send(const uint8_t * mac, const uint8_t * data, size_t len) {
+    (void)data;
+    (void)len;
+    if (espNowSent != NULL) {
+        espNowSent(mac, ESP_NOW_SEND_SUCCESS);
+    }
+    return (ESP_OK);
+}
+
+void nativeEspNowReceive(const uint8_t * mac, const uint8_t * data, const int len) {
+    if (espNowReceive != NULL) {
+        espNowReceive(mac, data, len);
+    }
+}
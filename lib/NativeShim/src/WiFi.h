@@ -0,0 +1,70 @@
+#ifndef WIFI_H
+#define WIFI_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Arduino.h"
+#include "esp_wifi.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+#include "WiFiUdp.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED
+} wl_status_t;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the WiFi object of the Arduino core.
+ * @details
+ *  begin() connects at once and the station address is the loopback one,
+ *  so the bridge reaches relays and clients served on 127.0.0.1.
+ */
+class WiFiClass {
+private:
+    wifi_mode_t wifiMode = WIFI_OFF;
+    wl_status_t wifiStatus = WL_DISCONNECTED;
+
+public:
+    wl_status_t begin(const char * ssid, const char * password = NULL);
+    bool disconnect(const bool wifiOff = false);
+    wl_status_t status(void) const { return (wifiStatus); }
+    bool mode(const wifi_mode_t mode) { wifiMode = mode; return (true); }
+    wifi_mode_t getMode(void) const { return (wifiMode); }
+    bool setAutoReconnect(const bool autoReconnect) { (void)autoReconnect; return (true); }
+    bool setHostname(const char * hostname) { (void)hostname; return (true); }
+
+    IPAddress localIP(void) const { return (IPAddress(127, 0, 0, 1)); }
+    IPAddress gatewayIP(void) const { return (IPAddress(127, 0, 0, 1)); }
+    String macAddress(void) const { return (String("02:00:00:00:00:01")); }
+    String softAPmacAddress(void) const { return (String("02:00:00:00:00:02")); }
+    int8_t RSSI(void) const { return (-50); }
+
+    /** @brief The host sees no networks */
+    int16_t scanNetworks(void) { return (0); }
+    String SSID(const uint8_t index) const { (void)index; return (String()); }
+    String SSID(void) const { return (String("native")); }
+
+    bool softAP(const char * ssid, const char * password = NULL);
+    bool softAPdisconnect(const bool wifiOff = false);
+};
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern WiFiClass WiFi;
+
+#endif /* WIFI_H */
@@ -0,0 +1,206 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <netdb.h>
+#include <poll.h>
+
+/* Local files */
+#include "WiFiClient.h"
+#include "lwip/sockets.h"
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Close the socket once the last copy of the client drops it */
+static std::shared_ptr<int> share(const int fd) {
+    return (std::shared_ptr<int>(new int(fd), [](int * fd) {
+        if (*fd >= 0) {
+            close(*fd);
+        }
+        delete fd;
+    }));
+}
+
+static IPAddress toIPAddress(const struct sockaddr_in & address) {
+    return (IPAddress((uint32_t)address.sin_addr.s_addr));
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+WiFiClient::WiFiClient(const int fd) {
+    if (fd >= 0) {
+        socket = share(fd);
+    }
+}
+
+int WiFiClient::connect(const IPAddress ip, const uint16_t port, const int32_t timeout) {
+    struct sockaddr_in address = {};
+    struct pollfd pending = {};
+    int error = 0;
+    socklen_t len = sizeof(error);
+
+    stop();
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return (0);
+    }
+
+    /* Connect without blocking, to bound the time with the timeout */
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = (uint32_t)ip;
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    if ((::connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) && (errno != EINPROGRESS)) {
+        close(fd);
+        return (0);
+    }
+
+    pending.fd = fd;
+    pending.events = POLLOUT;
+    if ((poll(&pending, 1, timeout) <= 0) || (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) < 0) || (error != 0)) {
+        close(fd);
+        return (0);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) & ~O_NONBLOCK);
+    socket = share(fd);
+
+    return (1);
+}
+
+int WiFiClient::connect(const char * const host, const uint16_t port, const int32_t timeout) {
+    IPAddress ip;
+    struct addrinfo hints = {};
+    struct addrinfo * result = NULL;
+
+    if (ip.fromString(host) == false) {
+        hints.ai_family = AF_INET;
+        if ((getaddrinfo(host, NULL, &hints, &result) != 0) || (result == NULL)) {
+            return (0);
+        }
+        ip = toIPAddress(*(struct sockaddr_in *)result->ai_addr);
+        freeaddrinfo(result);
+    }
+
+    return (connect(ip, port, timeout));
+}
+
+void WiFiClient::stop(void) {
+    if (socket != nullptr) {
+        /* Every copy sees the socket closed */
+        if (*socket >= 0) {
+            close(*socket);
+        }
+        *socket = -1;
+    }
+    socket = nullptr;
+}
+
+uint8_t WiFiClient::connected(void) {
+    uint8_t c;
+
+    if (fd() < 0) {
+        return (0U);
+    }
+
+    /* Data left to read counts as connected, as with the ESP32 core */
+    ssize_t n = recv(fd(), &c, 1U, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0) {
+        return (1U);
+    }
+
+    return (((n < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK))) ? 1U : 0U);
+}
+
+size_t WiFiClient::write(const uint8_t * buffer, size_t size) {
+    size_t sent = 0;
+    struct pollfd pending = {};
+
+    pending.fd = fd();
+    pending.events = POLLOUT;
+    while ((fd() >= 0) && (sent < size)) {
+        if (poll(&pending, 1, (int)timeout) <= 0) {
+            break;
+        }
+        ssize_t n = send(fd(), buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            break;
+        }
+        sent += (size_t)n;
+    }
+
+    return (sent);
+}
+
+int WiFiClient::available(void) {
+    int count = 0;
+
+    if ((fd() < 0) || (ioctl(fd(), FIONREAD, &count) < 0)) {
+        return (0);
+    }
+
+    return (count);
+}
+
+int WiFiClient::read(void) {
+    uint8_t c;
+    return ((read(&c, 1U) == 1) ? (int)c : -1);
+}
+
+int WiFiClient::read(uint8_t * buffer, size_t size) {
+    if (fd() < 0) {
+        return (-1);
+    }
+
+    ssize_t n = recv(fd(), buffer, size, MSG_DONTWAIT);
+
+    return ((n > 0) ? (int)n : -1);
+}
+
+int WiFiClient::peek(void) {
+    uint8_t c;
+
+    if (fd() < 0) {
+        return (-1);
+    }
+
+    return ((recv(fd(), &c, 1U, MSG_PEEK | MSG_DONTWAIT) == 1) ? (int)c : -1);
+}
+
+IPAddress WiFiClient::remoteIP(void) const {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    if ((fd() < 0) || (getpeername(fd(), (struct sockaddr *)&address, &len) < 0)) {
+        return (IPAddress());
+    }
+
+    return (toIPAddress(address));
+}
+
+uint16_t WiFiClient::remotePort(void) const {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    if ((fd() < 0) || (getpeername(fd(), (struct sockaddr *)&address, &len) < 0)) {
+        return (0U);
+    }
+
+    return (ntohs(address.sin_port));
+}
+
+IPAddress WiFiClient::localIP(void) const {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    if ((fd() < 0) || (getsockname(fd(), (struct sockaddr *)&address, &len) < 0)) {
+        return (IPAddress());
+    }
+
+    return (toIPAddress(address));
+}
+
+int WiFiClient::setNoDelay(const bool noDelay) {
+    int enable = noDelay ? 1 : 0;
+    return (setsockopt(fd(), IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)));
+}
@@ -0,0 +1,53 @@
+#ifndef WIFI_CLIENT_H
+#define WIFI_CLIENT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <memory>
+
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Host stand-in for the Arduino-ESP32 TCP client.
+ * @details
+ *  Copies share the socket, which is closed by stop() or when the last copy
+ *  goes away, as with the ESP32 core. Like there, connected() turns false
+ *  once the peer closed the connection and no data is left, but the socket
+ *  stays open, and fd() valid, until stop().
+ */
+class WiFiClient : public Stream {
+private:
+    /** @brief Socket shared by the copies of the client */
+    std::shared_ptr<int> socket;
+
+public:
+    WiFiClient() {}
+    /** @note Implicit like in the ESP32 core, HomeSpan resets clients with client=0 */
+    WiFiClient(const int fd);
+
+    int connect(const IPAddress ip, const uint16_t port, const int32_t timeout = 3000);
+    int connect(const char * const host, const uint16_t port, const int32_t timeout = 3000);
+    void stop(void);
+    uint8_t connected(void);
+    operator bool(void) { return (connected() != 0U); }
+
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int available(void) override;
+    int read(void) override;
+    int read(uint8_t * buffer, size_t size);
+    int peek(void) override;
+
+    int fd(void) const { return ((socket != nullptr) ? *socket : -1); }
+    IPAddress remoteIP(void) const;
+    uint16_t remotePort(void) const;
+    IPAddress localIP(void) const;
+    int setNoDelay(const bool noDelay);
+};
+
+#endif /* WIFI_CLIENT_H */
@@ -0,0 +1,58 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "WiFiServer.h"
+#include "lwip/sockets.h"
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void WiFiServer::begin(void) {
+    struct sockaddr_in address = {};
+    int enable = 1;
+
+    end();
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return;
+    }
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if ((bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0) || (listen(listener, 4) < 0)) {
+        end();
+        return;
+    }
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL, 0) | O_NONBLOCK);
+}
+
+void WiFiServer::end(void) {
+    if (listener >= 0) {
+        close(listener);
+    }
+    listener = -1;
+}
+
+WiFiClient WiFiServer::available(void) {
+    int fd;
+
+    if ((listener < 0) || ((fd = ::accept(listener, NULL, NULL)) < 0)) {
+        return (WiFiClient());
+    }
+
+    return (WiFiClient(fd));
+}
+
+uint16_t WiFiServer::localPort(void) const {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    if ((listener < 0) || (getsockname(listener, (struct sockaddr *)&address, &len) < 0)) {
+        return (0U);
+    }
+
+    return (ntohs(address.sin_port));
+}
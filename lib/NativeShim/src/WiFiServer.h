@@ -0,0 +1,35 @@
+#ifndef WIFI_SERVER_H
+#define WIFI_SERVER_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "WiFiClient.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the Arduino-ESP32 TCP server, accepting without blocking */
+class WiFiServer {
+private:
+    /** @brief Port to listen on, 0 picks a free one */
+    uint16_t port;
+    /** @brief Listening socket, -1 until begin() */
+    int listener;
+
+public:
+    explicit WiFiServer(const uint16_t port = 80) : port(port), listener(-1) {}
+    ~WiFiServer() { end(); }
+
+    void begin(void);
+    void end(void);
+    /** @brief Next pending connection, an empty client when there is none */
+    WiFiClient available(void);
+    WiFiClient accept(void) { return (available()); }
+    /** @brief Listening port, the one picked by the system when constructed with 0 */
+    uint16_t localPort(void) const;
+    operator bool(void) const { return (listener >= 0); }
+};
+
+#endif /* WIFI_SERVER_H */
@@ -0,0 +1,111 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "WiFiUdp.h"
+#include "lwip/sockets.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Largest datagram kept by parsePacket() */
+#define UDP_MAX_PACKET                          (1460U)
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+uint8_t WiFiUDP::begin(const uint16_t port) {
+    struct sockaddr_in address = {};
+    int enable = 1;
+
+    stop();
+    udpSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (udpSocket < 0) {
+        return (0U);
+    }
+    setsockopt(udpSocket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(udpSocket, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        stop();
+        return (0U);
+    }
+
+    return (1U);
+}
+
+void WiFiUDP::stop(void) {
+    if (udpSocket >= 0) {
+        close(udpSocket);
+    }
+    udpSocket = -1;
+    txBuffer.clear();
+    rxBuffer.clear();
+    rxPosition = 0U;
+}
+
+int WiFiUDP::beginPacket(const IPAddress ip, const uint16_t port) {
+    txAddress = ip;
+    txPort = port;
+    txBuffer.clear();
+    return (1);
+}
+
+int WiFiUDP::beginPacket(const char * const host, const uint16_t port) {
+    IPAddress ip;
+    return ((ip.fromString(host) == true) ? beginPacket(ip, port) : 0);
+}
+
+size_t WiFiUDP::write(const uint8_t * buffer, size_t size) {
+    txBuffer.insert(txBuffer.end(), buffer, buffer + size);
+    return (size);
+}
+
+int WiFiUDP::endPacket(void) {
+    struct sockaddr_in address = {};
+
+    if (udpSocket < 0) {
+        return (0);
+    }
+    address.sin_family = AF_INET;
+    address.sin_port = htons(txPort);
+    address.sin_addr.s_addr = (uint32_t)txAddress;
+    ssize_t n = sendto(udpSocket, txBuffer.data(), txBuffer.size(), 0, (struct sockaddr *)&address, sizeof(address));
+    txBuffer.clear();
+
+    return ((n >= 0) ? 1 : 0);
+}
+
+int WiFiUDP::parsePacket(void) {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    rxBuffer.assign(UDP_MAX_PACKET, 0U);
+    rxPosition = 0U;
+    ssize_t n = (udpSocket >= 0) ? recvfrom(udpSocket, rxBuffer.data(), rxBuffer.size(), MSG_DONTWAIT,
+                                            (struct sockaddr *)&address, &len) : -1;
+    if (n <= 0) {
+        rxBuffer.clear();
+        return (0);
+    }
+    rxBuffer.resize((size_t)n);
+    rxAddress = IPAddress((uint32_t)address.sin_addr.s_addr);
+    rxPort = ntohs(address.sin_port);
+
+    return ((int)n);
+}
+
+int WiFiUDP::read(void) {
+    return ((available() > 0) ? (int)rxBuffer[rxPosition++] : -1);
+}
+
+int WiFiUDP::read(uint8_t * buffer, size_t size) {
+    size_t n = std::min(size, (size_t)available());
+
+    memcpy(buffer, rxBuffer.data() + rxPosition, n);
+    rxPosition += n;
+
+    return ((int)n);
+}
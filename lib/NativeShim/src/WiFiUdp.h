@@ -0,0 +1,54 @@
+#ifndef WIFI_UDP_H
+#define WIFI_UDP_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <vector>
+
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/** @brief Host stand-in for the Arduino-ESP32 UDP socket, with its packet oriented API */
+class WiFiUDP : public Stream {
+private:
+    /** @brief Bound socket, -1 until begin() */
+    int udpSocket;
+    /** @brief Destination and payload of the packet being built */
+    IPAddress txAddress;
+    uint16_t txPort;
+    std::vector<uint8_t> txBuffer;
+    /** @brief Last packet returned by parsePacket() and the read position in it */
+    IPAddress rxAddress;
+    uint16_t rxPort;
+    std::vector<uint8_t> rxBuffer;
+    size_t rxPosition;
+
+public:
+    WiFiUDP() : udpSocket(-1), txPort(0U), rxPort(0U), rxPosition(0U) {}
+    ~WiFiUDP() { stop(); }
+
+    /** @brief Bind to the local port, 1 on success */
+    uint8_t begin(const uint16_t port);
+    void stop(void);
+
+    int beginPacket(const IPAddress ip, const uint16_t port);
+    int beginPacket(const char * const host, const uint16_t port);
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    int endPacket(void);
+
+    /** @brief Fetch the next datagram without waiting, its size or 0 when there is none */
+    int parsePacket(void);
+    int available(void) override { return ((int)(rxBuffer.size() - rxPosition)); }
+    int read(void) override;
+    int read(uint8_t * buffer, size_t size);
+    int peek(void) override { return ((available() > 0) ? (int)rxBuffer[rxPosition] : -1); }
+    IPAddress remoteIP(void) const { return (rxAddress); }
+    uint16_t remotePort(void) const { return (rxPort); }
+};
+
+#endif /* WIFI_UDP_H */
@@ -0,0 +1,71 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "Wire.h"
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+TwoWire Wire;
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void TwoWire::attach(const uint8_t address, I2CTarget * target) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (target == NULL) {
+        targets.erase(address);
+    } else {
+        targets[address] = target;
+    }
+}
+
+bool TwoWire::begin(const int sda, const int scl, const uint32_t frequency) {
+    (void)sda;
+    (void)scl;
+    (void)frequency;
+    return (true);
+}
+
+void TwoWire::beginTransmission(const uint8_t address) {
+    txAddress = address;
+    txBuffer.clear();
+}
+
+size_t TwoWire::write(const uint8_t * buffer, size_t size) {
+    size_t room = I2C_BUFFER_LENGTH - txBuffer.size();
+    size_t n = std::min(size, room);
+
+    txBuffer.insert(txBuffer.end(), buffer, buffer + n);
+
+    return (n);
+}
+
+uint8_t TwoWire::endTransmission(const bool stop) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = targets.find(txAddress);
+
+    (void)stop;
+    if ((it == targets.end()) || (it->second->onWrite(txBuffer.data(), txBuffer.size()) == false)) {
+        return (2U);
+    }
+
+    return (0U);
+}
+
+uint8_t TwoWire::requestFrom(const uint8_t address, const uint8_t len, const uint8_t stop) {
+    std::lock_guard<std::mutex> guard(lock);
+    auto it = targets.find(address);
+
+    (void)stop;
+    rxBuffer.assign(len, 0U);
+    rxPosition = 0U;
+    if ((it == targets.end()) || (it->second->onRead(rxBuffer.data(), len) == false)) {
+        rxBuffer.clear();
+        return (0U);
+    }
+
+    return (len);
+}
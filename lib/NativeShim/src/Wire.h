@@ -0,0 +1,73 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <map>
+#include <mutex>
+#include <vector>
+
+/* Local files */
+#include "Arduino.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define I2C_BUFFER_LENGTH                       (128)
+#define WIRE_HAS_END                            (1)
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Device answering on the host I2C bus.
+ * @details
+ *  Tests implement one per chip they fake. A target that returns false
+ *  NACKs the transfer, as a chip that is busy, hung or unplugged would.
+ */
+class I2CTarget {
+public:
+    virtual ~I2CTarget() {}
+    /** @brief Bytes written by the controller in one transaction */
+    virtual bool onWrite(const uint8_t * data, const size_t len) = 0;
+    /** @brief Fill data for a read of len bytes */
+    virtual bool onRead(uint8_t * data, const size_t len) = 0;
+};
+
+/** @brief Host stand-in for the Arduino I2C controller, routing transfers to attached targets */
+class TwoWire : public Stream {
+private:
+    std::mutex lock;
+    std::map<uint8_t, I2CTarget *> targets;
+    uint8_t txAddress = 0U;
+    std::vector<uint8_t> txBuffer;
+    std::vector<uint8_t> rxBuffer;
+    size_t rxPosition = 0U;
+
+public:
+    /** @brief Put a target on the bus, NULL takes it off */
+    void attach(const uint8_t address, I2CTarget * target);
+
+    bool begin(const int sda = -1, const int scl = -1, const uint32_t frequency = 0U);
+    bool end(void) { return (true); }
+    bool setClock(const uint32_t frequency) { (void)frequency; return (true); }
+
+    void beginTransmission(const uint8_t address);
+    size_t write(const uint8_t * buffer, size_t size) override;
+    using Print::write;
+    /** @brief 0 on success, 2 when no target or a NACK, as the Arduino core reports */
+    uint8_t endTransmission(const bool stop = true);
+    uint8_t requestFrom(const uint8_t address, const uint8_t len, const uint8_t stop = 1U);
+
+    int available(void) override { return ((int)(rxBuffer.size() - rxPosition)); }
+    int read(void) override { return ((available() > 0) ? (int)rxBuffer[rxPosition++] : -1); }
+    int peek(void) override { return ((available() > 0) ? (int)rxBuffer[rxPosition] : -1); }
+};
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern TwoWire Wire;
+
+#endif /* WIRE_H */
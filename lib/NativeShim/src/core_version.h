@@ -0,0 +1,20 @@
+#ifndef CORE_VERSION_H
+#define CORE_VERSION_H
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Arduino-ESP32 and ESP-IDF releases the host shim mimics */
+#define ARDUINO_ESP32_GIT_DESC                  2.0.11
+#define ARDUINO_ESP32_RELEASE                   "2_0_11"
+#define ESP_ARDUINO_VERSION_MAJOR               2
+#define ESP_ARDUINO_VERSION_MINOR               0
+#define ESP_ARDUINO_VERSION_PATCH               11
+
+#define ESP_IDF_VERSION_MAJOR                   4
+#define ESP_IDF_VERSION_MINOR                   4
+#define ESP_IDF_VERSION_PATCH                   5
+
+#define ARDUINO_VARIANT                         "native"
+
+#endif /* CORE_VERSION_H */
@@ -0,0 +1,38 @@
+#ifndef DRIVER_GPIO_H
+#define DRIVER_GPIO_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef int gpio_num_t;
+
+/** @brief Output set and clear registers, as laid out on the ESP32 */
+typedef struct {
+    uint32_t out_w1ts;
+    uint32_t out_w1tc;
+    union {
+        struct {
+            uint32_t data : 8;
+        };
+        uint32_t val;
+    } out1_w1ts;
+    union {
+        struct {
+            uint32_t data : 8;
+        };
+        uint32_t val;
+    } out1_w1tc;
+} gpio_dev_t;
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+/** @brief Plain memory on the host, writes go nowhere */
+extern volatile gpio_dev_t GPIO;
+
+#endif /* DRIVER_GPIO_H */
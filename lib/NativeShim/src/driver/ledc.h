@@ -0,0 +1,101 @@
+#ifndef DRIVER_LEDC_H
+#define DRIVER_LEDC_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Local files */
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief The ESP32 LED PWM controller layout, the host keeps duties in memory only */
+typedef enum {
+    LEDC_HIGH_SPEED_MODE = 0,
+    LEDC_LOW_SPEED_MODE,
+    LEDC_SPEED_MODE_MAX
+} ledc_mode_t;
+
+typedef enum {
+    LEDC_CHANNEL_0 = 0,
+    LEDC_CHANNEL_MAX = 8
+} ledc_channel_t;
+
+typedef enum {
+    LEDC_TIMER_0 = 0,
+    LEDC_TIMER_MAX = 4
+} ledc_timer_t;
+
+typedef enum {
+    LEDC_TIMER_1_BIT = 1,
+    LEDC_TIMER_BIT_MAX = 21
+} ledc_timer_bit_t;
+
+typedef enum {
+    LEDC_AUTO_CLK = 0,
+    LEDC_USE_REF_TICK,
+    LEDC_USE_APB_CLK
+} ledc_clk_cfg_t;
+
+typedef enum {
+    LEDC_INTR_DISABLE = 0,
+    LEDC_INTR_FADE_END
+} ledc_intr_type_t;
+
+typedef enum {
+    LEDC_FADE_NO_WAIT = 0,
+    LEDC_FADE_WAIT_DONE
+} ledc_fade_mode_t;
+
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_timer_bit_t duty_resolution;
+    ledc_timer_t timer_num;
+    uint32_t freq_hz;
+    ledc_clk_cfg_t clk_cfg;
+} ledc_timer_config_t;
+
+typedef struct {
+    int gpio_num;
+    ledc_mode_t speed_mode;
+    ledc_channel_t channel;
+    ledc_intr_type_t intr_type;
+    ledc_timer_t timer_sel;
+    uint32_t duty;
+    int hpoint;
+    struct {
+        unsigned int output_invert : 1;
+    } flags;
+} ledc_channel_config_t;
+
+typedef struct {
+    int event;
+    uint32_t speed_mode;
+    uint32_t channel;
+    uint32_t duty;
+} ledc_cb_param_t;
+
+typedef bool (*ledc_cb_t)(const ledc_cb_param_t * param, void * arg);
+
+typedef struct {
+    ledc_cb_t fade_cb;
+} ledc_cbs_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t ledc_timer_config(const ledc_timer_config_t * config);
+esp_err_t ledc_channel_config(const ledc_channel_config_t * config);
+uint32_t ledc_get_duty(const ledc_mode_t mode, const ledc_channel_t channel);
+esp_err_t ledc_fade_func_install(const int flags);
+esp_err_t ledc_cb_register(const ledc_mode_t mode, const ledc_channel_t channel, ledc_cbs_t * cbs, void * arg);
+/** @brief Completes at once, the fade callback runs before returning */
+esp_err_t ledc_set_fade_time_and_start(const ledc_mode_t mode, const ledc_channel_t channel, const uint32_t duty,
+                                       const uint32_t ms, const ledc_fade_mode_t wait);
+
+#endif /* DRIVER_LEDC_H */
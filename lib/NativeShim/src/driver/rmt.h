@@ -0,0 +1,104 @@
+#ifndef DRIVER_RMT_H
+#define DRIVER_RMT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Local files */
+#include "esp_err.h"
+#include "driver/gpio.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief The ESP32 remote control peripheral layout, transmissions go nowhere on the host */
+typedef enum {
+    RMT_CHANNEL_0 = 0,
+    RMT_CHANNEL_MAX = 8
+} rmt_channel_t;
+
+typedef enum {
+    RMT_MODE_TX = 0,
+    RMT_MODE_RX
+} rmt_mode_t;
+
+typedef enum {
+    RMT_IDLE_LEVEL_LOW = 0,
+    RMT_IDLE_LEVEL_HIGH
+} rmt_idle_level_t;
+
+typedef enum {
+    RMT_CARRIER_LEVEL_LOW = 0,
+    RMT_CARRIER_LEVEL_HIGH
+} rmt_carrier_level_t;
+
+typedef enum {
+    RMT_BASECLK_REF = 0,
+    RMT_BASECLK_APB
+} rmt_source_clk_t;
+
+typedef struct {
+    uint32_t carrier_freq_hz;
+    rmt_carrier_level_t carrier_level;
+    rmt_idle_level_t idle_level;
+    uint8_t carrier_duty_percent;
+    bool carrier_en;
+    bool loop_en;
+    bool idle_output_en;
+} rmt_tx_config_t;
+
+typedef struct {
+    rmt_mode_t rmt_mode;
+    rmt_channel_t channel;
+    gpio_num_t gpio_num;
+    uint8_t clk_div;
+    uint8_t mem_block_num;
+    uint32_t flags;
+    rmt_tx_config_t tx_config;
+} rmt_config_t;
+
+typedef struct {
+    uint32_t val;
+} rmt_item32_t;
+
+typedef struct {
+    struct {
+        uint32_t val;
+    } int_st, int_ena, int_clr;
+} rmt_dev_t;
+
+typedef struct {
+    struct {
+        rmt_item32_t data32[64];
+    } chan[RMT_CHANNEL_MAX];
+} rmt_mem_t;
+
+typedef void (*rmt_isr_t)(void * arg);
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t rmt_config(const rmt_config_t * config);
+esp_err_t rmt_driver_install(const rmt_channel_t channel, const size_t rxSize, const int flags);
+esp_err_t rmt_set_source_clk(const rmt_channel_t channel, const rmt_source_clk_t clock);
+esp_err_t rmt_set_clk_div(const rmt_channel_t channel, const uint8_t divider);
+esp_err_t rmt_write_items(const rmt_channel_t channel, const rmt_item32_t * items, const int count, const bool wait);
+esp_err_t rmt_set_tx_carrier(const rmt_channel_t channel, const bool enable, const uint16_t high, const uint16_t low,
+                             const rmt_carrier_level_t level);
+esp_err_t rmt_isr_register(rmt_isr_t handler, void * arg, const int flags, void * handle);
+esp_err_t rmt_set_tx_thr_intr_en(const rmt_channel_t channel, const bool enable, const uint16_t threshold);
+esp_err_t rmt_set_tx_intr_en(const rmt_channel_t channel, const bool enable);
+/** @brief Reports the end of transmission at once, through the registered handler */
+esp_err_t rmt_tx_start(const rmt_channel_t channel, const bool reset);
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+extern volatile rmt_dev_t RMT;
+extern volatile rmt_mem_t RMTMEM;
+
+#endif /* DRIVER_RMT_H */
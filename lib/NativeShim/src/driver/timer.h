@@ -0,0 +1,6 @@
+#ifndef DRIVER_TIMER_H
+#define DRIVER_TIMER_H
+
+/* Included by HomeSpan for the hardware timers, none are used on the host */
+
+#endif /* DRIVER_TIMER_H */
@@ -0,0 +1,42 @@
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define MALLOC_CAP_EXEC                         (1U << 0)
+#define MALLOC_CAP_8BIT                         (1U << 2)
+#define MALLOC_CAP_SPIRAM                       (1U << 10)
+#define MALLOC_CAP_INTERNAL                     (1U << 11)
+#define MALLOC_CAP_DEFAULT                      (1U << 12)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef struct {
+    size_t total_free_bytes;
+    size_t total_allocated_bytes;
+    size_t largest_free_block;
+    size_t minimum_free_bytes;
+    size_t allocated_blocks;
+    size_t free_blocks;
+    size_t total_blocks;
+} multi_heap_info_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @note The host heap has no capabilities, sizes are the fixed values of ESP.getFreeHeap() */
+inline void * heap_caps_malloc(const size_t size, const uint32_t caps) { (void)caps; return (malloc(size)); }
+inline void heap_caps_free(void * ptr) { free(ptr); }
+size_t heap_caps_get_free_size(const uint32_t caps);
+void heap_caps_get_info(multi_heap_info_t * info, const uint32_t caps);
+
+#endif /* ESP_HEAP_CAPS_H */
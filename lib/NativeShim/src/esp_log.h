@@ -0,0 +1,14 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief IDF component logs are dropped on the host, HomeSpan logs through LOG0/1/2 */
+#define ESP_LOGE(tag, format, ...)              ((void)(tag))
+#define ESP_LOGW(tag, format, ...)              ((void)(tag))
+#define ESP_LOGI(tag, format, ...)              ((void)(tag))
+#define ESP_LOGD(tag, format, ...)              ((void)(tag))
+#define ESP_LOGV(tag, format, ...)              ((void)(tag))
+
+#endif /* ESP_LOG_H */
@@ -0,0 +1,59 @@
+#ifndef ESP_NOW_H
+#define ESP_NOW_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Local files */
+#include "esp_err.h"
+#include "esp_wifi.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define ESP_NOW_ETH_ALEN                        (6)
+#define ESP_NOW_KEY_LEN                         (16)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    ESP_NOW_SEND_SUCCESS = 0,
+    ESP_NOW_SEND_FAIL
+} esp_now_send_status_t;
+
+typedef struct {
+    uint8_t peer_addr[ESP_NOW_ETH_ALEN];
+    uint8_t lmk[ESP_NOW_KEY_LEN];
+    uint8_t channel;
+    wifi_interface_t ifidx;
+    bool encrypt;
+    void * priv;
+} esp_now_peer_info_t;
+
+typedef void (*esp_now_recv_cb_t)(const uint8_t * mac, const uint8_t * data, int len);
+typedef void (*esp_now_send_cb_t)(const uint8_t * mac, esp_now_send_status_t status);
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t esp_now_init(void);
+esp_err_t esp_now_set_pmk(const uint8_t * pmk);
+esp_err_t esp_now_add_peer(const esp_now_peer_info_t * peer);
+esp_err_t esp_now_register_recv_cb(esp_now_recv_cb_t callback);
+esp_err_t esp_now_register_send_cb(esp_now_send_cb_t callback);
+/** @brief Every frame is reported delivered, there is no radio on the host */
+esp_err_t esp_now_send(const uint8_t * mac, const uint8_t * data, size_t len);
+
+/**
+ * @brief Deliver a frame as if it came over the air from mac
+ * @details
+ *  Calls the registered receive callback, so a test can stand in for a
+ *  remote SpanPoint sensor.
+ */
+void nativeEspNowReceive(const uint8_t * mac, const uint8_t * data, const int len);
+
+#endif /* ESP_NOW_H */
@@ -0,0 +1,37 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+
+/* Local files */
+#include "esp_ota_ops.h"
+#include "esp_system.h"
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static const esp_partition_t hostPartition = {"native", 0U, 0U};
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+const esp_partition_t * esp_ota_get_running_partition(void) {
+    return (&hostPartition);
+}
+
+const esp_partition_t * esp_ota_get_next_update_partition(const esp_partition_t * start) {
+    (void)start;
+    return (&hostPartition);
+}
+
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot(void) {
+    esp_restart();
+    return (ESP_OK);
+}
+
+esp_err_t esp_partition_read(const esp_partition_t * partition, size_t offset, void * dst, size_t size) {
+    (void)partition;
+    (void)offset;
+    memset(dst, 0, size);
+    return (ESP_OK);
+}
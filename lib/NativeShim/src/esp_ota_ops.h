@@ -0,0 +1,59 @@
+#ifndef ESP_OTA_OPS_H
+#define ESP_OTA_OPS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Local files */
+#include "esp_err.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef struct {
+    char label[17];
+    uint32_t address;
+    uint32_t size;
+} esp_partition_t;
+
+/** @brief Image headers, only their sizes matter to HomeSpan */
+typedef struct {
+    uint8_t magic;
+    uint8_t segment_count;
+    uint8_t spi_mode;
+    uint8_t spi_speed_size;
+    uint32_t entry_addr;
+    uint8_t reserved[16];
+} esp_image_header_t;
+
+typedef struct {
+    uint32_t load_addr;
+    uint32_t data_len;
+} esp_image_segment_header_t;
+
+typedef struct {
+    uint32_t magic_word;
+    uint32_t secure_version;
+    uint32_t reserv1[2];
+    char version[32];
+    char project_name[32];
+    char time[16];
+    char date[16];
+    char idf_ver[32];
+    uint8_t app_elf_sha256[32];
+    uint32_t reserv2[20];
+} esp_app_desc_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @note The host has a single partition, so HomeSpan sees OTA as unavailable */
+const esp_partition_t * esp_ota_get_running_partition(void);
+const esp_partition_t * esp_ota_get_next_update_partition(const esp_partition_t * start);
+esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot(void);
+esp_err_t esp_partition_read(const esp_partition_t * partition, size_t offset, void * dst, size_t size);
+
+#endif /* ESP_OTA_OPS_H */
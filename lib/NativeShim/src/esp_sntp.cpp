@@ -0,0 +1,58 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdlib.h>
+#include <sys/time.h>
+
+/* Local files */
+#include "esp_sntp.h"
+#include "esp_timer.h"
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Wall time pinned by nativeSetTime() and the esp_timer value at that moment */
+static bool timePinned = false;
+static time_t pinnedEpoch = 0;
+static int64_t pinnedAt = 0;
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void configTzTime(const char * tz, const char * server1, const char * server2, const char * server3) {
+    (void)server1;
+    (void)server2;
+    (void)server3;
+    setenv("TZ", tz, 1);
+    tzset();
+}
+
+bool getLocalTime(struct tm * info, const uint32_t ms) {
+    (void)ms;
+    time_t now = time(NULL);
+    return (localtime_r(&now, info) != NULL);
+}
+
+/* Replaces the C library time(), so code reading the system clock as on the ESP32 sees the pinned wall time too */
+extern "C" time_t time(time_t * tloc) noexcept {
+    struct timespec host;
+    time_t now;
+
+    if (timePinned) {
+        now = pinnedEpoch + (time_t)((esp_timer_get_time() - pinnedAt) / 1000000);
+    } else {
+        clock_gettime(CLOCK_REALTIME, &host);
+        now = host.tv_sec;
+    }
+
+    if (tloc != NULL) {
+        *tloc = now;
+    }
+    return (now);
+}
+
+void nativeSetTime(const time_t epoch) {
+    pinnedEpoch = epoch;
+    pinnedAt = esp_timer_get_time();
+    timePinned = true;
+}
@@ -0,0 +1,33 @@
+#ifndef ESP_SNTP_H
+#define ESP_SNTP_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <time.h>
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Sets TZ only, the host clock is already synchronised */
+void configTzTime(const char * tz, const char * server1, const char * server2 = NULL, const char * server3 = NULL);
+
+/**
+ * @brief Local time, as the Arduino core returns it once SNTP has synchronised
+ * @details
+ *  Wall time follows nativeSetTime() when a test set it, so schedules and
+ *  DST changes can be driven without waiting; otherwise it is the host time.
+ */
+bool getLocalTime(struct tm * info, const uint32_t ms = 5000);
+
+/**
+ * @brief Pin the wall clock to epoch, it then advances with nativeAdvanceClock() and real time
+ * @details
+ *  time() and getLocalTime() both follow it, as the ESP32 system clock does
+ *  once SNTP has set it. Call again to step the clock, e.g. to simulate an
+ *  SNTP correction.
+ */
+void nativeSetTime(const time_t epoch);
+
+#endif /* ESP_SNTP_H */
@@ -0,0 +1,41 @@
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Local files */
+#include "esp_err.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    ESP_RST_UNKNOWN = 0,
+    ESP_RST_POWERON,
+    ESP_RST_EXT,
+    ESP_RST_SW,
+    ESP_RST_PANIC,
+    ESP_RST_INT_WDT,
+    ESP_RST_TASK_WDT,
+    ESP_RST_WDT,
+    ESP_RST_DEEPSLEEP,
+    ESP_RST_BROWNOUT,
+    ESP_RST_SDIO
+} esp_reset_reason_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Seeded pseudo-random numbers, runs are reproducible */
+uint32_t esp_random(void);
+void esp_fill_random(void * buffer, size_t length);
+
+/** @brief Exits the process */
+void esp_restart(void);
+esp_reset_reason_t esp_reset_reason(void);
+
+#endif /* ESP_SYSTEM_H */
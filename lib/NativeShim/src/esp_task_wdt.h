@@ -0,0 +1,20 @@
+#ifndef ESP_TASK_WDT_H
+#define ESP_TASK_WDT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief There is no watchdog on the host */
+inline esp_err_t esp_task_wdt_add(TaskHandle_t task) { (void)task; return (ESP_OK); }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t task) { (void)task; return (ESP_OK); }
+inline esp_err_t esp_task_wdt_reset(void) { return (ESP_OK); }
+
+#endif /* ESP_TASK_WDT_H */
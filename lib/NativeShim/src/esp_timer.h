@@ -0,0 +1,15 @@
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Microseconds since start, moved forward by nativeAdvanceClock() */
+int64_t esp_timer_get_time(void);
+
+#endif /* ESP_TIMER_H */
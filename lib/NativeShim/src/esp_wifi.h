@@ -0,0 +1,59 @@
+#ifndef ESP_WIFI_H
+#define ESP_WIFI_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/* Local files */
+#include "esp_err.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    WIFI_MODE_NULL = 0,
+    WIFI_MODE_STA,
+    WIFI_MODE_AP,
+    WIFI_MODE_APSTA
+} wifi_mode_t;
+
+#define WIFI_OFF                                (WIFI_MODE_NULL)
+#define WIFI_STA                                (WIFI_MODE_STA)
+#define WIFI_AP                                 (WIFI_MODE_AP)
+#define WIFI_AP_STA                             (WIFI_MODE_APSTA)
+
+typedef enum {
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP
+} wifi_interface_t;
+
+typedef enum {
+    WIFI_SECOND_CHAN_NONE = 0,
+    WIFI_SECOND_CHAN_ABOVE,
+    WIFI_SECOND_CHAN_BELOW
+} wifi_second_chan_t;
+
+/** @brief Only the fields HomeSpan touches */
+typedef union {
+    struct {
+        uint8_t ssid[32];
+        uint8_t password[64];
+        uint8_t ssid_hidden;
+    } ap;
+    struct {
+        uint8_t ssid[32];
+        uint8_t password[64];
+    } sta;
+} wifi_config_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t esp_wifi_get_channel(uint8_t * primary, wifi_second_chan_t * second);
+esp_err_t esp_wifi_set_channel(const uint8_t primary, const wifi_second_chan_t second);
+esp_err_t esp_wifi_get_config(const wifi_interface_t interface, wifi_config_t * config);
+esp_err_t esp_wifi_set_config(const wifi_interface_t interface, wifi_config_t * config);
+
+#endif /* ESP_WIFI_H */
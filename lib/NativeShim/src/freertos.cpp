@@ -0,0 +1,280 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <pthread.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Local files */
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Host thread running a task */
+struct NativeTask {
+    TaskFunction_t function;            /**< Task body */
+    void * arg;                         /**< Task argument */
+    UBaseType_t priority;               /**< Priority given at creation, reported only */
+    std::mutex lock;                    /**< Guards the fields below */
+    std::condition_variable wake;       /**< Signalled on notification and deletion */
+    uint32_t notifications;             /**< Pending xTaskNotifyGive() count */
+    bool deleted;                       /**< Set by vTaskDelete() from another task */
+};
+
+/** @brief Queue of fixed-size items, also used for semaphores with zero-size items */
+struct NativeQueue {
+    UBaseType_t length;                 /**< Capacity in items */
+    UBaseType_t itemSize;               /**< Item size in bytes */
+    std::mutex lock;                    /**< Guards items */
+    std::condition_variable changed;    /**< Signalled on every send and receive */
+    std::deque<std::vector<uint8_t>> items;     /**< Queued items, oldest first */
+};
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Task of the calling thread, NULL for threads not started by xTaskCreate() */
+static thread_local NativeTask * currentTask = NULL;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Stop the calling task if another task deleted it */
+static void checkDeleted(void) {
+    if ((currentTask != NULL) && currentTask->deleted) {
+        pthread_exit(NULL);
+    }
+}
+
+/** @brief Wait until ready() holds, at most ticks, portMAX_DELAY waits forever */
+static bool waitUntil(std::unique_lock<std::mutex> & lock, std::condition_variable & cv, const TickType_t ticks,
+                      const std::function<bool(void)> & ready) {
+    /* Polling returns at once as on FreeRTOS, a timed wait of 0 still sleeps for the timer slack of the thread */
+    if (ticks == 0U) {
+        return (ready());
+    }
+    if (ticks == portMAX_DELAY) {
+        cv.wait(lock, ready);
+        return (true);
+    }
+    return (cv.wait_for(lock, std::chrono::milliseconds(ticks), ready));
+}
+
+static BaseType_t queueSend(QueueHandle_t queue, const void * const item, const TickType_t ticks, const bool overwrite) {
+    std::unique_lock<std::mutex> lock(queue->lock);
+
+    if (overwrite == true) {
+        queue->items.clear();
+    } else if (waitUntil(lock, queue->changed, ticks, [queue]() { return (queue->items.size() < queue->length); }) == false) {
+        return (pdFALSE);
+    }
+
+    const uint8_t * bytes = (const uint8_t *)item;
+    queue->items.emplace_back(bytes, bytes + ((item != NULL) ? queue->itemSize : 0U));
+    queue->changed.notify_all();
+
+    return (pdTRUE);
+}
+
+static BaseType_t queueReceive(QueueHandle_t queue, void * const item, const TickType_t ticks, const bool remove) {
+    checkDeleted();
+
+    std::unique_lock<std::mutex> lock(queue->lock);
+    if (waitUntil(lock, queue->changed, ticks, [queue]() { return (!queue->items.empty()); }) == false) {
+        return (pdFALSE);
+    }
+
+    if ((item != NULL) && (queue->itemSize > 0U)) {
+        memcpy(item, queue->items.front().data(), queue->itemSize);
+    }
+    if (remove == true) {
+        queue->items.pop_front();
+        queue->changed.notify_all();
+    }
+
+    return (pdTRUE);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                                   void * const arg, UBaseType_t priority, TaskHandle_t * const handle, const BaseType_t core) {
+    (void)name;
+    (void)stackSize;
+    (void)core;
+
+    NativeTask * task = new NativeTask();
+    task->function = function;
+    task->arg = arg;
+    task->priority = priority;
+    task->notifications = 0U;
+    task->deleted = false;
+    if (handle != NULL) {
+        *handle = task;
+    }
+
+    std::thread([task]() {
+        currentTask = task;
+        task->function(task->arg);
+    }).detach();
+
+    return (pdPASS);
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                       void * const arg, UBaseType_t priority, TaskHandle_t * const handle) {
+    return (xTaskCreatePinnedToCore(function, name, stackSize, arg, priority, handle, tskNO_AFFINITY));
+}
+
+BaseType_t xTaskCreateUniversal(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                                void * const arg, UBaseType_t priority, TaskHandle_t * const handle, const BaseType_t core) {
+    return (xTaskCreatePinnedToCore(function, name, stackSize, arg, priority, handle, core));
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    if ((task == NULL) || (task == currentTask)) {
+        pthread_exit(NULL);
+    }
+
+    /* The task record is never freed, the thread may still be about to look at it */
+    std::lock_guard<std::mutex> lock(task->lock);
+    task->deleted = true;
+    task->wake.notify_all();
+}
+
+void vTaskDelay(const TickType_t ticks) {
+    checkDeleted();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+    checkDeleted();
+}
+
+void vTaskDelayUntil(TickType_t * const previousWake, const TickType_t period) {
+    TickType_t now = xTaskGetTickCount();
+    *previousWake += period;
+    if ((int32_t)(*previousWake - now) > 0) {
+        vTaskDelay(*previousWake - now);
+    } else {
+        checkDeleted();
+    }
+}
+
+TickType_t xTaskGetTickCount(void) {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return ((TickType_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (currentTask);
+}
+
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(const UBaseType_t cpu) {
+    (void)cpu;
+    return (NULL);
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task) {
+    task = (task != NULL) ? task : currentTask;
+    return ((task != NULL) ? task->priority : 1U);
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    std::lock_guard<std::mutex> lock(task->lock);
+    task->notifications++;
+    task->wake.notify_all();
+    return (pdPASS);
+}
+
+uint32_t ulTaskNotifyTake(const BaseType_t clearOnExit, const TickType_t ticks) {
+    NativeTask * task = currentTask;
+    uint32_t count = 0U;
+
+    if (task == NULL) {
+        return (0U);
+    }
+
+    std::unique_lock<std::mutex> lock(task->lock);
+    (void)waitUntil(lock, task->wake, ticks, [task]() { return ((task->notifications > 0U) || task->deleted); });
+    if (task->deleted) {
+        lock.unlock();
+        pthread_exit(NULL);
+    }
+    count = task->notifications;
+    task->notifications = (clearOnExit == pdTRUE) ? 0U : ((count > 0U) ? count - 1U : 0U);
+
+    return (count);
+}
+
+QueueHandle_t xQueueCreate(const UBaseType_t length, const UBaseType_t itemSize) {
+    NativeQueue * queue = new NativeQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return (queue);
+}
+
+void vQueueDelete(QueueHandle_t queue) {
+    delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void * const item, const TickType_t ticks) {
+    return (queueSend(queue, item, ticks, false));
+}
+
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void * const item, const TickType_t ticks) {
+    return (queueSend(queue, item, ticks, false));
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void * const item) {
+    return (queueSend(queue, item, 0U, true));
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void * const item, const TickType_t ticks) {
+    return (queueReceive(queue, item, ticks, true));
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void * const item, const TickType_t ticks) {
+    return (queueReceive(queue, item, ticks, false));
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return ((UBaseType_t)queue->items.size());
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue) {
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return (queue->length - (UBaseType_t)queue->items.size());
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    /* A mutex starts given */
+    SemaphoreHandle_t semaphore = xQueueCreate(1U, 0U);
+    (void)xSemaphoreGive(semaphore);
+    return (semaphore);
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return (xQueueCreate(1U, 0U));
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, const TickType_t ticks) {
+    return (queueReceive(semaphore, NULL, ticks, true));
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    return (queueSend(semaphore, NULL, 0U, false));
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    vQueueDelete(semaphore);
+}
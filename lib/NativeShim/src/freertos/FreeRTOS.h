@@ -0,0 +1,40 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief One tick per millisecond, as configured for the Arduino core */
+#define configTICK_RATE_HZ                      (1000)
+#define portTICK_PERIOD_MS                      (1)
+#define portMAX_DELAY                           ((TickType_t)0xFFFFFFFFU)
+#define pdMS_TO_TICKS(ms)                       ((TickType_t)(ms))
+
+#define pdFALSE                                 (0)
+#define pdTRUE                                  (1)
+#define pdFAIL                                  (pdFALSE)
+#define pdPASS                                  (pdTRUE)
+
+#define tskIDLE_PRIORITY                        (0U)
+#define tskNO_AFFINITY                          (0x7FFFFFFF)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+/** @brief Tasks are host threads, queues and semaphores a mutex and a condition variable */
+typedef struct NativeTask * TaskHandle_t;
+typedef struct NativeQueue * QueueHandle_t;
+typedef QueueHandle_t SemaphoreHandle_t;
+typedef void (* TaskFunction_t)(void *);
+
+#endif /* FREERTOS_H */
@@ -0,0 +1,22 @@
+#ifndef FREERTOS_QUEUE_H
+#define FREERTOS_QUEUE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "freertos/FreeRTOS.h"
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+QueueHandle_t xQueueCreate(const UBaseType_t length, const UBaseType_t itemSize);
+void vQueueDelete(QueueHandle_t queue);
+BaseType_t xQueueSend(QueueHandle_t queue, const void * const item, const TickType_t ticks);
+BaseType_t xQueueSendToBack(QueueHandle_t queue, const void * const item, const TickType_t ticks);
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void * const item);
+BaseType_t xQueueReceive(QueueHandle_t queue, void * const item, const TickType_t ticks);
+BaseType_t xQueuePeek(QueueHandle_t queue, void * const item, const TickType_t ticks);
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue);
+
+#endif /* FREERTOS_QUEUE_H */
@@ -0,0 +1,19 @@
+#ifndef FREERTOS_SEMPHR_H
+#define FREERTOS_SEMPHR_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "freertos/queue.h"
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Semaphores are queues of empty items, as in FreeRTOS */
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, const TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+
+#endif /* FREERTOS_SEMPHR_H */
@@ -0,0 +1,37 @@
+#ifndef FREERTOS_TASK_H
+#define FREERTOS_TASK_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "freertos/FreeRTOS.h"
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @brief Start a task in a host thread
+ * @details
+ *  Priorities and cores are ignored. A task deleted by another one stops at
+ *  its next vTaskDelay(), ulTaskNotifyTake() or queue wait.
+ */
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                                   void * const arg, UBaseType_t priority, TaskHandle_t * const handle, const BaseType_t core);
+BaseType_t xTaskCreate(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                       void * const arg, UBaseType_t priority, TaskHandle_t * const handle);
+BaseType_t xTaskCreateUniversal(TaskFunction_t function, const char * const name, const uint32_t stackSize,
+                                void * const arg, UBaseType_t priority, TaskHandle_t * const handle, const BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+
+void vTaskDelay(const TickType_t ticks);
+void vTaskDelayUntil(TickType_t * const previousWake, const TickType_t period);
+TickType_t xTaskGetTickCount(void);
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TaskHandle_t xTaskGetIdleTaskHandleForCPU(const UBaseType_t cpu);
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(const BaseType_t clearOnExit, const TickType_t ticks);
+
+#endif /* FREERTOS_TASK_H */
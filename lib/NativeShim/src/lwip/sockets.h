@@ -0,0 +1,23 @@
+#ifndef LWIP_SOCKETS_H
+#define LWIP_SOCKETS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief lwIP numbers its sockets from this offset, host descriptors start at 0 */
+#define LWIP_SOCKET_OFFSET                      (0)
+
+#endif /* LWIP_SOCKETS_H */
@@ -0,0 +1,326 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <openssl/bn.h>
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+/* Local files */
+#include "mbedtls/base64.h"
+#include "mbedtls/bignum.h"
+#include "mbedtls/md.h"
+#include "mbedtls/platform_util.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/sha512.h"
+#include "mbedtls/version.h"
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static const mbedtls_md_info_t sha256Info = {MBEDTLS_MD_SHA256, 32U};
+static const mbedtls_md_info_t sha512Info = {MBEDTLS_MD_SHA512, 64U};
+
+static const char base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static const char * digestName(const mbedtls_md_info_t * info) {
+    return ((info->type == MBEDTLS_MD_SHA256) ? "SHA256" : "SHA512");
+}
+
+/** @brief BIGNUM behind X, allocated on first use */
+static BIGNUM * bn(const mbedtls_mpi * X) {
+    mbedtls_mpi * mpi = (mbedtls_mpi *)X;
+    if (mpi->bn == NULL) {
+        mpi->bn = BN_new();
+    }
+    return ((BIGNUM *)mpi->bn);
+}
+
+/** @brief Value of a base64 character, -1 when not in the alphabet */
+static int base64Value(const unsigned char c) {
+    const char * p = (c != '\0') ? strchr(base64Alphabet, c) : NULL;
+    return ((p != NULL) ? (int)(p - base64Alphabet) : -1);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void mbedtls_version_get_string_full(char * string) {
+    snprintf(string, 64U, "%s", OpenSSL_version(OPENSSL_VERSION));
+}
+
+void mbedtls_platform_zeroize(void * buffer, size_t length) {
+    OPENSSL_cleanse(buffer, length);
+}
+
+int mbedtls_sha256_ret(const unsigned char * input, size_t length, unsigned char output[32], int is224) {
+    (void)EVP_Digest(input, length, output, NULL, (is224 != 0) ? EVP_sha224() : EVP_sha256(), NULL);
+    return (0);
+}
+
+int mbedtls_sha512_ret(const unsigned char * input, size_t length, unsigned char output[64], int is384) {
+    (void)EVP_Digest(input, length, output, NULL, (is384 != 0) ? EVP_sha384() : EVP_sha512(), NULL);
+    return (0);
+}
+
+void mbedtls_sha512_init(mbedtls_sha512_context * context) {
+    context->md = EVP_MD_CTX_new();
+}
+
+void mbedtls_sha512_free(mbedtls_sha512_context * context) {
+    EVP_MD_CTX_free((EVP_MD_CTX *)context->md);
+    context->md = NULL;
+}
+
+int mbedtls_sha512_starts_ret(mbedtls_sha512_context * context, int is384) {
+    return ((EVP_DigestInit_ex((EVP_MD_CTX *)context->md, (is384 != 0) ? EVP_sha384() : EVP_sha512(), NULL) == 1) ? 0 : -1);
+}
+
+int mbedtls_sha512_update_ret(mbedtls_sha512_context * context, const unsigned char * input, size_t length) {
+    return ((EVP_DigestUpdate((EVP_MD_CTX *)context->md, input, length) == 1) ? 0 : -1);
+}
+
+int mbedtls_sha512_finish_ret(mbedtls_sha512_context * context, unsigned char output[64]) {
+    return ((EVP_DigestFinal_ex((EVP_MD_CTX *)context->md, output, NULL) == 1) ? 0 : -1);
+}
+
+int mbedtls_base64_encode(unsigned char * dst, size_t dlen, size_t * olen, const unsigned char * src, size_t slen) {
+    size_t needed = 4U * ((slen + 2U) / 3U) + 1U;
+    size_t n = 0;
+
+    if (slen == 0U) {
+        *olen = 0U;
+        return (0);
+    }
+    if ((dst == NULL) || (dlen < needed)) {
+        *olen = needed;
+        return (MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL);
+    }
+
+    for (size_t i = 0; i < slen; i += 3U) {
+        uint32_t block = ((uint32_t)src[i] << 16) | ((i + 1U < slen) ? ((uint32_t)src[i + 1U] << 8) : 0U) |
+                         ((i + 2U < slen) ? (uint32_t)src[i + 2U] : 0U);
+        dst[n++] = base64Alphabet[(block >> 18) & 0x3FU];
+        dst[n++] = base64Alphabet[(block >> 12) & 0x3FU];
+        dst[n++] = (i + 1U < slen) ? base64Alphabet[(block >> 6) & 0x3FU] : '=';
+        dst[n++] = (i + 2U < slen) ? base64Alphabet[block & 0x3FU] : '=';
+    }
+    dst[n] = '\0';
+    *olen = n;
+
+    return (0);
+}
+
+int mbedtls_base64_decode(unsigned char * dst, size_t dlen, size_t * olen, const unsigned char * src, size_t slen) {
+    size_t digits = 0;
+    size_t pads = 0;
+    uint32_t block = 0;
+    size_t n = 0;
+
+    /* First pass validates and sizes, whitespace is skipped like mbed TLS does */
+    for (size_t i = 0; i < slen; i++) {
+        if ((src[i] == ' ') || (src[i] == '\r') || (src[i] == '\n')) {
+            continue;
+        }
+        if (src[i] == '=') {
+            if (++pads > 2U) {
+                return (MBEDTLS_ERR_BASE64_INVALID_CHARACTER);
+            }
+        } else if ((pads > 0U) || (base64Value(src[i]) < 0)) {
+            return (MBEDTLS_ERR_BASE64_INVALID_CHARACTER);
+        }
+        digits++;
+    }
+    if ((digits % 4U) != 0U) {
+        return (MBEDTLS_ERR_BASE64_INVALID_CHARACTER);
+    }
+
+    size_t needed = (digits / 4U) * 3U - pads;
+    if ((dst == NULL) || (dlen < needed)) {
+        *olen = needed;
+        return (MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL);
+    }
+
+    digits = 0;
+    for (size_t i = 0; i < slen; i++) {
+        int value = (src[i] == '=') ? 0 : base64Value(src[i]);
+        if (value < 0) {
+            continue;
+        }
+        block = (block << 6) | (uint32_t)value;
+        if ((++digits % 4U) == 0U) {
+            for (int shift = 16; (shift >= 0) && (n < needed); shift -= 8) {
+                dst[n++] = (unsigned char)(block >> shift);
+            }
+            block = 0;
+        }
+    }
+    *olen = n;
+
+    return (0);
+}
+
+const mbedtls_md_info_t * mbedtls_md_info_from_type(mbedtls_md_type_t type) {
+    if (type == MBEDTLS_MD_SHA256) {
+        return (&sha256Info);
+    }
+    return ((type == MBEDTLS_MD_SHA512) ? &sha512Info : NULL);
+}
+
+unsigned char mbedtls_md_get_size(const mbedtls_md_info_t * info) {
+    return ((info != NULL) ? info->size : 0U);
+}
+
+int mbedtls_md_hmac(const mbedtls_md_info_t * info, const unsigned char * key, size_t keylen,
+                    const unsigned char * input, size_t ilen, unsigned char * output) {
+    size_t len = 0;
+
+    if (info == NULL) {
+        return (MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+    }
+
+    return ((EVP_Q_mac(NULL, "HMAC", NULL, digestName(info), NULL, key, keylen, input, ilen, output, info->size, &len) != NULL) ?
+            0 : MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+}
+
+void mbedtls_md_init(mbedtls_md_context_t * context) {
+    context->info = NULL;
+    context->mac = NULL;
+}
+
+void mbedtls_md_free(mbedtls_md_context_t * context) {
+    EVP_MAC_CTX_free((EVP_MAC_CTX *)context->mac);
+    context->mac = NULL;
+}
+
+int mbedtls_md_setup(mbedtls_md_context_t * context, const mbedtls_md_info_t * info, int hmac) {
+    EVP_MAC * mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+
+    if ((info == NULL) || (hmac == 0) || (mac == NULL)) {
+        EVP_MAC_free(mac);
+        return (MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+    }
+    context->info = info;
+    context->mac = EVP_MAC_CTX_new(mac);
+    EVP_MAC_free(mac);
+
+    return ((context->mac != NULL) ? 0 : MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+}
+
+int mbedtls_md_hmac_starts(mbedtls_md_context_t * context, const unsigned char * key, size_t keylen) {
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *)digestName(context->info), 0),
+        OSSL_PARAM_construct_end()
+    };
+
+    return ((EVP_MAC_init((EVP_MAC_CTX *)context->mac, key, keylen, params) == 1) ? 0 : MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+}
+
+int mbedtls_md_hmac_update(mbedtls_md_context_t * context, const unsigned char * input, size_t ilen) {
+    return ((EVP_MAC_update((EVP_MAC_CTX *)context->mac, input, ilen) == 1) ? 0 : MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+}
+
+int mbedtls_md_hmac_finish(mbedtls_md_context_t * context, unsigned char * output) {
+    size_t len = 0;
+    return ((EVP_MAC_final((EVP_MAC_CTX *)context->mac, output, &len, context->info->size) == 1) ? 0 : MBEDTLS_ERR_MD_BAD_INPUT_DATA);
+}
+
+void mbedtls_mpi_init(mbedtls_mpi * X) {
+    X->bn = NULL;
+}
+
+void mbedtls_mpi_free(mbedtls_mpi * X) {
+    BN_clear_free((BIGNUM *)X->bn);
+    X->bn = NULL;
+}
+
+void mbedtls_mpi_swap(mbedtls_mpi * X, mbedtls_mpi * Y) {
+    void * bn = X->bn;
+    X->bn = Y->bn;
+    Y->bn = bn;
+}
+
+int mbedtls_mpi_lset(mbedtls_mpi * X, mbedtls_mpi_sint z) {
+    BN_set_word(bn(X), (BN_ULONG)((z < 0) ? -z : z));
+    BN_set_negative(bn(X), (z < 0) ? 1 : 0);
+    return (0);
+}
+
+size_t mbedtls_mpi_size(const mbedtls_mpi * X) {
+    return ((size_t)BN_num_bytes(bn(X)));
+}
+
+int mbedtls_mpi_cmp_mpi(const mbedtls_mpi * X, const mbedtls_mpi * Y) {
+    int cmp = BN_cmp(bn(X), bn(Y));
+    return ((cmp > 0) ? 1 : ((cmp < 0) ? -1 : 0));
+}
+
+int mbedtls_mpi_read_binary(mbedtls_mpi * X, const unsigned char * buf, size_t buflen) {
+    return ((BN_bin2bn(buf, (int)buflen, bn(X)) != NULL) ? 0 : MBEDTLS_ERR_MPI_ALLOC_FAILED);
+}
+
+int mbedtls_mpi_write_binary(const mbedtls_mpi * X, unsigned char * buf, size_t buflen) {
+    return ((BN_bn2binpad(bn(X), buf, (int)buflen) >= 0) ? 0 : MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL);
+}
+
+int mbedtls_mpi_read_string(mbedtls_mpi * X, int radix, const char * s) {
+    BIGNUM * value = bn(X);
+
+    if ((radix != 16) && (radix != 10)) {
+        return (MBEDTLS_ERR_MPI_BAD_INPUT_DATA);
+    }
+
+    return ((((radix == 16) ? BN_hex2bn(&value, s) : BN_dec2bn(&value, s)) > 0) ? 0 : MBEDTLS_ERR_MPI_BAD_INPUT_DATA);
+}
+
+int mbedtls_mpi_write_string(const mbedtls_mpi * X, int radix, char * buf, size_t buflen, size_t * olen) {
+    if ((radix != 16) && (radix != 10)) {
+        return (MBEDTLS_ERR_MPI_BAD_INPUT_DATA);
+    }
+
+    char * text = (radix == 16) ? BN_bn2hex(bn(X)) : BN_bn2dec(bn(X));
+    size_t len = strlen(text) + 1U;
+    int ret = 0;
+
+    *olen = len;
+    if (buflen < len) {
+        ret = MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL;
+    } else {
+        memcpy(buf, text, len);
+    }
+    OPENSSL_free(text);
+
+    return (ret);
+}
+
+int mbedtls_mpi_add_mpi(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * B) {
+    return ((BN_add(bn(X), bn(A), bn(B)) == 1) ? 0 : MBEDTLS_ERR_MPI_ALLOC_FAILED);
+}
+
+int mbedtls_mpi_mul_mpi(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * B) {
+    BN_CTX * ctx = BN_CTX_new();
+    int ret = (BN_mul(bn(X), bn(A), bn(B), ctx) == 1) ? 0 : MBEDTLS_ERR_MPI_ALLOC_FAILED;
+    BN_CTX_free(ctx);
+    return (ret);
+}
+
+int mbedtls_mpi_mod_mpi(mbedtls_mpi * R, const mbedtls_mpi * A, const mbedtls_mpi * B) {
+    BN_CTX * ctx = BN_CTX_new();
+    int ret = (BN_nnmod(bn(R), bn(A), bn(B), ctx) == 1) ? 0 : MBEDTLS_ERR_MPI_BAD_INPUT_DATA;
+    BN_CTX_free(ctx);
+    return (ret);
+}
+
+int mbedtls_mpi_exp_mod(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * E, const mbedtls_mpi * N, mbedtls_mpi * RR) {
+    (void)RR;
+    BN_CTX * ctx = BN_CTX_new();
+    int ret = (BN_mod_exp(bn(X), bn(A), bn(E), bn(N), ctx) == 1) ? 0 : MBEDTLS_ERR_MPI_BAD_INPUT_DATA;
+    BN_CTX_free(ctx);
+    return (ret);
+}
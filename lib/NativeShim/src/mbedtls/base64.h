@@ -0,0 +1,22 @@
+#ifndef MBEDTLS_BASE64_H
+#define MBEDTLS_BASE64_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL     (-0x002A)
+#define MBEDTLS_ERR_BASE64_INVALID_CHARACTER    (-0x002C)
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @note Same contract as mbed TLS: olen reports the size needed when dst is too small */
+int mbedtls_base64_encode(unsigned char * dst, size_t dlen, size_t * olen, const unsigned char * src, size_t slen);
+int mbedtls_base64_decode(unsigned char * dst, size_t dlen, size_t * olen, const unsigned char * src, size_t slen);
+
+#endif /* MBEDTLS_BASE64_H */
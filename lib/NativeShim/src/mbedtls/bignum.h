@@ -0,0 +1,48 @@
+#ifndef MBEDTLS_BIGNUM_H
+#define MBEDTLS_BIGNUM_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define MBEDTLS_ERR_MPI_BAD_INPUT_DATA          (-0x0004)
+#define MBEDTLS_ERR_MPI_BUFFER_TOO_SMALL        (-0x0008)
+#define MBEDTLS_ERR_MPI_ALLOC_FAILED            (-0x0010)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Wraps an OpenSSL BIGNUM, allocated on first use */
+typedef struct {
+    void * bn;
+} mbedtls_mpi;
+
+typedef int64_t mbedtls_mpi_sint;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+void mbedtls_mpi_init(mbedtls_mpi * X);
+void mbedtls_mpi_free(mbedtls_mpi * X);
+void mbedtls_mpi_swap(mbedtls_mpi * X, mbedtls_mpi * Y);
+int mbedtls_mpi_lset(mbedtls_mpi * X, mbedtls_mpi_sint z);
+size_t mbedtls_mpi_size(const mbedtls_mpi * X);
+int mbedtls_mpi_cmp_mpi(const mbedtls_mpi * X, const mbedtls_mpi * Y);
+
+int mbedtls_mpi_read_binary(mbedtls_mpi * X, const unsigned char * buf, size_t buflen);
+int mbedtls_mpi_write_binary(const mbedtls_mpi * X, unsigned char * buf, size_t buflen);
+int mbedtls_mpi_read_string(mbedtls_mpi * X, int radix, const char * s);
+int mbedtls_mpi_write_string(const mbedtls_mpi * X, int radix, char * buf, size_t buflen, size_t * olen);
+
+int mbedtls_mpi_add_mpi(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * B);
+int mbedtls_mpi_mul_mpi(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * B);
+int mbedtls_mpi_mod_mpi(mbedtls_mpi * R, const mbedtls_mpi * A, const mbedtls_mpi * B);
+/** @note RR is the mbed TLS speed-up cache, unused with OpenSSL */
+int mbedtls_mpi_exp_mod(mbedtls_mpi * X, const mbedtls_mpi * A, const mbedtls_mpi * E, const mbedtls_mpi * N, mbedtls_mpi * RR);
+
+#endif /* MBEDTLS_BIGNUM_H */
@@ -0,0 +1,50 @@
+#ifndef MBEDTLS_MD_H
+#define MBEDTLS_MD_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define MBEDTLS_MD_MAX_SIZE                     (64)
+#define MBEDTLS_ERR_MD_BAD_INPUT_DATA           (-0x5100)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef enum {
+    MBEDTLS_MD_NONE = 0,
+    MBEDTLS_MD_SHA256 = 6,
+    MBEDTLS_MD_SHA512 = 8
+} mbedtls_md_type_t;
+
+typedef struct {
+    mbedtls_md_type_t type;
+    unsigned char size;
+} mbedtls_md_info_t;
+
+/** @brief Wraps an OpenSSL MAC context, HMAC only */
+typedef struct {
+    const mbedtls_md_info_t * info;
+    void * mac;
+} mbedtls_md_context_t;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+const mbedtls_md_info_t * mbedtls_md_info_from_type(mbedtls_md_type_t type);
+unsigned char mbedtls_md_get_size(const mbedtls_md_info_t * info);
+int mbedtls_md_hmac(const mbedtls_md_info_t * info, const unsigned char * key, size_t keylen,
+                    const unsigned char * input, size_t ilen, unsigned char * output);
+
+void mbedtls_md_init(mbedtls_md_context_t * context);
+void mbedtls_md_free(mbedtls_md_context_t * context);
+int mbedtls_md_setup(mbedtls_md_context_t * context, const mbedtls_md_info_t * info, int hmac);
+int mbedtls_md_hmac_starts(mbedtls_md_context_t * context, const unsigned char * key, size_t keylen);
+int mbedtls_md_hmac_update(mbedtls_md_context_t * context, const unsigned char * input, size_t ilen);
+int mbedtls_md_hmac_finish(mbedtls_md_context_t * context, unsigned char * output);
+
+#endif /* MBEDTLS_MD_H */
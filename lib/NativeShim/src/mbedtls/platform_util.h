@@ -0,0 +1,14 @@
+#ifndef MBEDTLS_PLATFORM_UTIL_H
+#define MBEDTLS_PLATFORM_UTIL_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+void mbedtls_platform_zeroize(void * buffer, size_t length);
+
+#endif /* MBEDTLS_PLATFORM_UTIL_H */
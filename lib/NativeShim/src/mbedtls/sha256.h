@@ -0,0 +1,14 @@
+#ifndef MBEDTLS_SHA256_H
+#define MBEDTLS_SHA256_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+int mbedtls_sha256_ret(const unsigned char * input, size_t length, unsigned char output[32], int is224);
+
+#endif /* MBEDTLS_SHA256_H */
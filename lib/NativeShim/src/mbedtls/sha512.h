@@ -0,0 +1,27 @@
+#ifndef MBEDTLS_SHA512_H
+#define MBEDTLS_SHA512_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Wraps an OpenSSL digest context */
+typedef struct {
+    void * md;
+} mbedtls_sha512_context;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+int mbedtls_sha512_ret(const unsigned char * input, size_t length, unsigned char output[64], int is384);
+void mbedtls_sha512_init(mbedtls_sha512_context * context);
+void mbedtls_sha512_free(mbedtls_sha512_context * context);
+int mbedtls_sha512_starts_ret(mbedtls_sha512_context * context, int is384);
+int mbedtls_sha512_update_ret(mbedtls_sha512_context * context, const unsigned char * input, size_t length);
+int mbedtls_sha512_finish_ret(mbedtls_sha512_context * context, unsigned char output[64]);
+
+#endif /* MBEDTLS_SHA512_H */
@@ -0,0 +1,10 @@
+#ifndef MBEDTLS_VERSION_H
+#define MBEDTLS_VERSION_H
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/** @brief Names the OpenSSL build the host primitives come from */
+void mbedtls_version_get_string_full(char * string);
+
+#endif /* MBEDTLS_VERSION_H */
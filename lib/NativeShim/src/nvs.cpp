@@ -0,0 +1,164 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* Local files */
+#include "nvs_flash.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef std::map<std::string, std::vector<uint8_t>> t_nvsNamespace;
+
+/** @brief Namespace and mode behind a handle */
+struct NativeNvsHandle {
+    std::string name;
+    nvs_open_mode_t mode;
+};
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static std::mutex nvsLock;
+static std::map<std::string, t_nvsNamespace> nvsStorage;
+static std::map<nvs_handle_t, NativeNvsHandle> nvsHandles;
+static nvs_handle_t nvsNextHandle = 1U;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Namespace of a handle, NULL when the handle is unknown */
+static t_nvsNamespace * space(const nvs_handle_t handle) {
+    auto it = nvsHandles.find(handle);
+    return ((it != nvsHandles.end()) ? &nvsStorage[it->second.name] : NULL);
+}
+
+static esp_err_t setValue(const nvs_handle_t handle, const char * key, const void * value, const size_t length) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    t_nvsNamespace * entries = space(handle);
+
+    if (entries == NULL) {
+        return (ESP_ERR_NVS_INVALID_HANDLE);
+    }
+    if (nvsHandles[handle].mode == NVS_READONLY) {
+        return (ESP_ERR_NVS_READ_ONLY);
+    }
+    const uint8_t * bytes = (const uint8_t *)value;
+    (*entries)[key] = std::vector<uint8_t>(bytes, bytes + length);
+
+    return (ESP_OK);
+}
+
+/** @brief Copy a value out, or only report its length when value is NULL */
+static esp_err_t getValue(const nvs_handle_t handle, const char * key, void * value, size_t * length) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    t_nvsNamespace * entries = space(handle);
+
+    if (entries == NULL) {
+        return (ESP_ERR_NVS_INVALID_HANDLE);
+    }
+    auto it = entries->find(key);
+    if (it == entries->end()) {
+        return (ESP_ERR_NVS_NOT_FOUND);
+    }
+    if (value == NULL) {
+        *length = it->second.size();
+        return (ESP_OK);
+    }
+    if (*length < it->second.size()) {
+        return (ESP_ERR_NVS_INVALID_LENGTH);
+    }
+    memcpy(value, it->second.data(), it->second.size());
+    *length = it->second.size();
+
+    return (ESP_OK);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+esp_err_t nvs_flash_init(void) {
+    return (ESP_OK);
+}
+
+esp_err_t nvs_flash_erase(void) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    nvsStorage.clear();
+    return (ESP_OK);
+}
+
+esp_err_t nvs_open(const char * name, nvs_open_mode_t mode, nvs_handle_t * handle) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+
+    /* Reading a namespace that was never written fails, as on flash */
+    if ((mode == NVS_READONLY) && (nvsStorage.find(name) == nvsStorage.end())) {
+        return (ESP_ERR_NVS_NOT_FOUND);
+    }
+    *handle = nvsNextHandle++;
+    nvsHandles[*handle] = {name, mode};
+
+    return (ESP_OK);
+}
+
+void nvs_close(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    nvsHandles.erase(handle);
+}
+
+esp_err_t nvs_commit(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    return ((nvsHandles.find(handle) != nvsHandles.end()) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE);
+}
+
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char * key) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    t_nvsNamespace * entries = space(handle);
+
+    if (entries == NULL) {
+        return (ESP_ERR_NVS_INVALID_HANDLE);
+    }
+
+    return ((entries->erase(key) > 0U) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND);
+}
+
+esp_err_t nvs_erase_all(nvs_handle_t handle) {
+    std::lock_guard<std::mutex> lock(nvsLock);
+    t_nvsNamespace * entries = space(handle);
+
+    if (entries == NULL) {
+        return (ESP_ERR_NVS_INVALID_HANDLE);
+    }
+    entries->clear();
+
+    return (ESP_OK);
+}
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char * key, uint8_t value) {
+    return (setValue(handle, key, &value, sizeof(value)));
+}
+
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char * key, uint8_t * value) {
+    size_t length = sizeof(*value);
+    return (getValue(handle, key, value, &length));
+}
+
+esp_err_t nvs_set_str(nvs_handle_t handle, const char * key, const char * value) {
+    return (setValue(handle, key, value, strlen(value) + 1U));
+}
+
+esp_err_t nvs_get_str(nvs_handle_t handle, const char * key, char * value, size_t * length) {
+    return (getValue(handle, key, value, length));
+}
+
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char * key, const void * value, size_t length) {
+    return (setValue(handle, key, value, length));
+}
+
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char * key, void * value, size_t * length) {
+    return (getValue(handle, key, value, length));
+}
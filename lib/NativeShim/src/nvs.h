@@ -0,0 +1,56 @@
+#ifndef NVS_H
+#define NVS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+
+/* Local files */
+#include "esp_err.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define ESP_ERR_NVS_BASE                        (0x1100)
+#define ESP_ERR_NVS_NOT_INITIALIZED             (ESP_ERR_NVS_BASE + 0x01)
+#define ESP_ERR_NVS_NOT_FOUND                   (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_READ_ONLY                   (ESP_ERR_NVS_BASE + 0x04)
+#define ESP_ERR_NVS_INVALID_HANDLE              (ESP_ERR_NVS_BASE + 0x07)
+#define ESP_ERR_NVS_INVALID_LENGTH              (ESP_ERR_NVS_BASE + 0x0C)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+typedef uint32_t nvs_handle_t;
+typedef nvs_handle_t nvs_handle;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE
+} nvs_open_mode_t;
+typedef nvs_open_mode_t nvs_open_mode;
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @note The host NVS lives in memory for the life of the process: what a
+ *       test writes is what the next begin() reads back, until
+ *       nvs_flash_erase().
+ */
+esp_err_t nvs_open(const char * name, nvs_open_mode_t mode, nvs_handle_t * handle);
+void nvs_close(nvs_handle_t handle);
+esp_err_t nvs_commit(nvs_handle_t handle);
+esp_err_t nvs_erase_key(nvs_handle_t handle, const char * key);
+esp_err_t nvs_erase_all(nvs_handle_t handle);
+
+esp_err_t nvs_set_u8(nvs_handle_t handle, const char * key, uint8_t value);
+esp_err_t nvs_get_u8(nvs_handle_t handle, const char * key, uint8_t * value);
+esp_err_t nvs_set_str(nvs_handle_t handle, const char * key, const char * value);
+esp_err_t nvs_get_str(nvs_handle_t handle, const char * key, char * value, size_t * length);
+esp_err_t nvs_set_blob(nvs_handle_t handle, const char * key, const void * value, size_t length);
+esp_err_t nvs_get_blob(nvs_handle_t handle, const char * key, void * value, size_t * length);
+
+#endif /* NVS_H */
@@ -0,0 +1,17 @@
+#ifndef NVS_FLASH_H
+#define NVS_FLASH_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "nvs.h"
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+esp_err_t nvs_flash_init(void);
+/** @brief Drop every namespace, open handles stay valid */
+esp_err_t nvs_flash_erase(void);
+
+#endif /* NVS_FLASH_H */
@@ -0,0 +1,138 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "driver/gpio.h"
+#include "driver/ledc.h"
+#include "driver/rmt.h"
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static uint32_t ledcDuty[LEDC_SPEED_MODE_MAX][LEDC_CHANNEL_MAX];
+static ledc_cbs_t ledcCallbacks[LEDC_SPEED_MODE_MAX][LEDC_CHANNEL_MAX];
+static void * ledcArgs[LEDC_SPEED_MODE_MAX][LEDC_CHANNEL_MAX];
+static rmt_isr_t rmtHandler = NULL;
+static void * rmtArg = NULL;
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+volatile gpio_dev_t GPIO;
+volatile rmt_dev_t RMT;
+volatile rmt_mem_t RMTMEM;
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+esp_err_t ledc_timer_config(const ledc_timer_config_t * config) {
+    (void)config;
+    return (ESP_OK);
+}
+
+esp_err_t ledc_channel_config(const ledc_channel_config_t * config) {
+    ledcDuty[config->speed_mode][config->channel] = config->duty;
+    return (ESP_OK);
+}
+
+uint32_t ledc_get_duty(const ledc_mode_t mode, const ledc_channel_t channel) {
+    return (ledcDuty[mode][channel]);
+}
+
+esp_err_t ledc_fade_func_install(const int flags) {
+    (void)flags;
+    return (ESP_OK);
+}
+
+esp_err_t ledc_cb_register(const ledc_mode_t mode, const ledc_channel_t channel, ledc_cbs_t * cbs, void * arg) {
+    ledcCallbacks[mode][channel] = *cbs;
+    ledcArgs[mode][channel] = arg;
+    return (ESP_OK);
+}
+
+esp_err_t ledc_set_fade_time_and_start(const ledc_mode_t mode, const ledc_channel_t channel, const uint32_t duty,
+                                       const uint32_t ms, const ledc_fade_mode_t wait) {
+    ledc_cb_param_t param = {0, (uint32_t)mode, (uint32_t)channel, duty};
+
+    (void)ms;
+    (void)wait;
+    ledcDuty[mode][channel] = duty;
+    if (ledcCallbacks[mode][channel].fade_cb != NULL) {
+        (void)ledcCallbacks[mode][channel].fade_cb(&param, ledcArgs[mode][channel]);
+    }
+
+    return (ESP_OK);
+}
+
+esp_err_t rmt_config(const rmt_config_t * config) {
+    (void)config;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_driver_install(const rmt_channel_t channel, const size_t rxSize, const int flags) {
+    (void)channel;
+    (void)rxSize;
+    (void)flags;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_set_source_clk(const rmt_channel_t channel, const rmt_source_clk_t clock) {
+    (void)channel;
+    (void)clock;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_set_clk_div(const rmt_channel_t channel, const uint8_t divider) {
+    (void)channel;
+    (void)divider;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_write_items(const rmt_channel_t channel, const rmt_item32_t * items, const int count, const bool wait) {
+    (void)channel;
+    (void)items;
+    (void)count;
+    (void)wait;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_set_tx_carrier(const rmt_channel_t channel, const bool enable, const uint16_t high, const uint16_t low,
+                             const rmt_carrier_level_t level) {
+    (void)channel;
+    (void)enable;
+    (void)high;
+    (void)low;
+    (void)level;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_isr_register(rmt_isr_t handler, void * arg, const int flags, void * handle) {
+    (void)flags;
+    (void)handle;
+    rmtHandler = handler;
+    rmtArg = arg;
+    return (ESP_OK);
+}
+
+esp_err_t rmt_set_tx_thr_intr_en(const rmt_channel_t channel, const bool enable, const uint16_t threshold) {
+    (void)threshold;
+    uint32_t bit = 1U << (24U + channel);
+    RMT.int_ena.val = enable ? (RMT.int_ena.val | bit) : (RMT.int_ena.val & ~bit);
+    return (ESP_OK);
+}
+
+esp_err_t rmt_set_tx_intr_en(const rmt_channel_t channel, const bool enable) {
+    uint32_t bit = 1U << (3U * channel);
+    RMT.int_ena.val = enable ? (RMT.int_ena.val | bit) : (RMT.int_ena.val & ~bit);
+    return (ESP_OK);
+}
+
+esp_err_t rmt_tx_start(const rmt_channel_t channel, const bool reset) {
+    (void)reset;
+    RMT.int_st.val = 1U << (3U * channel);
+    if (rmtHandler != NULL) {
+        rmtHandler(rmtArg);
+    }
+    RMT.int_st.val = 0U;
+    return (ESP_OK);
+}
@@ -0,0 +1,13 @@
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Values of the Arduino-ESP32 2.0 sdkconfig the bridge and HomeSpan depend on */
+#define CONFIG_IDF_TARGET                       ("native")
+#define CONFIG_IDF_TARGET_ESP32                 (1)
+#define CONFIG_LWIP_MAX_SOCKETS                 (16)
+#define CONFIG_FREERTOS_HZ                      (1000)
+
+#endif /* SDKCONFIG_H */
@@ -0,0 +1,63 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <openssl/evp.h>
+
+/* Local files */
+#include "ArduinoOTA.h"
+#include "ESPmDNS.h"
+#include "MD5Builder.h"
+#include "SPI.h"
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+UpdateClass Update;
+ArduinoOTAClass ArduinoOTA;
+MDNSResponder MDNS;
+SPIClass SPI;
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+esp_err_t mdns_service_txt_item_set(const char * service, const char * proto, const char * key, const char * value) {
+    (void)service;
+    (void)proto;
+    (void)key;
+    (void)value;
+    return (ESP_OK);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+MD5Builder::~MD5Builder() {
+    EVP_MD_CTX_free((EVP_MD_CTX *)context);
+}
+
+void MD5Builder::begin(void) {
+    if (context == NULL) {
+        context = EVP_MD_CTX_new();
+    }
+    EVP_DigestInit_ex((EVP_MD_CTX *)context, EVP_md5(), NULL);
+}
+
+void MD5Builder::add(const uint8_t * data, const size_t length) {
+    EVP_DigestUpdate((EVP_MD_CTX *)context, data, length);
+}
+
+void MD5Builder::calculate(void) {
+    EVP_DigestFinal_ex((EVP_MD_CTX *)context, digest, NULL);
+}
+
+void MD5Builder::getChars(char * output) const {
+    for (size_t i = 0; i < sizeof(digest); i++) {
+        sprintf(output + 2U * i, "%02x", digest[i]);
+    }
+}
+
+String MD5Builder::toString(void) const {
+    char text[33];
+    getChars(text);
+    return (String(text));
+}
@@ -0,0 +1,6 @@
+#ifndef SOC_RMT_REG_H
+#define SOC_RMT_REG_H
+
+/* RMT_SYS_CONF_REG is left undefined, as on the original ESP32 */
+
+#endif /* SOC_RMT_REG_H */
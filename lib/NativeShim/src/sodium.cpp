@@ -0,0 +1,190 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <openssl/evp.h>
+
+/* Local files */
+#include "sodium.h"
+#include "esp_system.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define CHACHA_KEY_LEN                          (32U)
+#define CHACHA_NONCE_LEN                        (12U)
+#define CURVE_KEY_LEN                           (32U)
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Run one ChaCha20-Poly1305 pass, the tag is written or checked by the caller */
+static EVP_CIPHER_CTX * chachaStart(const bool encrypt, const unsigned char * ad, const unsigned long long adlen,
+                                    const unsigned char * npub, const unsigned char * k) {
+    EVP_CIPHER_CTX * ctx = EVP_CIPHER_CTX_new();
+    int len = 0;
+
+    if ((ctx == NULL) ||
+        (EVP_CipherInit_ex(ctx, EVP_chacha20_poly1305(), NULL, NULL, NULL, encrypt ? 1 : 0) != 1) ||
+        (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, CHACHA_NONCE_LEN, NULL) != 1) ||
+        (EVP_CipherInit_ex(ctx, NULL, NULL, k, npub, encrypt ? 1 : 0) != 1) ||
+        ((adlen > 0U) && (EVP_CipherUpdate(ctx, NULL, &len, ad, (int)adlen) != 1))) {
+        EVP_CIPHER_CTX_free(ctx);
+        return (NULL);
+    }
+
+    return (ctx);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+const char * sodium_version_string(void) {
+    return ("native");
+}
+
+int sodium_library_version_major(void) {
+    return (10);
+}
+
+int sodium_library_version_minor(void) {
+    return (3);
+}
+
+void randombytes_buf(void * const buf, const size_t size) {
+    esp_fill_random(buf, size);
+}
+
+int crypto_aead_chacha20poly1305_ietf_encrypt(unsigned char * c, unsigned long long * clen_p,
+                                              const unsigned char * m, unsigned long long mlen,
+                                              const unsigned char * ad, unsigned long long adlen,
+                                              const unsigned char * nsec, const unsigned char * npub,
+                                              const unsigned char * k) {
+    (void)nsec;
+    EVP_CIPHER_CTX * ctx = chachaStart(true, ad, adlen, npub, k);
+    int len = 0;
+    int ret = -1;
+
+    if ((ctx != NULL) &&
+        ((mlen == 0U) || (EVP_CipherUpdate(ctx, c, &len, m, (int)mlen) == 1)) &&
+        (EVP_CipherFinal_ex(ctx, c + len, &len) == 1) &&
+        (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, crypto_aead_chacha20poly1305_IETF_ABYTES, c + mlen) == 1)) {
+        if (clen_p != NULL) {
+            *clen_p = mlen + crypto_aead_chacha20poly1305_IETF_ABYTES;
+        }
+        ret = 0;
+    }
+    EVP_CIPHER_CTX_free(ctx);
+
+    return (ret);
+}
+
+int crypto_aead_chacha20poly1305_ietf_decrypt(unsigned char * m, unsigned long long * mlen_p,
+                                              unsigned char * nsec,
+                                              const unsigned char * c, unsigned long long clen,
+                                              const unsigned char * ad, unsigned long long adlen,
+                                              const unsigned char * npub, const unsigned char * k) {
+    (void)nsec;
+    unsigned char tag[crypto_aead_chacha20poly1305_IETF_ABYTES];
+    EVP_CIPHER_CTX * ctx;
+    int len = 0;
+    int ret = -1;
+
+    if (clen < crypto_aead_chacha20poly1305_IETF_ABYTES) {
+        return (-1);
+    }
+    unsigned long long mlen = clen - crypto_aead_chacha20poly1305_IETF_ABYTES;
+    memcpy(tag, c + mlen, sizeof(tag));
+
+    ctx = chachaStart(false, ad, adlen, npub, k);
+    if ((ctx != NULL) &&
+        ((mlen == 0U) || (EVP_CipherUpdate(ctx, m, &len, c, (int)mlen) == 1)) &&
+        (EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, sizeof(tag), tag) == 1) &&
+        (EVP_CipherFinal_ex(ctx, m + len, &len) == 1)) {
+        if (mlen_p != NULL) {
+            *mlen_p = mlen;
+        }
+        ret = 0;
+    }
+    EVP_CIPHER_CTX_free(ctx);
+
+    return (ret);
+}
+
+int crypto_sign_keypair(unsigned char * pk, unsigned char * sk) {
+    size_t len = crypto_sign_PUBLICKEYBYTES;
+
+    randombytes_buf(sk, 32U);
+    EVP_PKEY * key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, sk, 32U);
+    int ret = ((key != NULL) && (EVP_PKEY_get_raw_public_key(key, pk, &len) == 1)) ? 0 : -1;
+    memcpy(sk + 32U, pk, crypto_sign_PUBLICKEYBYTES);
+    EVP_PKEY_free(key);
+
+    return (ret);
+}
+
+int crypto_sign_detached(unsigned char * sig, unsigned long long * siglen_p,
+                         const unsigned char * m, unsigned long long mlen, const unsigned char * sk) {
+    EVP_PKEY * key = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, NULL, sk, 32U);
+    EVP_MD_CTX * ctx = EVP_MD_CTX_new();
+    size_t len = crypto_sign_BYTES;
+    int ret = -1;
+
+    if ((key != NULL) && (ctx != NULL) && (EVP_DigestSignInit(ctx, NULL, NULL, NULL, key) == 1) &&
+        (EVP_DigestSign(ctx, sig, &len, m, (size_t)mlen) == 1)) {
+        if (siglen_p != NULL) {
+            *siglen_p = len;
+        }
+        ret = 0;
+    }
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(key);
+
+    return (ret);
+}
+
+int crypto_sign_verify_detached(const unsigned char * sig, const unsigned char * m,
+                                unsigned long long mlen, const unsigned char * pk) {
+    EVP_PKEY * key = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, NULL, pk, crypto_sign_PUBLICKEYBYTES);
+    EVP_MD_CTX * ctx = EVP_MD_CTX_new();
+    int ret = -1;
+
+    if ((key != NULL) && (ctx != NULL) && (EVP_DigestVerifyInit(ctx, NULL, NULL, NULL, key) == 1) &&
+        (EVP_DigestVerify(ctx, sig, crypto_sign_BYTES, m, (size_t)mlen) == 1)) {
+        ret = 0;
+    }
+    EVP_MD_CTX_free(ctx);
+    EVP_PKEY_free(key);
+
+    return (ret);
+}
+
+int crypto_box_keypair(unsigned char * pk, unsigned char * sk) {
+    size_t len = CURVE_KEY_LEN;
+
+    randombytes_buf(sk, CURVE_KEY_LEN);
+    EVP_PKEY * key = EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, NULL, sk, CURVE_KEY_LEN);
+    int ret = ((key != NULL) && (EVP_PKEY_get_raw_public_key(key, pk, &len) == 1)) ? 0 : -1;
+    EVP_PKEY_free(key);
+
+    return (ret);
+}
+
+int crypto_scalarmult_curve25519(unsigned char * q, const unsigned char * n, const unsigned char * p) {
+    EVP_PKEY * secret = EVP_PKEY_new_raw_private_key(EVP_PKEY_X25519, NULL, n, CURVE_KEY_LEN);
+    EVP_PKEY * peer = EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, NULL, p, CURVE_KEY_LEN);
+    EVP_PKEY_CTX * ctx = (secret != NULL) ? EVP_PKEY_CTX_new(secret, NULL) : NULL;
+    size_t len = CURVE_KEY_LEN;
+    int ret = -1;
+
+    /* OpenSSL rejects an all-zero shared secret, as libsodium does */
+    if ((peer != NULL) && (ctx != NULL) && (EVP_PKEY_derive_init(ctx) == 1) &&
+        (EVP_PKEY_derive_set_peer(ctx, peer) == 1) && (EVP_PKEY_derive(ctx, q, &len) == 1)) {
+        ret = 0;
+    }
+    EVP_PKEY_CTX_free(ctx);
+    EVP_PKEY_free(peer);
+    EVP_PKEY_free(secret);
+
+    return (ret);
+}
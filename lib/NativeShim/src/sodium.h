@@ -0,0 +1,55 @@
+#ifndef SODIUM_H
+#define SODIUM_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stddef.h>
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+#define crypto_aead_chacha20poly1305_IETF_ABYTES    (16U)
+#define crypto_sign_BYTES                           (64U)
+#define crypto_sign_PUBLICKEYBYTES                  (32U)
+#define crypto_sign_SECRETKEYBYTES                  (64U)
+#define crypto_box_PUBLICKEYBYTES                   (32U)
+#define crypto_box_SECRETKEYBYTES                   (32U)
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @note The libsodium subset HomeSpan uses, on top of OpenSSL. Keys and
+ *       buffers follow the libsodium layouts, e.g. an Ed25519 secret key
+ *       is the 32-byte seed followed by the public key.
+ */
+const char * sodium_version_string(void);
+int sodium_library_version_major(void);
+int sodium_library_version_minor(void);
+
+/** @brief Draws from esp_fill_random(), so runs stay reproducible */
+void randombytes_buf(void * const buf, const size_t size);
+
+int crypto_aead_chacha20poly1305_ietf_encrypt(unsigned char * c, unsigned long long * clen_p,
+                                              const unsigned char * m, unsigned long long mlen,
+                                              const unsigned char * ad, unsigned long long adlen,
+                                              const unsigned char * nsec, const unsigned char * npub,
+                                              const unsigned char * k);
+int crypto_aead_chacha20poly1305_ietf_decrypt(unsigned char * m, unsigned long long * mlen_p,
+                                              unsigned char * nsec,
+                                              const unsigned char * c, unsigned long long clen,
+                                              const unsigned char * ad, unsigned long long adlen,
+                                              const unsigned char * npub, const unsigned char * k);
+
+int crypto_sign_keypair(unsigned char * pk, unsigned char * sk);
+int crypto_sign_detached(unsigned char * sig, unsigned long long * siglen_p,
+                         const unsigned char * m, unsigned long long mlen, const unsigned char * sk);
+int crypto_sign_verify_detached(const unsigned char * sig, const unsigned char * m,
+                                unsigned long long mlen, const unsigned char * pk);
+
+int crypto_box_keypair(unsigned char * pk, unsigned char * sk);
+int crypto_scalarmult_curve25519(unsigned char * q, const unsigned char * n, const unsigned char * p);
+
+#endif /* SODIUM_H */
@@ -0,0 +1,325 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <string>
+
+/* Local files */
+#include "fakeRelay.h"
+#include "esp_timer.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Time in ms the serving thread waits before checking whether it must stop */
+#define FAKE_RELAY_POLL_PERIOD                  (10)
+
+/** @brief Longest request header accepted */
+#define FAKE_RELAY_MAX_REQUEST                  (1024U)
+
+/** @brief Body answered by E_FAKE_RELAY_GARBAGE */
+#define FAKE_RELAY_GARBAGE_BODY                 ("<html>relay busy</html>")
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Wait until fd has something to read, or running is cleared */
+static bool waitReadable(const int fd, const std::atomic<bool> & running) {
+    struct pollfd entry = {fd, POLLIN, 0};
+
+    while (running.load()) {
+        int ready = poll(&entry, 1, FAKE_RELAY_POLL_PERIOD);
+        if (ready > 0) {
+            return (true);
+        }
+        if (ready < 0) {
+            return (false);
+        }
+    }
+
+    return (false);
+}
+
+/** @brief Sleep in short slices so end() is not held up */
+static void sleepFor(const uint32_t ms, const std::atomic<bool> & running) {
+    auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+
+    while (running.load() && (std::chrono::steady_clock::now() < until)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+static void sendAnswer(const int fd, const int code, const std::string & body) {
+    char header[160];
+    int len = snprintf(header, sizeof(header),
+                       "HTTP/1.1 %d %s\r\nContent-Type: text/plain\r\nContent-Length: %u\r\nConnection: close\r\n\r\n",
+                       code, code == 200 ? "OK" : "Internal Server Error", (unsigned int)body.size());
+    std::string answer = std::string(header, len) + body;
+
+    (void)send(fd, answer.data(), answer.size(), MSG_NOSIGNAL);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+bool FakeRelay::begin(const t_esp01sRelayTransport protocol, const char * const key) {
+    struct sockaddr_in address = {};
+    socklen_t len = sizeof(address);
+
+    end();
+    transport = protocol;
+    udpKey = key;
+    listener = socket(AF_INET, (transport == E_ESP01S_RELAY_UDP) ? SOCK_DGRAM : SOCK_STREAM, 0);
+    if (listener < 0) {
+        return (false);
+    }
+
+    address.sin_family = AF_INET;
+    address.sin_port = 0;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if ((bind(listener, (struct sockaddr *)&address, sizeof(address)) < 0) ||
+        ((transport == E_ESP01S_RELAY_HTTP) && (listen(listener, 4) < 0)) ||
+        (getsockname(listener, (struct sockaddr *)&address, &len) < 0)) {
+        close(listener);
+        listener = -1;
+        return (false);
+    }
+    port = ntohs(address.sin_port);
+
+    running = true;
+    worker = std::thread(&FakeRelay::serve, this);
+
+    return (true);
+}
+
+void FakeRelay::end(void) {
+    running = false;
+    if (worker.joinable()) {
+        worker.join();
+    }
+    if (listener >= 0) {
+        close(listener);
+        listener = -1;
+    }
+}
+
+void FakeRelay::push(const t_fakeRelayAction action, const uint32_t delayMs) {
+    std::lock_guard<std::mutex> guard(lock);
+    script.push_back({action, delayMs});
+}
+
+void FakeRelay::setFallback(const t_fakeRelayAction action, const uint32_t delayMs) {
+    std::lock_guard<std::mutex> guard(lock);
+    fallback = {action, delayMs};
+}
+
+void FakeRelay::setState(const t_esp01sRelayState newState) {
+    std::lock_guard<std::mutex> guard(lock);
+    state = newState;
+}
+
+t_esp01sRelayState FakeRelay::getState(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    return (state);
+}
+
+void FakeRelay::setJsonStatus(const bool json) {
+    std::lock_guard<std::mutex> guard(lock);
+    jsonStatus = json;
+}
+
+std::vector<t_fakeRelayRequest> FakeRelay::getRequests(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    return (requests);
+}
+
+uint32_t FakeRelay::countCommands(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    uint32_t count = 0U;
+
+    for (const t_fakeRelayRequest & request : requests) {
+        count += request.command ? 1U : 0U;
+    }
+
+    return (count);
+}
+
+uint32_t FakeRelay::countCommands(const t_esp01sRelayState requested) {
+    std::lock_guard<std::mutex> guard(lock);
+    uint32_t count = 0U;
+
+    for (const t_fakeRelayRequest & request : requests) {
+        count += (request.command && (request.state == requested)) ? 1U : 0U;
+    }
+
+    return (count);
+}
+
+uint32_t FakeRelay::countStatusRequests(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    uint32_t count = 0U;
+
+    for (const t_fakeRelayRequest & request : requests) {
+        count += request.command ? 0U : 1U;
+    }
+
+    return (count);
+}
+
+void FakeRelay::reset(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    requests.clear();
+    script.clear();
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void FakeRelay::serve(void) {
+    while (running.load()) {
+        if (waitReadable(listener, running) == false) {
+            continue;
+        }
+        if (transport == E_ESP01S_RELAY_UDP) {
+            handleDatagram();
+            continue;
+        }
+        int fd = accept(listener, NULL, NULL);
+        if (fd >= 0) {
+            handle(fd);
+            close(fd);
+        }
+    }
+}
+
+void FakeRelay::handle(const int fd) {
+    std::string request;
+    char buffer[256];
+    unsigned int value = 0U;
+    t_fakeRelayRequest entry = {};
+
+    /* Read the header, the relay requests have no body */
+    while (request.find("\r\n\r\n") == std::string::npos) {
+        if ((request.size() > FAKE_RELAY_MAX_REQUEST) || (waitReadable(fd, running) == false)) {
+            return;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return;
+        }
+        request.append(buffer, n);
+    }
+
+    entry.time = (uint64_t)(esp_timer_get_time() / 1000);
+    if (sscanf(request.c_str(), "GET /relay_command?val=%u", &value) == 1) {
+        entry.command = true;
+        entry.state = (value != 0U) ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN;
+    } else if (request.compare(0, strlen("GET /relay_status"), "GET /relay_status") != 0) {
+        sendAnswer(fd, 404, "");
+        return;
+    }
+
+    t_fakeRelayStep step = nextStep(entry);
+    sleepFor(step.delayMs, running);
+
+    t_esp01sRelayState current = apply(entry, step);
+    std::string body;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (jsonStatus && !entry.command) {
+            body = "{\"state\":" + std::to_string((int)current) + ",\"uptime\":" +
+                   std::to_string(entry.time / 1000U) + ",\"rssi\":-55}";
+        } else {
+            body = std::to_string((int)current);
+        }
+    }
+
+    switch (step.action) {
+        case E_FAKE_RELAY_ANSWER:
+            sendAnswer(fd, 200, body);
+            break;
+        case E_FAKE_RELAY_ERROR:
+            sendAnswer(fd, 500, "");
+            break;
+        case E_FAKE_RELAY_GARBAGE:
+            sendAnswer(fd, 200, FAKE_RELAY_GARBAGE_BODY);
+            break;
+        case E_FAKE_RELAY_CORRUPT:
+            sendAnswer(fd, 200, body.substr(0, body.size() - 1U));
+            break;
+        case E_FAKE_RELAY_HANG:
+            /* Hold the connection until the client gives up */
+            while (waitReadable(fd, running) && (recv(fd, buffer, sizeof(buffer), 0) > 0)) {
+            }
+            break;
+        case E_FAKE_RELAY_LOST:
+        case E_FAKE_RELAY_DROP:
+        default:
+            break;
+    }
+}
+
+void FakeRelay::handleDatagram(void) {
+    t_relayUdpPacket request;
+    t_relayUdpPacket answer;
+    struct sockaddr_in from = {};
+    socklen_t fromLen = sizeof(from);
+    t_fakeRelayRequest entry = {};
+
+    ssize_t len = recvfrom(listener, &request, sizeof(request), 0, (struct sockaddr *)&from, &fromLen);
+
+    /* The firmware ignores anything not authenticated, and its own ACKs */
+    if ((RelayUdp::verify(&request, (int)len, udpKey) == false) || (request.type == E_RELAY_UDP_ACK)) {
+        return;
+    }
+
+    entry.time = (uint64_t)(esp_timer_get_time() / 1000);
+    entry.command = (request.type == E_RELAY_UDP_SET);
+    entry.state = (request.state != 0U) ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN;
+
+    t_fakeRelayStep step = nextStep(entry);
+    sleepFor(step.delayMs, running);
+
+    t_esp01sRelayState current = apply(entry, step);
+    if ((step.action != E_FAKE_RELAY_ANSWER) && (step.action != E_FAKE_RELAY_GARBAGE) && (step.action != E_FAKE_RELAY_CORRUPT)) {
+        return;
+    }
+
+    RelayUdp::encode(&answer, E_RELAY_UDP_ACK, (uint8_t)current, request.sequence, udpKey);
+    if ((step.action == E_FAKE_RELAY_GARBAGE) || (step.action == E_FAKE_RELAY_CORRUPT)) {
+        answer.tag[0] ^= 0xFFU;
+    }
+    (void)sendto(listener, &answer, sizeof(answer), 0, (struct sockaddr *)&from, fromLen);
+}
+
+t_fakeRelayStep FakeRelay::nextStep(t_fakeRelayRequest & entry) {
+    std::lock_guard<std::mutex> guard(lock);
+    t_fakeRelayStep step = fallback;
+
+    if (script.empty() == false) {
+        step = script.front();
+        script.pop_front();
+    }
+    entry.action = step.action;
+    requests.push_back(entry);
+
+    return (step);
+}
+
+t_esp01sRelayState FakeRelay::apply(const t_fakeRelayRequest & entry, const t_fakeRelayStep & step) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (entry.command && ((step.action == E_FAKE_RELAY_ANSWER) || (step.action == E_FAKE_RELAY_GARBAGE) ||
+                          (step.action == E_FAKE_RELAY_CORRUPT) || (step.action == E_FAKE_RELAY_LOST))) {
+        state = entry.state;
+    }
+
+    return (state);
+}
@@ -0,0 +1,164 @@
+#ifndef FAKE_RELAY_H
+#define FAKE_RELAY_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Local files */
+#include "devices/esp01sRelay.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief What the fake relay does with a request */
+typedef enum {
+    E_FAKE_RELAY_ANSWER  = 0U,          /**< Apply the request and answer it */
+    E_FAKE_RELAY_ERROR   = 1U,          /**< Answer HTTP 500 without applying the request, UDP has no error answer */
+    E_FAKE_RELAY_GARBAGE = 2U,          /**< Apply the request, answer 200 with a body that is not a relay status, or an ACK with a bad tag */
+    E_FAKE_RELAY_LOST    = 3U,          /**< Apply the request, close the connection without answering */
+    E_FAKE_RELAY_DROP    = 4U,          /**< Close the connection without applying nor answering */
+    E_FAKE_RELAY_HANG    = 5U,          /**< Never answer, the client times out */
+    E_FAKE_RELAY_CORRUPT = 6U           /**< Apply the request, answer 200 with the body cut short, or an ACK with a bad tag */
+} t_fakeRelayAction;
+
+/** @brief One scripted answer */
+typedef struct {
+    t_fakeRelayAction action;           /**< What to do with the request */
+    uint32_t delayMs;                   /**< Time slept before doing it, real time */
+} t_fakeRelayStep;
+
+/** @brief Request log entry */
+typedef struct {
+    uint64_t time;                      /**< esp_timer_get_time() in ms when the request was received */
+    bool command;                       /**< true for /relay_command or SET, false for /relay_status or GET */
+    t_esp01sRelayState state;           /**< Requested state, commands only */
+    t_fakeRelayAction action;           /**< What was done with the request */
+} t_fakeRelayRequest;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Fake ESP-01S relay.
+ * @details
+ *  Serves /relay_command?val=<0|1> and /relay_status, or the SET and GET
+ *  datagrams of relayUdp.h, on 127.0.0.1 from its own thread, so the real
+ *  Esp01sRelay client is exercised over a socket. Every request, each UDP
+ *  retransmission included, consumes the next scripted step, the fallback
+ *  step is used once the script is empty. Requests are served one at a time,
+ *  as the relay firmware does.
+ */
+class FakeRelay {
+private:
+    /** @brief Listening socket, -1 until begin() */
+    int listener;
+
+    /** @brief Port picked by the system */
+    uint16_t port;
+
+    /** @brief Protocol served */
+    t_esp01sRelayTransport transport;
+
+    /** @brief Shared HMAC key of the UDP protocol */
+    const char * udpKey;
+
+    /** @brief Serving thread */
+    std::thread worker;
+
+    /** @brief Cleared by end() to stop the thread */
+    std::atomic<bool> running;
+
+    /** @brief Guards everything below */
+    std::mutex lock;
+
+    /** @brief Scripted steps, oldest first */
+    std::deque<t_fakeRelayStep> script;
+
+    /** @brief Step used when the script is empty */
+    t_fakeRelayStep fallback;
+
+    /** @brief Relay state */
+    t_esp01sRelayState state;
+
+    /** @brief Answer status requests with the JSON body instead of the legacy one */
+    bool jsonStatus;
+
+    /** @brief Every request received */
+    std::vector<t_fakeRelayRequest> requests;
+
+    /** @brief Thread body */
+    void serve(void);
+
+    /** @brief Handle one connection */
+    void handle(const int fd);
+
+    /** @brief Handle one datagram */
+    void handleDatagram(void);
+
+    /** @brief Pop the next step and log the request with it */
+    t_fakeRelayStep nextStep(t_fakeRelayRequest & entry);
+
+    /** @brief Apply a command if the step lets it through, return the relay state */
+    t_esp01sRelayState apply(const t_fakeRelayRequest & entry, const t_fakeRelayStep & step);
+
+public:
+    /** @brief Constructor */
+    FakeRelay() : listener(-1), port(0U), transport(E_ESP01S_RELAY_HTTP), udpKey(NULL), running(false), fallback({E_FAKE_RELAY_ANSWER, 0U}),
+                  state(E_ESP01S_RELAY_OPEN), jsonStatus(false) {};
+
+    /** @brief Destructor, stops the thread */
+    ~FakeRelay() { end(); }
+
+    /**
+     * @brief Start serving
+     *
+     * @param protocol      HTTP or UDP
+     * @param key           Shared HMAC key, E_ESP01S_RELAY_UDP only, must remain valid
+     *
+     * @return true         If the socket could be opened
+     */
+    bool begin(const t_esp01sRelayTransport protocol = E_ESP01S_RELAY_HTTP, const char * const key = NULL);
+
+    /** @brief Stop serving, a hanging request is released */
+    void end(void);
+
+    /** @brief Get the port picked by begin() */
+    uint16_t getPort(void) const { return (port); }
+
+    /** @brief Append a step to the script */
+    void push(const t_fakeRelayAction action, const uint32_t delayMs = 0U);
+
+    /** @brief Set the step used once the script is empty */
+    void setFallback(const t_fakeRelayAction action, const uint32_t delayMs = 0U);
+
+    /** @brief Set the relay state, e.g. to simulate a relay reboot */
+    void setState(const t_esp01sRelayState newState);
+
+    /** @brief Get the relay state */
+    t_esp01sRelayState getState(void);
+
+    /** @brief Answer status requests with {"state":..,"uptime":..,"rssi":..} */
+    void setJsonStatus(const bool json);
+
+    /** @brief Get a copy of the request log */
+    std::vector<t_fakeRelayRequest> getRequests(void);
+
+    /** @brief Count the commands received, optionally only those asking for state */
+    uint32_t countCommands(void);
+    uint32_t countCommands(const t_esp01sRelayState requested);
+
+    /** @brief Count the status requests received */
+    uint32_t countStatusRequests(void);
+
+    /** @brief Forget the request log and the remaining script */
+    void reset(void);
+};
+
+#endif /* FAKE_RELAY_H */
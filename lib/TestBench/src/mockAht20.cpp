@@ -0,0 +1,128 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* Local files */
+#include "mockAht20.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief AHT20 commands */
+#define MOCK_AHT20_CMD_CALIBRATE                (0xE1U)
+#define MOCK_AHT20_CMD_TRIGGER                  (0xACU)
+#define MOCK_AHT20_CMD_SOFTRESET                (0xBAU)
+
+/** @brief Status bits */
+#define MOCK_AHT20_STATUS_BUSY                  (0x80U)
+#define MOCK_AHT20_STATUS_MODE                  (0x10U)
+#define MOCK_AHT20_STATUS_CALIBRATED            (0x08U)
+
+/** @brief Full scale of the 20-bit readouts */
+#define MOCK_AHT20_FULL_SCALE                   (0x100000U)
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static uint32_t toRaw(const float ratio) {
+    if (ratio <= 0.0f) {
+        return (0U);
+    }
+    if (ratio >= 1.0f) {
+        return (MOCK_AHT20_FULL_SCALE - 1U);
+    }
+    return ((uint32_t)(ratio * MOCK_AHT20_FULL_SCALE));
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void MockAht20::consumeFault(void) {
+    if ((fault != E_MOCK_AHT20_OK) && (faultCount > 0U) && (--faultCount == 0U)) {
+        fault = E_MOCK_AHT20_OK;
+    }
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void MockAht20::setReading(const float newTemperature, const float newHumidity) {
+    std::lock_guard<std::mutex> guard(lock);
+    temperature = newTemperature;
+    humidity = newHumidity;
+}
+
+void MockAht20::setFault(const t_mockAht20Fault newFault, const uint32_t count) {
+    std::lock_guard<std::mutex> guard(lock);
+    fault = newFault;
+    faultCount = count;
+}
+
+void MockAht20::setConversionTime(const uint32_t ms) {
+    std::lock_guard<std::mutex> guard(lock);
+    conversionTime = ms;
+}
+
+uint32_t MockAht20::getNbConversions(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    return (nbConversions);
+}
+
+bool MockAht20::onWrite(const uint8_t * data, const size_t len) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (len == 0U) {
+        /* Address probe, the driver probes again after a failed readout */
+        if (nacked()) {
+            consumeFault();
+            return (false);
+        }
+        return (true);
+    }
+
+    if (data[0] == MOCK_AHT20_CMD_TRIGGER) {
+        nbConversions++;
+        conversionFault = fault;
+        consumeFault();
+        readyAt = millis() + conversionTime;
+        return (conversionFault != E_MOCK_AHT20_NACK);
+    }
+
+    if (nacked()) {
+        return (false);
+    }
+    if (data[0] == MOCK_AHT20_CMD_SOFTRESET) {
+        conversionFault = E_MOCK_AHT20_OK;
+    } else if (data[0] == MOCK_AHT20_CMD_CALIBRATE) {
+        calibrated = true;
+    }
+
+    return (true);
+}
+
+bool MockAht20::onRead(uint8_t * data, const size_t len) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    if (nacked() || (len == 0U)) {
+        return (false);
+    }
+
+    bool busy = (conversionFault == E_MOCK_AHT20_BUSY) || ((int32_t)(millis() - readyAt) < 0);
+    data[0] = MOCK_AHT20_STATUS_MODE | (calibrated ? MOCK_AHT20_STATUS_CALIBRATED : 0U) | (busy ? MOCK_AHT20_STATUS_BUSY : 0U);
+    if (len < 6U) {
+        return (true);
+    }
+
+    uint32_t h = toRaw(humidity / 100.0f);
+    uint32_t t = toRaw((temperature + 50.0f) / 200.0f);
+    if (conversionFault == E_MOCK_AHT20_GLITCH) {
+        h = MOCK_AHT20_FULL_SCALE - 1U;
+        t = MOCK_AHT20_FULL_SCALE - 1U;
+    }
+    data[1] = (uint8_t)(h >> 12);
+    data[2] = (uint8_t)(h >> 4);
+    data[3] = (uint8_t)(((h & 0x0FU) << 4) | (t >> 16));
+    data[4] = (uint8_t)(t >> 8);
+    data[5] = (uint8_t)t;
+
+    return (true);
+}
@@ -0,0 +1,109 @@
+#ifndef MOCK_AHT20_H
+#define MOCK_AHT20_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <mutex>
+
+/* Local files */
+#include "Wire.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief I2C address of the AHT20 */
+#define MOCK_AHT20_ADDRESS                      (0x38U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Sensor faults */
+typedef enum {
+    E_MOCK_AHT20_OK     = 0U,           /**< Normal conversions */
+    E_MOCK_AHT20_NACK   = 1U,           /**< Every transfer is NACKed, as with a loose wire */
+    E_MOCK_AHT20_BUSY   = 2U,           /**< The busy bit never clears, the driver times out */
+    E_MOCK_AHT20_GLITCH = 3U            /**< The conversion returns all ones, about 150 °C and 100 % */
+} t_mockAht20Fault;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Mock AHT20 on the host I2C bus.
+ * @details
+ *  Implements the part of the AHT20 protocol used by Adafruit_AHTX0: soft
+ *  reset, calibration, status byte, triggered conversion and the 6 byte
+ *  result. Faults apply to a number of readouts, counted on each trigger
+ *  command and each NACKed address probe, or until cleared.
+ */
+class MockAht20 : public I2CTarget {
+private:
+    /** @brief Guards everything below, the bus calls come from the control pass */
+    std::mutex lock;
+
+    /** @brief Readout in °C and % */
+    float temperature;
+    float humidity;
+
+    /** @brief Active fault */
+    t_mockAht20Fault fault;
+
+    /** @brief Conversions left with the fault, 0 keeps it until cleared */
+    uint32_t faultCount;
+
+    /** @brief Fault of the conversion in progress */
+    t_mockAht20Fault conversionFault;
+
+    /** @brief Calibration bit, set by the calibrate command */
+    bool calibrated;
+
+    /** @brief millis() at which the conversion in progress completes */
+    uint32_t readyAt;
+
+    /** @brief Conversion time in ms, 0 answers at once */
+    uint32_t conversionTime;
+
+    /** @brief Number of trigger commands received */
+    uint32_t nbConversions;
+
+    /** @brief Whether transfers are NACKed */
+    bool nacked(void) const { return (fault == E_MOCK_AHT20_NACK); }
+
+    /** @brief Count one faulty readout down, the fault clears after the last one */
+    void consumeFault(void);
+
+public:
+    /** @brief Constructor, 21 °C and 45 % */
+    MockAht20() : temperature(21.0f), humidity(45.0f), fault(E_MOCK_AHT20_OK), faultCount(0U),
+                  conversionFault(E_MOCK_AHT20_OK), calibrated(false), readyAt(0U), conversionTime(0U), nbConversions(0U) {};
+
+    /** @brief Put the sensor on the bus */
+    void attach(TwoWire & wire = Wire) { wire.attach(MOCK_AHT20_ADDRESS, this); }
+
+    /** @brief Take the sensor off the bus */
+    void detach(TwoWire & wire = Wire) { wire.attach(MOCK_AHT20_ADDRESS, NULL); }
+
+    /** @brief Set what the next conversions return, before the driver calibration offset */
+    void setReading(const float newTemperature, const float newHumidity);
+
+    /**
+     * @brief Inject a fault
+     *
+     * @param newFault      Fault, E_MOCK_AHT20_OK clears it
+     * @param count         Number of readouts affected, 0 until cleared
+     */
+    void setFault(const t_mockAht20Fault newFault, const uint32_t count = 0U);
+
+    /** @brief Set the conversion time, the real chip takes 80 ms */
+    void setConversionTime(const uint32_t ms);
+
+    /** @brief Get the number of conversions triggered */
+    uint32_t getNbConversions(void);
+
+    bool onWrite(const uint8_t * data, const size_t len) override;
+    bool onRead(uint8_t * data, const size_t len) override;
+};
+
+#endif /* MOCK_AHT20_H */
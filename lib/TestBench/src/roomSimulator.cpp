@@ -0,0 +1,48 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <math.h>
+
+/* Local files */
+#include "roomSimulator.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Milliseconds in an hour and in a day */
+#define ROOM_SIMULATOR_HOUR                     (3600.0f * 1000.0f)
+#define ROOM_SIMULATOR_DAY                      (24U * 3600U * 1000U)
+
+/** @brief Coldest hour of the day */
+#define ROOM_SIMULATOR_COLDEST_HOUR             (4.0f)
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void RoomSimulator::begin(const t_roomModel & newModel) {
+    model = newModel;
+    temperature = model.initial;
+    elapsed = 0U;
+    sensor.setReading(temperature + ROOM_SIMULATOR_SENSOR_OFFSET, ROOM_SIMULATOR_HUMIDITY);
+}
+
+void RoomSimulator::step(const uint32_t ms) {
+    float hours = ms / ROOM_SIMULATOR_HOUR;
+    float rate = (getOutdoor() - temperature) / model.timeConstant;
+
+    if (heater.getState() == E_ESP01S_RELAY_CLOSE) {
+        rate += model.heaterRate;
+    }
+    if ((cooler != NULL) && (cooler->getState() == E_ESP01S_RELAY_CLOSE)) {
+        rate -= model.coolerRate;
+    }
+
+    temperature += rate * hours;
+    elapsed += ms;
+    sensor.setReading(temperature + ROOM_SIMULATOR_SENSOR_OFFSET, ROOM_SIMULATOR_HUMIDITY);
+}
+
+float RoomSimulator::getOutdoor(void) const {
+    float hour = (elapsed % ROOM_SIMULATOR_DAY) / ROOM_SIMULATOR_HOUR;
+    return (model.outdoorMean - model.outdoorSwing * cosf(2.0f * (float)M_PI * (hour - ROOM_SIMULATOR_COLDEST_HOUR) / 24.0f));
+}
@@ -0,0 +1,100 @@
+#ifndef ROOM_SIMULATOR_H
+#define ROOM_SIMULATOR_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/* Local files */
+#include "fakeRelay.h"
+#include "mockAht20.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Offset removed by the AHT20 driver, see TEMP_CALIBRATION_VALUE */
+#define ROOM_SIMULATOR_SENSOR_OFFSET            (1.5f)
+
+/** @brief Humidity reported by the sensor, constant */
+#define ROOM_SIMULATOR_HUMIDITY                 (45.0f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief First-order thermal model of a room */
+typedef struct {
+    float initial;                      /**< Room temperature at start, °C */
+    float outdoorMean;                  /**< Daily mean outdoor temperature, °C */
+    float outdoorSwing;                 /**< Half the daily outdoor swing in °C, coldest at 04:00, warmest at 16:00 */
+    float timeConstant;                 /**< Time constant of the losses to the outdoor, hours */
+    float heaterRate;                   /**< Heating power, °C per hour */
+    float coolerRate;                   /**< Cooling power, °C per hour */
+} t_roomModel;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Room simulator class definition.
+ * @details
+ *  Closes the loop of a test bench zone: the room warms up while the heating
+ *  relay is closed, cools down while the cooling relay is closed, and drifts
+ *  towards the outdoor temperature with the time constant of the model. The
+ *  room temperature is written to the mock AHT20 after every step. Simulated
+ *  time starts at midnight.
+ */
+class RoomSimulator {
+private:
+    /** @brief Thermal model */
+    t_roomModel model;
+
+    /** @brief Sensor of the zone */
+    MockAht20 & sensor;
+
+    /** @brief Heating relay */
+    FakeRelay & heater;
+
+    /** @brief Cooling relay, NULL if none */
+    FakeRelay * cooler;
+
+    /** @brief Room temperature in °C */
+    float temperature;
+
+    /** @brief Simulated time in ms */
+    uint64_t elapsed;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param sensor        Sensor of the zone
+     * @param heater        Heating relay
+     * @param cooler        Cooling relay, NULL if none
+     */
+    RoomSimulator(MockAht20 & sensor, FakeRelay & heater, FakeRelay * cooler = NULL) :
+        model(), sensor(sensor), heater(heater), cooler(cooler), temperature(0.0f), elapsed(0U) {};
+
+    /** @brief Start over with a model, at midnight */
+    void begin(const t_roomModel & newModel);
+
+    /**
+     * @brief Move the room forward
+     * @details
+     *  The relay states are read once, at the start of the step.
+     *
+     * @param ms            Duration of the step
+     */
+    void step(const uint32_t ms);
+
+    /** @brief Get the outdoor temperature now, in °C */
+    float getOutdoor(void) const;
+
+    /** @brief Get the room temperature, in °C */
+    float getTemperature(void) const { return (temperature); }
+
+    /** @brief Get the simulated time since begin(), in ms */
+    uint64_t getElapsed(void) const { return (elapsed); }
+};
+
+#endif /* ROOM_SIMULATOR_H */
@@ -0,0 +1,92 @@
+#ifndef SPAN_TEST_ACCESS_H
+#define SPAN_TEST_ACCESS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <vector>
+#include "HomeSpan.h"
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief What a characteristic refers to outside of its own object */
+typedef struct {
+    const void * range;                 /**< Range descriptor, shared with other characteristics */
+    size_t nbValidValues;               /**< Entries of the valid values array */
+    size_t validValuesJsonLen;          /**< Length of the valid values as a JSON array */
+    size_t stringBytes;                 /**< Description, unit and NVS key, terminators included */
+} t_spanCharacteristicExtras;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Access to HomeSpan internals for host tests and benchmarks.
+ * @details
+ *  HomeSpan declares this class a friend, so the HAP request paths can be
+ *  driven without a controller connection. Nothing here is built for the
+ *  ESP32.
+ */
+class SpanTestAccess {
+public:
+    static SpanCharacteristic * find(const uint32_t aid, const int iid) { return (homeSpan.find(aid, iid)); }
+
+    /** @brief Attribute database, as served on GET /accessories */
+    static int sprintfAttributes(char * buffer, const int flags) { return (homeSpan.sprintfAttributes(buffer, flags)); }
+
+    static int sprintfAttributes(char ** ids, const int numIds, const int flags, char * buffer) {
+        return (homeSpan.sprintfAttributes(ids, numIds, flags, buffer));
+    }
+
+    static int sprintfNotify(SpanBuf * objects, const int nbObjects, char * buffer, const int conNum) {
+        return (homeSpan.sprintfNotify(objects, nbObjects, buffer, conNum));
+    }
+
+    static int updateCharacteristics(char * buffer, SpanBuf * objects) { return (homeSpan.updateCharacteristics(buffer, objects)); }
+
+    static int countCharacteristics(char * buffer) { return (homeSpan.countCharacteristics(buffer)); }
+
+    /** @brief Timed-write PIDs, filled by PUT /prepare */
+    static SpanTimedWrites & timedWrites(void) { return (homeSpan.TimedWrites); }
+
+    /** @brief Every characteristic of the attribute database, in order */
+    static std::vector<SpanCharacteristic *> characteristics(void) {
+        std::vector<SpanCharacteristic *> all;
+        for (SpanAccessory * accessory : homeSpan.Accessories) {
+            for (SpanService * service : accessory->Services) {
+                all.insert(all.end(), service->Characteristics.begin(), service->Characteristics.end());
+            }
+        }
+        return (all);
+    }
+
+    static t_spanCharacteristicExtras extras(SpanCharacteristic * const c) {
+        t_spanCharacteristicExtras extras;
+        extras.range = c->range;
+        extras.nbValidValues = c->nValidValues;
+        extras.validValuesJsonLen = (c->validValues != NULL) ? (size_t)c->sprintfValidValues(NULL) : 0U;
+        extras.stringBytes = ((c->desc != NULL) ? strlen(c->desc) + 1U : 0U) + ((c->unit != NULL) ? strlen(c->unit) + 1U : 0U) +
+                             ((c->nvsKey != NULL) ? 16U : 0U);
+        return (extras);
+    }
+
+    /** @brief Range descriptors pooled so far */
+    static size_t rangePoolSize(void) { return (SpanCharacteristic::rangePool.size()); }
+
+    static size_t rangeSize(void) { return (sizeof(SpanCharacteristic::range_t)); }
+
+    static uint8_t maxConnections(void) { return (homeSpan.maxConnections); }
+
+    /** @brief Snap the current time as poll() does, SpanCharacteristic::timeVal() counts from it */
+    static void snapTime(void) { homeSpan.snapTime = Utils::uptime(); }
+
+    /** @brief HAP listening socket, only started by poll() once WiFi connects, which never happens on the host */
+    static HapServer * hapServer(void) { return (homeSpan.hapServer); }
+
+    /** @brief Check every connection slot on the next pass without waiting for socket readiness */
+    static void pollAll(void) { homeSpan.pollAll = true; }
+};
+
+#endif /* SPAN_TEST_ACCESS_H */
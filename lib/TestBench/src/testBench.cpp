@@ -0,0 +1,130 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+#include "spanTestAccess.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Highest instance ID looked at by testBenchFind() */
+#define TEST_BENCH_MAX_IID                      (64)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Sensor of the local zones */
+static MockAht20 sensor;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Instance ID of the characteristic of type in accessory aid, 0 if none, read from the attribute database */
+static int findIid(const uint32_t aid, const HapChar & type) {
+    char typeField[32];
+
+    snprintf(typeField, sizeof(typeField), "\"type\":\"%s\"", type.type);
+    for (int iid = 1; iid <= TEST_BENCH_MAX_IID; iid++) {
+        char id[24];
+        char * ids[] = {id};
+
+        if (SpanTestAccess::find(aid, iid) == NULL) {
+            continue;
+        }
+        snprintf(id, sizeof(id), "%u.%d", (unsigned int)aid, iid);
+        std::vector<char> json(SpanTestAccess::sprintfAttributes(ids, 1, GET_TYPE, NULL) + 1);
+        SpanTestAccess::sprintfAttributes(ids, 1, GET_TYPE, json.data());
+        if (strstr(json.data(), typeField) != NULL) {
+            return (iid);
+        }
+    }
+
+    return (0);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void testBenchBegin(void) {
+    sensor.attach();
+
+    homeSpan.setLogLevel(0);
+    homeSpan.begin(Category::Bridges, "Test Bench");
+
+    new SpanAccessory();
+        new Service::AccessoryInformation();
+            new Characteristic::Identify();
+}
+
+MockAht20 & testBenchSensor(void) {
+    return (sensor);
+}
+
+t_zoneConfig testBenchZoneConfig(const char * const name, const uint16_t relayPort) {
+    t_zoneConfig config = {};
+
+    config.name = name;
+    config.sensorSerialNum = "TB-SENSOR";
+    config.thermostatSerialNum = "TB-THERMOSTAT";
+    config.relayIpAddress = "127.0.0.1";
+    config.relayPort = relayPort;
+    config.relayTransport = E_ESP01S_RELAY_HTTP;
+    config.relaySafeState = E_ESP01S_RELAY_OPEN;
+    config.sensorSource = E_ZONE_SENSOR_LOCAL_AHT20;
+    config.heaterPowerW = 1000U;
+    config.humidityMode = E_HUMIDITY_MODE_DEHUMIDIFY;
+
+    return (config);
+}
+
+uint32_t testBenchRun(const uint32_t ms) {
+    uint64_t end = Utils::uptime() + ms;
+    uint32_t passes = 0U;
+
+    while (Utils::uptime() < end) {
+        zoneTable.run();
+        nativeAdvanceClock(ZONE_CONTROL_PERIOD);
+        passes++;
+    }
+
+    return (passes);
+}
+
+uint32_t testBenchRunUntil(const std::function<bool(void)> & done, const uint32_t ms) {
+    uint64_t start = Utils::uptime();
+
+    while ((Utils::uptime() - start) <= ms) {
+        zoneTable.run();
+        if (done()) {
+            return ((uint32_t)(Utils::uptime() - start));
+        }
+        nativeAdvanceClock(ZONE_CONTROL_PERIOD);
+    }
+
+    return (UINT32_MAX);
+}
+
+SpanCharacteristic * testBenchFind(const uint32_t aid, const HapChar & type) {
+    int iid = findIid(aid, type);
+    return ((iid > 0) ? SpanTestAccess::find(aid, iid) : NULL);
+}
+
+bool testBenchWrite(const uint32_t aid, const HapChar & type, const char * const value) {
+    int iid = findIid(aid, type);
+    SpanBuf update;
+    char body[128];
+
+    if (iid == 0) {
+        return (false);
+    }
+
+    snprintf(body, sizeof(body), "{\"characteristics\":[{\"aid\":%u,\"iid\":%d,\"value\":%s}]}", (unsigned int)aid, iid, value);
+    if ((SpanTestAccess::updateCharacteristics(body, &update) == 0) || (update.status != StatusCode::OK)) {
+        return (false);
+    }
+
+    return (true);
+}
@@ -0,0 +1,87 @@
+#ifndef TEST_BENCH_H
+#define TEST_BENCH_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <functional>
+#include "HomeSpan.h"
+
+/* Local files */
+#include "zones/zoneTable.h"
+#include "fakeRelay.h"
+#include "mockAht20.h"
+#include "roomSimulator.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Accessory IDs of the first zone: the bridge is 1, then sensor, thermostat and heating relay */
+#define TEST_BENCH_AID_SENSOR                   (2U)
+#define TEST_BENCH_AID_THERMOSTAT               (3U)
+#define TEST_BENCH_AID_RELAY                    (4U)
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @brief Start HomeSpan and create the bridge accessory
+ * @details
+ *  Call once per test binary, before adding zones. HomeSpan is not polled:
+ *  there is no HAP server, controller writes go through testBenchWrite().
+ *  The mock AHT20 is put on the bus.
+ */
+void testBenchBegin(void);
+
+/** @brief Mock AHT20 shared by the local zones */
+MockAht20 & testBenchSensor(void);
+
+/**
+ * @brief Get a zone configuration for a relay served by a FakeRelay
+ * @details
+ *  HTTP heating relay on 127.0.0.1, local AHT20, no schedule, no cooling or
+ *  humidity relay and no open window detection. The name must remain valid.
+ */
+t_zoneConfig testBenchZoneConfig(const char * const name, const uint16_t relayPort);
+
+/**
+ * @brief Run the zone scheduler for ms of simulated time
+ * @details
+ *  The host clock is moved forward by ZONE_CONTROL_PERIOD between passes, so
+ *  every pass runs a control pass too. Time spent in relay requests adds up.
+ *
+ * @return Number of passes
+ */
+uint32_t testBenchRun(const uint32_t ms);
+
+/**
+ * @brief Run the zone scheduler until done() holds
+ *
+ * @param done          Condition checked after every pass
+ * @param ms            Longest simulated time
+ *
+ * @return Simulated time in ms until done() held, or UINT32_MAX if it never did
+ */
+uint32_t testBenchRunUntil(const std::function<bool(void)> & done, const uint32_t ms);
+
+/**
+ * @brief Find a characteristic of an accessory by HAP type
+ *
+ * @param aid           Accessory ID
+ * @param type          HAP characteristic, e.g. hapChars.TargetTemperature
+ *
+ * @return Characteristic, NULL if the accessory has none of this type
+ */
+SpanCharacteristic * testBenchFind(const uint32_t aid, const HapChar & type);
+
+/**
+ * @brief Write a characteristic as a controller would
+ * @details
+ *  The value goes through the PUT /characteristics parser and the update()
+ *  of the service, as for a write from the Home app.
+ *
+ * @return true         If the write was accepted
+ */
+bool testBenchWrite(const uint32_t aid, const HapChar & type, const char * const value);
+
+#endif /* TEST_BENCH_H */
@@ -2,6 +2,7 @@
  *  Includes
  ***********************************************/
 #include "adafruitAht20.h"
+#include "faultInjection.h"
 
 /************************************************
  *  Defines / Macros
@@ -23,13 +24,26 @@ bool TempHumSensor::initializeSensor(void) {
     return (tempSensor.begin());
 }
 
+bool TempHumSensor::measure(void) {
+    /* A failed readout, e.g. an I2C NACK, leaves the events untouched: report it instead of stale values */
+    valid = !FAULT_SENSOR_FAIL() && tempSensor.getEvent(&humEvent, &tempEvent);
+    return (valid);
+}
+
 float TempHumSensor::getCurrentTemperature(void) {
-    tempSensor.getEvent(&humEvent, &tempEvent);
+    if (valid == false) {
+        return (NAN);
+    }
+    if (FAULT_SENSOR_GLITCH()) {
+        return (FAULT_SENSOR_GLITCH_VALUE);
+    }
     return(tempEvent.temperature - TEMP_CALIBRATION_VALUE);
 }
 
 float TempHumSensor::getCurrentHumidity(void) {
-    tempSensor.getEvent(&humEvent, &tempEvent);
+    if (valid == false) {
+        return (NAN);
+    }
     return(humEvent.relative_humidity);
 }
 
@@ -6,12 +6,18 @@
  ***********************************************/
 #include <Adafruit_AHTX0.h>
 
+/* Local files */
+#include "sensorDevice.h"
+
 /************************************************
  *  Defines / Macros
  ***********************************************/
 /** @brief Initial temperature value */
 #define TEMPERATURE_INITIAL_VALUE           (22U)
 
+/** @brief Initial humidity value */
+#define HUMIDITY_INITIAL_VALUE              (50U)
+
 /************************************************
  *  Typedef definition
  ***********************************************/
@@ -19,7 +25,7 @@
 /************************************************
  *  Class definition
  ***********************************************/
-class TempHumSensor {
+class TempHumSensor : public SensorDevice {
 private:
     /** @brief Adafruit Object */
     Adafruit_AHTX0 tempSensor;
@@ -30,9 +36,12 @@ private:
     /** @brief Humidity event type */
     sensors_event_t humEvent;
 
+    /** @brief Whether the events hold the last conversion */
+    bool valid;
+
 public:
     /** @brief Constructor */
-    TempHumSensor() {};
+    TempHumSensor() : valid(false) {};
 
     /**
      * @brief Initialize sensor public method
@@ -42,25 +51,36 @@ public:
      * @return true     If the sensor is initialized successfully
      * @return false    Most likely a wiring problem
      */
-    bool initializeSensor(void);
+    bool initializeSensor(void) override;
+
+    /**
+     * @brief Measure public method
+     * @details
+     *  This method runs one conversion, which returns both the temperature
+     *  and the humidity. The getters below return the values of this conversion.
+     *
+     * @return true     If the sensor answered
+     * @return false    I2C error or timeout
+     */
+    bool measure(void) override;
 
     /**
      * @brief Get the Current Temperature public method
      * @details
-     *  This method is used to get the current readout temperature
+     *  This method is used to get the temperature of the last measure()
      *
-     * @return temperature
+     * @return temperature, NAN if the sensor did not answer
      */
-    float getCurrentTemperature(void);
+    float getCurrentTemperature(void) override;
 
     /**
      * @brief Get the Current Humidity public method
      * @details
-     *  This method is used to get the current readout humidity
+     *  This method is used to get the humidity of the last measure()
      *
-     * @return humidity
+     * @return humidity, NAN if the sensor did not answer
      */
-    float getCurrentHumidity(void);
+    float getCurrentHumidity(void) override;
 };
 
 #endif /* ADAFRUIT_AHT20_H */
@@ -15,21 +15,23 @@
 #define HUMIDITY_DEFAULT_MIN_RANGE              (0U)
 #define HUMIDITY_DEFAULT_MAX_RANGE              (100U)
 
-#define TEMP_HUM_SENSOR_NAME                    ("Living Room Temperature")
 #define TEMP_HUM_SENSOR_MANUFACTURER            ("Adafruit")
 #define TEMP_HUM_SENSOR_MODEL                   ("AHT20")
-#define TEMP_HUM_SENSOR_SERIAL_NUM              ("SN170332CAE")
 #define TEMP_HUM_SENSOR_FIRMWARE                ("v1.0.0")
 
 /* Thermostat Info */
-#define THERMOSTAT_NAME                         ("Living Room Thermostat")
 #define THERMOSTAT_MANUFACTURER                 ("Custom made")
 #define THERMOSTAT_MODEL                        ("Model 1")
-#define THERMOSTAT_SERIAL_NUM                   ("00000001")
 #define THERMOSTAT_FIRMWARE                     ("v1.0.0")
 
-#define THERMOSTAT_RELAY_IP_ADDRESS             ("192.168.1.148")
-#define THERMOSTAT_RELAY_PORT_ID                (80U)
+/* Relays driven over UDP, the HMAC key must match the relay firmware. There is no built-in key:
+ * define RELAY_UDP_KEY in the git-ignored private/relayKey.h or with -DRELAY_UDP_KEY=... */
+#if __has_include("private/relayKey.h")
+#include "private/relayKey.h"
+#endif
+#ifndef RELAY_UDP_KEY
+#define RELAY_UDP_KEY                           (nullptr)
+#endif
 
 /************************************************
  *  Typedef definition
@@ -1,11 +1,12 @@
 /************************************************
  *  Includes
  ***********************************************/
-#include <string>
+#include <ctype.h>
 #include "HomeSpan.h"
 
 /* Local files */
 #include "esp01sRelay.h"
+#include "faultInjection.h"
 
 /************************************************
  *  Defines / Macros
@@ -22,13 +23,206 @@
 /** @brief HTTP BAD Request code */
 #define HTTP_RESPONSE_BAD_REQUEST       (400)
 
+/** @brief HTTP connect and response timeouts in ms, bound the time a dead relay blocks the control task.
+ *  Host tests shorten them from the build flags. */
+#ifndef HTTP_CONNECT_TIMEOUT
+#define HTTP_CONNECT_TIMEOUT            (1000)
+#endif
+#ifndef HTTP_RESPONSE_TIMEOUT
+#define HTTP_RESPONSE_TIMEOUT           (2000U)
+#endif
+
 /************************************************
  *  Typedef definition
  ***********************************************/
+/** @brief Parser position in a bounded status body */
+typedef struct {
+    const char * p;                     /**< Next character */
+    const char * end;                   /**< One past the last character */
+} t_statusCursor;
 
 /************************************************
  *  Static function implementation
  ***********************************************/
+static void skipSpaces(t_statusCursor & c) {
+    while ((c.p < c.end) && isspace((unsigned char)*c.p)) {
+        c.p++;
+    }
+}
+
+static bool expectChar(t_statusCursor & c, const char ch) {
+    skipSpaces(c);
+    if ((c.p < c.end) && (*c.p == ch)) {
+        c.p++;
+        return (true);
+    }
+    return (false);
+}
+
+static bool matchWord(t_statusCursor & c, const char * const word) {
+    size_t n = strlen(word);
+    if (((size_t)(c.end - c.p) >= n) && (memcmp(c.p, word, n) == 0)) {
+        c.p += n;
+        return (true);
+    }
+    return (false);
+}
+
+/* Decimal integer of at most 10 digits, so it always fits an int64_t */
+static bool parseInteger(t_statusCursor & c, int64_t * const value) {
+    bool negative = false;
+    int64_t v = 0;
+    uint8_t digits = 0U;
+
+    skipSpaces(c);
+    if ((c.p < c.end) && (*c.p == '-')) {
+        negative = true;
+        c.p++;
+    }
+    while ((c.p < c.end) && isdigit((unsigned char)*c.p)) {
+        if (++digits > 10U) {
+            return (false);
+        }
+        v = (v * 10) + (*c.p - '0');
+        c.p++;
+    }
+    if (digits == 0U) {
+        return (false);
+    }
+
+    *value = negative ? -v : v;
+    return (true);
+}
+
+/* String without escapes or control characters, returned in place */
+static bool parseString(t_statusCursor & c, const char ** const str, size_t * const len) {
+    if (expectChar(c, '"') == false) {
+        return (false);
+    }
+    const char * start = c.p;
+    while ((c.p < c.end) && (*c.p != '"')) {
+        if ((*c.p == '\\') || ((unsigned char)*c.p < 0x20U)) {
+            return (false);
+        }
+        c.p++;
+    }
+    if (c.p == c.end) {
+        return (false);
+    }
+    *str = start;
+    *len = c.p - start;
+    c.p++;
+    return (true);
+}
+
+/* Member value: integer, boolean (read as 0 or 1) or string (not numeric) */
+static bool parseValue(t_statusCursor & c, int64_t * const value, bool * const numeric) {
+    const char * str;
+    size_t len;
+
+    skipSpaces(c);
+    *numeric = true;
+    if ((c.p < c.end) && (*c.p == '"')) {
+        *numeric = false;
+        return (parseString(c, &str, &len));
+    }
+    if (matchWord(c, "true")) {
+        *value = 1;
+        return (true);
+    }
+    if (matchWord(c, "false")) {
+        *value = 0;
+        return (true);
+    }
+    return (parseInteger(c, value));
+}
+
+static bool isKey(const char * const key, const size_t len, const char * const name) {
+    return ((strlen(name) == len) && (memcmp(key, name, len) == 0));
+}
+
+static bool parseJsonStatus(t_statusCursor & c, t_esp01sRelayStatus * const status) {
+    t_esp01sRelayStatus parsed = {E_ESP01S_RELAY_OPEN, 0U, 0};
+    bool hasState = false;
+    const char * key;
+    size_t keyLen;
+    int64_t value;
+    bool numeric;
+
+    if ((expectChar(c, '{') == false) || (expectChar(c, '}') == true)) {
+        return (false);
+    }
+
+    do {
+        if ((parseString(c, &key, &keyLen) == false) || (expectChar(c, ':') == false) ||
+            (parseValue(c, &value, &numeric) == false)) {
+            return (false);
+        }
+        if (isKey(key, keyLen, "state")) {
+            if (!numeric || (value < 0) || (value > (int64_t)E_ESP01S_RELAY_CLOSE)) {
+                return (false);
+            }
+            parsed.state = (t_esp01sRelayState)value;
+            hasState = true;
+        } else if (isKey(key, keyLen, "uptime")) {
+            if (!numeric || (value < 0) || (value > (int64_t)UINT32_MAX)) {
+                return (false);
+            }
+            parsed.uptime = (uint32_t)value;
+        } else if (isKey(key, keyLen, "rssi")) {
+            if (!numeric || (value < INT8_MIN) || (value > INT8_MAX)) {
+                return (false);
+            }
+            parsed.rssi = (int8_t)value;
+        }
+    } while (expectChar(c, ','));
+
+    if ((expectChar(c, '}') == false) || (hasState == false)) {
+        return (false);
+    }
+
+    *status = parsed;
+    return (true);
+}
+
+/**
+ * @brief Read a response body into a bounded buffer
+ * @details
+ *  The body is read straight from the connection, without building a String.
+ *  Bodies that do not fit, or that end before their Content-Length, are rejected.
+ *
+ * @return Body length, or -1 on failure
+ */
+static int readBody(HTTPClient & http, char * const buffer, const size_t size) {
+    WiFiClient * stream = http.getStreamPtr();
+    int expected = http.getSize();
+    size_t len = 0;
+    uint64_t start = Utils::uptime();
+
+    /* Without Content-Length, the body ends when the relay closes the connection */
+    if ((stream == NULL) || (expected >= (int)size)) {
+        return (-1);
+    }
+
+    while ((len < size) && ((expected < 0) || (len < (size_t)expected))) {
+        if (stream->available() > 0) {
+            int n = stream->read((uint8_t *)buffer + len, size - len);
+            if (n > 0) {
+                len += n;
+            }
+        } else if ((stream->connected() == false) || ((Utils::uptime() - start) > HTTP_RESPONSE_TIMEOUT)) {
+            break;
+        } else {
+            delay(1);
+        }
+    }
+
+    if ((len >= size) || ((expected >= 0) && (len != (size_t)expected))) {
+        return (-1);
+    }
+
+    return ((int)len);
+}
 
 /************************************************
  *  Public Method Implementation
@@ -38,6 +232,21 @@ t_httpErrorCodes Esp01sRelay::sendEsp01sRelayCommand(const t_esp01sRelayState co
     HTTPClient http;
     String url = httpCommand;
     t_httpErrorCodes error = E_REQUEST_FAILURE;
+    uint8_t echo;
+
+    /* Injected faults, see faultInjection.h */
+    FAULT_RELAY_DELAY();
+    if (FAULT_RELAY_DROP()) {
+        return (E_REQUEST_FAILURE);
+    }
+
+    if (udpRelay != NULL) {
+        if (udpRelay->setState((uint8_t)command, &echo) == true) {
+            internalRelayState = (t_esp01sRelayState)echo;
+            error = E_REQUEST_SUCCESS;
+        }
+        return (error);
+    }
 
     if (command == E_ESP01S_RELAY_OPEN) {
         url += String(RELAY_OPEN_COMMAND);
@@ -47,10 +256,13 @@ t_httpErrorCodes Esp01sRelay::sendEsp01sRelayCommand(const t_esp01sRelayState co
 
     WEBLOG("Sending the command: %s to the relay\n", url.c_str());
 
+    http.setConnectTimeout(HTTP_CONNECT_TIMEOUT);
+    http.setTimeout(HTTP_RESPONSE_TIMEOUT);
     if (http.begin(url) == true) {
         int httpCode = http.GET();
         if (httpCode == HTTP_RESPONSE_SUCCESS) {
             WEBLOG("Relay request success");
+            internalRelayState = command;
             error = E_REQUEST_SUCCESS;
         } else {
             WEBLOG("Tried to send a command and client responded with HTTP Code: %d\n", httpCode);
@@ -68,27 +280,85 @@ t_httpErrorCodes Esp01sRelay::getEsp01sRelayState(t_esp01sRelayState * const rel
     HTTPClient http;
     String url = httpCommand + "/relay_status";
     t_httpErrorCodes error = E_REQUEST_FAILURE;
+    t_esp01sRelayStatus status = {E_ESP01S_RELAY_OPEN, 0U, 0};
+    char body[RELAY_STATUS_MAX_LEN];
     uint8_t response;
     int httpCode;
+    int len;
+    bool valid = false;
 
-    if (http.begin(url) == true) {
-        httpCode = http.GET();
-        if (httpCode == HTTP_RESPONSE_SUCCESS) {
-            response = std::stoul(http.getString().c_str());
+    /* Injected faults, see faultInjection.h */
+    FAULT_RELAY_DELAY();
+    if (FAULT_RELAY_DROP()) {
+        return (E_REQUEST_FAILURE);
+    }
 
-            internalRelayState = (t_esp01sRelayState)response;
-            *relayState = internalRelayState;
-            error = E_REQUEST_SUCCESS;
-        } else {
-           WEBLOG("Failed to retrieve relay status\n");
+    if (udpRelay != NULL) {
+        if (udpRelay->getState(&response) == true) {
+            /* The UDP answer is a single byte, validated like a legacy HTTP body */
+            body[0] = FAULT_RELAY_CORRUPT() ? 'x' : (char)('0' + response);
+            valid = parseStatus(body, 1U, &status);
         }
-        http.end();
     } else {
-        WEBLOG("Failed to begin HTTP request");
+        http.setConnectTimeout(HTTP_CONNECT_TIMEOUT);
+        http.setTimeout(HTTP_RESPONSE_TIMEOUT);
+        /* HTTP/1.0 so the body is never chunked and can be read as is */
+        http.useHTTP10(true);
+        if (http.begin(url) == true) {
+            httpCode = http.GET();
+            if (httpCode == HTTP_RESPONSE_SUCCESS) {
+                len = readBody(http, body, sizeof(body));
+                if ((len > 0) && FAULT_RELAY_CORRUPT()) {
+                    body[esp_random() % len] ^= (char)(1U + esp_random() % 0xFFU);
+                }
+                valid = (len >= 0) && parseStatus(body, len, &status);
+                if (valid == false) {
+                    WEBLOG("Invalid relay status answer\n");
+                }
+            } else {
+               WEBLOG("Failed to retrieve relay status\n");
+            }
+            http.end();
+        } else {
+            WEBLOG("Failed to begin HTTP request");
+        }
+    }
+
+    /* Keep the last confirmed state on anything but a valid answer */
+    if (valid == true) {
+        lastStatus = status;
+        internalRelayState = status.state;
+        *relayState = internalRelayState;
+        error = E_REQUEST_SUCCESS;
     }
 
     return (error);
 }
+
+bool Esp01sRelay::parseStatus(const char * const body, const size_t len, t_esp01sRelayStatus * const status) {
+
+    t_statusCursor c = {body, body + len};
+    t_esp01sRelayStatus parsed = {E_ESP01S_RELAY_OPEN, 0U, 0};
+    int64_t value = 0;
+    bool valid;
+
+    skipSpaces(c);
+    if ((c.p < c.end) && (*c.p == '{')) {
+        valid = parseJsonStatus(c, &parsed);
+    } else {
+        /* Legacy body, a bare 0 or 1 */
+        valid = parseInteger(c, &value) && ((value == 0) || (value == 1));
+        parsed.state = (t_esp01sRelayState)value;
+    }
+    skipSpaces(c);
+
+    if ((valid == false) || (c.p != c.end)) {
+        return (false);
+    }
+
+    *status = parsed;
+    return (true);
+}
 /************************************************
  *  Private Method implementation
  ***********************************************/
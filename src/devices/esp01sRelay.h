@@ -7,6 +7,10 @@
 #include "Arduino.h"
 #include <HTTPClient.h>
 
+/* Local files */
+#include "relayDevice.h"
+#include "relayUdp.h"
+
 /************************************************
  *  Defines / Macros
  ***********************************************/
@@ -16,20 +20,24 @@
 /** @brief Relay HTTP GET open command */
 #define RELAY_OPEN_COMMAND      ("/relay_command?val=0")
 
+/** @brief Longest relay status body accepted, longer answers are rejected */
+#define RELAY_STATUS_MAX_LEN    (96U)
+
 /************************************************
  *  Typedef definition
  ***********************************************/
-/** @brief This enum represents all the possible HTTP Requests failures*/
+/** @brief ESP-01S Relay transport */
 typedef enum {
-    E_REQUEST_SUCCESS = 0U,             /**< HTTP Request success */
-    E_REQUEST_FAILURE = 1U              /**< HTTP Request failure */
-} t_httpErrorCodes;
+    E_ESP01S_RELAY_HTTP = 0U,           /**< HTTP GET commands */
+    E_ESP01S_RELAY_UDP  = 1U            /**< Authenticated UDP datagrams, see relayUdp.h */
+} t_esp01sRelayTransport;
 
-/** @brief ESP-01S Relay State */
-typedef enum {
-    E_ESP01S_RELAY_OPEN  = 0U,          /**< ESP-01S Relay Open */
-    E_ESP01S_RELAY_CLOSE = 1U           /**< ESP-01S Relay Close */
-} t_esp01sRelayState;
+/** @brief Relay status, as answered to /relay_status */
+typedef struct {
+    t_esp01sRelayState state;           /**< Relay state */
+    uint32_t uptime;                    /**< Relay uptime in s, 0 if not reported */
+    int8_t rssi;                        /**< Relay WiFi RSSI in dBm, 0 if not reported */
+} t_esp01sRelayStatus;
 
 /************************************************
  *  Class definition
@@ -38,7 +46,7 @@ typedef enum {
  * @brief ESP-01S class definition.
  * @details This class is used to define a generic ESP-01S Relay
  */
-class Esp01sRelay {
+class Esp01sRelay : public RelayDevice {
 private:
     /** @brief ESP-01S relay state */
     t_esp01sRelayState internalRelayState;
@@ -46,32 +54,95 @@ private:
     /** @brief URL Start */
     String httpCommand;
 
+    /** @brief UDP transport, NULL when the relay is driven over HTTP */
+    RelayUdp * udpRelay;
+
+    /** @brief Last valid status answer */
+    t_esp01sRelayStatus lastStatus;
+
 public:
-    /** @brief Constructor */
-    Esp01sRelay(const String relayIpAddress, const uint8_t portId) {
+    /**
+     * @brief Constructor
+     *
+     * @param relayIpAddress    IP address of the relay
+     * @param portId            HTTP or UDP port of the relay
+     * @param transport         Transport used to talk to the relay
+     * @param udpKey            Shared HMAC key, E_ESP01S_RELAY_UDP only
+     */
+    Esp01sRelay(const String relayIpAddress, const uint16_t portId,
+                const t_esp01sRelayTransport transport = E_ESP01S_RELAY_HTTP, const char * const udpKey = NULL) {
         internalRelayState = E_ESP01S_RELAY_OPEN;
+        lastStatus = {E_ESP01S_RELAY_OPEN, 0U, 0};
         httpCommand = "http://" + relayIpAddress + ":" + String(portId);
+        udpRelay = NULL;
+        if (transport == E_ESP01S_RELAY_UDP) {
+            udpRelay = new RelayUdp(relayIpAddress.c_str(), portId, udpKey);
+        }
     }
 
     /**
      * @brief Send commands to a generic ESP-01S device
      * @details
      *  This function is used to send commands to the ESP-01S Relay using HTTP GET commands
+     *  or UDP datagrams, depending on the transport
      *
      * @param command       E_ESP01S_RELAY_OPEN or E_ESP01S_RELAY_CLOSE
      *
      * @return t_espNowErrorCodes
      */
-    t_httpErrorCodes sendEsp01sRelayCommand(const t_esp01sRelayState command);
+    t_httpErrorCodes sendEsp01sRelayCommand(const t_esp01sRelayState command) override;
 
     /**
      * @brief Get the Esp01s Relay State
      * @details
      *  This function is used to retrieve the status of the ESP-01S Relay using HTTP GET commands
+     *  or UDP datagrams, depending on the transport
+     *
+     * @return t_esp01sRelayState
+     */
+    t_httpErrorCodes getEsp01sRelayState(t_esp01sRelayState * const relayState) override;
+
+    /**
+     * @brief Get the last state confirmed by the relay
+     * @details
+     *  The state is updated when a command is acknowledged or a status request succeeds,
+     *  no request is sent to the relay.
      *
      * @return t_esp01sRelayState
      */
-    t_httpErrorCodes getEsp01sRelayState(t_esp01sRelayState * const relayState);
+    t_esp01sRelayState getConfirmedState(void) const override { return (internalRelayState); }
+
+    /**
+     * @brief Preset the confirmed state
+     * @details
+     *  Used on boot with the last known state, until the relay answers a request.
+     *
+     * @param state         Last known relay state
+     */
+    void presetState(const t_esp01sRelayState state) override { internalRelayState = state; }
+
+    /** @brief Get the last valid status answer, uptime and RSSI are only reported by JSON capable firmware */
+    const t_esp01sRelayStatus & getLastStatus(void) const { return (lastStatus); }
+
+    /**
+     * @brief Parse a relay status body
+     * @details
+     *  Two formats are accepted, surrounding whitespace aside:
+     *   - the legacy body, a single "0" or "1"
+     *   - a JSON object such as {"state":1,"uptime":3600,"rssi":-61}, where
+     *     state is required (0, 1, false or true), uptime and rssi are optional
+     *     integers and other members are ignored if they are numbers, booleans
+     *     or strings without escapes.
+     *  Anything else is rejected. The parser does not allocate and never reads
+     *  past len, body does not need to be null terminated.
+     *
+     * @param body          Response body
+     * @param len           Length of the body
+     * @param status        Parsed status, only written on success
+     *
+     * @return true         If the body is a valid status
+     */
+    static bool parseStatus(const char * const body, const size_t len, t_esp01sRelayStatus * const status);
 };
 
 #endif /* ESP_01_S_RELAY_H */
@@ -0,0 +1,56 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/* Local files */
+#include "faultInjection.h"
+
+#ifdef FAULT_INJECTION
+/************************************************
+ *  Public variables
+ ***********************************************/
+FaultInjection faultInjection;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static uint8_t toPercent(const unsigned int value) {
+    return (value > 100U ? 100U : (uint8_t)value);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void FaultInjection::begin(void) {
+    new SpanUserCommand('F', "<relay drop %> <relay delay ms> <relay corrupt %> <sensor glitch %> <sensor fail %> - inject faults, no argument clears them", command);
+    LOG0("*** Fault injection enabled, see @F ***\n");
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+/**
+ * @brief Fault injection user command: @F [<relay drop %> <relay delay ms> <relay corrupt %> <sensor glitch %> <sensor fail %>]
+ * @details
+ *  Example: "@F 30 500 10 5 0" drops 30% of the relay exchanges, delays all of
+ *  them by 500 ms, corrupts 10% of the status answers and glitches 5% of the
+ *  sensor readouts. Missing values are zero, "@F" alone clears every fault.
+ */
+void FaultInjection::command(const char * buf) {
+
+    unsigned int values[5] = {0U, 0U, 0U, 0U, 0U};
+
+    (void)sscanf(buf + 1, "%u %u %u %u %u", &values[0], &values[1], &values[2], &values[3], &values[4]);
+
+    faultInjection.config.relayDropPercent = toPercent(values[0]);
+    faultInjection.config.relayDelayMs = (values[1] > UINT16_MAX) ? UINT16_MAX : (uint16_t)values[1];
+    faultInjection.config.relayCorruptPercent = toPercent(values[2]);
+    faultInjection.config.sensorGlitchPercent = toPercent(values[3]);
+    faultInjection.config.sensorFailPercent = toPercent(values[4]);
+
+    LOG0("Faults: relay drop %u%%, delay %u ms, corrupt %u%%, sensor glitch %u%%, fail %u%%\n",
+         faultInjection.config.relayDropPercent, faultInjection.config.relayDelayMs, faultInjection.config.relayCorruptPercent,
+         faultInjection.config.sensorGlitchPercent, faultInjection.config.sensorFailPercent);
+}
+#endif
@@ -0,0 +1,99 @@
+#ifndef FAULT_INJECTION_H
+#define FAULT_INJECTION_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "Arduino.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/**
+ * @brief Fault injection hooks
+ * @details
+ *  Built with -DFAULT_INJECTION, the relay and sensor drivers fail on purpose
+ *  as set with the @F command, so the reconciliation, backoff and sensor
+ *  validation paths can be exercised on a bench. Without the flag every hook
+ *  compiles to nothing.
+ */
+#ifdef FAULT_INJECTION
+#define FAULT_RELAY_DROP()              (faultInjection.draw(faultInjection.getConfig().relayDropPercent))
+#define FAULT_RELAY_DELAY()             (faultInjection.delayRelay())
+#define FAULT_RELAY_CORRUPT()           (faultInjection.draw(faultInjection.getConfig().relayCorruptPercent))
+#define FAULT_SENSOR_GLITCH()           (faultInjection.draw(faultInjection.getConfig().sensorGlitchPercent))
+#define FAULT_SENSOR_FAIL()             (faultInjection.draw(faultInjection.getConfig().sensorFailPercent))
+#else
+#define FAULT_RELAY_DROP()              (false)
+#define FAULT_RELAY_DELAY()
+#define FAULT_RELAY_CORRUPT()           (false)
+#define FAULT_SENSOR_GLITCH()           (false)
+#define FAULT_SENSOR_FAIL()             (false)
+#endif
+
+/** @brief Temperature returned by a glitched sensor readout */
+#define FAULT_SENSOR_GLITCH_VALUE       (150.0f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Fault injection settings, all zero means no fault */
+typedef struct {
+    uint8_t relayDropPercent;           /**< Relay exchanges failing as if the relay did not answer */
+    uint16_t relayDelayMs;              /**< Latency added to every relay exchange */
+    uint8_t relayCorruptPercent;        /**< Relay status answers replaced with garbage */
+    uint8_t sensorGlitchPercent;        /**< Sensor readouts replaced with an out of range value */
+    uint8_t sensorFailPercent;          /**< Sensor readouts failing as on an I2C NACK */
+} t_faultInjectionConfig;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+#ifdef FAULT_INJECTION
+/**
+ * @brief Fault injection class definition.
+ * @details
+ *  Settings are written from the HomeSpan poll task by the @F command and read
+ *  by the control task. Each field is a single byte or half-word, a torn
+ *  update only mixes old and new settings for one pass.
+ */
+class FaultInjection {
+private:
+    /** @brief Settings */
+    volatile t_faultInjectionConfig config;
+
+    /** @brief @F user command handler */
+    static void command(const char * buf);
+
+public:
+    /** @brief Constructor */
+    FaultInjection() : config() {};
+
+    /** @brief Register the @F user command */
+    void begin(void);
+
+    /** @brief Get the settings */
+    const volatile t_faultInjectionConfig & getConfig(void) const { return (config); }
+
+    /**
+     * @brief Draw a fault
+     *
+     * @param percent       Probability of the fault
+     *
+     * @return true         If the fault must be injected
+     */
+    bool draw(const uint8_t percent) const { return ((percent > 0U) && ((esp_random() % 100U) < percent)); }
+
+    /** @brief Add the configured relay latency */
+    void delayRelay(void) const {
+        if (config.relayDelayMs > 0U) {
+            delay(config.relayDelayMs);
+        }
+    }
+};
+
+/** @brief Fault injection settings of the bridge */
+extern FaultInjection faultInjection;
+#endif
+
+#endif /* FAULT_INJECTION_H */
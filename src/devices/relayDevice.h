@@ -0,0 +1,66 @@
+#ifndef RELAY_DEVICE_H
+#define RELAY_DEVICE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents all the possible HTTP Requests failures*/
+typedef enum {
+    E_REQUEST_SUCCESS = 0U,             /**< HTTP Request success */
+    E_REQUEST_FAILURE = 1U              /**< HTTP Request failure */
+} t_httpErrorCodes;
+
+/** @brief ESP-01S Relay State */
+typedef enum {
+    E_ESP01S_RELAY_OPEN  = 0U,          /**< ESP-01S Relay Open */
+    E_ESP01S_RELAY_CLOSE = 1U           /**< ESP-01S Relay Close */
+} t_esp01sRelayState;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Relay device interface.
+ * @details
+ *  What the zone control needs from a relay. Esp01sRelay implements it for
+ *  the ESP-01S boards, host tests implement it to script relay answers.
+ */
+class RelayDevice {
+public:
+    virtual ~RelayDevice() {}
+
+    /**
+     * @brief Send a command to the relay
+     *
+     * @param command       E_ESP01S_RELAY_OPEN or E_ESP01S_RELAY_CLOSE
+     *
+     * @return E_REQUEST_SUCCESS if the relay acknowledged the command
+     */
+    virtual t_httpErrorCodes sendEsp01sRelayCommand(const t_esp01sRelayState command) = 0;
+
+    /**
+     * @brief Query the relay state
+     *
+     * @param relayState    State reported by the relay, only written on success
+     *
+     * @return E_REQUEST_SUCCESS if the relay answered
+     */
+    virtual t_httpErrorCodes getEsp01sRelayState(t_esp01sRelayState * const relayState) = 0;
+
+    /** @brief Get the last state confirmed by the relay, no request is sent */
+    virtual t_esp01sRelayState getConfirmedState(void) const = 0;
+
+    /** @brief Preset the confirmed state, used on boot with the last known state */
+    virtual void presetState(const t_esp01sRelayState state) = 0;
+};
+
+#endif /* RELAY_DEVICE_H */
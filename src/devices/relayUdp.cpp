@@ -0,0 +1,126 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+#include <mbedtls/md.h>
+
+/* Local files */
+#include "relayUdp.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Number of bytes covered by the tag */
+#define RELAY_UDP_SIGNED_LEN            (offsetof(t_relayUdpPacket, tag))
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void computeTag(const t_relayUdpPacket * const packet, const char * const key, uint8_t * const tag) {
+
+    uint8_t hmac[32];
+
+    (void)mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                          (const uint8_t *)key, strlen(key),
+                          (const uint8_t *)packet, RELAY_UDP_SIGNED_LEN, hmac);
+    memcpy(tag, hmac, RELAY_UDP_TAG_LEN);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+WiFiUDP RelayUdp::udp;
+bool RelayUdp::udpReady = false;
+
+RelayUdp::RelayUdp(const char * const relayIpAddress, const uint16_t portId, const char * const key) {
+    relayIp.fromString(relayIpAddress);
+    relayPort = portId;
+    this->key = key;
+
+    /* Start from a random sequence so that a reboot does not replay old numbers */
+    sequence = esp_random();
+}
+
+void RelayUdp::encode(t_relayUdpPacket * const packet, const t_relayUdpType type, const uint8_t state,
+                      const uint32_t sequence, const char * const key) {
+    packet->magic = RELAY_UDP_MAGIC;
+    packet->type = type;
+    packet->state = state;
+    packet->reserved = 0U;
+    packet->sequence = sequence;
+    computeTag(packet, key, packet->tag);
+}
+
+bool RelayUdp::verify(const t_relayUdpPacket * const packet, const int len, const char * const key) {
+
+    uint8_t tag[RELAY_UDP_TAG_LEN];
+    uint8_t diff = 0U;
+
+    if ((len != sizeof(t_relayUdpPacket)) || (packet->magic != RELAY_UDP_MAGIC) || (packet->state > 1U)) {
+        return (false);
+    }
+
+    /* Constant time comparison */
+    computeTag(packet, key, tag);
+    for (uint8_t i = 0; i < RELAY_UDP_TAG_LEN; i++) {
+        diff |= tag[i] ^ packet->tag[i];
+    }
+
+    return (diff == 0U);
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+bool RelayUdp::exchange(const t_relayUdpType type, const uint8_t state, uint8_t * const echo) {
+
+    t_relayUdpPacket request;
+    t_relayUdpPacket answer;
+    uint32_t timeout = RELAY_UDP_INITIAL_TIMEOUT;
+
+    if (udpReady == false) {
+        udpReady = (udp.begin(RELAY_UDP_LOCAL_PORT) == 1);
+        if (udpReady == false) {
+            WEBLOG("Failed to open the relay UDP socket");
+            return (false);
+        }
+    }
+
+    /* Retransmissions reuse the sequence number, the relay applies SET idempotently */
+    encode(&request, type, state, ++sequence, key);
+
+    for (uint8_t i = 0; i < RELAY_UDP_NB_TRIES; i++) {
+        udp.beginPacket(relayIp, relayPort);
+        udp.write((const uint8_t *)&request, sizeof(request));
+        udp.endPacket();
+
+        uint64_t start = Utils::uptime();
+        while ((Utils::uptime() - start) < timeout) {
+            int len = udp.parsePacket();
+            if (len == 0) {
+                delay(1);
+                continue;
+            }
+
+            /* Discard late answers and datagrams from other hosts */
+            int nbRead = udp.read((uint8_t *)&answer, sizeof(answer));
+            if ((udp.remoteIP() != relayIp) || (len != nbRead) ||
+                (verify(&answer, nbRead, key) == false) ||
+                (answer.type != E_RELAY_UDP_ACK) || (answer.sequence != sequence)) {
+                continue;
+            }
+
+            *echo = answer.state;
+            return (true);
+        }
+
+        timeout *= 2U;
+    }
+
+    WEBLOG("No answer from relay %s after %d tries", relayIp.toString().c_str(), RELAY_UDP_NB_TRIES);
+    return (false);
+}
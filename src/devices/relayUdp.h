@@ -0,0 +1,142 @@
+#ifndef RELAY_UDP_H
+#define RELAY_UDP_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "Arduino.h"
+#include <WiFiUdp.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief First byte of every relay datagram */
+#define RELAY_UDP_MAGIC                 (0xA5U)
+
+/** @brief Local port used to talk to the relays */
+#define RELAY_UDP_LOCAL_PORT            (4211U)
+
+/** @brief Length of the truncated HMAC-SHA256 tag */
+#define RELAY_UDP_TAG_LEN               (16U)
+
+/** @brief Retransmission: first timeout in ms, doubled on every try */
+#define RELAY_UDP_INITIAL_TIMEOUT       (50U)
+#define RELAY_UDP_NB_TRIES              (5U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Datagram types */
+typedef enum {
+    E_RELAY_UDP_SET = 0x01U,            /**< Set the relay state (idempotent) */
+    E_RELAY_UDP_GET = 0x02U,            /**< Query the relay state */
+    E_RELAY_UDP_ACK = 0x81U             /**< Answer to SET and GET, echoes the relay state */
+} t_relayUdpType;
+
+/** @brief Fixed-size relay datagram (little endian) */
+typedef struct __attribute__((packed)) {
+    uint8_t magic;                      /**< RELAY_UDP_MAGIC */
+    uint8_t type;                       /**< t_relayUdpType */
+    uint8_t state;                      /**< Requested state (SET) or current relay state (ACK) */
+    uint8_t reserved;                   /**< Always 0 */
+    uint32_t sequence;                  /**< Request sequence number, echoed in the ACK */
+    uint8_t tag[RELAY_UDP_TAG_LEN];     /**< HMAC-SHA256 of the previous fields, truncated */
+} t_relayUdpPacket;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Relay UDP transport class definition.
+ * @details
+ *  This class talks to a relay with single authenticated datagrams. Every
+ *  request carries a new sequence number and is retransmitted with
+ *  exponential backoff until the matching ACK is received.
+ */
+class RelayUdp {
+private:
+    /** @brief Relay address */
+    IPAddress relayIp;
+
+    /** @brief Relay port */
+    uint16_t relayPort;
+
+    /** @brief Shared HMAC key */
+    const char * key;
+
+    /** @brief Sequence number of the last request */
+    uint32_t sequence;
+
+    /** @brief Socket shared by all the UDP relays */
+    static WiFiUDP udp;
+
+    /** @brief Flag to track if the shared socket is open */
+    static bool udpReady;
+
+    /**
+     * @brief Send a request and wait for its ACK
+     *
+     * @param type          E_RELAY_UDP_SET or E_RELAY_UDP_GET
+     * @param state         Requested state (ignored for GET)
+     * @param echo          Relay state reported in the ACK
+     *
+     * @return true         If a valid ACK was received
+     * @return false        No valid ACK after RELAY_UDP_NB_TRIES
+     */
+    bool exchange(const t_relayUdpType type, const uint8_t state, uint8_t * const echo);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param relayIpAddress    IP address of the relay
+     * @param portId            UDP port of the relay
+     * @param key               Shared HMAC key, must remain valid
+     */
+    RelayUdp(const char * const relayIpAddress, const uint16_t portId, const char * const key);
+
+    /**
+     * @brief Encode a datagram
+     *
+     * @param packet        Datagram to fill
+     * @param type          Datagram type
+     * @param state         Relay state
+     * @param sequence      Sequence number
+     * @param key           Shared HMAC key
+     */
+    static void encode(t_relayUdpPacket * const packet, const t_relayUdpType type, const uint8_t state,
+                       const uint32_t sequence, const char * const key);
+
+    /**
+     * @brief Check a received datagram
+     *
+     * @param packet        Received datagram
+     * @param len           Number of bytes received
+     * @param key           Shared HMAC key
+     *
+     * @return true         If the datagram is well formed and authenticated
+     * @return false        Otherwise
+     */
+    static bool verify(const t_relayUdpPacket * const packet, const int len, const char * const key);
+
+    /**
+     * @brief Set the relay state
+     *
+     * @param state         0 open, 1 close
+     * @param echo          Relay state reported in the ACK
+     *
+     * @return true         If the relay acknowledged the command
+     */
+    bool setState(const uint8_t state, uint8_t * const echo) { return (exchange(E_RELAY_UDP_SET, state, echo)); }
+
+    /**
+     * @brief Query the relay state
+     *
+     * @param echo          Relay state reported in the ACK
+     *
+     * @return true         If the relay answered
+     */
+    bool getState(uint8_t * const echo) { return (exchange(E_RELAY_UDP_GET, 0U, echo)); }
+};
+
+#endif /* RELAY_UDP_H */
@@ -0,0 +1,87 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "remoteSensor.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Valid ranges of the reported values */
+#define REMOTE_SENSOR_MIN_TEMPERATURE           (-4000)
+#define REMOTE_SENSOR_MAX_TEMPERATURE           (8500)
+#define REMOTE_SENSOR_MAX_HUMIDITY              (10000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+RemoteSensor::RemoteSensor(const char * const macAddress) {
+    head = 0U;
+    nbSamples = 0U;
+    lastSequence = 0U;
+    nbDropped = 0U;
+
+    /* Receive only, the bridge never sends to the sensor nodes */
+    point = new SpanPoint(macAddress, 0, sizeof(t_remoteSensorFrame), REMOTE_SENSOR_QUEUE_DEPTH);
+}
+
+bool RemoteSensor::decodeFrame(const t_remoteSensorFrame * const frame, t_remoteSensorSample * const sample) {
+
+    if ((frame->version != REMOTE_SENSOR_FRAME_VERSION) ||
+        (frame->temperature < REMOTE_SENSOR_MIN_TEMPERATURE) ||
+        (frame->temperature > REMOTE_SENSOR_MAX_TEMPERATURE) ||
+        (frame->humidity > REMOTE_SENSOR_MAX_HUMIDITY)) {
+        return (false);
+    }
+
+    sample->temperature = frame->temperature / 100.0f;
+    sample->humidity = (frame->flags & REMOTE_SENSOR_FLAG_HUMIDITY_VALID) ? frame->humidity / 100.0f : NAN;
+    sample->batteryMv = frame->batteryMv;
+    sample->lowBattery = (frame->flags & REMOTE_SENSOR_FLAG_LOW_BATTERY) != 0U;
+
+    return (true);
+}
+
+uint8_t RemoteSensor::receive(void) {
+
+    t_remoteSensorFrame frame;
+    t_remoteSensorSample sample;
+    uint8_t nbStored = 0U;
+
+    while (point->get(&frame) == true) {
+        /* Nodes resend a frame when the ESP-NOW ack is lost, keep only the first copy */
+        if (((nbSamples > 0U) && (frame.sequence == lastSequence)) ||
+            (decodeFrame(&frame, &sample) == false)) {
+            nbDropped++;
+            continue;
+        }
+
+        sample.time = Utils::uptime();
+        head = (head + 1U) % REMOTE_SENSOR_NB_SAMPLES;
+        samples[head] = sample;
+        if (nbSamples < REMOTE_SENSOR_NB_SAMPLES) {
+            nbSamples++;
+        }
+        lastSequence = frame.sequence;
+        nbStored++;
+    }
+
+    return (nbStored);
+}
+
+bool RemoteSensor::getSample(t_remoteSensorSample * const sample) {
+
+    if (nbSamples == 0U) {
+        return (false);
+    }
+
+    *sample = samples[head];
+    return ((Utils::uptime() - sample->time) <= REMOTE_SENSOR_STALE_TIME);
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
@@ -0,0 +1,125 @@
+#ifndef REMOTE_SENSOR_H
+#define REMOTE_SENSOR_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Version of the remote sensor frame format */
+#define REMOTE_SENSOR_FRAME_VERSION             (1U)
+
+/** @brief Frame flags */
+#define REMOTE_SENSOR_FLAG_HUMIDITY_VALID       (0x01U)
+#define REMOTE_SENSOR_FLAG_LOW_BATTERY          (0x02U)
+
+/** @brief Number of samples kept per remote sensor */
+#define REMOTE_SENSOR_NB_SAMPLES                (4U)
+
+/** @brief Depth of the SpanPoint receive queue of a remote sensor */
+#define REMOTE_SENSOR_QUEUE_DEPTH               (4U)
+
+/** @brief Time in ms after which the last frame of a remote sensor is considered stale */
+#define REMOTE_SENSOR_STALE_TIME                (5 * 60 * 1000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Frame pushed by a battery sensor node over ESP-NOW (little endian) */
+typedef struct __attribute__((packed)) {
+    uint8_t version;                    /**< REMOTE_SENSOR_FRAME_VERSION */
+    uint8_t flags;                      /**< REMOTE_SENSOR_FLAG_* */
+    uint16_t sequence;                  /**< Incremented by the node on every frame */
+    int16_t temperature;                /**< Temperature in 1/100 °C */
+    uint16_t humidity;                  /**< Relative humidity in 1/100 % */
+    uint16_t batteryMv;                 /**< Battery voltage in mV */
+} t_remoteSensorFrame;
+
+/** @brief Decoded remote sensor sample */
+typedef struct {
+    float temperature;                  /**< Temperature in °C */
+    float humidity;                     /**< Relative humidity in %, NAN if not reported */
+    uint16_t batteryMv;                 /**< Battery voltage in mV */
+    bool lowBattery;                    /**< Low battery flag reported by the node */
+    uint64_t time;                      /**< Utils::uptime() when the frame was received */
+} t_remoteSensorSample;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Remote sensor class definition.
+ * @details
+ *  This class receives the frames of one battery sensor node through a SpanPoint
+ *  and keeps its last samples. SpanPoint already demultiplexes the frames by MAC
+ *  address, so each remote zone owns one RemoteSensor.
+ */
+class RemoteSensor {
+private:
+    /** @brief ESP-NOW endpoint of the sensor node */
+    SpanPoint * point;
+
+    /** @brief Ring of the last samples */
+    t_remoteSensorSample samples[REMOTE_SENSOR_NB_SAMPLES];
+
+    /** @brief Index of the most recent sample */
+    uint8_t head;
+
+    /** @brief Number of valid samples */
+    uint8_t nbSamples;
+
+    /** @brief Sequence number of the most recent frame */
+    uint16_t lastSequence;
+
+    /** @brief Number of frames dropped as invalid or duplicated */
+    uint32_t nbDropped;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param macAddress    MAC address of the sensor node, "XX:XX:XX:XX:XX:XX"
+     */
+    RemoteSensor(const char * const macAddress);
+
+    /**
+     * @brief Decode a frame
+     * @details
+     *  This method validates and converts a raw frame, it has no side effect.
+     *
+     * @param frame         Raw frame
+     * @param sample        Decoded sample, time is left untouched
+     *
+     * @return true         If the frame is valid
+     * @return false        Unknown version or out of range values
+     */
+    static bool decodeFrame(const t_remoteSensorFrame * const frame, t_remoteSensorSample * const sample);
+
+    /**
+     * @brief Receive pending frames
+     * @details
+     *  This method drains the SpanPoint queue and stores the valid frames.
+     *  Frames repeating the previous sequence number are dropped.
+     *
+     * @return Number of samples stored
+     */
+    uint8_t receive(void);
+
+    /**
+     * @brief Get the most recent sample
+     *
+     * @param sample        Most recent sample
+     *
+     * @return true         If a sample was received within REMOTE_SENSOR_STALE_TIME
+     * @return false        No sample or stale sample
+     */
+    bool getSample(t_remoteSensorSample * const sample);
+
+    /** @brief Get the number of dropped frames */
+    uint32_t getNbDropped(void) { return (nbDropped); }
+};
+
+#endif /* REMOTE_SENSOR_H */
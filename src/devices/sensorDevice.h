@@ -0,0 +1,51 @@
+#ifndef SENSOR_DEVICE_H
+#define SENSOR_DEVICE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Temperature and humidity sensor interface.
+ * @details
+ *  What the zone control needs from the sensor wired to the bridge.
+ *  TempHumSensor implements it for the AHT20, host tests implement it to
+ *  script readouts.
+ */
+class SensorDevice {
+public:
+    virtual ~SensorDevice() {}
+
+    /**
+     * @brief Initialize the sensor
+     *
+     * @return true     If the sensor answered
+     */
+    virtual bool initializeSensor(void) = 0;
+
+    /**
+     * @brief Run one conversion, giving both the temperature and the humidity
+     *
+     * @return true     If the sensor answered
+     */
+    virtual bool measure(void) = 0;
+
+    /** @brief Get the temperature of the last measure(), NAN if the sensor did not answer */
+    virtual float getCurrentTemperature(void) = 0;
+
+    /** @brief Get the humidity of the last measure(), NAN if the sensor did not answer */
+    virtual float getCurrentHumidity(void) = 0;
+};
+
+#endif /* SENSOR_DEVICE_H */
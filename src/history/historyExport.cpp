@@ -0,0 +1,169 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "historyExport.h"
+
+/* Local files */
+#include "zones/zoneTable.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Maximum size of one encoded sample, CSV or binary */
+#define HISTORY_EXPORT_MAX_SAMPLE_LEN           (64U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Export state, lives on the stack for the duration of the request */
+typedef struct {
+    WiFiClient * client;                /**< HTTP client */
+    bool binary;                        /**< Binary or CSV format */
+    uint32_t period;                    /**< Tier period in seconds */
+    t_historyPoint previous;            /**< Previous sample, reference of the binary deltas */
+    uint16_t len;                       /**< Number of bytes in buffer */
+    uint8_t buffer[HISTORY_EXPORT_CHUNK_LEN];
+} t_historyExport;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void flushChunk(t_historyExport & exp) {
+
+    char header[8];
+
+    if (exp.len == 0U) {
+        return;
+    }
+
+    snprintf(header, sizeof(header), "%x\r\n", exp.len);
+    exp.client->print(header);
+    exp.client->write(exp.buffer, exp.len);
+    exp.client->print("\r\n");
+    exp.len = 0U;
+}
+
+static void putVarint(t_historyExport & exp, uint32_t value) {
+    while (value >= 0x80U) {
+        exp.buffer[exp.len++] = (uint8_t)(value | 0x80U);
+        value >>= 7;
+    }
+    exp.buffer[exp.len++] = (uint8_t)value;
+}
+
+static void putZigzag(t_historyExport & exp, const int32_t value) {
+    putVarint(exp, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+static bool exportSample(const t_historyPoint & point, void * arg) {
+
+    t_historyExport & exp = *(t_historyExport *)arg;
+    const t_historySample & sample = point.sample;
+
+    if (exp.len + HISTORY_EXPORT_MAX_SAMPLE_LEN > HISTORY_EXPORT_CHUNK_LEN) {
+        flushChunk(exp);
+    }
+
+    if (exp.binary == true) {
+        putVarint(exp, (point.time - exp.previous.time) / exp.period);
+        putZigzag(exp, sample.temperature - exp.previous.sample.temperature);
+        putZigzag(exp, sample.humidity - exp.previous.sample.humidity);
+        putZigzag(exp, sample.setpoint - exp.previous.sample.setpoint);
+        exp.buffer[exp.len++] = sample.relayDuty;
+        exp.previous = point;
+    } else {
+        char humidity[8] = "";
+        if (sample.humidity != HISTORY_NO_HUMIDITY) {
+            snprintf(humidity, sizeof(humidity), "%.1f", sample.humidity / 10.0f);
+        }
+        exp.len += snprintf((char *)exp.buffer + exp.len, HISTORY_EXPORT_CHUNK_LEN - exp.len, "%u,%.2f,%s,%.1f,%u\n",
+                            (unsigned int)point.time, sample.temperature / 100.0f, humidity,
+                            sample.setpoint / 10.0f, sample.relayDuty);
+    }
+
+    /* Stop early if the client went away */
+    return (exp.client->connected());
+}
+
+static bool getArg(const char * args, const char * name, char * const value, const size_t len) {
+
+    size_t nameLen = strlen(name);
+    const char * p = args;
+
+    /* Arguments end at the space before "HTTP/1.1" */
+    while ((p = strstr(p, name)) != NULL) {
+        if (((p[-1] == '?') || (p[-1] == '&')) && (p[nameLen] == '=')) {
+            p += nameLen + 1U;
+            size_t i = 0;
+            while ((p[i] != '&') && (p[i] != ' ') && (p[i] != '\0') && (i < len - 1U)) {
+                value[i] = p[i];
+                i++;
+            }
+            value[i] = '\0';
+            return (true);
+        }
+        p += nameLen;
+    }
+
+    return (false);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void historyExport(WiFiClient & client, const char * args) {
+
+    static const uint32_t periods[E_HISTORY_NB_TIERS] = {HISTORY_PERIOD_1MIN, HISTORY_PERIOD_15MIN, HISTORY_PERIOD_1HOUR};
+    t_historyExport exp;
+    char value[16];
+    uint8_t index = 0U;
+    t_historyTier tier = E_HISTORY_TIER_1HOUR;
+    uint32_t from = 0U;
+    uint32_t to = UINT32_MAX;
+
+    /* Query string is only present if args starts with '?' */
+    if (args[0] != '?') {
+        args = "";
+    }
+
+    if (getArg(args, "zone", value, sizeof(value))) {
+        index = strtoul(value, NULL, 10);
+    }
+    if (getArg(args, "tier", value, sizeof(value))) {
+        tier = !strcmp(value, "1m") ? E_HISTORY_TIER_1MIN : !strcmp(value, "15m") ? E_HISTORY_TIER_15MIN : E_HISTORY_TIER_1HOUR;
+    }
+    if (getArg(args, "from", value, sizeof(value))) {
+        from = strtoul(value, NULL, 10);
+    }
+    if (getArg(args, "to", value, sizeof(value))) {
+        to = strtoul(value, NULL, 10);
+    }
+
+    t_zone * zone = zoneTable.getZone(index);
+    if (zone == NULL) {
+        client.print("HTTP/1.1 404 Not Found\r\n\r\n");
+        return;
+    }
+
+    memset(&exp, 0, sizeof(exp));
+    exp.client = &client;
+    exp.binary = getArg(args, "format", value, sizeof(value)) && !strcmp(value, "bin");
+    exp.period = periods[tier];
+
+    client.print("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\nContent-Type: ");
+    client.print(exp.binary ? "application/octet-stream\r\n\r\n" : "text/csv\r\n\r\n");
+
+    if (exp.binary == true) {
+        memcpy(exp.buffer, HISTORY_EXPORT_MAGIC, strlen(HISTORY_EXPORT_MAGIC));
+        exp.len = strlen(HISTORY_EXPORT_MAGIC);
+        putVarint(exp, index);
+        putVarint(exp, exp.period);
+    } else {
+        exp.len = snprintf((char *)exp.buffer, HISTORY_EXPORT_CHUNK_LEN, "time,temperature,humidity,setpoint,relay_duty\n");
+    }
+
+    (void)zone->history->query(tier, from, to, exportSample, &exp);
+
+    flushChunk(exp);
+    client.print("0\r\n\r\n");
+}
@@ -0,0 +1,49 @@
+#ifndef HISTORY_EXPORT_H
+#define HISTORY_EXPORT_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Web route of the export, served next to the web log */
+#define HISTORY_EXPORT_URL                      ("history")
+
+/** @brief Size of the chunks written to the client */
+#define HISTORY_EXPORT_CHUNK_LEN                (512U)
+
+/** @brief First bytes of the binary format */
+#define HISTORY_EXPORT_MAGIC                    ("HST1")
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @brief Stream the history of a zone
+ * @details
+ *  Handler of GET /history?zone=<n>&tier=<1m|15m|1h>&from=<epoch>&to=<epoch>&format=<csv|bin>.
+ *  All arguments are optional, defaults are zone 0, 1h tier, whole range and CSV.
+ *  The response uses chunked transfer encoding and a single fixed-size buffer.
+ *
+ *  The binary format starts with "HST1", the zone and the tier period in seconds
+ *  as unsigned varints. Each sample follows as:
+ *   - time delta to the previous sample, in periods (unsigned varint)
+ *   - temperature delta in 1/100 °C (zigzag varint)
+ *   - humidity delta in 1/10 % (zigzag varint, 65535 means unknown)
+ *   - setpoint delta in 1/10 °C (zigzag varint)
+ *   - relay duty in % (one byte)
+ *  Deltas of the first sample are relative to zero.
+ *
+ * @param client        HTTP client
+ * @param args          Query string
+ */
+void historyExport(WiFiClient & client, const char * args);
+
+#endif /* HISTORY_EXPORT_H */
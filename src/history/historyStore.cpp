@@ -0,0 +1,254 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+/* Local files */
+#include "historyStore.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief NVS namespace of the flushed history */
+#define HISTORY_NVS_NAMESPACE                   ("HISTORY")
+
+/** @brief Maximum length of the NVS keys, including the tier suffix */
+#define HISTORY_KEY_LEN                         (16U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Ring position, saved next to the blocks */
+typedef struct {
+    uint16_t head;
+    uint16_t used;
+    t_historySample last;
+} t_historyRingState;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static bool fitsInt8(const int32_t value) {
+    return ((value >= INT8_MIN) && (value <= INT8_MAX));
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void HistoryTier::begin(const uint16_t depth, const uint32_t period, const uint8_t step) {
+    /* One spare block so that depth samples survive while the oldest block is recycled */
+    nbBlocks = (depth + HISTORY_BLOCK_LEN - 1U) / HISTORY_BLOCK_LEN + 1U;
+    blocks = (t_historyBlock *)calloc(nbBlocks, sizeof(t_historyBlock));
+    this->period = period;
+    temperatureStep = step;
+    head = 0U;
+    used = 0U;
+}
+
+void HistoryTier::append(const uint32_t time, const t_historySample & sample) {
+
+    if (blocks == NULL) {
+        return;
+    }
+
+    if (used > 0U) {
+        t_historyBlock & block = blocks[head];
+        int32_t dTemperature = sample.temperature - last.temperature;
+        dTemperature = (dTemperature + (dTemperature >= 0 ? 1 : -1) * temperatureStep / 2) / temperatureStep;
+        int32_t dHumidity = sample.humidity - last.humidity;
+        int32_t dSetpoint = sample.setpoint - last.setpoint;
+
+        if ((block.count < HISTORY_BLOCK_LEN) &&
+            (time == block.time + block.count * period) &&
+            fitsInt8(dTemperature) && fitsInt8(dHumidity) && fitsInt8(dSetpoint)) {
+            block.deltas[block.count - 1U] = {(int8_t)dTemperature, (int8_t)dHumidity, (int8_t)dSetpoint, sample.relayDuty};
+            block.count++;
+
+            /* Track the decoded value so that rounding errors do not accumulate */
+            int16_t decoded = last.temperature + dTemperature * temperatureStep;
+            last = sample;
+            last.temperature = decoded;
+            return;
+        }
+
+        head = (head + 1U) % nbBlocks;
+    }
+
+    /* Start a new block, recycling the oldest one when the ring is full */
+    if (used < nbBlocks) {
+        used++;
+    }
+    blocks[head].time = time;
+    blocks[head].key = sample;
+    blocks[head].count = 1U;
+    last = sample;
+}
+
+uint32_t HistoryTier::query(const uint32_t from, const uint32_t to, t_historyCallback callback, void * arg) const {
+
+    uint32_t nbVisited = 0U;
+
+    for (uint16_t i = 0; i < used; i++) {
+        const t_historyBlock & block = blocks[(head + nbBlocks - used + 1U + i) % nbBlocks];
+
+        /* Skip whole blocks outside of the range */
+        if ((block.time > to) || (block.time + block.count * period <= from)) {
+            continue;
+        }
+
+        t_historyPoint point = {block.time, block.key};
+        for (uint8_t j = 0; j < block.count; j++) {
+            if (j > 0U) {
+                const t_historyDelta & delta = block.deltas[j - 1U];
+                point.time += period;
+                point.sample.temperature += delta.temperature * temperatureStep;
+                point.sample.humidity += delta.humidity;
+                point.sample.setpoint += delta.setpoint;
+                point.sample.relayDuty = delta.relayDuty;
+            }
+
+            if ((point.time < from) || (point.time > to)) {
+                continue;
+            }
+
+            nbVisited++;
+            if (callback(point, arg) == false) {
+                return (nbVisited);
+            }
+        }
+    }
+
+    return (nbVisited);
+}
+
+void HistoryTier::load(const nvs_handle handle, const char * const key) {
+
+    char blocksKey[HISTORY_KEY_LEN];
+    t_historyRingState state;
+    size_t len = sizeof(state);
+
+    snprintf(blocksKey, sizeof(blocksKey), "%s.b", key);
+
+    if ((blocks == NULL) ||
+        (nvs_get_blob(handle, key, &state, &len) != ESP_OK) || (len != sizeof(state)) ||
+        (state.used > nbBlocks) || (state.head >= nbBlocks)) {
+        return;
+    }
+
+    len = nbBlocks * sizeof(t_historyBlock);
+    if ((nvs_get_blob(handle, blocksKey, blocks, &len) != ESP_OK) || (len != nbBlocks * sizeof(t_historyBlock))) {
+        memset(blocks, 0, nbBlocks * sizeof(t_historyBlock));
+        return;
+    }
+
+    head = state.head;
+    used = state.used;
+    last = state.last;
+}
+
+void HistoryTier::save(const nvs_handle handle, const char * const key) const {
+
+    char blocksKey[HISTORY_KEY_LEN];
+    t_historyRingState state = {head, used, last};
+
+    snprintf(blocksKey, sizeof(blocksKey), "%s.b", key);
+
+    if (blocks == NULL) {
+        return;
+    }
+
+    (void)nvs_set_blob(handle, blocksKey, blocks, nbBlocks * sizeof(t_historyBlock));
+    (void)nvs_set_blob(handle, key, &state, sizeof(state));
+}
+
+HistoryStore::HistoryStore() {
+    tiers[E_HISTORY_TIER_1MIN].begin(HISTORY_DEPTH_1MIN, HISTORY_PERIOD_1MIN, HISTORY_TEMPERATURE_STEP_1MIN);
+    tiers[E_HISTORY_TIER_15MIN].begin(HISTORY_DEPTH_15MIN, HISTORY_PERIOD_15MIN, HISTORY_TEMPERATURE_STEP_COARSE);
+    tiers[E_HISTORY_TIER_1HOUR].begin(HISTORY_DEPTH_1HOUR, HISTORY_PERIOD_1HOUR, HISTORY_TEMPERATURE_STEP_COARSE);
+    memset(accumulators, 0, sizeof(accumulators));
+    lastFlush = 0U;
+}
+
+void HistoryStore::addSample(const uint32_t time, const t_historySample & sample) {
+    accumulate(E_HISTORY_TIER_1MIN, time, sample);
+}
+
+size_t HistoryStore::getMemoryUsage(void) const {
+
+    size_t total = sizeof(*this);
+
+    for (uint8_t i = 0; i < E_HISTORY_NB_TIERS; i++) {
+        total += tiers[i].getMemoryUsage();
+    }
+
+    return (total);
+}
+
+void HistoryStore::load(const char * const key) {
+
+    nvs_handle handle;
+
+    if (nvs_open(HISTORY_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+
+    tiers[E_HISTORY_TIER_1HOUR].load(handle, key);
+    nvs_close(handle);
+}
+
+void HistoryStore::flush(const char * const key, const uint64_t now) {
+
+    nvs_handle handle;
+
+    if ((HISTORY_FLUSH_PERIOD == 0U) || ((now - lastFlush) < HISTORY_FLUSH_PERIOD)) {
+        return;
+    }
+    lastFlush = now;
+
+    if (nvs_open(HISTORY_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    tiers[E_HISTORY_TIER_1HOUR].save(handle, key);
+    (void)nvs_commit(handle);
+    nvs_close(handle);
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void HistoryStore::accumulate(const uint8_t tier, const uint32_t time, const t_historySample & sample) {
+
+    static const uint32_t periods[E_HISTORY_NB_TIERS] = {HISTORY_PERIOD_1MIN, HISTORY_PERIOD_15MIN, HISTORY_PERIOD_1HOUR};
+    t_historyAccumulator & acc = accumulators[tier];
+    uint32_t start = time - time % periods[tier];
+
+    /* Close the period when a later one starts */
+    if ((acc.count > 0U) && (start != acc.time)) {
+        t_historySample average;
+        average.temperature = acc.temperature / acc.count;
+        average.humidity = acc.humidityCount > 0U ? acc.humidity / acc.humidityCount : HISTORY_NO_HUMIDITY;
+        average.setpoint = acc.setpoint;
+        average.relayDuty = acc.relayDuty / acc.count;
+        average.reserved = 0U;
+
+        tiers[tier].append(acc.time, average);
+        if (tier + 1U < E_HISTORY_NB_TIERS) {
+            accumulate(tier + 1U, acc.time, average);
+        }
+
+        memset(&acc, 0, sizeof(acc));
+    }
+
+    acc.time = start;
+    acc.temperature += sample.temperature;
+    acc.relayDuty += sample.relayDuty;
+    acc.setpoint = sample.setpoint;
+    acc.count++;
+    if (sample.humidity != HISTORY_NO_HUMIDITY) {
+        acc.humidity += sample.humidity;
+        acc.humidityCount++;
+    }
+}
@@ -0,0 +1,234 @@
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <nvs.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Number of samples per delta-encoded block (one key sample and deltas) */
+#define HISTORY_BLOCK_LEN                       (16U)
+
+/** @brief Tier periods in seconds */
+#define HISTORY_PERIOD_1MIN                     (60U)
+#define HISTORY_PERIOD_15MIN                    (15U * 60U)
+#define HISTORY_PERIOD_1HOUR                    (3600U)
+
+/** @brief Tier depths in samples: 3 hours, 3 days and 30 days */
+#define HISTORY_DEPTH_1MIN                      (3U * 60U)
+#define HISTORY_DEPTH_15MIN                     (3U * 24U * 4U)
+#define HISTORY_DEPTH_1HOUR                     (30U * 24U)
+
+/** @brief Temperature delta step in 1/100 °C: exact for 1 minute samples, 0.05 °C above so that hourly swings fit in 8 bits */
+#define HISTORY_TEMPERATURE_STEP_1MIN           (1U)
+#define HISTORY_TEMPERATURE_STEP_COARSE         (5U)
+
+/** @brief Humidity value of samples without humidity */
+#define HISTORY_NO_HUMIDITY                     (0xFFFFU)
+
+/** @brief Time in ms between two NVS flushes of the 1-hour tier, 0 to disable */
+#define HISTORY_FLUSH_PERIOD                    (6 * 3600 * 1000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Downsampling tiers */
+typedef enum {
+    E_HISTORY_TIER_1MIN  = 0U,          /**< 1 minute averages */
+    E_HISTORY_TIER_15MIN = 1U,          /**< 15 minutes averages */
+    E_HISTORY_TIER_1HOUR = 2U,          /**< 1 hour averages */
+    E_HISTORY_NB_TIERS   = 3U
+} t_historyTier;
+
+/** @brief Fixed-point sample */
+typedef struct {
+    int16_t temperature;                /**< Temperature in 1/100 °C */
+    uint16_t humidity;                  /**< Relative humidity in 1/10 %, HISTORY_NO_HUMIDITY if unknown */
+    int16_t setpoint;                   /**< Target temperature in 1/10 °C */
+    uint8_t relayDuty;                  /**< Share of the period the relay was closed, in % */
+    uint8_t reserved;                   /**< Always 0 */
+} t_historySample;
+
+/** @brief Sample returned by range queries */
+typedef struct {
+    uint32_t time;                      /**< Start of the period, seconds since epoch */
+    t_historySample sample;             /**< Values averaged over the period */
+} t_historyPoint;
+
+/** @brief Range query callback, return false to stop the query */
+typedef bool (*t_historyCallback)(const t_historyPoint & point, void * arg);
+
+/** @brief Difference between two consecutive samples of a block */
+typedef struct {
+    int8_t temperature;                 /**< Temperature step of the tier */
+    int8_t humidity;                    /**< 1/10 % */
+    int8_t setpoint;                    /**< 1/10 °C */
+    uint8_t relayDuty;                  /**< Absolute, in % */
+} t_historyDelta;
+
+/** @brief Block of consecutive samples, the first one in full and the others as deltas */
+typedef struct {
+    uint32_t time;                      /**< Time of the key sample, seconds since epoch */
+    t_historySample key;                /**< Key sample */
+    uint8_t count;                      /**< Number of samples in the block */
+    t_historyDelta deltas[HISTORY_BLOCK_LEN - 1U];
+} t_historyBlock;
+
+/** @brief Running average of a period being downsampled */
+typedef struct {
+    uint32_t time;                      /**< Start of the period */
+    int32_t temperature;                /**< Sum of temperatures */
+    uint32_t humidity;                  /**< Sum of known humidities */
+    uint32_t relayDuty;                 /**< Sum of relay duties */
+    int16_t setpoint;                   /**< Last setpoint */
+    uint16_t count;                     /**< Number of samples */
+    uint16_t humidityCount;             /**< Number of samples with humidity */
+} t_historyAccumulator;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief History tier class definition.
+ * @details
+ *  Ring of delta-encoded blocks holding samples of a fixed period. A block
+ *  is closed when it is full, when a sample does not immediately follow the
+ *  previous one, or when a delta does not fit in 8 bits.
+ */
+class HistoryTier {
+private:
+    /** @brief Ring of blocks */
+    t_historyBlock * blocks;
+
+    /** @brief Number of blocks of the ring */
+    uint16_t nbBlocks;
+
+    /** @brief Index of the newest block */
+    uint16_t head;
+
+    /** @brief Number of blocks in use */
+    uint16_t used;
+
+    /** @brief Period of the samples in seconds */
+    uint32_t period;
+
+    /** @brief Temperature delta step in 1/100 °C */
+    uint8_t temperatureStep;
+
+    /** @brief Newest sample as decoded, reference for the next delta */
+    t_historySample last;
+
+public:
+    /** @brief Constructor */
+    HistoryTier() : blocks(NULL), nbBlocks(0U), head(0U), used(0U), period(0U), temperatureStep(1U) {};
+
+    /**
+     * @brief Allocate the ring
+     *
+     * @param depth         Number of samples to keep
+     * @param period        Period of the samples in seconds
+     * @param step          Temperature delta step in 1/100 °C
+     */
+    void begin(const uint16_t depth, const uint32_t period, const uint8_t step);
+
+    /**
+     * @brief Append a sample
+     *
+     * @param time          Start of the period, seconds since epoch
+     * @param sample        Sample
+     */
+    void append(const uint32_t time, const t_historySample & sample);
+
+    /**
+     * @brief Visit the samples of a time range, oldest first
+     *
+     * @param from          First time, included
+     * @param to            Last time, included
+     * @param callback      Called for every sample
+     * @param arg           Passed to callback
+     *
+     * @return Number of samples visited
+     */
+    uint32_t query(const uint32_t from, const uint32_t to, t_historyCallback callback, void * arg) const;
+
+    /** @brief Get the number of bytes used by the ring */
+    size_t getMemoryUsage(void) const { return (nbBlocks * sizeof(t_historyBlock)); }
+
+    /** @brief Load the ring from an open NVS handle */
+    void load(const nvs_handle handle, const char * const key);
+
+    /** @brief Save the ring to an open NVS handle */
+    void save(const nvs_handle handle, const char * const key) const;
+};
+
+/**
+ * @brief History store class definition.
+ * @details
+ *  Time series of one zone. Samples are averaged into 1 minute periods,
+ *  which are averaged into 15 minutes periods, then into 1 hour periods.
+ *  Each period is kept in its own tier.
+ */
+class HistoryStore {
+private:
+    /** @brief Tiers */
+    HistoryTier tiers[E_HISTORY_NB_TIERS];
+
+    /** @brief Period being averaged for each tier */
+    t_historyAccumulator accumulators[E_HISTORY_NB_TIERS];
+
+    /** @brief Utils::uptime() of the last NVS flush */
+    uint64_t lastFlush;
+
+    /**
+     * @brief Add a sample to the period being averaged for a tier
+     * @details
+     *  The period is closed and appended to its tier, then forwarded to the
+     *  next tier, when a sample of a later period arrives.
+     */
+    void accumulate(const uint8_t tier, const uint32_t time, const t_historySample & sample);
+
+public:
+    /** @brief Constructor, allocates the tiers */
+    HistoryStore();
+
+    /**
+     * @brief Add a raw sample
+     *
+     * @param time          Seconds since epoch
+     * @param sample        Sample, relayDuty is 0 or 100
+     */
+    void addSample(const uint32_t time, const t_historySample & sample);
+
+    /**
+     * @brief Visit the samples of a tier in a time range, oldest first
+     *
+     * @return Number of samples visited
+     */
+    uint32_t query(const t_historyTier tier, const uint32_t from, const uint32_t to,
+                   t_historyCallback callback, void * arg) const {
+        return (tiers[tier].query(from, to, callback, arg));
+    }
+
+    /** @brief Get the number of bytes used by the tiers */
+    size_t getMemoryUsage(void) const;
+
+    /** @brief Load the 1-hour tier from NVS */
+    void load(const char * const key);
+
+    /**
+     * @brief Flush the 1-hour tier to NVS
+     * @details
+     *  Nothing is written before HISTORY_FLUSH_PERIOD elapsed since the previous flush.
+     *
+     * @param key           NVS key
+     * @param now           Utils::uptime()
+     */
+    void flush(const char * const key, const uint64_t now);
+};
+
+#endif /* HISTORY_STORE_H */
@@ -8,13 +8,11 @@
 
 /* Local files */
 #include "devices/deviceInfo.h"
-#include "devices/esp01sRelay.h"
+#include "devices/relayDevice.h"
 
 /************************************************
  *  Defines / Macros
  ***********************************************/
-/** @brief Update homekit device status time in ms */
-#define GET_STATUS_REFRESH_TIME_IN_MS           (30 * 1000)
 
 /************************************************
  *  Typedef definition
@@ -27,18 +25,14 @@ struct HS_RelaySwitch : Service::Switch {
     /* Characteristic */
     SpanCharacteristic *power;
 
-    /* ESP-01S Relay */
-    Esp01sRelay relay {THERMOSTAT_RELAY_IP_ADDRESS, THERMOSTAT_RELAY_PORT_ID};
+    /* ESP-01S Relay, owned by the zone */
+    RelayDevice * relay;
 
-    HS_RelaySwitch() : Service::Switch()  {
-        t_esp01sRelayState state;
+    HS_RelaySwitch(RelayDevice * relay) : Service::Switch(), relay(relay) {
         power = new Characteristic::On();
 
-        /* Get the current relay state */
-        (void)relay.getEsp01sRelayState(&state);
-        power->setVal<bool>(
-            state == E_ESP01S_RELAY_OPEN ? false : true
-        );
+        /* Last known state, until the control task hears from the relay */
+        refreshState(relay->getConfirmedState());
     }
 
     boolean update()
@@ -46,16 +40,12 @@ struct HS_RelaySwitch : Service::Switch {
         return (true);
     }
 
-    void loop() override {
-        /* Check the status of the relay */
-        if (power->timeVal() > GET_STATUS_REFRESH_TIME_IN_MS) {
-            t_esp01sRelayState state;
-            (void)relay.getEsp01sRelayState(&state);
-            power->setVal<bool>(
-                state == E_ESP01S_RELAY_OPEN ? false : true
-            );
-            WEBLOG("Relay state = %s", state == E_ESP01S_RELAY_OPEN ? "OPEN" : "CLOSE");
-        }
+    /* Publish the state confirmed by the relay, called by the zone scheduler */
+    void refreshState(t_esp01sRelayState state) {
+        power->setVal<bool>(
+            state == E_ESP01S_RELAY_OPEN ? false : true
+        );
+        WEBLOG("Relay state = %s", state == E_ESP01S_RELAY_OPEN ? "OPEN" : "CLOSE");
     }
 };
 
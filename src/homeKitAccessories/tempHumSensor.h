@@ -26,29 +26,37 @@ private:
     /** @brief Temperature Characteristic */
     SpanCharacteristic * temp;
 
-    /** @brief TempHumSensor Object */
-    TempHumSensor tempSensor;
-
 public:
-    /** @brief Constructor */
-    HS_TempSensor() : Service::TemperatureSensor() {
-        /* Initialize the Temperature & Humidity Sensor */
-        (void)tempSensor.initializeSensor();
-
-        /* Get the initial temperature */
-        temp = new Characteristic::CurrentTemperature(TEMPERATURE_INITIAL_VALUE);
+    /** @brief Constructor, starts from the last known temperature of the zone */
+    HS_TempSensor(float initialTemp) : Service::TemperatureSensor() {
+        temp = new Characteristic::CurrentTemperature(initialTemp);
 
         /* Set default values for temperature and humidity ranges */
         temp->setRange(TEMPERATURE_DEFAULT_MIN_VAL, TEMPERATURE_DEFAULT_MAX_VAL);
     }
 
-    /** @brief Loop function override */
-    void loop() override {
-        /* If it has been a while since last update */
-        if (temp->timeVal() > TEMPERATURE_SENSOR_POLLING_TIME) {
-            /* Set the temperature */
-            temp->setVal(tempSensor.getCurrentTemperature());
-        }
+    /** @brief Publish a new temperature readout, called by the zone scheduler */
+    void setTemperature(float reading) {
+        temp->setVal(reading);
+    }
+};
+
+struct HS_HumiditySensor : Service::HumiditySensor {
+private:
+    /** @brief Humidity Characteristic */
+    SpanCharacteristic * humidity;
+
+public:
+    /** @brief Constructor */
+    HS_HumiditySensor(float initialHumidity) : Service::HumiditySensor() {
+        humidity = new Characteristic::CurrentRelativeHumidity(initialHumidity);
+
+        humidity->setRange(HUMIDITY_DEFAULT_MIN_RANGE, HUMIDITY_DEFAULT_MAX_RANGE);
+    }
+
+    /** @brief Publish the humidity of a new readout, called by the zone scheduler */
+    void setHumidity(float reading) {
+        humidity->setVal(reading);
     }
 };
 
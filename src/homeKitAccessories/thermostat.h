@@ -10,6 +10,7 @@
 #include "devices/esp01sRelay.h"
 #include "devices/adafruitAht20.h"
 #include "devices/deviceInfo.h"
+#include "zones/zoneTable.h"
 
 /************************************************
  *  Defines / Macros
@@ -17,16 +18,15 @@
 /** @brief Default Target Humidity */
 #define THERMOSTAT_DEFAULT_TARGET_HUMIDITY          (50U)
 
-/** @brief Temperature hysteresis */
-#define THERMOSTAT_AUTO_HYSTERESIS                  (0.1)
-#define THERMOSTAT_MANUAL_HYSTERESIS                (0.5)
-
-/** @brief Alpha for exponential average */
-#define TEMPERATURE_ALPHA                           (0.75)
-
 /** @brief Time in MS in between characteristics update */
 #define THERMOSTAT_STATUS_UPDATE_POLLING_TIME       (30 * 1000U)
 
+/** @brief Minimum energy change in kWh notified to HomeKit */
+#define THERMOSTAT_ENERGY_NOTIFY_STEP               (0.01f)
+
+/** @brief Total consumption in kWh, displayed by the Eve app */
+CUSTOM_CHAR(TotalConsumption, E863F10C-079E-48FF-8F27-9C2605A29F52, PR+EV, FLOAT, 0, 0, 1000000, false);
+
 /************************************************
  *  Typedef definition
  ***********************************************/
@@ -47,35 +47,10 @@ enum TemperatureDisplayUnits {
 /************************************************
  *  Class definition
  ***********************************************/
-class CurrentHeaterStatus: public Characteristic::CurrentHeatingCoolingState {
-private:
-    /** @brief Heating relay Object */
-    Esp01sRelay heatingDevice {THERMOSTAT_RELAY_IP_ADDRESS, THERMOSTAT_RELAY_PORT_ID};
-
-public:
-    /** @brief Constructor */
-    CurrentHeaterStatus(): Characteristic::CurrentHeatingCoolingState(E_THERMOSTAT_STATE_OFF) {}
-
-
-    template <typename T>
-    void setVal(T value, bool notify = true) {
-        (void)heatingDevice.sendEsp01sRelayCommand((t_esp01sRelayState)value);
-        Characteristic::CurrentHeatingCoolingState::setVal(value, notify);
-    }
-
-    t_esp01sRelayState getHeaterState(void) {
-        t_esp01sRelayState state;
-        if (heatingDevice.getEsp01sRelayState(&state) != E_REQUEST_SUCCESS) {
-            state = E_ESP01S_RELAY_OPEN;
-        }
-        return (state);
-    }
-};
-
 struct HS_Thermostat : Service::Thermostat {
 private:
     /** @brief Characteristic objects */
-    CurrentHeaterStatus * currentState;
+    SpanCharacteristic * currentState;
     SpanCharacteristic * targetState;
     SpanCharacteristic * currentTemp;
     SpanCharacteristic * targetTemp;
@@ -84,79 +59,68 @@ private:
     SpanCharacteristic * heatingThreshold;
     SpanCharacteristic * coolingThreshold;
     SpanCharacteristic * displayUnits;;
+    SpanCharacteristic * totalConsumption;
+    SpanCharacteristic * statusFault;
 
-    /** @brief DHT Temperature Sensor Object */
-    TempHumSensor tempHumSensor;
-
-    /** @brief Average temperature */
-    float averageTemp;
-
-    /** @brief Flag to track if user manually updated the thermostat */
-    bool wasUpdated;
+    /** @brief Zone record holding the sensor readings and controller state */
+    t_zone * zone;
 
-    /** @brief Variable used to track the millis passed since last Temperature update */
-    unsigned long lastUpdateTemperature;
-
-    /** @brief Variable used to track the millis passed since last temperature readout */
-    unsigned long lastSenseTemperature;
-
-    /** @brief Variable used to track the millis passed since last thermostat overall update */
-    unsigned long lastUpdateState;
+    /** @brief Output confirmed by the relays */
+    t_climateOutput confirmedOutput() {
+        if (zone->relayState == E_ESP01S_RELAY_CLOSE) {
+            return (E_CLIMATE_HEAT);
+        }
+        if ((zone->coolerRelay != NULL) && (zone->coolerRelayState == E_ESP01S_RELAY_CLOSE)) {
+            return (E_CLIMATE_COOL);
+        }
+        return (E_CLIMATE_IDLE);
+    }
 
 public:
     /** @brief Constructor */
-    HS_Thermostat() : Service::Thermostat() {
-        (void)tempHumSensor.initializeSensor();
-
-        /* Get an initial temperature read */
-        averageTemp = tempHumSensor.getCurrentTemperature();
-
+    HS_Thermostat(t_zone * zone) : Service::Thermostat(), zone(zone) {
         /* Initialize the Characteristics */
-        currentState = new CurrentHeaterStatus();
+        /* Current state shows what the relays confirmed, starting from their last known state */
+        currentState = new Characteristic::CurrentHeatingCoolingState(confirmedOutput());
+        /* The target state is restored from NVS after a reset, the control task brings the relays in line with it */
         targetState =  new Characteristic::TargetHeatingCoolingState(E_THERMOSTAT_STATE_OFF, true);
 
-        currentTemp = new Characteristic::CurrentTemperature(averageTemp);
+        currentTemp = new Characteristic::CurrentTemperature(zone->averageTemp);
         targetTemp = new Characteristic::TargetTemperature(TEMPERATURE_INITIAL_VALUE);
-        currentHumidity = new Characteristic::CurrentRelativeHumidity(THERMOSTAT_DEFAULT_TARGET_HUMIDITY);
-        targetHumidity = new Characteristic::TargetRelativeHumidity(THERMOSTAT_DEFAULT_TARGET_HUMIDITY);
-        heatingThreshold = new Characteristic::CoolingThresholdTemperature(TEMPERATURE_INITIAL_VALUE + 2U, true);
-        coolingThreshold = new Characteristic::HeatingThresholdTemperature(TEMPERATURE_INITIAL_VALUE, true);
+        currentHumidity = new Characteristic::CurrentRelativeHumidity(isnan(zone->humidity) ? HUMIDITY_INITIAL_VALUE : zone->humidity);
+        targetHumidity = new Characteristic::TargetRelativeHumidity(THERMOSTAT_DEFAULT_TARGET_HUMIDITY, true);
+        heatingThreshold = new Characteristic::HeatingThresholdTemperature(TEMPERATURE_INITIAL_VALUE, true);
+        coolingThreshold = new Characteristic::CoolingThresholdTemperature(TEMPERATURE_INITIAL_VALUE + 2U, true);
         displayUnits =  new Characteristic::TemperatureDisplayUnits(E_CELSIUS);
+        totalConsumption = new Characteristic::TotalConsumption(0);
+        statusFault = new Characteristic::StatusFault();
 
         /* Setup the valid values for characteristics */
-        currentState->setValidValues(2, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT);
-        targetState->setValidValues(3, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT, E_THERMOSTAT_STATE_AUTO);
+        if (zone->coolerRelay != NULL) {
+            currentState->setValidValues(3, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT, E_THERMOSTAT_STATE_COOL);
+            targetState->setValidValues(4, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT, E_THERMOSTAT_STATE_COOL, E_THERMOSTAT_STATE_AUTO);
+        } else {
+            /* Heating only, AUTO heats to the heating threshold */
+            currentState->setValidValues(2, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT);
+            targetState->setValidValues(3, E_THERMOSTAT_STATE_OFF, E_THERMOSTAT_STATE_HEAT, E_THERMOSTAT_STATE_AUTO);
+        }
         displayUnits->setValidValues(1, E_CELSIUS);
         displayUnits->removePerms(PW);
 
         /* Set the ranges and step values of temperatures */
         targetTemp->setRange(10, 38, 0.5);
         currentTemp->setRange(0, 100, 0.5);
+        heatingThreshold->setRange(10, 28, 0.5);
         coolingThreshold->setRange(18, 35, 0.5);
-        heatingThreshold->setRange(18, 28, 0.5);
-
-        /* Setup the state of the thermostat */
-        lastUpdateTemperature = millis();
-        lastSenseTemperature = millis();
-        lastUpdateState = millis();
-        wasUpdated = false;
-
-        /* In case of a sudden reset, get the last state the heater */
-        t_esp01sRelayState currentRelayState = currentState->getHeaterState();
-        currentState->setVal(uint8_t(currentRelayState));
-        if (currentRelayState == E_ESP01S_RELAY_OPEN) {
-            targetState->setVal((int)E_THERMOSTAT_STATE_OFF);
-        } else {
-            targetState->setVal((int)E_THERMOSTAT_STATE_HEAT);
-        }
     }
 
     /** @brief Update function override */
     boolean update() override {
 
         /* Check if the user updated any parameter */
-        wasUpdated = targetState->updated()      ||
+        zone->wasUpdated = targetState->updated()      ||
                      targetTemp->updated()       ||
+                     targetHumidity->updated()   ||
                      coolingThreshold->updated() ||
                      heatingThreshold->updated();
 
@@ -164,104 +128,93 @@ public:
         return(true);
     }
 
-    /** @brief Loop function override */
-    void loop() override {
+    /* Update the state of the system given parameters */
+    void updateState() {
+        static const char * const modes[] = {"OFF", "HEAT mode", "COOL mode", "AUTO mode"};
+        static const char * const outputs[] = {"IDLE", "HEAT", "COOL"};
 
-        /* Update temperature every given duration */
-        if ((millis() - lastSenseTemperature) > TEMPERATURE_SENSOR_POLLING_TIME) {
-            updateTempReading();
-            lastSenseTemperature = millis();
-        }
+        t_climateMode mode = (t_climateMode)targetState->getVal();
 
-        /* Update current temperature every given duration but only when when you have enough readings */
-        if ((millis() - lastUpdateTemperature) > THERMOSTAT_STATUS_UPDATE_POLLING_TIME) {
-            updateCurrentTemp();
-            lastUpdateTemperature = millis();
+        /* An open window suspends heating, cooling is left alone */
+        if ((zone->openWindow != NULL) && zone->openWindow->isOpen() && (mode != E_CLIMATE_MODE_COOL)) {
+            mode = E_CLIMATE_MODE_OFF;
         }
 
-        /* Update state every given duration */
-        if ((millis() - lastUpdateState) > THERMOSTAT_STATUS_UPDATE_POLLING_TIME || wasUpdated) {
-            updateState();
-            wasUpdated = false;
-            lastUpdateState = millis();
+        /* Decide from the requested output, the relays may not have confirmed it yet */
+        t_climateOutput previous = zone->climate->getOutput();
+        t_climateOutput output = zone->climate->update(mode, zone->averageTemp,
+                                                       targetTemp->getVal<float>(), heatingThreshold->getVal<float>(),
+                                                       coolingThreshold->getVal<float>(), Utils::uptime());
+        WEBLOG("State: %s%s", modes[targetState->getVal() & 3U], mode != targetState->getVal() ? " (open window)" : "");
+
+        if (output != previous) {
+            WEBLOG("Setting the climate output to %s", outputs[output]);
+            (void)zoneControl.requestRelay(zone->index, E_ZONE_CHANNEL_HEATER, output == E_CLIMATE_HEAT ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN);
+            if (zone->coolerRelay != NULL) {
+                (void)zoneControl.requestRelay(zone->index, E_ZONE_CHANNEL_COOLER, output == E_CLIMATE_COOL ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN);
+            }
         }
     }
 
-    /* Update the state of the system given parameters */
-    void updateState() {
-        /* get the current state of the system */
-        bool toggle = false;
-        bool heaterState = currentState->getVal();
-
-        /* Decide whether to changed the state of the heater based on currently set config */
-        switch (targetState->getVal()) {
-            case E_THERMOSTAT_STATE_OFF:
-                toggle = (bool)E_ESP01S_RELAY_OPEN;
-                WEBLOG("State: OFF");
-                break;
-            case E_THERMOSTAT_STATE_HEAT:
-                toggle = toggleManualHeaterState(averageTemp, targetTemp->getVal<float>(), heaterState);
-                WEBLOG("State: HEAT mode");
-                break;
-            case E_THERMOSTAT_STATE_AUTO:
-            default:
-                toggle = toggleAutoHeaterState(averageTemp, coolingThreshold->getVal<float>(), heatingThreshold->getVal<float>(), heaterState);
-                WEBLOG("State: AUTO mode");
+    /* Publish the humidity and drive the humidifier or dehumidifier from the same readout as the temperature */
+    void updateHumidity() {
+        if (!isnan(zone->humidity)) {
+            currentHumidity->setVal<float>(zone->humidity);
+        }
+        if (zone->humidityControl == NULL) {
+            return;
         }
 
-        if (toggle != heaterState) {
-            WEBLOG("Setting the relay state to %s", toggle == true ? "CLOSE" : "OPEN");
-            currentState->setVal(toggle);
+        bool on = zone->humidityControl->isOn();
+        bool request = zone->humidityControl->update(zone->humidity, zone->averageTemp, targetHumidity->getVal<float>(), Utils::uptime());
+        if (request != on) {
+            WEBLOG("Setting the humidity relay state to %s", request == true ? "CLOSE" : "OPEN");
+            (void)zoneControl.requestRelay(zone->index, E_ZONE_CHANNEL_HUMIDITY, request == true ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN);
         }
     }
 
-    /* Accumulate a new temperature reading using exponential averaging */
-    void updateTempReading() {
-        /* Read the current temperature */
-        float reading = tempHumSensor.getCurrentTemperature();
+    /* Publish the outputs confirmed by the control task */
+    void refreshOutputs() {
+        currentState->setVal((uint8_t)confirmedOutput());
+    }
 
-        /* Validate for correct reading and accumulate if so */
-        if ((TEMPERATURE_DEFAULT_MIN_VAL <= reading) &&
-            (reading <= TEMPERATURE_DEFAULT_MAX_VAL)) {
-            averageTemp *= TEMPERATURE_ALPHA;
-            averageTemp += (1 - TEMPERATURE_ALPHA) * reading;
-        }
+    /* Forget the last request, used when the control task overrode it with the safe state */
+    void resyncOutputs() {
+        zone->climate->resync(confirmedOutput(), Utils::uptime());
     }
 
-    /* Update the current temperature from accumulated readings */
-    void updateCurrentTemp() {
-        currentTemp->setVal<float>(averageTemp);
-        WEBLOG("Current temperature = %f", averageTemp);
+    /* Raise or clear the fault status when the relay stops or resumes answering */
+    void setFault(bool fault) {
+        statusFault->setVal(fault ? 1 : 0);
+        WEBLOG("%s relay fault %s", zone->config->name, fault ? "raised" : "cleared");
     }
 
-    /* Manual mode Heater Control */
-    bool toggleManualHeaterState(float currentTemp, float targetTemp, bool heaterState) {
-        bool toggle = heaterState;
-        /* Check the temperature range */
-        if (currentTemp <= (targetTemp - THERMOSTAT_MANUAL_HYSTERESIS) && heaterState == false) {
-            toggle = (bool)E_ESP01S_RELAY_CLOSE;
-        } else if (currentTemp >= (targetTemp + THERMOSTAT_MANUAL_HYSTERESIS) && heaterState == true) {
-            toggle = (bool)E_ESP01S_RELAY_OPEN;
-        } else {
-            toggle = heaterState;
-        }
+    /* Check whether the heater is currently on */
+    bool isHeating() {
+        return (currentState->getVal() == E_THERMOSTAT_STATE_HEAT);
+    }
 
-        return (toggle);
+    /* Get the target temperature */
+    float getTargetTemperature() {
+        return (targetTemp->getVal<float>());
     }
 
-    /* Auto mode Heater Control */
-    bool toggleAutoHeaterState(float currentTemp, float minTemp, float maxTemp, bool heaterState) {
-        bool toggle = heaterState;
-        /* Check the temperature range */
-        if (currentTemp <= (minTemp - THERMOSTAT_AUTO_HYSTERESIS) && heaterState == false) {
-            toggle = (bool)E_ESP01S_RELAY_CLOSE;
-        } else if (currentTemp >= (maxTemp + THERMOSTAT_AUTO_HYSTERESIS) && heaterState == true) {
-            toggle = (bool)E_ESP01S_RELAY_OPEN;
-        } else {
-            toggle = heaterState;
+    /* Update the energy used by the heater, only notify noticeable changes */
+    void updateEnergy(float kWh) {
+        if (fabsf(kWh - totalConsumption->getVal<float>()) >= THERMOSTAT_ENERGY_NOTIFY_STEP) {
+            totalConsumption->setVal<float>(kWh);
         }
+    }
+
+    /* Set the target temperature, used by the weekly schedule */
+    void setTargetTemperature(float temperature) {
+        targetTemp->setVal<float>(temperature);
+    }
 
-        return (toggle);
+    /* Update the current temperature from accumulated readings */
+    void updateCurrentTemp() {
+        currentTemp->setVal<float>(zone->averageTemp);
+        WEBLOG("%s temperature = %f", zone->config->name, zone->averageTemp);
     }
 };
 
@@ -0,0 +1,42 @@
+#ifndef WINDOW_SENSOR_H
+#define WINDOW_SENSOR_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents the HomeKit contact sensor states */
+typedef enum {
+    E_WINDOW_CLOSED = 0U,               /**< Contact detected */
+    E_WINDOW_OPEN   = 1U                /**< Contact not detected */
+} t_windowState;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+struct HS_WindowSensor : Service::ContactSensor {
+private:
+    /** @brief Contact Characteristic */
+    SpanCharacteristic * state;
+
+public:
+    /** @brief Constructor */
+    HS_WindowSensor() : Service::ContactSensor() {
+        state = new Characteristic::ContactSensorState(E_WINDOW_CLOSED);
+    }
+
+    /** @brief Publish the state of the open window detector, called by the zone scheduler */
+    void setOpen(bool open) {
+        state->setVal((int)(open ? E_WINDOW_OPEN : E_WINDOW_CLOSED));
+    }
+};
+
+#endif /* WINDOW_SENSOR_H */
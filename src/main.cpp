@@ -5,10 +5,11 @@
 #include "HomeSpan.h"
 
 /* Local files */
-#include "homeKitAccessories/thermostat.h"
-#include "homeKitAccessories/tempHumSensor.h"
-#include "homeKitAccessories/relaySwitch.h"
+#include "zones/zoneTable.h"
+#include "history/historyExport.h"
+#include "zones/zoneStatus.h"
 #include "devices/deviceInfo.h"
+#include "devices/faultInjection.h"
 
 /* Private files */
 #include "private/wifiCredentials.h"
@@ -20,10 +21,55 @@
  *  As the log fills with messages, older ones are replaced by newer ones. */
 #define MAX_NB_LOG_MESSAGES_TO_SAVE             (25U)
 
+/** @brief HomeSpan poll task, on the core of the WiFi stack, the zone control task runs on the other one */
+#define HAP_POLL_STACK_SIZE                     (8192U)
+#define HAP_POLL_PRIORITY                       (1U)
+#define HAP_POLL_CORE                           (0U)
+
+/** @brief Time in ms between two zone polls, HomeSpan sleeps in select() up to that long without HAP requests */
+#define ZONE_POLL_INTERVAL                      (100U)
+
 /************************************************
  *  Typedef definition
  ***********************************************/
 
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Default weekly program of the living room, can be replaced with the @S command */
+static const t_schedulePeriod livingRoomSchedule[] = {
+    { SCHEDULE_WEEKDAYS, 6 * 60 + 30,  SCHEDULE_SETPOINT(21) },
+    { SCHEDULE_WEEKDAYS, 8 * 60,       SCHEDULE_SETPOINT(17) },
+    { SCHEDULE_WEEKDAYS, 17 * 60 + 30, SCHEDULE_SETPOINT(21) },
+    { SCHEDULE_WEEKEND,  8 * 60,       SCHEDULE_SETPOINT(21) },
+    { SCHEDULE_EVERYDAY, 22 * 60 + 30, SCHEDULE_SETPOINT(17) },
+};
+
+/** @brief Zones hosted by the bridge, one temperature sensor, thermostat and relay per room */
+static constexpr t_zoneConfig zoneConfigs[] = {
+    /* Name          Sensor S/N     Thermostat S/N  Relay IP         Port  Relay transport       Relay safe state      Sensor source               Sensor node MAC  Default schedule                                                                Heater power (W)  Cooling relay IP  Port  Humidity relay IP  Port  Humidity appliance           Open window (min) */
+    { "Living Room", "SN170332CAE", "00000001",     "192.168.1.148", 80U,  E_ESP01S_RELAY_HTTP,  E_ESP01S_RELAY_OPEN,  E_ZONE_SENSOR_LOCAL_AHT20,  NULL,            livingRoomSchedule, sizeof(livingRoomSchedule) / sizeof(livingRoomSchedule[0]), 2000U,            NULL,             0U,   NULL,              0U,   E_HUMIDITY_MODE_DEHUMIDIFY,  15U },
+};
+
+/** @brief Whether a zone from index on drives its relays over UDP */
+static constexpr bool zonesUseUdpRelays(const size_t index = 0U) {
+    return ((index < sizeof(zoneConfigs) / sizeof(zoneConfigs[0])) &&
+            ((zoneConfigs[index].relayTransport == E_ESP01S_RELAY_UDP) || zonesUseUdpRelays(index + 1U)));
+}
+
+/** @brief Never fall back to a well-known key, a UDP relay would accept commands from anyone on the LAN */
+static constexpr const char * relayUdpKey = RELAY_UDP_KEY;
+static_assert((zonesUseUdpRelays() == false) || (relayUdpKey != nullptr),
+              "UDP relays need RELAY_UDP_KEY, define it in private/relayKey.h");
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief HomeKit side of the zones, called in every HomeSpan poll pass */
+static void zonePoll(void) {
+    zoneTable.run();
+}
+
 /************************************************
  *  Public function implementation
  ***********************************************/
@@ -38,6 +84,13 @@ void setup() {
     Serial.begin(115200);
     homeSpan.enableWebLog(MAX_NB_LOG_MESSAGES_TO_SAVE, "pool.ntp.org", "UTC+4", "myLog");
     homeSpan.enableOTA();
+    homeSpan.addWebRoute(HISTORY_EXPORT_URL, historyExport);
+    homeSpan.addWebRoute(ZONE_METRICS_URL, zoneMetrics);
+    homeSpan.setWebLogCallback(zoneWebLogStatus);
+    homeSpan.setPollCallback(zonePoll, ZONE_POLL_INTERVAL);
+#ifdef FAULT_INJECTION
+    faultInjection.begin();
+#endif
 
     /* Create the pairing code */
     homeSpan.setPairingCode("00011000");
@@ -50,36 +103,23 @@ void setup() {
         new Service::AccessoryInformation();
             new Characteristic::Identify();
 
-    /* 2. Living Room Temperature & Humidity Sensor */
-    new SpanAccessory();
-        new Service::AccessoryInformation();
-            new Characteristic::Name(TEMP_HUM_SENSOR_NAME);
-            new Characteristic::Manufacturer(TEMP_HUM_SENSOR_MANUFACTURER);
-            new Characteristic::Model(TEMP_HUM_SENSOR_MODEL);
-            new Characteristic::SerialNumber(TEMP_HUM_SENSOR_SERIAL_NUM);
-            new Characteristic::FirmwareRevision(TEMP_HUM_SENSOR_FIRMWARE);
-            new Characteristic::Identify();
-        new HS_TempSensor();
+    /* 2. One sensor, thermostat and relay accessory per zone */
+    for (size_t i = 0; i < sizeof(zoneConfigs) / sizeof(zoneConfigs[0]); i++) {
+        (void)zoneTable.addZone(&zoneConfigs[i]);
+    }
 
-    /* 3. Living Room Thermostat */
-    new SpanAccessory();
-        new Service::AccessoryInformation();
-            new Characteristic::Name(THERMOSTAT_NAME);
-            new Characteristic::Manufacturer(THERMOSTAT_MANUFACTURER);
-            new Characteristic::Model(THERMOSTAT_MODEL);
-            new Characteristic::SerialNumber(THERMOSTAT_SERIAL_NUM);
-            new Characteristic::FirmwareRevision(THERMOSTAT_FIRMWARE);
-            new Characteristic::Identify();
-        new HS_Thermostat();
-
-    /* 4. Heating relay - defined as switch */
-    new SpanAccessory();
-        new Service::AccessoryInformation();
-            new Characteristic::Name("Heating Relay");
-            new Characteristic::Identify();
-        new HS_RelaySwitch();
+    /* Sensors and relays on one core, HomeKit on the other */
+    zoneTable.begin();
+#if ZONE_CONTROL_CORE >= 0
+    homeSpan.autoPoll(HAP_POLL_STACK_SIZE, HAP_POLL_PRIORITY, HAP_POLL_CORE);
+#endif
 }
 
 void loop() {
+#if ZONE_CONTROL_CORE >= 0
+    /* Nothing left to do, HomeSpan and the zone control run in their own tasks */
+    vTaskDelete(NULL);
+#else
     homeSpan.poll();
+#endif
 }
@@ -0,0 +1,66 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "climateControl.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+t_climateOutput ClimateControl::update(const t_climateMode mode, const float temperature, const float target,
+                                       const float heatThreshold, const float coolThreshold, const uint64_t now) {
+
+    bool heatAllowed = (mode == E_CLIMATE_MODE_HEAT) || (mode == E_CLIMATE_MODE_AUTO);
+    bool coolAllowed = canCool && ((mode == E_CLIMATE_MODE_COOL) || (mode == E_CLIMATE_MODE_AUTO));
+    float heatSetpoint = target;
+    float coolSetpoint = target;
+    float hysteresis = CLIMATE_MANUAL_HYSTERESIS;
+    t_climateOutput request = output;
+
+    if (mode == E_CLIMATE_MODE_AUTO) {
+        /* Enforce the deadband, the hysteresis bands of both outputs never overlap */
+        heatSetpoint = heatThreshold;
+        coolSetpoint = (coolThreshold < heatThreshold + CLIMATE_MIN_DEADBAND) ? heatThreshold + CLIMATE_MIN_DEADBAND : coolThreshold;
+        hysteresis = CLIMATE_AUTO_HYSTERESIS;
+    }
+
+    if (output == E_CLIMATE_HEAT) {
+        if ((heatAllowed == false) || (temperature >= (heatSetpoint + hysteresis))) {
+            request = E_CLIMATE_IDLE;
+        }
+    } else if (output == E_CLIMATE_COOL) {
+        if ((coolAllowed == false) || (temperature <= (coolSetpoint - hysteresis))) {
+            request = E_CLIMATE_IDLE;
+        }
+    } else if (heatAllowed && (temperature <= (heatSetpoint - hysteresis))) {
+        request = E_CLIMATE_HEAT;
+    } else if (coolAllowed && (temperature >= (coolSetpoint + hysteresis))) {
+        request = E_CLIMATE_COOL;
+    }
+
+    /* Changeover lockout, the other output has to stay stopped long enough */
+    if ((request != E_CLIMATE_IDLE) && (output == E_CLIMATE_IDLE) &&
+        (lastActive != E_CLIMATE_IDLE) && (request != lastActive) &&
+        ((now - lastStop) < CLIMATE_CHANGEOVER_LOCKOUT)) {
+        request = E_CLIMATE_IDLE;
+    }
+
+    resync(request, now);
+
+    return (output);
+}
+
+void ClimateControl::resync(const t_climateOutput actual, const uint64_t now) {
+    if ((output != E_CLIMATE_IDLE) && (actual != output)) {
+        lastActive = output;
+        lastStop = now;
+    }
+    output = actual;
+}
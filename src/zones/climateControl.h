@@ -0,0 +1,108 @@
+#ifndef CLIMATE_CONTROL_H
+#define CLIMATE_CONTROL_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Temperature hysteresis in °C, around the thresholds in AUTO mode and the target otherwise */
+#define CLIMATE_AUTO_HYSTERESIS                 (0.1f)
+#define CLIMATE_MANUAL_HYSTERESIS               (0.5f)
+
+/** @brief Minimum gap in °C between the heating and cooling thresholds, the cooling one is raised to keep it */
+#define CLIMATE_MIN_DEADBAND                    (1.0f)
+
+/** @brief Time in ms an output must have been stopped before the other one may start */
+#define CLIMATE_CHANGEOVER_LOCKOUT              (10 * 60 * 1000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents the modes of the climate control, same values as the HomeKit target state */
+typedef enum {
+    E_CLIMATE_MODE_OFF  = 0U,           /**< Both outputs stopped */
+    E_CLIMATE_MODE_HEAT = 1U,           /**< Heat to the target temperature */
+    E_CLIMATE_MODE_COOL = 2U,           /**< Cool to the target temperature */
+    E_CLIMATE_MODE_AUTO = 3U            /**< Heat below the heating threshold, cool above the cooling threshold */
+} t_climateMode;
+
+/** @brief This enum represents the active output, same values as the HomeKit current state */
+typedef enum {
+    E_CLIMATE_IDLE = 0U,                /**< Both outputs stopped */
+    E_CLIMATE_HEAT = 1U,                /**< Heating output running */
+    E_CLIMATE_COOL = 2U                 /**< Cooling output running */
+} t_climateOutput;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Climate control class definition.
+ * @details
+ *  This class decides which of the heating and cooling outputs of a zone runs.
+ *  At most one output runs at a time and a changeover always goes through
+ *  idle: an output may only start CLIMATE_CHANGEOVER_LOCKOUT after the other
+ *  one stopped, so a room oscillating around the deadband never flips a heat
+ *  pump between heating and cooling.
+ */
+class ClimateControl {
+private:
+    /** @brief Whether the zone has a cooling output */
+    bool canCool;
+
+    /** @brief Decided output */
+    t_climateOutput output;
+
+    /** @brief Last output that ran, the lockout applies to the other one */
+    t_climateOutput lastActive;
+
+    /** @brief Utils::uptime() when lastActive stopped */
+    uint64_t lastStop;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param canCool       Whether the zone has a cooling output
+     * @param output        Last known output
+     */
+    ClimateControl(const bool canCool, const t_climateOutput output) :
+        canCool(canCool), output(output), lastActive(E_CLIMATE_IDLE), lastStop(0U) {};
+
+    /**
+     * @brief Decide the output
+     *
+     * @param mode          Requested mode
+     * @param temperature   Zone temperature
+     * @param target        Target temperature, HEAT and COOL modes
+     * @param heatThreshold Heating threshold, AUTO mode
+     * @param coolThreshold Cooling threshold, AUTO mode
+     * @param now           Utils::uptime()
+     *
+     * @return Output that should run
+     */
+    t_climateOutput update(const t_climateMode mode, const float temperature, const float target,
+                           const float heatThreshold, const float coolThreshold, const uint64_t now);
+
+    /**
+     * @brief Align the decided output with what the relays really do
+     * @details
+     *  Used when the control task overrode a request, e.g. with the safe state of a faulted relay.
+     *
+     * @param actual        Output confirmed by the relays
+     * @param now           Utils::uptime()
+     */
+    void resync(const t_climateOutput actual, const uint64_t now);
+
+    /** @brief Get the decided output */
+    t_climateOutput getOutput(void) const { return (output); }
+
+    /** @brief Whether the zone has a cooling output */
+    bool hasCooling(void) const { return (canCool); }
+};
+
+#endif /* CLIMATE_CONTROL_H */
@@ -0,0 +1,73 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <math.h>
+
+/* Local files */
+#include "humidityControl.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Magnus coefficients over water */
+#define HUMIDITY_MAGNUS_B                       (17.62f)
+#define HUMIDITY_MAGNUS_C                       (243.12f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+bool HumidityControl::update(const float humidity, const float temperature, const float target, const uint64_t now) {
+
+    bool request = on;
+
+    if (isnan(humidity) || isnan(temperature)) {
+        request = false;
+    } else {
+        float dew = dewPoint(temperature, humidity);
+
+        if (mode == E_HUMIDITY_MODE_HUMIDIFY) {
+            if (humidity <= (target - HUMIDITY_HYSTERESIS)) {
+                request = true;
+            } else if (humidity >= (target + HUMIDITY_HYSTERESIS)) {
+                request = false;
+            }
+            if (dew >= HUMIDITY_MAX_DEW_POINT) {
+                request = false;
+            }
+        } else {
+            if (humidity >= (target + HUMIDITY_HYSTERESIS)) {
+                request = true;
+            } else if (humidity <= (target - HUMIDITY_HYSTERESIS)) {
+                request = false;
+            }
+            if (dew <= HUMIDITY_MIN_DEW_POINT) {
+                request = false;
+            }
+        }
+
+        /* Hold the current state for the minimum cycle, a lost sensor stops the appliance at once */
+        if (switched && ((now - lastSwitch) < HUMIDITY_MIN_CYCLE_TIME)) {
+            request = on;
+        }
+    }
+
+    if (request != on) {
+        on = request;
+        switched = true;
+        lastSwitch = now;
+    }
+
+    return (on);
+}
+
+float HumidityControl::dewPoint(const float temperature, const float humidity) {
+
+    /* A dry readout would take the log of zero */
+    float gamma = logf(fmaxf(humidity, 1.0f) / 100.0f) + (HUMIDITY_MAGNUS_B * temperature) / (HUMIDITY_MAGNUS_C + temperature);
+
+    return ((HUMIDITY_MAGNUS_C * gamma) / (HUMIDITY_MAGNUS_B - gamma));
+}
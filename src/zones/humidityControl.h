@@ -0,0 +1,102 @@
+#ifndef HUMIDITY_CONTROL_H
+#define HUMIDITY_CONTROL_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Relative humidity hysteresis in %, around the target */
+#define HUMIDITY_HYSTERESIS                     (3.0f)
+
+/** @brief Minimum time in ms the appliance stays on or off, spares the compressor of a dehumidifier */
+#define HUMIDITY_MIN_CYCLE_TIME                 (5 * 60 * 1000U)
+
+/** @brief Dew point in °C above which the humidifier stops, moisture would condense on cold walls and windows */
+#define HUMIDITY_MAX_DEW_POINT                  (12.0f)
+
+/** @brief Dew point in °C below which the dehumidifier stops, its coil would ice and the air is dry enough */
+#define HUMIDITY_MIN_DEW_POINT                  (4.0f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents the appliance driven by the humidity relay of a zone */
+typedef enum {
+    E_HUMIDITY_MODE_HUMIDIFY   = 0U,    /**< Humidifier, on below the target */
+    E_HUMIDITY_MODE_DEHUMIDIFY = 1U     /**< Dehumidifier, on above the target */
+} t_humidityMode;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Humidity control class definition.
+ * @details
+ *  This class decides the state of the humidifier or dehumidifier of a zone
+ *  from the humidity and temperature of the shared sensor sample. It switches
+ *  with a hysteresis around the target, holds every state for at least
+ *  HUMIDITY_MIN_CYCLE_TIME and keeps the dew point within
+ *  [HUMIDITY_MIN_DEW_POINT, HUMIDITY_MAX_DEW_POINT] whatever the target.
+ */
+class HumidityControl {
+private:
+    /** @brief Driven appliance */
+    t_humidityMode mode;
+
+    /** @brief Decided state */
+    bool on;
+
+    /** @brief Flag set by the first switch, the first decision is never held */
+    bool switched;
+
+    /** @brief Utils::uptime() of the last switch */
+    uint64_t lastSwitch;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param mode          Driven appliance
+     * @param on            Last known state of the appliance
+     */
+    HumidityControl(const t_humidityMode mode, const bool on) : mode(mode), on(on), switched(false), lastSwitch(0U) {};
+
+    /**
+     * @brief Decide the state of the appliance
+     * @details
+     *  Without humidity, e.g. a remote node that does not report it, the
+     *  appliance is stopped right away.
+     *
+     * @param humidity      Relative humidity in %, NAN if unknown
+     * @param temperature   Temperature in °C
+     * @param target        Target relative humidity in %
+     * @param now           Utils::uptime()
+     *
+     * @return true         If the appliance should run
+     */
+    bool update(const float humidity, const float temperature, const float target, const uint64_t now);
+
+    /**
+     * @brief Compute the dew point
+     * @details
+     *  Magnus formula, within 0.4 °C of the exact value between -40 and 50 °C.
+     *
+     * @param temperature   Temperature in °C
+     * @param humidity      Relative humidity in %
+     *
+     * @return Dew point in °C
+     */
+    static float dewPoint(const float temperature, const float humidity);
+
+    /** @brief Get the driven appliance */
+    t_humidityMode getMode(void) const { return (mode); }
+
+    /** @brief Get the decided state */
+    bool isOn(void) const { return (on); }
+};
+
+#endif /* HUMIDITY_CONTROL_H */
@@ -0,0 +1,99 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "openWindowDetector.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Constant sums of the window positions, x = 0 .. N - 1 */
+#define OPEN_WINDOW_N                           ((int32_t)OPEN_WINDOW_NB_SAMPLES)
+#define OPEN_WINDOW_SUM_X                       (OPEN_WINDOW_N * (OPEN_WINDOW_N - 1) / 2)
+#define OPEN_WINDOW_SUM_XX                      (OPEN_WINDOW_N * (OPEN_WINDOW_N - 1) * (2 * OPEN_WINDOW_N - 1) / 6)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+OpenWindowDetector::OpenWindowDetector(const uint32_t suspendTime) : suspendTime(suspendTime) {
+    head = 0U;
+    count = 0U;
+    sumY = 0;
+    sumXY = 0;
+    lastSample = 0U;
+    open = false;
+    openUntil = 0U;
+    nbEvents = 0U;
+}
+
+bool OpenWindowDetector::addSample(const float temperature, const uint64_t now) {
+
+    int16_t y = (int16_t)(temperature * 100.0f);
+
+    if ((count > 0U) && ((now - lastSample) < OPEN_WINDOW_SAMPLE_PERIOD)) {
+        return (false);
+    }
+
+    /* Positions assume evenly spaced samples, start over after a gap */
+    if ((count > 0U) && ((now - lastSample) >= 2U * OPEN_WINDOW_SAMPLE_PERIOD)) {
+        count = 0U;
+        head = 0U;
+        sumY = 0;
+        sumXY = 0;
+    }
+    lastSample = now;
+
+    if (count < OPEN_WINDOW_NB_SAMPLES) {
+        sumXY += (int32_t)count * y;
+        sumY += y;
+        samples[(head + count) % OPEN_WINDOW_NB_SAMPLES] = y;
+        count++;
+    } else {
+        /* Every remaining sample moves one position down, the new one takes the last position */
+        int16_t oldest = samples[head];
+        sumXY += -(sumY - oldest) + (OPEN_WINDOW_N - 1) * y;
+        sumY += y - oldest;
+        samples[head] = y;
+        head = (head + 1U) % OPEN_WINDOW_NB_SAMPLES;
+    }
+
+    if (getSlope() > -OPEN_WINDOW_DROP_RATE) {
+        return (false);
+    }
+
+    /* Still dropping, keep heating suspended */
+    openUntil = now + suspendTime;
+    if (open == true) {
+        return (false);
+    }
+    open = true;
+    nbEvents++;
+
+    return (true);
+}
+
+bool OpenWindowDetector::update(const uint64_t now) {
+
+    if ((open == false) || (now < openUntil)) {
+        return (false);
+    }
+    open = false;
+
+    return (true);
+}
+
+float OpenWindowDetector::getSlope(void) const {
+
+    if (count < OPEN_WINDOW_NB_SAMPLES) {
+        return (0.0f);
+    }
+
+    /* Least squares slope in 1/100 °C per sample */
+    float slope = (float)(OPEN_WINDOW_N * sumXY - OPEN_WINDOW_SUM_X * sumY) /
+                  (float)(OPEN_WINDOW_N * OPEN_WINDOW_SUM_XX - OPEN_WINDOW_SUM_X * OPEN_WINDOW_SUM_X);
+
+    return (slope / 100.0f * (60.0f * 1000.0f / OPEN_WINDOW_SAMPLE_PERIOD));
+}
@@ -0,0 +1,108 @@
+#ifndef OPEN_WINDOW_DETECTOR_H
+#define OPEN_WINDOW_DETECTOR_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Time in ms between two samples of the sliding window */
+#define OPEN_WINDOW_SAMPLE_PERIOD               (30 * 1000U)
+
+/** @brief Number of samples of the sliding window, 5 minutes */
+#define OPEN_WINDOW_NB_SAMPLES                  (11U)
+
+/** @brief Temperature drop rate in °C per minute over the window that means an open window */
+#define OPEN_WINDOW_DROP_RATE                   (0.15f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Open window detector class definition.
+ * @details
+ *  This class fits the slope of the filtered zone temperature over a sliding
+ *  window of OPEN_WINDOW_NB_SAMPLES samples taken every OPEN_WINDOW_SAMPLE_PERIOD.
+ *  The least squares sums are updated as samples enter and leave the window,
+ *  so each sample costs O(1) whatever the window length. Temperatures are kept
+ *  in 1/100 °C and the sums are integers, they never drift.
+ *
+ *  A drop faster than OPEN_WINDOW_DROP_RATE flags the window open for the
+ *  suspend time, extended as long as the drop goes on. A gap in the samples,
+ *  e.g. a stale sensor, restarts the window.
+ */
+class OpenWindowDetector {
+private:
+    /** @brief Ring of samples in 1/100 °C, samples[head] is the oldest once full */
+    int16_t samples[OPEN_WINDOW_NB_SAMPLES];
+    uint8_t head;
+    uint8_t count;
+
+    /** @brief Sums of y and x * y, x being the position of the sample in the window */
+    int32_t sumY;
+    int32_t sumXY;
+
+    /** @brief Utils::uptime() of the last sample */
+    uint64_t lastSample;
+
+    /** @brief Detector state */
+    bool open;
+    uint64_t openUntil;
+
+    /** @brief Time in ms heating stays suspended after a detection */
+    uint32_t suspendTime;
+
+    /** @brief Number of detections */
+    uint32_t nbEvents;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param suspendTime   Time in ms heating stays suspended after a detection
+     */
+    OpenWindowDetector(const uint32_t suspendTime);
+
+    /**
+     * @brief Feed a filtered temperature
+     * @details
+     *  Samples closer than OPEN_WINDOW_SAMPLE_PERIOD to the previous one are ignored.
+     *
+     * @param temperature   Filtered zone temperature
+     * @param now           Utils::uptime()
+     *
+     * @return true         If the window was just detected open
+     */
+    bool addSample(const float temperature, const uint64_t now);
+
+    /**
+     * @brief End the suspension once its time is over
+     *
+     * @param now           Utils::uptime()
+     *
+     * @return true         If the window was just considered closed
+     */
+    bool update(const uint64_t now);
+
+    /**
+     * @brief Get the slope over the window
+     *
+     * @return Temperature change in °C per minute, 0 until the window is full
+     */
+    float getSlope(void) const;
+
+    /** @brief Whether heating is suspended */
+    bool isOpen(void) const { return (open); }
+
+    /** @brief Get the number of detections */
+    uint32_t getNbEvents(void) const { return (nbEvents); }
+};
+
+#endif /* OPEN_WINDOW_DETECTOR_H */
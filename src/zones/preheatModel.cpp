@@ -0,0 +1,118 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <nvs.h>
+
+/* Local files */
+#include "preheatModel.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief NVS namespace of the learned rates */
+#define PREHEAT_NVS_NAMESPACE                   ("PREHEAT")
+
+/** @brief Milliseconds per hour */
+#define PREHEAT_MS_PER_HOUR                     (3600.0f * 1000.0f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+PreheatModel::PreheatModel() {
+    rates.heatRate = PREHEAT_DEFAULT_HEAT_RATE;
+    rates.coolRate = PREHEAT_DEFAULT_COOL_RATE;
+    started = false;
+    dirty = false;
+    lastSave = 0U;
+}
+
+void PreheatModel::addSample(const float temperature, const bool heating, const uint64_t now) {
+
+    /* A relay change ends the interval, it is too short to say anything */
+    if ((started == false) || (heating != startHeating)) {
+        startTemp = temperature;
+        startTime = now;
+        startHeating = heating;
+        started = true;
+        return;
+    }
+
+    if ((now - startTime) < PREHEAT_SAMPLE_PERIOD) {
+        return;
+    }
+
+    float rate = (temperature - startTemp) * PREHEAT_MS_PER_HOUR / (now - startTime);
+
+    if (heating == true) {
+        /* A falling temperature while heating means the heater cannot keep up, ignore it */
+        if (rate > 0.0f) {
+            rates.heatRate += PREHEAT_ALPHA * (rate - rates.heatRate);
+            rates.heatRate = rates.heatRate < PREHEAT_MIN_HEAT_RATE ? PREHEAT_MIN_HEAT_RATE : rates.heatRate;
+            rates.heatRate = rates.heatRate > PREHEAT_MAX_HEAT_RATE ? PREHEAT_MAX_HEAT_RATE : rates.heatRate;
+            dirty = true;
+        }
+    } else if (rate < 0.0f) {
+        rates.coolRate += PREHEAT_ALPHA * (-rate - rates.coolRate);
+        dirty = true;
+    }
+
+    /* Next interval starts here */
+    startTemp = temperature;
+    startTime = now;
+}
+
+uint32_t PreheatModel::getLeadTime(const float temperature, const float target) const {
+
+    if (temperature >= target) {
+        return (0U);
+    }
+
+    float lead = (target - temperature) / rates.heatRate * 3600.0f;
+
+    return (lead > PREHEAT_MAX_LEAD ? PREHEAT_MAX_LEAD : (uint32_t)lead);
+}
+
+void PreheatModel::load(const char * const key) {
+
+    nvs_handle handle;
+    t_preheatRates stored;
+    size_t len = sizeof(stored);
+
+    if (nvs_open(PREHEAT_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+
+    if ((nvs_get_blob(handle, key, &stored, &len) == ESP_OK) && (len == sizeof(stored))) {
+        rates = stored;
+    }
+
+    nvs_close(handle);
+}
+
+void PreheatModel::save(const char * const key, const uint64_t now) {
+
+    nvs_handle handle;
+
+    if ((dirty == false) || ((now - lastSave) < PREHEAT_SAVE_PERIOD)) {
+        return;
+    }
+
+    if (nvs_open(PREHEAT_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    (void)nvs_set_blob(handle, key, &rates, sizeof(rates));
+    (void)nvs_commit(handle);
+    nvs_close(handle);
+
+    dirty = false;
+    lastSave = now;
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
@@ -0,0 +1,111 @@
+#ifndef PREHEAT_MODEL_H
+#define PREHEAT_MODEL_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Minimum duration in ms of a constant relay state interval used for learning */
+#define PREHEAT_SAMPLE_PERIOD                   (15 * 60 * 1000U)
+
+/** @brief Weight of a new interval in the learned rates */
+#define PREHEAT_ALPHA                           (0.2f)
+
+/** @brief Initial rates in °C per hour, until the room has been observed */
+#define PREHEAT_DEFAULT_HEAT_RATE               (1.0f)
+#define PREHEAT_DEFAULT_COOL_RATE               (0.3f)
+
+/** @brief Bounds of the learned heat-up rate in °C per hour */
+#define PREHEAT_MIN_HEAT_RATE                   (0.2f)
+#define PREHEAT_MAX_HEAT_RATE                   (10.0f)
+
+/** @brief Maximum anticipation in seconds */
+#define PREHEAT_MAX_LEAD                        (3 * 3600U)
+
+/** @brief Minimum time in ms between two NVS writes of the learned rates */
+#define PREHEAT_SAVE_PERIOD                     (6 * 3600 * 1000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Learned room coefficients, persisted in NVS */
+typedef struct {
+    float heatRate;                     /**< Temperature rise while heating, °C per hour */
+    float coolRate;                     /**< Temperature drop while not heating, °C per hour */
+} t_preheatRates;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Pre-heat model class definition.
+ * @details
+ *  This class learns how fast a room warms up while the relay is closed and
+ *  cools down while it is open, from the filtered zone temperature. Rates are
+ *  measured over intervals where the relay state did not change and blended
+ *  into exponential averages. The heat-up rate gives the lead time needed to
+ *  reach a setpoint on schedule.
+ */
+class PreheatModel {
+private:
+    /** @brief Learned rates */
+    t_preheatRates rates;
+
+    /** @brief Start of the current interval */
+    float startTemp;
+    uint64_t startTime;
+    bool startHeating;
+    bool started;
+
+    /** @brief Flag to track unsaved changes */
+    bool dirty;
+
+    /** @brief Utils::uptime() of the last NVS write */
+    uint64_t lastSave;
+
+public:
+    /** @brief Constructor */
+    PreheatModel();
+
+    /**
+     * @brief Feed a new filtered temperature
+     *
+     * @param temperature   Filtered zone temperature
+     * @param heating       Relay state since the previous sample
+     * @param now           Utils::uptime()
+     */
+    void addSample(const float temperature, const bool heating, const uint64_t now);
+
+    /**
+     * @brief Get the lead time to reach a setpoint
+     *
+     * @param temperature   Current temperature
+     * @param target        Setpoint to reach
+     *
+     * @return Seconds of heating needed, capped to PREHEAT_MAX_LEAD
+     */
+    uint32_t getLeadTime(const float temperature, const float target) const;
+
+    /** @brief Get the learned rates */
+    const t_preheatRates & getRates(void) const { return (rates); }
+
+    /** @brief Load the learned rates from NVS */
+    void load(const char * const key);
+
+    /**
+     * @brief Save the learned rates to NVS
+     * @details
+     *  Nothing is written unless the rates changed and PREHEAT_SAVE_PERIOD elapsed
+     *  since the previous write, to spare the flash.
+     *
+     * @param key           NVS key
+     * @param now           Utils::uptime()
+     */
+    void save(const char * const key, const uint64_t now);
+};
+
+#endif /* PREHEAT_MODEL_H */
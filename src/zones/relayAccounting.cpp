@@ -0,0 +1,134 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <nvs.h>
+
+/* Local files */
+#include "relayAccounting.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief NVS namespace of the counters */
+#define RELAY_ACCOUNTING_NVS_NAMESPACE          ("RELAYACC")
+
+/** @brief 1970-01-01 was a Thursday, shift days so that weeks start on Monday */
+#define RELAY_ACCOUNTING_WEEK_OFFSET            (3U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+RelayAccounting::RelayAccounting(const uint16_t powerW) {
+    memset(&counters, 0, sizeof(counters));
+    this->powerW = powerW;
+    pendingMs = 0U;
+    lastUpdate = 0U;
+    relayOn = false;
+    started = false;
+    dirty = false;
+    lastSave = 0U;
+}
+
+void RelayAccounting::update(const bool on, const uint64_t now, const uint32_t wallTime) {
+
+    uint64_t elapsed = now - lastUpdate;
+    lastUpdate = now;
+
+    if (started == false) {
+        started = true;
+        relayOn = on;
+        return;
+    }
+
+    /* Start new periods before adding time to them, their indexes are unknown until NTP sets the clock */
+    bool periodsValid = (wallTime >= RELAY_ACCOUNTING_MIN_VALID_TIME);
+    if (periodsValid == true) {
+        uint32_t day = wallTime / 86400U;
+        rollover(counters.hourIndex, wallTime / 3600U, counters.hourOnSeconds, counters.lastHourOnSeconds);
+        rollover(counters.dayIndex, day, counters.dayOnSeconds, counters.lastDayOnSeconds);
+        rollover(counters.weekIndex, (day + RELAY_ACCOUNTING_WEEK_OFFSET) / 7U, counters.weekOnSeconds, counters.lastWeekOnSeconds);
+    }
+
+    /* The relay was in its previous state during the elapsed time */
+    if (relayOn == true) {
+        pendingMs += elapsed;
+        uint32_t seconds = (uint32_t)(pendingMs / 1000U);
+        pendingMs %= 1000U;
+
+        if (seconds > 0U) {
+            counters.totalOnSeconds += seconds;
+            if (periodsValid == true) {
+                counters.hourOnSeconds += seconds;
+                counters.dayOnSeconds += seconds;
+                counters.weekOnSeconds += seconds;
+            }
+            dirty = true;
+        }
+    }
+
+    if (on != relayOn) {
+        if (on == true) {
+            counters.cycles++;
+        }
+        counters.lastTransition = (periodsValid == true) ? wallTime : 0U;
+        relayOn = on;
+        dirty = true;
+    }
+}
+
+void RelayAccounting::load(const char * const key) {
+
+    nvs_handle handle;
+    t_relayCounters stored;
+    size_t len = sizeof(stored);
+
+    if (nvs_open(RELAY_ACCOUNTING_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+
+    if ((nvs_get_blob(handle, key, &stored, &len) == ESP_OK) && (len == sizeof(stored))) {
+        counters = stored;
+    }
+
+    nvs_close(handle);
+}
+
+void RelayAccounting::save(const char * const key, const uint64_t now) {
+
+    nvs_handle handle;
+
+    if ((dirty == false) || ((now - lastSave) < RELAY_ACCOUNTING_SAVE_PERIOD)) {
+        return;
+    }
+
+    if (nvs_open(RELAY_ACCOUNTING_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    (void)nvs_set_blob(handle, key, &counters, sizeof(counters));
+    (void)nvs_commit(handle);
+    nvs_close(handle);
+
+    dirty = false;
+    lastSave = now;
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void RelayAccounting::rollover(uint32_t & index, const uint32_t newIndex, uint32_t & current, uint32_t & previous) {
+
+    if (newIndex == index) {
+        return;
+    }
+
+    /* The previous period is only meaningful if it directly precedes the new one */
+    previous = (newIndex == index + 1U) ? current : 0U;
+    current = 0U;
+    index = newIndex;
+}
@@ -0,0 +1,116 @@
+#ifndef RELAY_ACCOUNTING_H
+#define RELAY_ACCOUNTING_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Minimum time in ms between two NVS writes of the counters */
+#define RELAY_ACCOUNTING_SAVE_PERIOD            (3600 * 1000U)
+
+/** @brief Wall clock times before this one mean NTP has not synchronized yet */
+#define RELAY_ACCOUNTING_MIN_VALID_TIME         (1600000000UL)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Relay on-time counters, persisted in NVS */
+typedef struct {
+    uint32_t totalOnSeconds;            /**< On-time since the counters were created */
+    uint32_t cycles;                    /**< Number of confirmed open to close transitions */
+    uint32_t lastTransition;            /**< Wall time of the last confirmed transition, 0 if unknown */
+    uint32_t hourIndex;                 /**< Hour (since epoch) of hourOnSeconds */
+    uint32_t dayIndex;                  /**< Day (since epoch, UTC) of dayOnSeconds */
+    uint32_t weekIndex;                 /**< Week (since epoch, UTC, starting Monday) of weekOnSeconds */
+    uint32_t hourOnSeconds;             /**< On-time of the current hour */
+    uint32_t dayOnSeconds;              /**< On-time of the current day */
+    uint32_t weekOnSeconds;             /**< On-time of the current week */
+    uint32_t lastHourOnSeconds;         /**< On-time of the previous hour */
+    uint32_t lastDayOnSeconds;          /**< On-time of the previous day */
+    uint32_t lastWeekOnSeconds;         /**< On-time of the previous week */
+} t_relayCounters;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Relay accounting class definition.
+ * @details
+ *  This class integrates the on-time of a relay from its confirmed state.
+ *  Elapsed time is measured on the 64-bit Utils::uptime() time base, which does
+ *  not wrap around like millis(). Whole seconds are added to the counters, the
+ *  remainder is carried to the next update. Until NTP sets the clock, on-time
+ *  only counts in totalOnSeconds as the current periods are unknown.
+ */
+class RelayAccounting {
+private:
+    /** @brief Counters */
+    t_relayCounters counters;
+
+    /** @brief Heater power in W, for the energy estimate */
+    uint16_t powerW;
+
+    /** @brief On-time in ms not yet added to the counters */
+    uint64_t pendingMs;
+
+    /** @brief Utils::uptime() of the previous update */
+    uint64_t lastUpdate;
+
+    /** @brief Relay state at the previous update */
+    bool relayOn;
+
+    /** @brief Flag to track if update() was already called */
+    bool started;
+
+    /** @brief Flag to track unsaved changes */
+    bool dirty;
+
+    /** @brief Utils::uptime() of the last NVS write */
+    uint64_t lastSave;
+
+    /** @brief Move the current period counters to the previous period ones when the period changes */
+    static void rollover(uint32_t & index, const uint32_t newIndex, uint32_t & current, uint32_t & previous);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param powerW        Heater power in W
+     */
+    RelayAccounting(const uint16_t powerW);
+
+    /**
+     * @brief Account for the time elapsed since the previous update
+     *
+     * @param on            Confirmed relay state
+     * @param now           Utils::uptime()
+     * @param wallTime      Seconds since epoch, or 0 if the clock is not set
+     */
+    void update(const bool on, const uint64_t now, const uint32_t wallTime);
+
+    /** @brief Get the counters */
+    const t_relayCounters & getCounters(void) const { return (counters); }
+
+    /** @brief Get the estimated energy in kWh */
+    float getEnergyKwh(void) const { return (counters.totalOnSeconds * (float)powerW / 3600000.0f); }
+
+    /** @brief Load the counters from NVS */
+    void load(const char * const key);
+
+    /**
+     * @brief Save the counters to NVS
+     * @details
+     *  Nothing is written unless the counters changed and RELAY_ACCOUNTING_SAVE_PERIOD
+     *  elapsed since the previous write, so at most one period of counts is lost on power cuts.
+     *
+     * @param key           NVS key
+     * @param now           Utils::uptime()
+     */
+    void save(const char * const key, const uint64_t now);
+};
+
+#endif /* RELAY_ACCOUNTING_H */
@@ -0,0 +1,86 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <atomic>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Single producer, single consumer queue class definition.
+ * @details
+ *  Lock-free ring of N elements, N must be a power of two. push() must only be
+ *  called from one task and pop() from one other task. Each index is written by
+ *  a single side, the release/acquire pairs publish the element before the index.
+ *
+ * @tparam T            Element type, copied in and out
+ * @tparam N            Capacity
+ */
+template <typename T, uint16_t N>
+class SpscQueue {
+private:
+    static_assert((N & (N - 1U)) == 0U, "SpscQueue capacity must be a power of two");
+
+    /** @brief Elements */
+    T elements[N];
+
+    /** @brief Next element to pop, written by the consumer */
+    std::atomic<uint16_t> head;
+
+    /** @brief Next element to push, written by the producer */
+    std::atomic<uint16_t> tail;
+
+public:
+    /** @brief Constructor */
+    SpscQueue() : head(0U), tail(0U) {};
+
+    /**
+     * @brief Push an element, producer side
+     *
+     * @param element       Element to copy
+     *
+     * @return true         If the element was queued
+     * @return false        Queue full
+     */
+    bool push(const T & element) {
+        uint16_t t = tail.load(std::memory_order_relaxed);
+        if ((uint16_t)(t - head.load(std::memory_order_acquire)) >= N) {
+            return (false);
+        }
+        elements[t & (N - 1U)] = element;
+        tail.store(t + 1U, std::memory_order_release);
+        return (true);
+    }
+
+    /**
+     * @brief Pop an element, consumer side
+     *
+     * @param element       Popped element
+     *
+     * @return true         If an element was popped
+     * @return false        Queue empty
+     */
+    bool pop(T * const element) {
+        uint16_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return (false);
+        }
+        *element = elements[h & (N - 1U)];
+        head.store(h + 1U, std::memory_order_release);
+        return (true);
+    }
+};
+
+#endif /* SPSC_QUEUE_H */
@@ -0,0 +1,159 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <nvs.h>
+
+/* Local files */
+#include "weeklySchedule.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief NVS namespace of the schedules */
+#define SCHEDULE_NVS_NAMESPACE                  ("SCHEDULE")
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+bool WeeklySchedule::compile(const t_schedulePeriod * const periods, const uint8_t nbPeriods) {
+
+    nbTransitions = 0U;
+
+    for (uint8_t p = 0; p < nbPeriods; p++) {
+        if (periods[p].startMinute >= 24U * 60U) {
+            nbTransitions = 0U;
+            return (false);
+        }
+
+        for (uint8_t day = 0; day < 7U; day++) {
+            if ((periods[p].dayMask & (1U << day)) == 0U) {
+                continue;
+            }
+
+            t_scheduleTransition t = {(uint16_t)(day * 24U * 60U + periods[p].startMinute), periods[p].setpoint};
+
+            /* Insertion sort, the table is small and compiled once */
+            uint8_t i = nbTransitions;
+            while ((i > 0U) && (transitions[i - 1U].minuteOfWeek > t.minuteOfWeek)) {
+                i--;
+            }
+
+            if ((i > 0U) && (transitions[i - 1U].minuteOfWeek == t.minuteOfWeek)) {
+                transitions[i - 1U] = t;
+                continue;
+            }
+
+            if (nbTransitions >= SCHEDULE_MAX_TRANSITIONS) {
+                nbTransitions = 0U;
+                return (false);
+            }
+
+            for (uint8_t j = nbTransitions; j > i; j--) {
+                transitions[j] = transitions[j - 1U];
+            }
+            transitions[i] = t;
+            nbTransitions++;
+        }
+    }
+
+    return (true);
+}
+
+int16_t WeeklySchedule::getSetpoint(const struct tm & local, uint8_t * const index) const {
+
+    if (nbTransitions == 0U) {
+        *index = SCHEDULE_MAX_TRANSITIONS;
+        return (0);
+    }
+
+    *index = find(getMinuteOfWeek(local));
+    return (transitions[*index].setpoint);
+}
+
+uint32_t WeeklySchedule::getSecondsToNext(const struct tm & local, uint8_t * const nextIndex, int16_t * const nextSetpoint) const {
+
+    if (nbTransitions == 0U) {
+        return (0U);
+    }
+
+    uint16_t minute = getMinuteOfWeek(local);
+    uint8_t next = (find(minute) + 1U) % nbTransitions;
+    uint32_t minutes = (transitions[next].minuteOfWeek + SCHEDULE_MINUTES_PER_WEEK - minute) % SCHEDULE_MINUTES_PER_WEEK;
+
+    /* A single transition repeats every week */
+    if (minutes == 0U) {
+        minutes = SCHEDULE_MINUTES_PER_WEEK;
+    }
+
+    if (nextIndex != NULL) {
+        *nextIndex = next;
+    }
+    if (nextSetpoint != NULL) {
+        *nextSetpoint = transitions[next].setpoint;
+    }
+
+    return (minutes * 60U - local.tm_sec);
+}
+
+bool WeeklySchedule::load(const char * const key) {
+
+    nvs_handle handle;
+    size_t len = sizeof(transitions);
+    bool loaded = false;
+
+    if (nvs_open(SCHEDULE_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return (false);
+    }
+
+    if ((nvs_get_blob(handle, key, transitions, &len) == ESP_OK) && (len % sizeof(t_scheduleTransition) == 0U)) {
+        nbTransitions = len / sizeof(t_scheduleTransition);
+        loaded = (nbTransitions > 0U);
+    }
+
+    nvs_close(handle);
+    return (loaded);
+}
+
+void WeeklySchedule::save(const char * const key) const {
+
+    nvs_handle handle;
+
+    if (nvs_open(SCHEDULE_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    if (nbTransitions > 0U) {
+        (void)nvs_set_blob(handle, key, transitions, nbTransitions * sizeof(t_scheduleTransition));
+    } else {
+        (void)nvs_erase_key(handle, key);
+    }
+
+    (void)nvs_commit(handle);
+    nvs_close(handle);
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+uint8_t WeeklySchedule::find(const uint16_t minuteOfWeek) const {
+
+    /* Binary search of the last transition at or before minuteOfWeek */
+    uint8_t low = 0U;
+    uint8_t high = nbTransitions;
+
+    while (low < high) {
+        uint8_t mid = (low + high) / 2U;
+        if (transitions[mid].minuteOfWeek <= minuteOfWeek) {
+            low = mid + 1U;
+        } else {
+            high = mid;
+        }
+    }
+
+    /* Before the first transition of the week, the last one of the previous week applies */
+    return (low > 0U ? low - 1U : nbTransitions - 1U);
+}
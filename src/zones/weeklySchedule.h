@@ -0,0 +1,142 @@
+#ifndef WEEKLY_SCHEDULE_H
+#define WEEKLY_SCHEDULE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Maximum number of setpoint transitions in a week */
+#define SCHEDULE_MAX_TRANSITIONS                (48U)
+
+/** @brief Number of minutes in a week */
+#define SCHEDULE_MINUTES_PER_WEEK               (7U * 24U * 60U)
+
+/** @brief Day masks, bit 0 is Sunday as in struct tm */
+#define SCHEDULE_SUNDAY                         (0x01U)
+#define SCHEDULE_WEEKDAYS                       (0x3EU)
+#define SCHEDULE_WEEKEND                        (0x41U)
+#define SCHEDULE_EVERYDAY                       (0x7FU)
+
+/** @brief Setpoint in 1/10 °C from a temperature in °C */
+#define SCHEDULE_SETPOINT(temp)                 ((int16_t)((temp) * 10))
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Setpoint period of a weekly program, active from startMinute until the next period */
+typedef struct {
+    uint8_t dayMask;                    /**< Days the period applies to, SCHEDULE_* masks */
+    uint16_t startMinute;               /**< Local start time in minutes after midnight */
+    int16_t setpoint;                   /**< Target temperature in 1/10 °C */
+} t_schedulePeriod;
+
+/** @brief Compiled setpoint transition */
+typedef struct {
+    uint16_t minuteOfWeek;              /**< Local time in minutes after Sunday midnight */
+    int16_t setpoint;                   /**< Target temperature in 1/10 °C */
+} t_scheduleTransition;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Weekly schedule class definition.
+ * @details
+ *  A weekly program is compiled into a table of transitions sorted by minute
+ *  of the week. The active setpoint is the last transition at or before the
+ *  current minute, wrapping around to the last transition of the week.
+ *  All methods work on local time given by the caller, so the engine does not
+ *  depend on the clock source.
+ */
+class WeeklySchedule {
+private:
+    /** @brief Sorted transitions */
+    t_scheduleTransition transitions[SCHEDULE_MAX_TRANSITIONS];
+
+    /** @brief Number of transitions in use */
+    uint8_t nbTransitions;
+
+    /**
+     * @brief Find the active transition
+     *
+     * @param minuteOfWeek  Local time in minutes after Sunday midnight
+     *
+     * @return Index of the active transition
+     */
+    uint8_t find(const uint16_t minuteOfWeek) const;
+
+public:
+    /** @brief Constructor */
+    WeeklySchedule() : nbTransitions(0U) {};
+
+    /**
+     * @brief Compile a weekly program
+     * @details
+     *  Periods starting at the same minute of the same day replace each other,
+     *  the last one wins.
+     *
+     * @param periods       Setpoint periods
+     * @param nbPeriods     Number of periods
+     *
+     * @return true         If the program fits in SCHEDULE_MAX_TRANSITIONS
+     * @return false        Program too large or invalid start time, schedule left empty
+     */
+    bool compile(const t_schedulePeriod * const periods, const uint8_t nbPeriods);
+
+    /** @brief Remove all transitions */
+    void clear(void) { nbTransitions = 0U; }
+
+    /** @brief Check whether the schedule has at least one transition */
+    bool isEmpty(void) const { return (nbTransitions == 0U); }
+
+    /**
+     * @brief Get the active setpoint
+     *
+     * @param local         Local time
+     * @param index         Index of the active transition, to detect transitions
+     *                      (SCHEDULE_MAX_TRANSITIONS if the schedule is empty)
+     *
+     * @return Setpoint in 1/10 °C
+     */
+    int16_t getSetpoint(const struct tm & local, uint8_t * const index) const;
+
+    /**
+     * @brief Get the time until the next transition
+     *
+     * @param local         Local time
+     * @param nextIndex     Index of the next transition, optional
+     * @param nextSetpoint  Setpoint of the next transition in 1/10 °C, optional
+     *
+     * @return Seconds until the next transition, 0 if the schedule is empty
+     */
+    uint32_t getSecondsToNext(const struct tm & local, uint8_t * const nextIndex = NULL, int16_t * const nextSetpoint = NULL) const;
+
+    /**
+     * @brief Load the compiled table from NVS
+     *
+     * @param key           NVS key
+     *
+     * @return true         If a table was stored under key
+     */
+    bool load(const char * const key);
+
+    /**
+     * @brief Save the compiled table to NVS, an empty table erases the key
+     *
+     * @param key           NVS key
+     */
+    void save(const char * const key) const;
+
+    /** @brief Get the minute of the week of a local time */
+    static uint16_t getMinuteOfWeek(const struct tm & local) {
+        return ((local.tm_wday * 24U + local.tm_hour) * 60U + local.tm_min);
+    }
+};
+
+#endif /* WEEKLY_SCHEDULE_H */
@@ -0,0 +1,99 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <string.h>
+#include <stdlib.h>
+#include <nvs.h>
+
+/* Local files */
+#include "zoneBootCache.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief NVS namespace and key of the cache */
+#define ZONE_BOOT_CACHE_NVS_NAMESPACE           ("ZONEBOOT")
+#define ZONE_BOOT_CACHE_NVS_KEY                 ("zones")
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+ZoneBootCache zoneBootCache;
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+void ZoneBootCache::load(void) {
+
+    nvs_handle handle;
+    size_t len = sizeof(records);
+
+    if (loaded == true) {
+        return;
+    }
+    loaded = true;
+
+    if (nvs_open(ZONE_BOOT_CACHE_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return;
+    }
+
+    if ((nvs_get_blob(handle, ZONE_BOOT_CACHE_NVS_KEY, records, &len) != ESP_OK) || (len != sizeof(records))) {
+        memset(records, 0, sizeof(records));
+    }
+
+    nvs_close(handle);
+}
+
+bool ZoneBootCache::get(const uint8_t index, float * const temperature, t_esp01sRelayState * const relayState) {
+
+    if ((index >= ZONE_BOOT_CACHE_MAX_ZONES) || (records[index].valid == 0U)) {
+        return (false);
+    }
+
+    *temperature = records[index].temperature / 100.0f;
+    *relayState = (records[index].relayState == E_ESP01S_RELAY_CLOSE) ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN;
+
+    return (true);
+}
+
+void ZoneBootCache::update(const uint8_t index, const float temperature, const t_esp01sRelayState relayState) {
+
+    if (index >= ZONE_BOOT_CACHE_MAX_ZONES) {
+        return;
+    }
+
+    t_zoneBootRecord & record = records[index];
+    int16_t centi = (int16_t)(temperature * 100);
+
+    if ((record.valid == 0U) || (record.relayState != relayState) ||
+        (abs(centi - record.temperature) >= ZONE_BOOT_CACHE_TEMP_STEP)) {
+        record.temperature = centi;
+        record.relayState = relayState;
+        record.valid = 1U;
+        dirty = true;
+    }
+}
+
+void ZoneBootCache::save(const uint64_t now) {
+
+    nvs_handle handle;
+
+    if ((dirty == false) || ((now - lastSave) < ZONE_BOOT_CACHE_SAVE_PERIOD)) {
+        return;
+    }
+
+    if (nvs_open(ZONE_BOOT_CACHE_NVS_NAMESPACE, NVS_READWRITE, &handle) != ESP_OK) {
+        return;
+    }
+
+    (void)nvs_set_blob(handle, ZONE_BOOT_CACHE_NVS_KEY, records, sizeof(records));
+    (void)nvs_commit(handle);
+    nvs_close(handle);
+
+    dirty = false;
+    lastSave = now;
+}
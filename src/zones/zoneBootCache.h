@@ -0,0 +1,103 @@
+#ifndef ZONE_BOOT_CACHE_H
+#define ZONE_BOOT_CACHE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <stdint.h>
+
+/* Local files */
+#include "devices/esp01sRelay.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Maximum number of zones in the cache */
+#define ZONE_BOOT_CACHE_MAX_ZONES               (32U)
+
+/** @brief Minimum time in ms between two NVS writes of the cache */
+#define ZONE_BOOT_CACHE_SAVE_PERIOD             (10 * 60 * 1000U)
+
+/** @brief Temperature change in 1/100 °C that makes the cache dirty */
+#define ZONE_BOOT_CACHE_TEMP_STEP               (20)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Last known state of a zone */
+typedef struct {
+    int16_t temperature;                /**< Averaged temperature in 1/100 °C */
+    uint8_t relayState;                 /**< Last confirmed t_esp01sRelayState */
+    uint8_t valid;                      /**< Non-zero once the record was written */
+} t_zoneBootRecord;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Zone boot cache class definition.
+ * @details
+ *  This class keeps the last known temperature and relay state of every zone
+ *  in a single NVS blob. On boot, the accessories are published with these
+ *  values right away, while the control task discovers the sensors and relays
+ *  in the background. The whole table is read with one NVS lookup.
+ */
+class ZoneBootCache {
+private:
+    /** @brief Records, indexed by zone */
+    t_zoneBootRecord records[ZONE_BOOT_CACHE_MAX_ZONES];
+
+    /** @brief Flag to track if the table was read from NVS */
+    bool loaded;
+
+    /** @brief Flag to track unsaved changes */
+    bool dirty;
+
+    /** @brief Utils::uptime() of the last NVS write */
+    uint64_t lastSave;
+
+public:
+    /** @brief Constructor */
+    ZoneBootCache() : records(), loaded(false), dirty(false), lastSave(0U) {};
+
+    /** @brief Read the whole table from NVS, only the first call does something */
+    void load(void);
+
+    /**
+     * @brief Get the last known state of a zone
+     *
+     * @param index         Zone index
+     * @param temperature   Averaged temperature, unchanged if unknown
+     * @param relayState    Relay state, unchanged if unknown
+     *
+     * @return true         If the zone has a record
+     */
+    bool get(const uint8_t index, float * const temperature, t_esp01sRelayState * const relayState);
+
+    /**
+     * @brief Record the current state of a zone
+     * @details
+     *  Small temperature changes are ignored so the table is only written when
+     *  it would noticeably change the values published on the next boot.
+     *
+     * @param index         Zone index
+     * @param temperature   Averaged temperature
+     * @param relayState    Confirmed relay state
+     */
+    void update(const uint8_t index, const float temperature, const t_esp01sRelayState relayState);
+
+    /**
+     * @brief Save the table to NVS
+     * @details
+     *  Nothing is written unless a record changed and ZONE_BOOT_CACHE_SAVE_PERIOD
+     *  elapsed since the previous write.
+     *
+     * @param now           Utils::uptime()
+     */
+    void save(const uint64_t now);
+};
+
+/** @brief Boot cache of the bridge */
+extern ZoneBootCache zoneBootCache;
+
+#endif /* ZONE_BOOT_CACHE_H */
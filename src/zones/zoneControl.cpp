@@ -0,0 +1,348 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "zoneControl.h"
+
+/* Local files */
+#include "devices/deviceInfo.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/** @brief Relay names by channel, for the log */
+static const char * const relayLabels[E_ZONE_NB_CHANNELS] = {"heating", "cooling", "humidity"};
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+ZoneControl zoneControl;
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+uint8_t ZoneControl::addZone(const char * const name, RelayDevice * const relay, RemoteSensor * const remoteSensor,
+                             const float initialTemp, const t_esp01sRelayState safeState) {
+
+    if (nbZones >= ZONE_CONTROL_MAX_ZONES) {
+        return (ZONE_CONTROL_MAX_ZONES);
+    }
+
+    t_zoneControl & zone = zones[nbZones];
+    zone.name = name;
+    zone.remoteSensor = remoteSensor;
+    zone.nbReadings = 0U;
+    zone.primed = false;
+    zone.sensorFault = false;
+    zone.sensorErrors = 0U;
+    for (uint8_t channel = 0; channel < E_ZONE_NB_CHANNELS; channel++) {
+        initRelay(zone.relays[channel], (t_zoneChannel)channel, NULL, E_ESP01S_RELAY_OPEN);
+    }
+    initRelay(zone.relays[E_ZONE_CHANNEL_HEATER], E_ZONE_CHANNEL_HEATER, relay, safeState);
+    zone.lastSenseTemperature = Utils::uptime();
+    zone.sequence.store(0U);
+
+    /* The sensor is read by the first pass, publish the last known value until then */
+    zone.averageTemp = initialTemp;
+    zone.lastReading = initialTemp;
+    zone.humidity = NAN;
+    publish(zone);
+
+    return (nbZones++);
+}
+
+void ZoneControl::addRelay(const uint8_t zone, const t_zoneChannel channel, RelayDevice * const relay) {
+    if ((zone < nbZones) && (channel != E_ZONE_CHANNEL_HEATER) && (channel < E_ZONE_NB_CHANNELS)) {
+        initRelay(zones[zone].relays[channel], channel, relay, E_ESP01S_RELAY_OPEN);
+        publish(zones[zone]);
+    }
+}
+
+void ZoneControl::begin(void) {
+#if ZONE_CONTROL_CORE >= 0
+    xTaskCreatePinnedToCore(task, "zoneControl", ZONE_CONTROL_STACK_SIZE, this, ZONE_CONTROL_PRIORITY, NULL, ZONE_CONTROL_CORE);
+    WEBLOG("Zone control task started on core %d", ZONE_CONTROL_CORE);
+#endif
+}
+
+void ZoneControl::poll(void) {
+    if ((Utils::uptime() - lastPass) >= ZONE_CONTROL_PERIOD) {
+        run();
+    }
+}
+
+void ZoneControl::run(void) {
+
+    uint64_t now = Utils::uptime();
+    bool cacheValid = false;
+    t_zoneReading cache;
+    t_zoneCommand command;
+
+    /* The first pass discovers every sensor and relay, without waiting for their polling period */
+    bool discovery = (stats.nbPasses == 0U);
+
+    /* Lateness against the nominal period measures how much other work delays the control loop */
+    if (stats.nbPasses > 0U) {
+        uint64_t elapsed = now - lastPass;
+        stats.lastLateness = (elapsed > ZONE_CONTROL_PERIOD) ? (uint32_t)(elapsed - ZONE_CONTROL_PERIOD) : 0U;
+        if (stats.lastLateness > stats.maxLateness) {
+            stats.maxLateness = stats.lastLateness;
+        }
+    }
+    lastPass = now;
+
+    /* Keep the latest request of each relay */
+    while (commands.pop(&command) == true) {
+        if ((command.zone < nbZones) && (command.channel < E_ZONE_NB_CHANNELS)) {
+            zones[command.zone].relays[command.channel].desired = command.state;
+        }
+    }
+
+    for (uint8_t i = 0; i < nbZones; i++) {
+        t_zoneControl & zone = zones[i];
+        bool changed = false;
+        t_zoneReading reading;
+
+        /* Drain the frames of remote nodes so their queue never overflows */
+        if (zone.remoteSensor != NULL) {
+            (void)zone.remoteSensor->receive();
+        }
+
+        /* Update temperature every given duration, stale remote zones keep their last average */
+        if (discovery || ((now - zone.lastSenseTemperature) > TEMPERATURE_SENSOR_POLLING_TIME)) {
+            bool valid = false;
+            if (readSensor(zone, &reading, &cache, &cacheValid) == true) {
+                /* Validate for correct reading and accumulate if so, glitches are never published */
+                if ((TEMPERATURE_DEFAULT_MIN_VAL <= reading.temperature) &&
+                    (reading.temperature <= TEMPERATURE_DEFAULT_MAX_VAL)) {
+                    if (zone.primed == false) {
+                        zone.averageTemp = reading.temperature;
+                        zone.primed = true;
+                    }
+                    zone.averageTemp *= TEMPERATURE_ALPHA;
+                    zone.averageTemp += (1 - TEMPERATURE_ALPHA) * reading.temperature;
+                    zone.lastReading = reading.temperature;
+                    /* Humidity of the same readout, dropped alone when out of range */
+                    zone.humidity = ((HUMIDITY_DEFAULT_MIN_RANGE <= reading.humidity) &&
+                                     (reading.humidity <= HUMIDITY_DEFAULT_MAX_RANGE)) ? reading.humidity : NAN;
+                    zone.nbReadings++;
+                    changed = true;
+                    valid = true;
+                } else if (zone.sensorFault == false) {
+                    WEBLOG("%s readout %.1f out of range", zone.name, reading.temperature);
+                }
+            } else if (zone.sensorFault == false) {
+                WEBLOG("%s sensor is stale or not answering", zone.name);
+            }
+
+            /* Only transitions are logged, a dead sensor would flush the web log otherwise */
+            if (valid == false) {
+                zone.sensorErrors++;
+                zone.sensorFault = true;
+                changed = true;
+            } else if (zone.sensorFault == true) {
+                WEBLOG("%s sensor answers again", zone.name);
+                zone.sensorFault = false;
+            }
+            zone.lastSenseTemperature = now;
+        }
+
+        /* Drive the relays to their desired state, or check they still are there */
+        for (uint8_t channel = 0; channel < E_ZONE_NB_CHANNELS; channel++) {
+            if ((zone.relays[channel].relay != NULL) && (reconcileRelay(zone, zone.relays[channel], now, discovery) == true)) {
+                changed = true;
+            }
+        }
+
+        if (changed == true) {
+            publish(zone);
+        }
+    }
+
+    uint64_t passTime = Utils::uptime() - now;
+    if (passTime > stats.maxPassTime) {
+        stats.maxPassTime = (uint32_t)passTime;
+    }
+    stats.nbPasses++;
+
+    if (discovery == true) {
+        stats.discoveryTime = (uint32_t)Utils::uptime();
+        WEBLOG("Sensors and relays discovered %u ms after boot", (unsigned int)stats.discoveryTime);
+    }
+}
+
+bool ZoneControl::requestRelay(const uint8_t zone, const t_zoneChannel channel, const t_esp01sRelayState state) {
+
+    t_zoneCommand command = {zone, channel, state};
+
+    if (commands.push(command) == false) {
+        WEBLOG("Relay command queue full, zone %u request dropped", zone);
+        return (false);
+    }
+
+    return (true);
+}
+
+void ZoneControl::getSnapshot(const uint8_t zone, t_zoneSnapshot * const snapshot) {
+
+    t_zoneControl & record = zones[zone];
+    uint32_t before;
+    uint32_t after;
+
+    /* Retry while the control task is writing the snapshot */
+    do {
+        before = record.sequence.load(std::memory_order_acquire);
+        *snapshot = record.snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = record.sequence.load(std::memory_order_relaxed);
+    } while (((before & 1U) != 0U) || (before != after));
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void ZoneControl::task(void * arg) {
+
+    ZoneControl * self = (ZoneControl *)arg;
+    TickType_t wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(ZONE_CONTROL_PERIOD));
+        self->run();
+    }
+}
+
+void ZoneControl::publish(t_zoneControl & zone) {
+
+    const t_zoneRelay & heater = zone.relays[E_ZONE_CHANNEL_HEATER];
+    const t_zoneRelay & cooler = zone.relays[E_ZONE_CHANNEL_COOLER];
+    const t_zoneRelay & humidity = zone.relays[E_ZONE_CHANNEL_HUMIDITY];
+    uint32_t sequence = zone.sequence.load(std::memory_order_relaxed);
+
+    zone.sequence.store(sequence + 1U, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    zone.snapshot.averageTemp = zone.averageTemp;
+    zone.snapshot.lastReading = zone.lastReading;
+    zone.snapshot.humidity = zone.humidity;
+    zone.snapshot.nbReadings = zone.nbReadings;
+    zone.snapshot.sensorFault = zone.sensorFault;
+    zone.snapshot.sensorErrors = zone.sensorErrors;
+    zone.snapshot.relayState = heater.relay->getConfirmedState();
+    zone.snapshot.relayFault = heater.fault;
+    zone.snapshot.relayErrors = heater.relayErrors;
+    zone.snapshot.coolerRelayState = (cooler.relay != NULL) ? cooler.relay->getConfirmedState() : E_ESP01S_RELAY_OPEN;
+    zone.snapshot.coolerRelayFault = cooler.fault;
+    zone.snapshot.coolerRelayErrors = cooler.relayErrors;
+    zone.snapshot.humidityRelayState = (humidity.relay != NULL) ? humidity.relay->getConfirmedState() : E_ESP01S_RELAY_OPEN;
+    zone.snapshot.humidityRelayFault = humidity.fault;
+    zone.snapshot.humidityRelayErrors = humidity.relayErrors;
+
+    zone.sequence.store(sequence + 2U, std::memory_order_release);
+}
+
+void ZoneControl::initRelay(t_zoneRelay & relay, const t_zoneChannel channel, RelayDevice * const device, const t_esp01sRelayState safeState) {
+    relay.label = relayLabels[channel];
+    relay.relay = device;
+    relay.desired = (device != NULL) ? device->getConfirmedState() : safeState;
+    relay.safeState = safeState;
+    relay.failures = 0U;
+    relay.fault = false;
+    relay.relayErrors = 0U;
+    relay.retryDelay = 0U;
+    relay.nextRelayAttempt = 0U;
+    relay.lastRelayStatus = Utils::uptime();
+}
+
+bool ZoneControl::reconcileRelay(t_zoneControl & zone, t_zoneRelay & relay, const uint64_t now, const bool force) {
+
+    t_esp01sRelayState state;
+    t_httpErrorCodes error;
+
+    /* Back off while the relay does not answer */
+    if (now < relay.nextRelayAttempt) {
+        return (false);
+    }
+
+    if (relay.desired != relay.relay->getConfirmedState()) {
+        error = relay.relay->sendEsp01sRelayCommand(relay.desired);
+    } else if (force || ((now - relay.lastRelayStatus) > GET_STATUS_REFRESH_TIME_IN_MS)) {
+        /* A mismatch found here, e.g. after a relay reboot, is corrected on the next pass */
+        error = relay.relay->getEsp01sRelayState(&state);
+        relay.lastRelayStatus = now;
+    } else {
+        return (false);
+    }
+
+    if (error != E_REQUEST_SUCCESS) {
+        retryLater(zone, relay, now);
+        return (true);
+    }
+
+    if (relay.fault == true) {
+        WEBLOG("%s %s relay answers again", zone.name, relay.label);
+    }
+    relay.failures = 0U;
+    relay.fault = false;
+    relay.retryDelay = 0U;
+
+    return (true);
+}
+
+void ZoneControl::retryLater(t_zoneControl & zone, t_zoneRelay & relay, const uint64_t now) {
+
+    relay.relayErrors++;
+    if (relay.failures < UINT8_MAX) {
+        relay.failures++;
+    }
+
+    relay.retryDelay = (relay.retryDelay == 0U) ? RELAY_RETRY_MIN_DELAY : relay.retryDelay * 2U;
+    if (relay.retryDelay > RELAY_RETRY_MAX_DELAY) {
+        relay.retryDelay = RELAY_RETRY_MAX_DELAY;
+    }
+    relay.nextRelayAttempt = now + relay.retryDelay;
+
+    if ((relay.failures >= RELAY_FAULT_THRESHOLD) && (relay.fault == false)) {
+        relay.fault = true;
+        relay.desired = relay.safeState;
+        WEBLOG("%s %s relay not answering, falling back to %s", zone.name, relay.label,
+               relay.safeState == E_ESP01S_RELAY_OPEN ? "OPEN" : "CLOSE");
+    }
+}
+
+bool ZoneControl::readSensor(t_zoneControl & zone, t_zoneReading * const reading, t_zoneReading * const cache, bool * const cacheValid) {
+
+    t_remoteSensorSample sample;
+
+    if (zone.remoteSensor != NULL) {
+        if (zone.remoteSensor->getSample(&sample) == false) {
+            return (false);
+        }
+        reading->temperature = sample.temperature;
+        reading->humidity = sample.humidity;
+        return (true);
+    }
+
+    if (localSensorReady == false) {
+        localSensorReady = localSensor->initializeSensor();
+    }
+    if ((*cacheValid == false) && (localSensorReady == true)) {
+        /* A single conversion gives both values */
+        (void)localSensor->measure();
+        cache->temperature = localSensor->getCurrentTemperature();
+        cache->humidity = localSensor->getCurrentHumidity();
+        *cacheValid = true;
+        /* Initialize the sensor again after a failed readout, it may have been power cycled */
+        localSensorReady = !isnan(cache->temperature);
+    }
+    *reading = *cache;
+
+    return ((*cacheValid == true) && !isnan(reading->temperature));
+}
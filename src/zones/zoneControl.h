@@ -0,0 +1,322 @@
+#ifndef ZONE_CONTROL_H
+#define ZONE_CONTROL_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+#include <atomic>
+
+/* Local files */
+#include "devices/relayDevice.h"
+#include "devices/adafruitAht20.h"
+#include "devices/remoteSensor.h"
+#include "zones/spscQueue.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Core of the control task, -1 runs the control passes from the HomeSpan poll task instead */
+#ifndef ZONE_CONTROL_CORE
+#define ZONE_CONTROL_CORE                       (1)
+#endif
+
+/** @brief Control task priority, above the Arduino loop task */
+#define ZONE_CONTROL_PRIORITY                   (2U)
+
+/** @brief Control task stack size, the HTTP relay client needs most of it */
+#define ZONE_CONTROL_STACK_SIZE                 (8192U)
+
+/** @brief Period of the control passes in ms */
+#define ZONE_CONTROL_PERIOD                     (100U)
+
+/** @brief Maximum number of zones driven by the control task */
+#define ZONE_CONTROL_MAX_ZONES                  (32U)
+
+/** @brief Depth of the relay command queue */
+#define ZONE_CONTROL_QUEUE_DEPTH                (16U)
+
+/** @brief Alpha for exponential average */
+#define TEMPERATURE_ALPHA                       (0.75)
+
+/** @brief Update homekit device status time in ms */
+#define GET_STATUS_REFRESH_TIME_IN_MS           (30 * 1000)
+
+/** @brief Relay retry delay in ms after the first failure, doubled on every further failure */
+#define RELAY_RETRY_MIN_DELAY                   (1000U)
+
+/** @brief Longest relay retry delay in ms, bounds the traffic while the relay is down */
+#define RELAY_RETRY_MAX_DELAY                   (60 * 1000U)
+
+/** @brief Consecutive relay failures after which the zone is faulted and falls back to its safe state */
+#define RELAY_FAULT_THRESHOLD                   (5U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents the relays of a zone */
+typedef enum {
+    E_ZONE_CHANNEL_HEATER   = 0U,       /**< Heating relay */
+    E_ZONE_CHANNEL_COOLER   = 1U,       /**< Cooling relay, optional */
+    E_ZONE_CHANNEL_HUMIDITY = 2U,       /**< Humidifier or dehumidifier relay, optional */
+    E_ZONE_NB_CHANNELS      = 3U
+} t_zoneChannel;
+
+/** @brief Relay command sent to the control task */
+typedef struct {
+    uint8_t zone;                       /**< Zone index */
+    t_zoneChannel channel;              /**< Relay of the zone */
+    t_esp01sRelayState state;           /**< Requested relay state */
+} t_zoneCommand;
+
+/** @brief Zone state published by the control task */
+typedef struct {
+    float averageTemp;                  /**< Exponentially averaged temperature */
+    float lastReading;                  /**< Latest temperature readout */
+    float humidity;                     /**< Relative humidity of the latest readout, NAN if the sensor does not report it */
+    uint32_t nbReadings;                /**< Number of readouts, changes with every new lastReading */
+    bool sensorFault;                   /**< The last sensor poll gave no valid readout */
+    uint32_t sensorErrors;              /**< Number of sensor polls without a valid readout */
+    t_esp01sRelayState relayState;      /**< Last state confirmed by the relay */
+    bool relayFault;                    /**< The relay failed RELAY_FAULT_THRESHOLD exchanges in a row */
+    uint32_t relayErrors;               /**< Number of failed relay exchanges */
+    t_esp01sRelayState coolerRelayState;    /**< Last state confirmed by the cooling relay */
+    bool coolerRelayFault;              /**< Same as relayFault, for the cooling relay */
+    uint32_t coolerRelayErrors;         /**< Same as relayErrors, for the cooling relay */
+    t_esp01sRelayState humidityRelayState;  /**< Last state confirmed by the humidity relay */
+    bool humidityRelayFault;            /**< Same as relayFault, for the humidity relay */
+    uint32_t humidityRelayErrors;       /**< Same as relayErrors, for the humidity relay */
+} t_zoneSnapshot;
+
+/** @brief Control loop timing, each field is a single word written by the control task only */
+typedef struct {
+    uint32_t nbPasses;                  /**< Number of control passes */
+    uint32_t lastLateness;              /**< Delay in ms of the last pass after its due time */
+    uint32_t maxLateness;               /**< Largest delay in ms of a pass after its due time */
+    uint32_t maxPassTime;               /**< Longest pass in ms */
+    uint32_t discoveryTime;             /**< Utils::uptime() at the end of the first pass, once every sensor and relay was queried */
+} t_zoneControlStats;
+
+/** @brief One sensor readout, temperature and humidity come from the same conversion */
+typedef struct {
+    float temperature;                  /**< Temperature in °C */
+    float humidity;                     /**< Relative humidity in %, NAN if not reported */
+} t_zoneReading;
+
+/** @brief Control side record of a relay */
+typedef struct {
+    const char * label;                 /**< Relay name, for the log */
+    RelayDevice * relay;                /**< Relay, NULL if the zone has none on this channel */
+    t_esp01sRelayState desired;         /**< Relay state the zone should be in */
+    t_esp01sRelayState safeState;       /**< Relay state applied once the relay is faulted */
+    uint8_t failures;                   /**< Consecutive failed relay exchanges */
+    bool fault;                         /**< Set after RELAY_FAULT_THRESHOLD failures, cleared by the next success */
+    uint32_t relayErrors;               /**< Number of failed relay exchanges */
+    uint32_t retryDelay;                /**< Current relay retry delay in ms, 0 while the relay answers */
+    uint64_t nextRelayAttempt;          /**< Utils::uptime() before which the relay is left alone */
+    uint64_t lastRelayStatus;           /**< Utils::uptime() of the last relay status query */
+} t_zoneRelay;
+
+/** @brief Control side record of a zone */
+typedef struct {
+    const char * name;                  /**< Zone name, for the log */
+    RemoteSensor * remoteSensor;        /**< Sensor node, NULL for the local AHT20 */
+    float averageTemp;                  /**< Exponentially averaged temperature */
+    float lastReading;                  /**< Latest temperature readout */
+    float humidity;                     /**< Latest relative humidity, NAN if unknown */
+    uint32_t nbReadings;                /**< Number of readouts */
+    bool primed;                        /**< Set by the first valid readout, which replaces the cached boot temperature */
+    bool sensorFault;                   /**< Set by a poll without valid readout, cleared by the next valid one */
+    uint32_t sensorErrors;              /**< Number of sensor polls without a valid readout */
+    t_zoneRelay relays[E_ZONE_NB_CHANNELS];  /**< Relays of the zone, by channel */
+    uint64_t lastSenseTemperature;      /**< Utils::uptime() of the last temperature readout */
+    std::atomic<uint32_t> sequence;     /**< Snapshot sequence, odd while the snapshot is written */
+    t_zoneSnapshot snapshot;            /**< Published state */
+} t_zoneControl;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Zone control class definition.
+ * @details
+ *  This class owns everything that blocks: the AHT20 I2C conversions, the
+ *  remote sensor frames and the relay requests. It runs in its own task,
+ *  pinned to ZONE_CONTROL_CORE, while HomeSpan and the HomeKit side of the
+ *  zones run in the HomeSpan poll task on the other core.
+ *
+ *  Relay commands flow from the HomeKit side through a lock-free single
+ *  producer, single consumer queue. Sensor readings and confirmed relay
+ *  states flow back through one snapshot per zone, published with a sequence
+ *  counter so the reader never sees a half-written snapshot.
+ */
+class ZoneControl {
+private:
+    /** @brief Zone records */
+    t_zoneControl zones[ZONE_CONTROL_MAX_ZONES];
+
+    /** @brief Number of zones in use */
+    uint8_t nbZones;
+
+    /** @brief Relay commands, produced by the HomeKit side */
+    SpscQueue<t_zoneCommand, ZONE_CONTROL_QUEUE_DEPTH> commands;
+
+    /** @brief AHT20 wired to the bridge */
+    TempHumSensor aht20;
+
+    /** @brief Sensor shared by all local zones, the AHT20 unless replaced with setLocalSensor() */
+    SensorDevice * localSensor;
+
+    /** @brief Flag to track if the local sensor was initialized */
+    bool localSensorReady;
+
+    /** @brief Utils::uptime() of the last pass */
+    uint64_t lastPass;
+
+    /** @brief Timing statistics */
+    t_zoneControlStats stats;
+
+    /** @brief Control task body */
+    static void task(void * arg);
+
+    /**
+     * @brief Read the temperature and humidity of a zone
+     * @details
+     *  The local sensor runs at most one conversion per pass, whatever the
+     *  number of zones bound to it, and that conversion gives both values.
+     *  Remote zones return their latest frame.
+     *
+     * @param zone          Zone to read
+     * @param reading       Temperature and humidity
+     * @param cache         Reading of the local sensor for the current pass
+     * @param cacheValid    Whether cache holds a reading for the current pass
+     *
+     * @return true         If reading holds a fresh temperature
+     * @return false        Remote sensor silent for too long
+     */
+    bool readSensor(t_zoneControl & zone, t_zoneReading * const reading, t_zoneReading * const cache, bool * const cacheValid);
+
+    /** @brief Publish the snapshot of a zone */
+    void publish(t_zoneControl & zone);
+
+    /** @brief Initialize the record of a relay */
+    void initRelay(t_zoneRelay & relay, const t_zoneChannel channel, RelayDevice * const device, const t_esp01sRelayState safeState);
+
+    /**
+     * @brief Bring a relay of a zone to its desired state
+     * @details
+     *  A command is sent whenever the confirmed state differs from the desired
+     *  one, otherwise the relay status is queried every GET_STATUS_REFRESH_TIME_IN_MS.
+     *  Failed exchanges are retried with an exponential backoff, see retryLater().
+     *
+     * @param zone          Zone of the relay
+     * @param relay         Relay to reconcile
+     * @param now           Utils::uptime()
+     * @param force         Query the relay status even if not due
+     *
+     * @return true         If the relay was contacted
+     */
+    bool reconcileRelay(t_zoneControl & zone, t_zoneRelay & relay, const uint64_t now, const bool force);
+
+    /**
+     * @brief Account for a failed relay exchange
+     * @details
+     *  After RELAY_FAULT_THRESHOLD consecutive failures the relay is faulted and
+     *  its desired state becomes the safe state, so the relay goes there as
+     *  soon as it answers again.
+     *
+     * @param zone          Zone of the relay
+     * @param relay         Relay that failed
+     * @param now           Utils::uptime()
+     */
+    void retryLater(t_zoneControl & zone, t_zoneRelay & relay, const uint64_t now);
+
+public:
+    /** @brief Constructor */
+    ZoneControl() : nbZones(0U), localSensor(&aht20), localSensorReady(false), lastPass(0U), stats() {};
+
+    /**
+     * @brief Add a zone
+     * @details
+     *  Nothing is read here: the zone starts from the given temperature and
+     *  the sensor and relay are queried on the first pass of the control task.
+     *
+     * @param name          Zone name, must remain valid
+     * @param relay         Heating relay
+     * @param remoteSensor  Sensor node, NULL for the local AHT20
+     * @param initialTemp   Last known temperature, published until the first readout
+     * @param safeState     Relay state applied when the relay stops answering
+     *
+     * @return Zone index, or ZONE_CONTROL_MAX_ZONES if the table is full
+     */
+    uint8_t addZone(const char * const name, RelayDevice * const relay, RemoteSensor * const remoteSensor,
+                    const float initialTemp, const t_esp01sRelayState safeState);
+
+    /**
+     * @brief Add an optional relay to a zone
+     * @details
+     *  The relay is opened when it stops answering. It must be called before begin().
+     *
+     * @param zone          Zone index
+     * @param channel       E_ZONE_CHANNEL_COOLER or E_ZONE_CHANNEL_HUMIDITY
+     * @param relay         Cooling, humidifier or dehumidifier relay
+     */
+    void addRelay(const uint8_t zone, const t_zoneChannel channel, RelayDevice * const relay);
+
+    /**
+     * @brief Replace the sensor of the local zones
+     * @details
+     *  Host tests use it to script readouts. It must be called before begin().
+     *
+     * @param sensor        Sensor, must remain valid
+     */
+    void setLocalSensor(SensorDevice * const sensor) { localSensor = sensor; localSensorReady = false; }
+
+    /**
+     * @brief Start the control task
+     * @details
+     *  Does nothing if ZONE_CONTROL_CORE is negative, poll() must then be
+     *  called from the HomeSpan poll task.
+     */
+    void begin(void);
+
+    /** @brief Run a control pass if one is due, for builds without the control task */
+    void poll(void);
+
+    /** @brief Run one control pass */
+    void run(void);
+
+    /**
+     * @brief Request a relay state, HomeKit side only
+     * @details
+     *  Requests for the same relay are coalesced, only the latest one is sent.
+     *  The control task keeps sending it until the relay confirms it.
+     *
+     * @param zone          Zone index
+     * @param channel       Relay of the zone
+     * @param state         Requested relay state
+     *
+     * @return true         If the request was queued
+     * @return false        Queue full
+     */
+    bool requestRelay(const uint8_t zone, const t_zoneChannel channel, const t_esp01sRelayState state);
+
+    /**
+     * @brief Get the latest snapshot of a zone, HomeKit side only
+     *
+     * @param zone          Zone index
+     * @param snapshot      Copy of the snapshot
+     */
+    void getSnapshot(const uint8_t zone, t_zoneSnapshot * const snapshot);
+
+    /** @brief Whether addZone() would fail */
+    bool isFull(void) const { return (nbZones >= ZONE_CONTROL_MAX_ZONES); }
+
+    /** @brief Get the timing statistics */
+    const t_zoneControlStats & getStats(void) const { return (stats); }
+};
+
+/** @brief Control side of the zones */
+extern ZoneControl zoneControl;
+
+#endif /* ZONE_CONTROL_H */
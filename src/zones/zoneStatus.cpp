@@ -0,0 +1,113 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "zoneStatus.h"
+
+/* Local files */
+#include "zones/zoneTable.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Maximum length of one metrics line */
+#define ZONE_METRICS_LINE_LEN                   (128U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void printMetric(WiFiClient & client, const char * metric, const char * zone, const uint32_t value) {
+
+    char line[ZONE_METRICS_LINE_LEN];
+
+    snprintf(line, sizeof(line), "%s{zone=\"%s\"} %u\n", metric, zone, (unsigned int)value);
+    client.print(line);
+}
+
+/************************************************
+ *  Public function implementation
+ ***********************************************/
+void zoneMetrics(WiFiClient & client, const char * args) {
+
+    char line[ZONE_METRICS_LINE_LEN];
+
+    (void)args;
+    client.print("HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n\r\n");
+
+    for (uint8_t i = 0; i < zoneTable.getNbZones(); i++) {
+        t_zone * zone = zoneTable.getZone(i);
+        const t_relayCounters & counters = zone->energy->getCounters();
+        const char * name = zone->config->name;
+        t_zoneSnapshot snapshot;
+
+        zoneControl.getSnapshot(zone->index, &snapshot);
+
+        printMetric(client, "relay_on_seconds_total", name, counters.totalOnSeconds);
+        printMetric(client, "relay_on_seconds_hour", name, counters.hourOnSeconds);
+        printMetric(client, "relay_on_seconds_day", name, counters.dayOnSeconds);
+        printMetric(client, "relay_on_seconds_week", name, counters.weekOnSeconds);
+        printMetric(client, "relay_on_seconds_last_day", name, counters.lastDayOnSeconds);
+        printMetric(client, "relay_cycles_total", name, counters.cycles);
+        printMetric(client, "relay_last_transition_time", name, counters.lastTransition);
+        printMetric(client, "relay_errors_total", name, snapshot.relayErrors);
+        printMetric(client, "relay_fault", name, snapshot.relayFault ? 1U : 0U);
+        printMetric(client, "sensor_errors_total", name, snapshot.sensorErrors);
+        printMetric(client, "sensor_fault", name, snapshot.sensorFault ? 1U : 0U);
+        if (zone->coolerRelay != NULL) {
+            printMetric(client, "cooler_relay_on", name, snapshot.coolerRelayState == E_ESP01S_RELAY_CLOSE ? 1U : 0U);
+            printMetric(client, "cooler_relay_errors_total", name, snapshot.coolerRelayErrors);
+            printMetric(client, "cooler_relay_fault", name, snapshot.coolerRelayFault ? 1U : 0U);
+        }
+        if (zone->humidityRelay != NULL) {
+            printMetric(client, "humidity_relay_on", name, snapshot.humidityRelayState == E_ESP01S_RELAY_CLOSE ? 1U : 0U);
+            printMetric(client, "humidity_relay_errors_total", name, snapshot.humidityRelayErrors);
+            printMetric(client, "humidity_relay_fault", name, snapshot.humidityRelayFault ? 1U : 0U);
+        }
+        if (zone->openWindow != NULL) {
+            printMetric(client, "open_window", name, zone->openWindow->isOpen() ? 1U : 0U);
+            printMetric(client, "open_window_events_total", name, zone->openWindow->getNbEvents());
+        }
+        if (!isnan(snapshot.humidity)) {
+            snprintf(line, sizeof(line), "relative_humidity_percent{zone=\"%s\"} %.1f\n", name, snapshot.humidity);
+            client.print(line);
+        }
+        snprintf(line, sizeof(line), "heater_energy_kwh_total{zone=\"%s\"} %.3f\n", name, zone->energy->getEnergyKwh());
+        client.print(line);
+    }
+
+    const t_zoneControlStats & stats = zoneControl.getStats();
+    snprintf(line, sizeof(line), "control_passes_total %u\ncontrol_lateness_ms %u\ncontrol_lateness_max_ms %u\ncontrol_pass_max_ms %u\n",
+             (unsigned int)stats.nbPasses, (unsigned int)stats.lastLateness, (unsigned int)stats.maxLateness, (unsigned int)stats.maxPassTime);
+    client.print(line);
+
+    snprintf(line, sizeof(line), "boot_discovery_ms %u\nboot_first_hap_response_ms %u\n",
+             (unsigned int)stats.discoveryTime, (unsigned int)homeSpan.getFirstResponseTime());
+    client.print(line);
+}
+
+void zoneWebLogStatus(String & htmlText) {
+
+    char line[ZONE_METRICS_LINE_LEN];
+    const t_zoneControlStats & stats = zoneControl.getStats();
+
+    snprintf(line, sizeof(line), "<tr><td>Control Loop:</td><td>%s, %u ms period, max lateness %u ms, max pass %u ms</td></tr>\n",
+             ZONE_CONTROL_CORE >= 0 ? "own task" : "poll task", ZONE_CONTROL_PERIOD,
+             (unsigned int)stats.maxLateness, (unsigned int)stats.maxPassTime);
+    htmlText += line;
+
+    snprintf(line, sizeof(line), "<tr><td>Device Discovery:</td><td>%u ms after boot</td></tr>\n", (unsigned int)stats.discoveryTime);
+    htmlText += line;
+
+    for (uint8_t i = 0; i < zoneTable.getNbZones(); i++) {
+        t_zone * zone = zoneTable.getZone(i);
+        const t_relayCounters & counters = zone->energy->getCounters();
+
+        snprintf(line, sizeof(line), "<tr><td>%s Heater:</td><td>%u min today, %u min this week, %u cycles, %.2f kWh%s</td></tr>\n",
+                 zone->config->name, (unsigned int)(counters.dayOnSeconds / 60U), (unsigned int)(counters.weekOnSeconds / 60U),
+                 (unsigned int)counters.cycles, zone->energy->getEnergyKwh(), zone->relayFault ? ", RELAY FAULT" : "");
+        htmlText += line;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef ZONE_STATUS_H
+#define ZONE_STATUS_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Web route of the metrics, served next to the web log */
+#define ZONE_METRICS_URL                        ("metrics")
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public function definition
+ ***********************************************/
+/**
+ * @brief Serve the relay counters of every zone
+ * @details
+ *  Handler of GET /metrics, plain text in the Prometheus exposition format.
+ *  Each relay series is labelled with the zone name, the control loop timing
+ *  series are global.
+ *
+ * @param client        HTTP client
+ * @param args          Query string, unused
+ */
+void zoneMetrics(WiFiClient & client, const char * args);
+
+/**
+ * @brief Add the relay counters of every zone to the web log status table
+ *
+ * @param htmlText      Status table being built
+ */
+void zoneWebLogStatus(String & htmlText);
+
+#endif /* ZONE_STATUS_H */
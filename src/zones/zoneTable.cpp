@@ -0,0 +1,423 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "zoneTable.h"
+
+/* Local files */
+#include "devices/deviceInfo.h"
+#include "homeKitAccessories/thermostat.h"
+#include "homeKitAccessories/tempHumSensor.h"
+#include "homeKitAccessories/relaySwitch.h"
+#include "homeKitAccessories/windowSensor.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+
+/** @brief Maximum length of a schedule NVS key */
+#define SCHEDULE_KEY_LEN                        (8U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+
+/************************************************
+ *  Public variables
+ ***********************************************/
+ZoneTable zoneTable;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/**
+ * @brief Schedule user command: @S<zone> [<days hex> <HH:MM> <temp> ...]
+ * @details
+ *  Example: "@S0 3E 06:30 21 08:00 17 17:30 21 22:30 17 41 08:00 21 23:00 17"
+ *  programs zone 0 for weekdays (3E) and weekends (41). "@S0" restores the default.
+ */
+static void scheduleCommand(const char * buf) {
+
+    char line[128];
+    t_schedulePeriod periods[SCHEDULE_MAX_TRANSITIONS];
+    uint8_t nbPeriods = 0U;
+    uint8_t dayMask = SCHEDULE_EVERYDAY;
+    char * save;
+
+    strncpy(line, buf + 1, sizeof(line) - 1U);
+    line[sizeof(line) - 1U] = '\0';
+
+    char * token = strtok_r(line, " ", &save);
+    if (token == NULL) {
+        LOG0("*** Usage: @S<zone> [<days hex> <HH:MM> <temp> ...]\n");
+        return;
+    }
+    uint8_t index = strtoul(token, NULL, 10);
+
+    while (((token = strtok_r(NULL, " ", &save)) != NULL) && (nbPeriods < SCHEDULE_MAX_TRANSITIONS)) {
+        unsigned int hour, minute;
+        if (sscanf(token, "%u:%u", &hour, &minute) != 2) {
+            dayMask = strtoul(token, NULL, 16) & SCHEDULE_EVERYDAY;
+            continue;
+        }
+
+        char * temp = strtok_r(NULL, " ", &save);
+        if (temp == NULL) {
+            LOG0("*** Missing temperature after %s\n", token);
+            return;
+        }
+        periods[nbPeriods++] = {dayMask, (uint16_t)(hour * 60U + minute), SCHEDULE_SETPOINT(atof(temp))};
+    }
+
+    if (zoneTable.setSchedule(index, periods, nbPeriods) == false) {
+        LOG0("*** Invalid schedule for zone %u\n", index);
+        return;
+    }
+    LOG0("Schedule of zone %u updated\n", index);
+}
+
+/************************************************
+ *  Public Method Implementation
+ ***********************************************/
+t_zone * ZoneTable::addZone(const t_zoneConfig * const config) {
+
+    if (nbZones >= MAX_NB_ZONES) {
+        WEBLOG("Zone table full, %s ignored", config->name);
+        return (NULL);
+    }
+
+    /* Nothing is allocated unless the control task can take the zone */
+    if (zoneControl.isFull() == true) {
+        WEBLOG("Zone control table full, %s ignored", config->name);
+        return (NULL);
+    }
+
+    t_zone * zone = &zones[nbZones];
+
+    /* Last known state, a single NVS read for all zones */
+    float initialTemp = TEMPERATURE_INITIAL_VALUE;
+    t_esp01sRelayState initialRelay = E_ESP01S_RELAY_OPEN;
+    zoneBootCache.load();
+    (void)zoneBootCache.get(nbZones, &initialTemp, &initialRelay);
+
+    zone->config = config;
+    zone->relay = new Esp01sRelay(config->relayIpAddress, config->relayPort, config->relayTransport, RELAY_UDP_KEY);
+    zone->relay->presetState(initialRelay);
+    zone->remoteSensor = NULL;
+    if (config->sensorSource == E_ZONE_SENSOR_REMOTE) {
+        zone->remoteSensor = new RemoteSensor(config->remoteSensorMac);
+    }
+
+    /* Sensors and relay belong to the control task from now on */
+    zone->index = zoneControl.addZone(config->name, zone->relay, zone->remoteSensor, initialTemp, config->relaySafeState);
+    nbZones++;
+
+    /* The cooling and humidity relays start open, the first pass of the control task checks them */
+    zone->coolerRelay = NULL;
+    if (config->coolerRelayIpAddress != NULL) {
+        zone->coolerRelay = new Esp01sRelay(config->coolerRelayIpAddress, config->coolerRelayPort, config->relayTransport, RELAY_UDP_KEY);
+        zoneControl.addRelay(zone->index, E_ZONE_CHANNEL_COOLER, zone->coolerRelay);
+    }
+    zone->climate = new ClimateControl(zone->coolerRelay != NULL, initialRelay == E_ESP01S_RELAY_CLOSE ? E_CLIMATE_HEAT : E_CLIMATE_IDLE);
+    zone->openWindow = NULL;
+    if (config->openWindowMinutes > 0U) {
+        zone->openWindow = new OpenWindowDetector(config->openWindowMinutes * 60U * 1000U);
+    }
+    zone->humidityRelay = NULL;
+    zone->humidityControl = NULL;
+    if (config->humidityRelayIpAddress != NULL) {
+        zone->humidityRelay = new Esp01sRelay(config->humidityRelayIpAddress, config->humidityRelayPort, config->relayTransport, RELAY_UDP_KEY);
+        zone->humidityControl = new HumidityControl(config->humidityMode, false);
+        zoneControl.addRelay(zone->index, E_ZONE_CHANNEL_HUMIDITY, zone->humidityRelay);
+    }
+
+    /* A program saved from the command line overrides the default one */
+    char key[SCHEDULE_KEY_LEN];
+    getScheduleKey(*zone, key);
+    zone->schedule = new WeeklySchedule();
+    if ((zone->schedule->load(key) == false) && (config->schedule != NULL)) {
+        (void)zone->schedule->compile(config->schedule, config->nbSchedulePeriods);
+    }
+    zone->scheduleIndex = SCHEDULE_MAX_TRANSITIONS;
+    zone->schedulePreheat = false;
+    zone->lastScheduleCheck = Utils::uptime();
+    zone->scheduleWait = 0U;
+    zone->preheat = new PreheatModel();
+    zone->preheat->load(key);
+    zone->history = new HistoryStore();
+    zone->history->load(key);
+    WEBLOG("%s history uses %u bytes", config->name, (unsigned int)zone->history->getMemoryUsage());
+    zone->energy = new RelayAccounting(config->heaterPowerW);
+    zone->energy->load(key);
+
+    if (nbZones == 1U) {
+        new SpanUserCommand('S', "<zone> [<days hex> <HH:MM> <temp> ...] - program the weekly schedule of a zone", scheduleCommand);
+    }
+
+    t_zoneSnapshot snapshot;
+    zoneControl.getSnapshot(zone->index, &snapshot);
+    zone->averageTemp = snapshot.averageTemp;
+    zone->humidity = snapshot.humidity;
+    zone->nbReadings = snapshot.nbReadings;
+    zone->relayState = snapshot.relayState;
+    zone->relayFault = false;
+    zone->coolerRelayState = snapshot.coolerRelayState;
+    zone->coolerRelayFault = false;
+    zone->humidityRelayState = snapshot.humidityRelayState;
+    zone->wasUpdated = false;
+    zone->lastUpdateTemperature = Utils::uptime();
+    zone->lastUpdateState = Utils::uptime();
+
+    /* Temperature & Humidity Sensor */
+    new SpanAccessory();
+        new Service::AccessoryInformation();
+            new Characteristic::Name((String(config->name) + " Temperature").c_str());
+            new Characteristic::Manufacturer(TEMP_HUM_SENSOR_MANUFACTURER);
+            new Characteristic::Model(TEMP_HUM_SENSOR_MODEL);
+            new Characteristic::SerialNumber(config->sensorSerialNum);
+            new Characteristic::FirmwareRevision(TEMP_HUM_SENSOR_FIRMWARE);
+            new Characteristic::Identify();
+        zone->sensor = new HS_TempSensor(zone->averageTemp);
+        zone->humiditySensor = new HS_HumiditySensor(HUMIDITY_INITIAL_VALUE);
+        zone->windowSensor = NULL;
+        if (zone->openWindow != NULL) {
+            zone->windowSensor = new HS_WindowSensor();
+        }
+
+    /* Thermostat */
+    new SpanAccessory();
+        new Service::AccessoryInformation();
+            new Characteristic::Name((String(config->name) + " Thermostat").c_str());
+            new Characteristic::Manufacturer(THERMOSTAT_MANUFACTURER);
+            new Characteristic::Model(THERMOSTAT_MODEL);
+            new Characteristic::SerialNumber(config->thermostatSerialNum);
+            new Characteristic::FirmwareRevision(THERMOSTAT_FIRMWARE);
+            new Characteristic::Identify();
+        zone->thermostat = new HS_Thermostat(zone);
+        zone->thermostat->updateEnergy(zone->energy->getEnergyKwh());
+
+    /* Heating relay - defined as switch */
+    new SpanAccessory();
+        new Service::AccessoryInformation();
+            new Characteristic::Name((String(config->name) + " Heating Relay").c_str());
+            new Characteristic::Identify();
+        zone->relaySwitch = new HS_RelaySwitch(zone->relay);
+
+    /* Cooling relay - defined as switch */
+    zone->coolerSwitch = NULL;
+    if (zone->coolerRelay != NULL) {
+        new SpanAccessory();
+            new Service::AccessoryInformation();
+                new Characteristic::Name((String(config->name) + " Cooling Relay").c_str());
+                new Characteristic::Identify();
+            zone->coolerSwitch = new HS_RelaySwitch(zone->coolerRelay);
+    }
+
+    /* Humidifier or dehumidifier relay - defined as switch */
+    zone->humiditySwitch = NULL;
+    if (zone->humidityRelay != NULL) {
+        new SpanAccessory();
+            new Service::AccessoryInformation();
+                new Characteristic::Name((String(config->name) + (config->humidityMode == E_HUMIDITY_MODE_HUMIDIFY ? " Humidifier" : " Dehumidifier")).c_str());
+                new Characteristic::Identify();
+            zone->humiditySwitch = new HS_RelaySwitch(zone->humidityRelay);
+    }
+
+    return (zone);
+}
+
+void ZoneTable::begin(void) {
+    zoneControl.begin();
+}
+
+void ZoneTable::run(void) {
+
+    uint64_t now = Utils::uptime();
+
+#if ZONE_CONTROL_CORE < 0
+    /* No control task, sensors and relays are serviced from this task */
+    zoneControl.poll();
+#endif
+
+    for (uint8_t i = 0; i < nbZones; i++) {
+        t_zone & zone = zones[i];
+        t_zoneSnapshot snapshot;
+
+        /* Pick up the readings and relay state published by the control task */
+        zoneControl.getSnapshot(zone.index, &snapshot);
+        zone.averageTemp = snapshot.averageTemp;
+        zone.humidity = snapshot.humidity;
+        if (snapshot.nbReadings != zone.nbReadings) {
+            zone.nbReadings = snapshot.nbReadings;
+            zone.sensor->setTemperature(snapshot.lastReading);
+            if (!isnan(snapshot.humidity)) {
+                zone.humiditySensor->setHumidity(snapshot.humidity);
+            }
+            /* Watch the filtered temperature for the drop of an open window */
+            if ((zone.openWindow != NULL) && (zone.openWindow->addSample(snapshot.averageTemp, now) == true)) {
+                WEBLOG("%s open window detected, %.2f C/min, heating suspended", zone.config->name, zone.openWindow->getSlope());
+                zone.windowSensor->setOpen(true);
+                zone.wasUpdated = true;
+            }
+        }
+        if ((zone.openWindow != NULL) && (zone.openWindow->update(now) == true)) {
+            WEBLOG("%s window considered closed, heating resumed", zone.config->name);
+            zone.windowSensor->setOpen(false);
+            zone.wasUpdated = true;
+        }
+        if ((zone.humiditySwitch != NULL) && (snapshot.humidityRelayState != zone.humidityRelayState)) {
+            zone.humidityRelayState = snapshot.humidityRelayState;
+            zone.humiditySwitch->refreshState(zone.humidityRelayState);
+        }
+        if (snapshot.relayState != zone.relayState) {
+            zone.relayState = snapshot.relayState;
+            zone.relaySwitch->refreshState(zone.relayState);
+            zone.thermostat->refreshOutputs();
+        }
+        if ((zone.coolerSwitch != NULL) && (snapshot.coolerRelayState != zone.coolerRelayState)) {
+            zone.coolerRelayState = snapshot.coolerRelayState;
+            zone.coolerSwitch->refreshState(zone.coolerRelayState);
+            zone.thermostat->refreshOutputs();
+        }
+        if ((snapshot.relayFault != zone.relayFault) || (snapshot.coolerRelayFault != zone.coolerRelayFault)) {
+            zone.relayFault = snapshot.relayFault;
+            zone.coolerRelayFault = snapshot.coolerRelayFault;
+            zone.thermostat->setFault(zone.relayFault || zone.coolerRelayFault);
+            /* The control task applied the safe state, decide again from what the relays really do */
+            zone.thermostat->resyncOutputs();
+            zone.wasUpdated = true;
+        }
+
+        /* Integrate the on-time of the relay from the last state it confirmed */
+        zone.energy->update(zone.relayState == E_ESP01S_RELAY_CLOSE, now, (uint32_t)time(NULL));
+
+        /* Update current temperature every given duration but only when when you have enough readings */
+        if ((now - zone.lastUpdateTemperature) > THERMOSTAT_STATUS_UPDATE_POLLING_TIME) {
+            zone.thermostat->updateCurrentTemp();
+            zone.lastUpdateTemperature = now;
+
+            /* Learn how fast the room reacts from the same filtered temperature */
+            char key[SCHEDULE_KEY_LEN];
+            getScheduleKey(zone, key);
+            zone.preheat->addSample(zone.averageTemp, zone.thermostat->isHeating(), now);
+            zone.preheat->save(key, now);
+            zone.energy->save(key, now);
+            zone.thermostat->updateEnergy(zone.energy->getEnergyKwh());
+            zoneBootCache.update(zone.index, zone.averageTemp, zone.relayState);
+
+            /* Record the history once the wall clock is set */
+            time_t wallTime = time(NULL);
+            if (wallTime >= SCHEDULE_MIN_VALID_TIME) {
+                t_historySample sample;
+                sample.temperature = (int16_t)(zone.averageTemp * 100);
+                sample.humidity = isnan(zone.humidity) ? HISTORY_NO_HUMIDITY : (uint16_t)(zone.humidity * 10);
+                sample.setpoint = (int16_t)(zone.thermostat->getTargetTemperature() * 10);
+                sample.relayDuty = zone.thermostat->isHeating() ? 100U : 0U;
+                sample.reserved = 0U;
+                zone.history->addSample((uint32_t)wallTime, sample);
+                zone.history->flush(key, now);
+            }
+        }
+
+        /* Update state every given duration */
+        if ((now - zone.lastUpdateState) > THERMOSTAT_STATUS_UPDATE_POLLING_TIME || zone.wasUpdated) {
+            zone.thermostat->updateState();
+            zone.thermostat->updateHumidity();
+            zone.wasUpdated = false;
+            zone.lastUpdateState = now;
+        }
+
+        /* Follow the weekly schedule */
+        if ((now - zone.lastScheduleCheck) >= zone.scheduleWait) {
+            applySchedule(zone);
+        }
+    }
+
+    zoneBootCache.save(now);
+}
+
+bool ZoneTable::setSchedule(const uint8_t index, const t_schedulePeriod * const periods, const uint8_t nbPeriods) {
+
+    t_zone * zone = getZone(index);
+    char key[SCHEDULE_KEY_LEN];
+
+    if (zone == NULL) {
+        return (false);
+    }
+
+    getScheduleKey(*zone, key);
+
+    if (nbPeriods == 0U) {
+        /* Back to the default program */
+        zone->schedule->clear();
+        zone->schedule->save(key);
+        if (zone->config->schedule != NULL) {
+            (void)zone->schedule->compile(zone->config->schedule, zone->config->nbSchedulePeriods);
+        }
+    } else if (zone->schedule->compile(periods, nbPeriods) == true) {
+        zone->schedule->save(key);
+    } else {
+        return (false);
+    }
+
+    /* Apply the new program on the next pass */
+    zone->scheduleIndex = SCHEDULE_MAX_TRANSITIONS;
+    zone->schedulePreheat = false;
+    zone->scheduleWait = 0U;
+    return (true);
+}
+
+/************************************************
+ *  Private Method implementation
+ ***********************************************/
+void ZoneTable::applySchedule(t_zone & zone) {
+
+    time_t now = time(NULL);
+    struct tm local;
+    uint8_t index;
+
+    zone.lastScheduleCheck = Utils::uptime();
+    zone.scheduleWait = SCHEDULE_MAX_WAIT;
+
+    if (zone.schedule->isEmpty() || (now < SCHEDULE_MIN_VALID_TIME)) {
+        return;
+    }
+
+    localtime_r(&now, &local);
+    int16_t setpoint = zone.schedule->getSetpoint(local, &index);
+
+    uint8_t nextIndex;
+    int16_t nextSetpoint;
+    uint32_t toNext = zone.schedule->getSecondsToNext(local, &nextIndex, &nextSetpoint);
+    bool warmer = (nextSetpoint > setpoint) && (nextIndex != index);
+    bool preheat = false;
+
+    /* Optimal start: once started, a pre-heat holds even if the lead time shrinks as the room warms up.
+       Only a pre-heat holds, the clock going back over a transition (DST end, SNTP step) returns to the period before it */
+    if (warmer && ((zone.schedulePreheat && (zone.scheduleIndex == nextIndex)) ||
+                   (toNext <= zone.preheat->getLeadTime(zone.averageTemp, nextSetpoint / 10.0f)))) {
+        index = nextIndex;
+        setpoint = nextSetpoint;
+        preheat = true;
+    }
+    zone.schedulePreheat = preheat;
+
+    if (index != zone.scheduleIndex) {
+        zone.scheduleIndex = index;
+        zone.thermostat->setTargetTemperature(setpoint / 10.0f);
+        zone.wasUpdated = true;
+        WEBLOG("%s schedule setpoint = %.1f%s", zone.config->name, setpoint / 10.0f, preheat ? " (pre-heat)" : "");
+    }
+
+    /* Wake up right after the next transition, or regularly while a pre-heat may have to start */
+    uint32_t wait = toNext * 1000U;
+    if (warmer && (index != nextIndex) && (toNext <= PREHEAT_MAX_LEAD + SCHEDULE_MAX_WAIT / 1000U)) {
+        wait = PREHEAT_CHECK_PERIOD;
+    }
+    if (wait < zone.scheduleWait) {
+        zone.scheduleWait = wait;
+    }
+}
+
+void ZoneTable::getScheduleKey(const t_zone & zone, char * const key) {
+    snprintf(key, SCHEDULE_KEY_LEN, "zone%u", (unsigned int)zone.index);
+}
@@ -0,0 +1,205 @@
+#ifndef ZONE_TABLE_H
+#define ZONE_TABLE_H
+
+/************************************************
+ *  Includes
+ ***********************************************/
+#include "HomeSpan.h"
+
+/* Local files */
+#include "devices/esp01sRelay.h"
+#include "devices/remoteSensor.h"
+#include "zones/zoneControl.h"
+#include "zones/weeklySchedule.h"
+#include "zones/preheatModel.h"
+#include "zones/relayAccounting.h"
+#include "zones/humidityControl.h"
+#include "zones/climateControl.h"
+#include "zones/openWindowDetector.h"
+#include "zones/zoneBootCache.h"
+#include "history/historyStore.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Maximum number of zones hosted by a single bridge */
+#define MAX_NB_ZONES                            (32U)
+
+/** @brief Maximum time in ms between two schedule evaluations, bounds the error after a DST or clock change */
+#define SCHEDULE_MAX_WAIT                       (15 * 60 * 1000U)
+
+/** @brief Time in ms between two schedule evaluations while a pre-heat may start */
+#define PREHEAT_CHECK_PERIOD                    (5 * 60 * 1000U)
+
+/** @brief Wall clock times before this one mean NTP has not synchronized yet */
+#define SCHEDULE_MIN_VALID_TIME                 (1600000000L)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief This enum represents the possible temperature sources of a zone */
+typedef enum {
+    E_ZONE_SENSOR_LOCAL_AHT20 = 0U,     /**< AHT20 wired to the bridge I2C bus */
+    E_ZONE_SENSOR_REMOTE      = 1U      /**< Battery sensor node pushing frames over ESP-NOW */
+} t_zoneSensorSource;
+
+/** @brief Static configuration of a zone */
+typedef struct {
+    const char * name;                  /**< Room name, used as prefix of the accessory names */
+    const char * sensorSerialNum;       /**< Serial number of the temperature sensor accessory */
+    const char * thermostatSerialNum;   /**< Serial number of the thermostat accessory */
+    const char * relayIpAddress;        /**< IP address of the heating relay */
+    uint16_t relayPort;                 /**< Port of the heating relay */
+    t_esp01sRelayTransport relayTransport;  /**< HTTP or UDP relay protocol */
+    t_esp01sRelayState relaySafeState;  /**< Relay state applied when the relay stops answering */
+    t_zoneSensorSource sensorSource;    /**< Where the zone temperature comes from */
+    const char * remoteSensorMac;       /**< MAC address of the sensor node, E_ZONE_SENSOR_REMOTE only */
+    const t_schedulePeriod * schedule;  /**< Default weekly program, NULL if none */
+    uint8_t nbSchedulePeriods;          /**< Number of periods of the default program */
+    uint16_t heaterPowerW;              /**< Power of the heater driven by the relay, for the energy estimate */
+    const char * coolerRelayIpAddress;  /**< IP address of the cooling relay, NULL if the zone only heats */
+    uint16_t coolerRelayPort;           /**< Port of the cooling relay, same transport as the heating relay */
+    const char * humidityRelayIpAddress;  /**< IP address of the humidifier or dehumidifier relay, NULL if none */
+    uint16_t humidityRelayPort;         /**< Port of the humidity relay, same transport as the heating relay */
+    t_humidityMode humidityMode;        /**< Appliance driven by the humidity relay */
+    uint16_t openWindowMinutes;         /**< Heating suspension after an open window is detected, 0 disables the detector */
+} t_zoneConfig;
+
+/* HomeKit services bound to a zone */
+struct HS_TempSensor;
+struct HS_HumiditySensor;
+struct HS_WindowSensor;
+struct HS_Thermostat;
+struct HS_RelaySwitch;
+
+/** @brief Runtime record of a zone: configuration, HomeKit services and controller state */
+typedef struct {
+    const t_zoneConfig * config;        /**< Static zone configuration */
+    uint8_t index;                      /**< Zone index, shared with the control task */
+    RelayDevice * relay;                /**< Heating relay, driven by the control task */
+    RemoteSensor * remoteSensor;        /**< Sensor node, NULL for local zones */
+    WeeklySchedule * schedule;          /**< Weekly setpoint program */
+    PreheatModel * preheat;             /**< Learned heat-up rate of the room */
+    HistoryStore * history;             /**< Temperature, setpoint and relay history */
+    RelayAccounting * energy;           /**< Relay on-time and energy counters */
+    RelayDevice * coolerRelay;          /**< Cooling relay, NULL if none */
+    ClimateControl * climate;           /**< Heating and cooling decision */
+    OpenWindowDetector * openWindow;    /**< Open window detector, NULL if disabled */
+    RelayDevice * humidityRelay;        /**< Humidifier or dehumidifier relay, NULL if none */
+    HumidityControl * humidityControl;  /**< Humidity controller, NULL without humidity relay */
+    HS_TempSensor * sensor;             /**< Temperature sensor service */
+    HS_HumiditySensor * humiditySensor; /**< Humidity sensor service */
+    HS_WindowSensor * windowSensor;     /**< Open window contact service, NULL if the detector is disabled */
+    HS_Thermostat * thermostat;         /**< Thermostat service */
+    HS_RelaySwitch * relaySwitch;       /**< Relay switch service */
+    HS_RelaySwitch * coolerSwitch;      /**< Cooling relay switch service, NULL without cooling relay */
+    HS_RelaySwitch * humiditySwitch;    /**< Humidity relay switch service, NULL without humidity relay */
+    float averageTemp;                  /**< Exponentially averaged temperature, copied from the control snapshot */
+    float humidity;                     /**< Relative humidity of the last snapshot, NAN if unknown */
+    uint32_t nbReadings;                /**< Readout count of the last snapshot */
+    t_esp01sRelayState relayState;      /**< Confirmed relay state of the last snapshot */
+    bool relayFault;                    /**< Relay fault of the last snapshot */
+    t_esp01sRelayState coolerRelayState;    /**< Confirmed cooling relay state of the last snapshot */
+    bool coolerRelayFault;              /**< Cooling relay fault of the last snapshot */
+    t_esp01sRelayState humidityRelayState;  /**< Confirmed humidity relay state of the last snapshot */
+    bool wasUpdated;                    /**< Set when the user updated the thermostat from HomeKit */
+    uint64_t lastUpdateTemperature;     /**< Utils::uptime() of the last current temperature update */
+    uint64_t lastUpdateState;           /**< Utils::uptime() of the last thermostat state update */
+    uint64_t lastScheduleCheck;         /**< Utils::uptime() of the last schedule evaluation */
+    uint64_t scheduleWait;              /**< Time in ms until the next schedule evaluation */
+    uint8_t scheduleIndex;              /**< Index of the last applied schedule transition */
+    bool schedulePreheat;               /**< Set while scheduleIndex was applied ahead of its start time */
+} t_zone;
+
+/************************************************
+ *  Class definition
+ ***********************************************/
+/**
+ * @brief Zone table class definition.
+ * @details
+ *  This class holds every zone of the bridge in a contiguous table and runs
+ *  the HomeKit side of all zones in a single scheduler pass, from the HomeSpan
+ *  poll task. Sensors and relays are only accessed by the control task, see
+ *  ZoneControl.
+ */
+class ZoneTable {
+private:
+    /** @brief Zone records */
+    t_zone zones[MAX_NB_ZONES];
+
+    /** @brief Number of zones in use */
+    uint8_t nbZones;
+
+    /**
+     * @brief Apply the weekly schedule of a zone
+     * @details
+     *  The target temperature is only changed when a new transition becomes
+     *  active, so manual changes from HomeKit hold until the next transition.
+     *  A warmer transition is applied ahead of time, by the lead time the
+     *  pre-heat model needs to reach it on schedule.
+     *
+     * @param zone          Zone to update
+     */
+    void applySchedule(t_zone & zone);
+
+    /** @brief Get the NVS key of a zone, shared by the schedule and the pre-heat model */
+    void getScheduleKey(const t_zone & zone, char * const key);
+
+public:
+    /** @brief Constructor */
+    ZoneTable() : nbZones(0U) {};
+
+    /**
+     * @brief Add a zone
+     * @details
+     *  This method creates the temperature sensor, thermostat and relay switch
+     *  accessories of the zone. It must be called after homeSpan.begin().
+     *  Nothing blocks on the sensor or the relay: the accessories start from
+     *  the values cached in NVS and the control task discovers the devices.
+     *
+     * @param config        Zone configuration, must remain valid
+     *
+     * @return Zone record, or NULL if the table is full
+     */
+    t_zone * addZone(const t_zoneConfig * const config);
+
+    /**
+     * @brief Start the control task
+     * @details
+     *  This method must be called once all zones are added.
+     */
+    void begin(void);
+
+    /**
+     * @brief Run one scheduler pass
+     * @details
+     *  This method must be called from the HomeSpan poll task, see
+     *  Span::setPollCallback(). It updates every zone that is due.
+     */
+    void run(void);
+
+    /**
+     * @brief Program the weekly schedule of a zone
+     * @details
+     *  The compiled program is saved in NVS and survives reboots. Without
+     *  periods, the saved program is erased and the default one is restored.
+     *
+     * @param index         Zone index
+     * @param periods       Setpoint periods
+     * @param nbPeriods     Number of periods
+     *
+     * @return true         If the program was accepted
+     */
+    bool setSchedule(const uint8_t index, const t_schedulePeriod * const periods, const uint8_t nbPeriods);
+
+    /** @brief Get the number of zones */
+    uint8_t getNbZones(void) { return (nbZones); }
+
+    /** @brief Get a zone record, or NULL if index is out of range */
+    t_zone * getZone(const uint8_t index) { return (index < nbZones ? &zones[index] : NULL); }
+};
+
+/** @brief Zone table of the bridge */
+extern ZoneTable zoneTable;
+
+#endif /* ZONE_TABLE_H */
@@ -0,0 +1,177 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <set>
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+#include "spanTestAccess.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Zones of the measured bridge */
+#define NB_ZONES                                (4U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief SpanCharacteristic fields before the shared ranges and packed flags, in their order then */
+typedef struct {
+    int iid;
+    const HapChar * hapChar;
+    const char * type;
+    const char * hapName;
+    uint64_t value;
+    uint8_t perms;
+    FORMAT format;
+    char * desc;
+    char * unit;
+    uint64_t minValue;
+    uint64_t maxValue;
+    uint64_t stepValue;
+    boolean staticRange;
+    boolean customRange;
+    char * validValues;                 /**< JSON array, built with String */
+    boolean * ev;                       /**< maxConnections entries */
+    char * nvsKey;
+    boolean isCustom;
+    boolean setRangeError;
+    boolean setValidValuesError;
+    uint32_t aid;
+    boolean isUpdated;
+    uint64_t updateTime;
+    uint64_t newValue;
+    void * service;
+} t_legacyCharacteristic;
+
+/** @brief Memory of the characteristics of the bridge, one layout */
+typedef struct {
+    size_t objects;                     /**< The characteristic objects */
+    size_t heap;                        /**< Bytes allocated by each characteristic */
+    size_t shared;                      /**< Range descriptors shared by all */
+    size_t blocks;                      /**< Number of heap blocks, objects excluded */
+} t_layoutFootprint;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static t_zoneConfig configs[NB_ZONES];
+static char names[NB_ZONES][16];
+
+/** @brief Range descriptors pooled once the first zone is added */
+static size_t firstZoneRanges;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static t_layoutFootprint legacyFootprint(const std::vector<SpanCharacteristic *> & all) {
+    t_layoutFootprint footprint = {};
+
+    for (SpanCharacteristic * c : all) {
+        t_spanCharacteristicExtras extras = SpanTestAccess::extras(c);
+
+        footprint.objects += sizeof(t_legacyCharacteristic);
+        footprint.heap += SpanTestAccess::maxConnections() * sizeof(boolean) + extras.stringBytes;
+        footprint.blocks++;
+        if (extras.nbValidValues > 0U) {
+            footprint.heap += extras.validValuesJsonLen + 1U;
+            footprint.blocks++;
+        }
+    }
+
+    return (footprint);
+}
+
+static t_layoutFootprint compactFootprint(const std::vector<SpanCharacteristic *> & all) {
+    t_layoutFootprint footprint = {};
+
+    for (SpanCharacteristic * c : all) {
+        t_spanCharacteristicExtras extras = SpanTestAccess::extras(c);
+
+        footprint.objects += sizeof(SpanCharacteristic);
+        footprint.heap += extras.stringBytes;
+        if (extras.nbValidValues > 0U) {
+            footprint.heap += extras.nbValidValues * sizeof(int32_t);
+            footprint.blocks++;
+        }
+    }
+    footprint.shared = SpanTestAccess::rangePoolSize() * SpanTestAccess::rangeSize();
+    footprint.blocks += SpanTestAccess::rangePoolSize();
+
+    return (footprint);
+}
+
+static size_t total(const t_layoutFootprint & footprint) {
+    return (footprint.objects + footprint.heap + footprint.shared);
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* Bytes per characteristic before and after, on this host: pointers are twice the ESP32 size */
+void test_bytes_per_characteristic(void) {
+    std::vector<SpanCharacteristic *> all = SpanTestAccess::characteristics();
+    size_t n = all.size();
+    TEST_ASSERT_GREATER_THAN_UINT32(NB_ZONES * 10U, n);
+
+    t_layoutFootprint before = legacyFootprint(all);
+    t_layoutFootprint after = compactFootprint(all);
+
+    printf("%u characteristics, %u shared ranges, %u HAP connections\n", (unsigned int)n,
+           (unsigned int)SpanTestAccess::rangePoolSize(), (unsigned int)SpanTestAccess::maxConnections());
+    printf("bytes per characteristic   before   after\n");
+    printf("  object                  %7.1f %7.1f\n", (double)before.objects / n, (double)after.objects / n);
+    printf("  own heap                %7.1f %7.1f\n", (double)before.heap / n, (double)after.heap / n);
+    printf("  shared ranges           %7.1f %7.1f\n", (double)before.shared / n, (double)after.shared / n);
+    printf("  total                   %7.1f %7.1f\n", (double)total(before) / n, (double)total(after) / n);
+    printf("  heap blocks             %7.2f %7.2f\n", (double)before.blocks / n, (double)after.blocks / n);
+
+    TEST_ASSERT_LESS_THAN_UINT32(sizeof(t_legacyCharacteristic), sizeof(SpanCharacteristic));
+    TEST_ASSERT_LESS_THAN_UINT32(total(before), total(after));
+    TEST_ASSERT_LESS_THAN_UINT32(before.blocks, after.blocks);
+}
+
+/* Characteristics with the same range share one descriptor, more zones add no range to the pool */
+void test_ranges_shared(void) {
+    std::set<const void *> used;
+
+    for (SpanCharacteristic * c : SpanTestAccess::characteristics()) {
+        used.insert(SpanTestAccess::extras(c).range);
+    }
+    used.erase(NULL);
+
+    /* Descriptors replaced by setRange() stay pooled */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(SpanTestAccess::rangePoolSize(), used.size());
+    TEST_ASSERT_EQUAL_UINT32(firstZoneRanges, SpanTestAccess::rangePoolSize());
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    testBenchBegin();
+    for (uint32_t i = 0U; i < NB_ZONES; i++) {
+        snprintf(names[i], sizeof(names[i]), "Room %u", (unsigned int)(i + 1U));
+        configs[i] = testBenchZoneConfig(names[i], 80U);
+        if (zoneTable.addZone(&configs[i]) == NULL) {
+            return (1);
+        }
+        if (i == 0U) {
+            firstZoneRanges = SpanTestAccess::rangePoolSize();
+        }
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_bytes_per_characteristic);
+    RUN_TEST(test_ranges_shared);
+    return (UNITY_END());
+}
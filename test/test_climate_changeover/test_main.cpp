@@ -0,0 +1,319 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+/* The custom characteristics are defined by zoneTable.cpp, only declared here */
+#define CUSTOM_CHAR_HEADER
+#include <unity.h>
+#include <math.h>
+
+/* Local files */
+#include "testBench.h"
+#include "zones/climateControl.h"
+#include "homeKitAccessories/thermostat.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Step of the room simulator, the zone scheduler runs in between */
+#define ROOM_STEP                               (10U * 1000U)
+
+/** @brief Milliseconds in an hour */
+#define HOUR                                    (3600U * 1000U)
+
+/** @brief Time for the filtered temperature to catch up with the room after a start */
+#define WARMUP_TIME                             (2U * HOUR)
+
+/** @brief Margin in °C around the thresholds, for the hysteresis, the sensor filter and the room inertia */
+#define CONTROL_MARGIN                          (0.6f)
+
+/** @brief Thermostat state refresh period, from homeKitAccessories/thermostat.h which defines characteristics */
+#define THERMOSTAT_REFRESH_TIME                 (30U * 1000U)
+
+/** @brief Time the relays are watched after a reboot of the thermostat */
+#define REBOOT_WATCH_TIME                       (HOUR / 2U)
+
+/** @brief Time to bring both relays back to open between tests */
+#define SETTLE_TIMEOUT                          (5U * 60U * 1000U)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief What the relays did during a simulation */
+typedef struct {
+    uint32_t heatStarts;                /**< Heating relay closings */
+    uint32_t coolStarts;                /**< Cooling relay closings */
+    uint32_t changeovers;               /**< Starts of the other output than the last one that ran */
+    uint64_t minChangeoverGap;          /**< Shortest time between an output stopping and the other starting, ms */
+    bool overlap;                       /**< Both relays closed at once */
+    float minTemperature;               /**< Coldest room after the warmup, °C */
+    float maxTemperature;               /**< Warmest room after the warmup, °C */
+    float minCoolStart;                 /**< Coldest room when cooling started, °C */
+    float maxHeatStart;                 /**< Warmest room when heating started, °C */
+} t_changeoverLog;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay heater;
+static FakeRelay cooler;
+static RoomSimulator room(testBenchSensor(), heater, &cooler);
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void write(const HapChar & type, const float value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%.1f", value);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, type, text));
+}
+
+/** @brief Run the room and the zone together, logging what the relays do */
+static t_changeoverLog simulate(const uint32_t ms) {
+    t_changeoverLog log = {0U, 0U, 0U, UINT64_MAX, false, 100.0f, -100.0f, 100.0f, -100.0f};
+    t_climateOutput running = E_CLIMATE_IDLE;
+    t_climateOutput lastActive = E_CLIMATE_IDLE;
+    uint64_t lastStop = 0U;
+
+    for (uint32_t t = 0U; t < ms; t += ROOM_STEP) {
+        room.step(ROOM_STEP);
+        testBenchRun(ROOM_STEP);
+
+        bool heating = (heater.getState() == E_ESP01S_RELAY_CLOSE);
+        bool cooling = (cooler.getState() == E_ESP01S_RELAY_CLOSE);
+        t_climateOutput now = heating ? E_CLIMATE_HEAT : (cooling ? E_CLIMATE_COOL : E_CLIMATE_IDLE);
+        log.overlap |= (heating && cooling);
+
+        if (now != running) {
+            if (running != E_CLIMATE_IDLE) {
+                lastActive = running;
+                lastStop = room.getElapsed();
+            }
+            if (now == E_CLIMATE_HEAT) {
+                log.heatStarts++;
+                log.maxHeatStart = fmaxf(log.maxHeatStart, room.getTemperature());
+            } else if (now == E_CLIMATE_COOL) {
+                log.coolStarts++;
+                log.minCoolStart = fminf(log.minCoolStart, room.getTemperature());
+            }
+            if ((now != E_CLIMATE_IDLE) && (lastActive != E_CLIMATE_IDLE) && (now != lastActive)) {
+                log.changeovers++;
+                log.minChangeoverGap = (room.getElapsed() - lastStop < log.minChangeoverGap) ? room.getElapsed() - lastStop : log.minChangeoverGap;
+            }
+            running = now;
+        }
+
+        if (t >= WARMUP_TIME) {
+            log.minTemperature = fminf(log.minTemperature, room.getTemperature());
+            log.maxTemperature = fmaxf(log.maxTemperature, room.getTemperature());
+        }
+    }
+
+    return (log);
+}
+
+/**
+ * @brief Reboot the thermostat accessory
+ * @details
+ *  The accessory is deleted and created again as zoneTable.addZone() does, with
+ *  the same characteristics in the same order so their IDs and NVS keys match.
+ *  Persisted characteristics come back from NVS, the relays keep their state.
+ */
+static void rebootThermostat(void) {
+    TEST_ASSERT_TRUE(homeSpan.deleteAccessory(TEST_BENCH_AID_THERMOSTAT));
+
+    new SpanAccessory(TEST_BENCH_AID_THERMOSTAT);
+        new Service::AccessoryInformation();
+            new Characteristic::Name("Changeover Thermostat");
+            new Characteristic::Manufacturer("Test");
+            new Characteristic::Model("Test");
+            new Characteristic::SerialNumber("0");
+            new Characteristic::FirmwareRevision("0");
+            new Characteristic::Identify();
+        zone->thermostat = new HS_Thermostat(zone);
+}
+
+/** @brief Whether a relay stays closed for a while, the room and the zone running */
+static bool staysClosed(FakeRelay & relay, const uint32_t ms) {
+    for (uint32_t t = 0U; t < ms; t += ROOM_STEP) {
+        room.step(ROOM_STEP);
+        testBenchRun(ROOM_STEP);
+        if (relay.getState() != E_ESP01S_RELAY_CLOSE) {
+            return (false);
+        }
+    }
+    return (true);
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+/* Thermostat off and both relays open, whatever the previous test left */
+void setUp(void) {
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "0"));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (heater.getState() == E_ESP01S_RELAY_OPEN) &&
+                                                                      (cooler.getState() == E_ESP01S_RELAY_OPEN); },
+                                                        SETTLE_TIMEOUT));
+}
+
+void tearDown(void) {
+}
+
+/* Hot days and cold nights in AUTO: heats at night, cools in the afternoon, each changeover once and after the lockout */
+void test_auto_daily_changeover(void) {
+    room.begin({21.0f, 22.0f, 10.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.HeatingThresholdTemperature, 20.0f);
+    write(hapChars.CoolingThresholdTemperature, 24.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "3"));
+
+    t_changeoverLog log = simulate(48U * HOUR);
+    printf("heat starts %u, cool starts %u, changeovers %u, shortest gap %u s, room %.2f..%.2f °C\n",
+           (unsigned int)log.heatStarts, (unsigned int)log.coolStarts, (unsigned int)log.changeovers,
+           (unsigned int)(log.minChangeoverGap / 1000U), log.minTemperature, log.maxTemperature);
+
+    TEST_ASSERT_FALSE(log.overlap);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, log.heatStarts);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, log.coolStarts);
+    /* One heat to cool and one cool to heat changeover a day */
+    TEST_ASSERT_UINT32_WITHIN(1U, 4U, log.changeovers);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(CLIMATE_CHANGEOVER_LOCKOUT, log.minChangeoverGap);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(20.0f - CONTROL_MARGIN, log.minTemperature);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(24.0f + CONTROL_MARGIN, log.maxTemperature);
+}
+
+/* Thresholds inside the deadband: cooling waits for the heating threshold plus the deadband, the room drifting in between flips nothing */
+void test_auto_deadband_enforced(void) {
+    room.begin({21.5f, 21.5f, 3.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.HeatingThresholdTemperature, 21.0f);
+    write(hapChars.CoolingThresholdTemperature, 21.5f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "3"));
+
+    t_changeoverLog log = simulate(48U * HOUR);
+    printf("heat starts %u, cool starts %u, changeovers %u, heat start <= %.2f °C, cool start >= %.2f °C\n",
+           (unsigned int)log.heatStarts, (unsigned int)log.coolStarts, (unsigned int)log.changeovers,
+           log.maxHeatStart, log.minCoolStart);
+
+    TEST_ASSERT_FALSE(log.overlap);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, log.coolStarts);
+    TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(21.0f + CLIMATE_MIN_DEADBAND, log.minCoolStart);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(21.0f, log.maxHeatStart);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(4U, log.changeovers);
+    if (log.changeovers > 0U) {
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT64(CLIMATE_CHANGEOVER_LOCKOUT, log.minChangeoverGap);
+    }
+}
+
+/* COOL mode never heats, however cold the room gets, and holds the target once it is hot */
+void test_cool_mode_never_heats(void) {
+    room.begin({20.0f, 12.0f, 2.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.TargetTemperature, 23.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "2"));
+
+    t_changeoverLog log = simulate(12U * HOUR);
+    TEST_ASSERT_EQUAL_UINT32(0U, log.heatStarts);
+    TEST_ASSERT_EQUAL_UINT32(0U, log.coolStarts);
+
+    room.begin({26.0f, 30.0f, 2.0f, 4.0f, 3.0f, 3.0f});
+    log = simulate(12U * HOUR);
+    TEST_ASSERT_EQUAL_UINT32(0U, log.heatStarts);
+    TEST_ASSERT_GREATER_THAN_UINT32(0U, log.coolStarts);
+    TEST_ASSERT_FALSE(log.overlap);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(23.0f + CLIMATE_MANUAL_HYSTERESIS + CONTROL_MARGIN, log.maxTemperature);
+}
+
+/* Switching from HEAT to COOL while heating: the heater stops at once, the cooler starts only after the lockout */
+void test_mode_switch_lockout(void) {
+    room.begin({23.0f, 28.0f, 0.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.TargetTemperature, 26.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "1"));
+    (void)simulate(HOUR / 2U);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, heater.getState());
+
+    write(hapChars.TargetTemperature, 22.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "2"));
+    uint64_t switched = room.getElapsed();
+    uint64_t heaterStopped = UINT64_MAX;
+    uint64_t coolerStarted = UINT64_MAX;
+
+    for (uint32_t t = 0U; (t < HOUR) && (coolerStarted == UINT64_MAX); t += ROOM_STEP) {
+        room.step(ROOM_STEP);
+        testBenchRun(ROOM_STEP);
+        if ((heaterStopped == UINT64_MAX) && (heater.getState() == E_ESP01S_RELAY_OPEN)) {
+            heaterStopped = room.getElapsed();
+        }
+        if (cooler.getState() == E_ESP01S_RELAY_CLOSE) {
+            TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, heater.getState());
+            coolerStarted = room.getElapsed();
+        }
+    }
+
+    TEST_ASSERT_NOT_EQUAL(UINT64_MAX, heaterStopped);
+    TEST_ASSERT_NOT_EQUAL(UINT64_MAX, coolerStarted);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(2U * ROOM_STEP + 2U * THERMOSTAT_REFRESH_TIME, heaterStopped - switched);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(CLIMATE_CHANGEOVER_LOCKOUT, coolerStarted - heaterStopped);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT64(CLIMATE_CHANGEOVER_LOCKOUT + 2U * ROOM_STEP + 2U * THERMOSTAT_REFRESH_TIME,
+                                     coolerStarted - heaterStopped);
+}
+
+/* A reboot in AUTO while heating keeps AUTO and the thresholds, the heater keeps running */
+void test_reboot_keeps_auto(void) {
+    room.begin({17.0f, 5.0f, 0.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.HeatingThresholdTemperature, 20.0f);
+    write(hapChars.CoolingThresholdTemperature, 24.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "3"));
+    (void)simulate(HOUR / 2U);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, heater.getState());
+
+    rebootThermostat();
+    TEST_ASSERT_EQUAL_INT(E_THERMOSTAT_STATE_AUTO, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState)->getVal());
+    TEST_ASSERT_EQUAL_FLOAT(20.0f, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.HeatingThresholdTemperature)->getVal<float>());
+    TEST_ASSERT_EQUAL_FLOAT(24.0f, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.CoolingThresholdTemperature)->getVal<float>());
+    TEST_ASSERT_TRUE(staysClosed(heater, REBOOT_WATCH_TIME));
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, cooler.getState());
+}
+
+/* A reboot in COOL while cooling keeps COOL, the heater being open does not turn the thermostat off */
+void test_reboot_keeps_cool(void) {
+    room.begin({27.0f, 32.0f, 0.0f, 4.0f, 3.0f, 3.0f});
+    write(hapChars.TargetTemperature, 23.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "2"));
+    (void)simulate(HOUR / 2U);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, cooler.getState());
+
+    rebootThermostat();
+    TEST_ASSERT_EQUAL_INT(E_THERMOSTAT_STATE_COOL, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState)->getVal());
+    TEST_ASSERT_TRUE(staysClosed(cooler, REBOOT_WATCH_TIME));
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, heater.getState());
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    heater.begin();
+    cooler.begin();
+    room.begin({20.0f, 20.0f, 0.0f, 4.0f, 3.0f, 3.0f});
+    testBenchBegin();
+    config = testBenchZoneConfig("Changeover", heater.getPort());
+    config.coolerRelayIpAddress = "127.0.0.1";
+    config.coolerRelayPort = cooler.getPort();
+    zone = zoneTable.addZone(&config);
+    if (zone == NULL) {
+        return (1);
+    }
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_auto_daily_changeover);
+    RUN_TEST(test_auto_deadband_enforced);
+    RUN_TEST(test_cool_mode_never_heats);
+    RUN_TEST(test_mode_switch_lockout);
+    RUN_TEST(test_reboot_keeps_auto);
+    RUN_TEST(test_reboot_keeps_cool);
+    int failures = UNITY_END();
+
+    heater.end();
+    cooler.end();
+    return (failures);
+}
@@ -0,0 +1,332 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <math.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+#include "history/historyExport.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Seconds between two raw samples, as recorded by the zone scheduler */
+#define RAW_SAMPLE_PERIOD                       (30U)
+
+/** @brief Recorded days, the depth of the 1-hour tier */
+#define RECORDED_DAYS                           (31U)
+
+/** @brief First sample, 2026-01-01 00:00 UTC */
+#define RECORD_START                            (1767225600U)
+
+/** @brief End of the recording */
+#define RECORD_END                              (RECORD_START + RECORDED_DAYS * 24U * 3600U)
+
+/** @brief Exports of each format in the throughput test */
+#define THROUGHPUT_RUNS                         (200U)
+
+/** @brief Lowest export rate accepted on the host, in samples per second */
+#define THROUGHPUT_MIN_SAMPLES                  (100000.0)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Response of one export, chunked transfer decoded */
+typedef struct {
+    std::string head;                   /**< Status line and headers */
+    std::string body;                   /**< Body, chunks joined */
+    std::vector<size_t> chunks;         /**< Size of every chunk */
+    bool complete;                      /**< Ended with the last chunk */
+} t_exportResponse;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Serve one export to a socket pair, the test reading the other end */
+static std::string exportRaw(const char * const args) {
+    int fds[2];
+    std::string raw;
+
+    TEST_ASSERT_EQUAL(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+    std::thread reader([&raw, fds]() {
+        char buf[4096];
+        ssize_t n;
+        while ((n = recv(fds[1], buf, sizeof(buf), 0)) > 0) {
+            raw.append(buf, (size_t)n);
+        }
+        close(fds[1]);
+    });
+
+    {
+        WiFiClient client(fds[0]);
+        historyExport(client, args);
+        client.stop();
+    }
+    reader.join();
+
+    return (raw);
+}
+
+static t_exportResponse exportHistory(const char * const args) {
+    std::string raw = exportRaw(args);
+    t_exportResponse response = {};
+    size_t end = raw.find("\r\n\r\n");
+
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, end);
+    response.head = raw.substr(0U, end + 2U);
+    size_t pos = end + 4U;
+
+    while (pos < raw.size()) {
+        size_t eol = raw.find("\r\n", pos);
+        TEST_ASSERT_NOT_EQUAL(std::string::npos, eol);
+        size_t len = strtoul(raw.substr(pos, eol - pos).c_str(), NULL, 16);
+        pos = eol + 2U;
+        if (len == 0U) {
+            response.complete = (raw.compare(pos, std::string::npos, "\r\n") == 0);
+            break;
+        }
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(raw.size(), pos + len + 2U);
+        response.body.append(raw, pos, len);
+        response.chunks.push_back(len);
+        pos += len + 2U;
+    }
+
+    return (response);
+}
+
+static uint32_t getVarint(const std::string & data, size_t & pos) {
+    uint32_t value = 0U;
+    uint8_t shift = 0U;
+    uint8_t byte;
+
+    do {
+        TEST_ASSERT_LESS_THAN_UINT32(data.size(), pos);
+        byte = (uint8_t)data[pos++];
+        value |= (uint32_t)(byte & 0x7FU) << shift;
+        shift += 7U;
+    } while (byte >= 0x80U);
+
+    return (value);
+}
+
+static int32_t getZigzag(const std::string & data, size_t & pos) {
+    uint32_t value = getVarint(data, pos);
+    return ((int32_t)(value >> 1) ^ -(int32_t)(value & 1U));
+}
+
+/** @brief Host-side decoder of the binary format, the C++ twin of tools/historyDecode.py */
+static std::vector<t_historyPoint> decodeBinary(const std::string & data, uint32_t * const zoneIndex) {
+    std::vector<t_historyPoint> points;
+    t_historyPoint point = {};
+    size_t pos = strlen(HISTORY_EXPORT_MAGIC);
+
+    TEST_ASSERT_EQUAL(0, data.compare(0U, pos, HISTORY_EXPORT_MAGIC));
+    *zoneIndex = getVarint(data, pos);
+    uint32_t period = getVarint(data, pos);
+
+    while (pos < data.size()) {
+        point.time += getVarint(data, pos) * period;
+        point.sample.temperature += getZigzag(data, pos);
+        point.sample.humidity += getZigzag(data, pos);
+        point.sample.setpoint += getZigzag(data, pos);
+        TEST_ASSERT_LESS_THAN_UINT32(data.size(), pos);
+        point.sample.relayDuty = (uint8_t)data[pos++];
+        points.push_back(point);
+    }
+
+    return (points);
+}
+
+static bool collectPoint(const t_historyPoint & point, void * arg) {
+    ((std::vector<t_historyPoint> *)arg)->push_back(point);
+    return (true);
+}
+
+/** @brief What the store holds, the reference of every export */
+static std::vector<t_historyPoint> stored(const t_historyTier tier, const uint32_t from, const uint32_t to) {
+    std::vector<t_historyPoint> points;
+    (void)zone->history->query(tier, from, to, collectPoint, &points);
+    return (points);
+}
+
+static void assertSamePoints(const std::vector<t_historyPoint> & expected, const std::vector<t_historyPoint> & actual) {
+    TEST_ASSERT_EQUAL_UINT32(expected.size(), actual.size());
+    for (size_t i = 0U; i < expected.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].time, actual[i].time);
+        TEST_ASSERT_EQUAL_INT16(expected[i].sample.temperature, actual[i].sample.temperature);
+        TEST_ASSERT_EQUAL_UINT16(expected[i].sample.humidity, actual[i].sample.humidity);
+        TEST_ASSERT_EQUAL_INT16(expected[i].sample.setpoint, actual[i].sample.setpoint);
+        TEST_ASSERT_EQUAL_UINT8(expected[i].sample.relayDuty, actual[i].sample.relayDuty);
+    }
+}
+
+/** @brief Record the zone for RECORDED_DAYS: day and night setpoints, a relay with 0.3 °C hysteresis */
+static void record(void) {
+    int16_t temperature = 1800;
+    bool heating = false;
+
+    for (uint32_t time = RECORD_START; time < RECORD_END; time += RAW_SAMPLE_PERIOD) {
+        uint32_t hour = (time % (24U * 3600U)) / 3600U;
+        t_historySample sample;
+
+        sample.setpoint = ((hour >= 7U) && (hour < 22U)) ? 190 : 160;
+        if (temperature < sample.setpoint * 10 - 30) {
+            heating = true;
+        } else if (temperature > sample.setpoint * 10 + 30) {
+            heating = false;
+        }
+        temperature += heating ? 2 : -1;
+
+        sample.temperature = temperature;
+        /* Humidity unknown from 20:00 to 22:00 on the last day, a period every tier still holds */
+        sample.humidity = ((time >= RECORD_END - 4U * 3600U) && (time < RECORD_END - 2U * 3600U)) ? HISTORY_NO_HUMIDITY :
+                          (uint16_t)(450U + hour * 5U);
+        sample.relayDuty = heating ? 100U : 0U;
+        sample.reserved = 0U;
+        zone->history->addSample(time, sample);
+    }
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* The CSV export has one row per stored sample, with the values of the store */
+void test_csv_matches_store(void) {
+    t_exportResponse response = exportHistory("?zone=0&tier=1h&format=csv HTTP/1.1");
+    std::vector<t_historyPoint> expected = stored(E_HISTORY_TIER_1HOUR, 0U, UINT32_MAX);
+
+    TEST_ASSERT_EQUAL(0, response.head.compare(0U, strlen("HTTP/1.1 200 OK"), "HTTP/1.1 200 OK"));
+    TEST_ASSERT_NOT_EQUAL(std::string::npos, response.head.find("Content-Type: text/csv"));
+    TEST_ASSERT_TRUE(response.complete);
+
+    const char * line = response.body.c_str();
+    TEST_ASSERT_EQUAL(0, strncmp(line, "time,temperature,humidity,setpoint,relay_duty\n", 46));
+    line = strchr(line, '\n') + 1;
+
+    std::vector<t_historyPoint> actual;
+    while (*line != '\0') {
+        t_historyPoint point = {};
+        char * field;
+        point.time = strtoul(line, &field, 10);
+        point.sample.temperature = (int16_t)lroundf(strtof(field + 1, &field) * 100.0f);
+        point.sample.humidity = (field[1] == ',') ? HISTORY_NO_HUMIDITY : (uint16_t)lroundf(strtof(field + 1, &field) * 10.0f);
+        if (point.sample.humidity == HISTORY_NO_HUMIDITY) {
+            field++;
+        }
+        point.sample.setpoint = (int16_t)lroundf(strtof(field + 1, &field) * 10.0f);
+        point.sample.relayDuty = (uint8_t)strtoul(field + 1, &field, 10);
+        TEST_ASSERT_EQUAL_CHAR('\n', *field);
+        actual.push_back(point);
+        line = field + 1;
+    }
+    assertSamePoints(expected, actual);
+}
+
+/* The binary export decodes back to the stored samples, in every tier, with unknown humidity kept */
+void test_binary_round_trip(void) {
+    static const char * const tiers[E_HISTORY_NB_TIERS] = {"1m", "15m", "1h"};
+
+    for (uint8_t tier = 0U; tier < E_HISTORY_NB_TIERS; tier++) {
+        char args[64];
+        uint32_t zoneIndex;
+        snprintf(args, sizeof(args), "?tier=%s&format=bin HTTP/1.1", tiers[tier]);
+
+        t_exportResponse response = exportHistory(args);
+        TEST_ASSERT_NOT_EQUAL(std::string::npos, response.head.find("Content-Type: application/octet-stream"));
+        TEST_ASSERT_TRUE(response.complete);
+        assertSamePoints(stored((t_historyTier)tier, 0U, UINT32_MAX), decodeBinary(response.body, &zoneIndex));
+        TEST_ASSERT_EQUAL_UINT32(0U, zoneIndex);
+    }
+}
+
+/* from and to are inclusive, an unknown zone is not found */
+void test_range_and_unknown_zone(void) {
+    uint32_t from = RECORD_START + 10U * 24U * 3600U;
+    uint32_t to = from + 24U * 3600U;
+    char args[96];
+    uint32_t zoneIndex;
+
+    snprintf(args, sizeof(args), "?zone=0&tier=1h&from=%u&to=%u&format=bin HTTP/1.1", (unsigned int)from, (unsigned int)to);
+    std::vector<t_historyPoint> points = decodeBinary(exportHistory(args).body, &zoneIndex);
+    TEST_ASSERT_EQUAL_UINT32(25U, points.size());
+    TEST_ASSERT_EQUAL_UINT32(from, points.front().time);
+    TEST_ASSERT_EQUAL_UINT32(to, points.back().time);
+
+    std::string raw = exportRaw("?zone=7 HTTP/1.1");
+    TEST_ASSERT_EQUAL(0, raw.compare(0U, strlen("HTTP/1.1 404"), "HTTP/1.1 404"));
+}
+
+/* Constant memory: whatever the range, no chunk is larger than the export buffer */
+void test_chunks_bounded(void) {
+    const char * const formats[] = {"?tier=1m&format=csv HTTP/1.1", "?tier=1m&format=bin HTTP/1.1"};
+
+    for (const char * args : formats) {
+        t_exportResponse response = exportHistory(args);
+        TEST_ASSERT_GREATER_THAN_UINT32(1U, response.chunks.size());
+        for (size_t len : response.chunks) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(HISTORY_EXPORT_CHUNK_LEN, len);
+        }
+    }
+}
+
+/* Samples and bytes per second of 30 days exports, both formats */
+void test_export_throughput(void) {
+    const char * const formats[] = {"csv", "bin"};
+    size_t nbSamples = stored(E_HISTORY_TIER_1HOUR, 0U, UINT32_MAX).size();
+
+    for (const char * format : formats) {
+        char args[64];
+        size_t bytes = 0U;
+        snprintf(args, sizeof(args), "?tier=1h&format=%s HTTP/1.1", format);
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t run = 0U; run < THROUGHPUT_RUNS; run++) {
+            bytes += exportRaw(args).size();
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        double samplesPerSecond = THROUGHPUT_RUNS * nbSamples / seconds;
+        printf("%s: %u samples, %.1f bytes per sample, %.0f samples/s, %.1f MB/s\n", format, (unsigned int)nbSamples,
+               (double)bytes / THROUGHPUT_RUNS / nbSamples, samplesPerSecond, bytes / seconds / 1e6);
+        TEST_ASSERT_GREATER_THAN_DOUBLE(THROUGHPUT_MIN_SAMPLES, samplesPerSecond);
+    }
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    testBenchBegin();
+    config = testBenchZoneConfig("Export", 80U);
+    zone = zoneTable.addZone(&config);
+    if (zone == NULL) {
+        return (1);
+    }
+    record();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_csv_matches_store);
+    RUN_TEST(test_binary_round_trip);
+    RUN_TEST(test_range_and_unknown_zone);
+    RUN_TEST(test_chunks_bounded);
+    RUN_TEST(test_export_throughput);
+    return (UNITY_END());
+}
@@ -0,0 +1,186 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+#include "spanTestAccess.h"
+#include "devices/deviceInfo.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief millis() period, 49.7 days */
+#define MILLIS_WRAP                             (1ULL << 32)
+
+/** @brief Wrap points crossed by each test, about 150 days of uptime */
+#define NB_WRAPS                                (3U)
+
+/** @brief Time simulated on each side of a wrap point */
+#define WRAP_WINDOW                             (2U * 60U * 1000U)
+
+/** @brief Sensor offset removed by TempHumSensor */
+#define SENSOR_CALIBRATION                      (1.5f)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay relay;
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static t_zoneSnapshot snapshot(void) {
+    t_zoneSnapshot current;
+    zoneControl.getSnapshot(zone->index, &current);
+    return (current);
+}
+
+/** @brief Instance ID of a characteristic of the thermostat */
+static int thermostatIid(const SpanCharacteristic * const target) {
+    for (int iid = 1; iid <= 64; iid++) {
+        if (SpanTestAccess::find(TEST_BENCH_AID_THERMOSTAT, iid) == target) {
+            return (iid);
+        }
+    }
+    return (0);
+}
+
+/** @brief Fast-forward to margin ms before the next millis() wrap point */
+static void advanceToWrap(const uint32_t margin) {
+    uint64_t left = MILLIS_WRAP - (uint64_t)millis();
+
+    if (left > margin) {
+        nativeAdvanceClock(left - margin);
+    } else {
+        nativeAdvanceClock(left + MILLIS_WRAP - margin);
+    }
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+}
+
+void tearDown(void) {
+}
+
+/* millis() wraps, Utils::uptime() keeps counting */
+void test_uptime_across_wraps(void) {
+    for (uint32_t wrap = 0U; wrap < NB_WRAPS; wrap++) {
+        advanceToWrap(1000U);
+        uint64_t before = Utils::uptime();
+        unsigned long beforeMillis = millis();
+
+        nativeAdvanceClock(2000U);
+        TEST_ASSERT_LESS_THAN(beforeMillis, millis());
+        TEST_ASSERT_UINT32_WITHIN(50U, 2000U, (uint32_t)(Utils::uptime() - before));
+    }
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT64(NB_WRAPS * MILLIS_WRAP, Utils::uptime());
+}
+
+/* A timed write prepared before a wrap point expires after its TTL, not at the wrap */
+void test_timed_write_across_wraps(void) {
+    SpanCharacteristic * target = testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature);
+    TEST_ASSERT_NOT_NULL(target);
+    int iid = thermostatIid(target);
+
+    for (uint32_t wrap = 0U; wrap < NB_WRAPS; wrap++) {
+        uint64_t pid = 0x1000U + wrap;
+        char body[128];
+        SpanBuf update;
+
+        advanceToWrap(2000U);
+        SpanTestAccess::timedWrites().add(pid, 5000U);
+
+        /* Past the wrap, within the TTL */
+        nativeAdvanceClock(3000U);
+        TEST_ASSERT_EQUAL(1, SpanTestAccess::timedWrites().check(pid));
+        snprintf(body, sizeof(body), "{\"characteristics\":[{\"aid\":%u,\"iid\":%d,\"value\":21.5}],\"pid\":%llu}",
+                 TEST_BENCH_AID_THERMOSTAT, iid, (unsigned long long)pid);
+        TEST_ASSERT_EQUAL(1, SpanTestAccess::updateCharacteristics(body, &update));
+        TEST_ASSERT_EQUAL(StatusCode::OK, update.status);
+
+        /* Past the TTL */
+        nativeAdvanceClock(3000U);
+        TEST_ASSERT_EQUAL(0, SpanTestAccess::timedWrites().check(pid));
+        snprintf(body, sizeof(body), "{\"characteristics\":[{\"aid\":%u,\"iid\":%d,\"value\":21.0}],\"pid\":%llu}",
+                 TEST_BENCH_AID_THERMOSTAT, iid, (unsigned long long)pid);
+        SpanTestAccess::updateCharacteristics(body, &update);
+        TEST_ASSERT_NOT_EQUAL(StatusCode::OK, update.status);
+        TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.5f, target->getVal<float>());
+
+        SpanTestAccess::timedWrites().purge();
+        TEST_ASSERT_EQUAL(-1, SpanTestAccess::timedWrites().check(pid));
+    }
+}
+
+/* The age of a characteristic counts through a wrap point */
+void test_characteristic_age_across_wraps(void) {
+    SpanCharacteristic * target = testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature);
+    TEST_ASSERT_NOT_NULL(target);
+
+    for (uint32_t wrap = 0U; wrap < NB_WRAPS; wrap++) {
+        advanceToWrap(10U * 1000U);
+        TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature, "20.0"));
+
+        nativeAdvanceClock(30U * 1000U);
+        SpanTestAccess::snapTime();
+        TEST_ASSERT_UINT32_WITHIN(50U, 30U * 1000U, (uint32_t)target->timeVal());
+    }
+}
+
+/* The relay status query and the sensor polling keep their period through wrap points, a command after one still goes out */
+void test_zone_timers_across_wraps(void) {
+    for (uint32_t wrap = 0U; wrap < NB_WRAPS; wrap++) {
+        advanceToWrap(WRAP_WINDOW);
+        /* Catch up with the jump, then watch the window around the wrap point */
+        testBenchRun(ZONE_CONTROL_PERIOD);
+        relay.reset();
+        uint32_t readings = snapshot().nbReadings;
+
+        testBenchRun(2U * WRAP_WINDOW);
+
+        std::vector<t_fakeRelayRequest> requests = relay.getRequests();
+        TEST_ASSERT_UINT32_WITHIN(1U, 2U * WRAP_WINDOW / GET_STATUS_REFRESH_TIME_IN_MS, requests.size());
+        for (size_t i = 1U; i < requests.size(); i++) {
+            TEST_ASSERT_UINT32_WITHIN(2U * ZONE_CONTROL_PERIOD, GET_STATUS_REFRESH_TIME_IN_MS, (uint32_t)(requests[i].time - requests[i - 1U].time));
+        }
+        TEST_ASSERT_UINT32_WITHIN(1U, 2U * WRAP_WINDOW / TEMPERATURE_SENSOR_POLLING_TIME, snapshot().nbReadings - readings);
+
+        /* After the wrap point, a request still reaches the relay within two passes */
+        t_esp01sRelayState next = (relay.getState() == E_ESP01S_RELAY_OPEN) ? E_ESP01S_RELAY_CLOSE : E_ESP01S_RELAY_OPEN;
+        TEST_ASSERT_TRUE(zoneControl.requestRelay(zone->index, E_ZONE_CHANNEL_HEATER, next));
+        TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([next]() { return (snapshot().relayState == next); }, 2U * ZONE_CONTROL_PERIOD));
+        TEST_ASSERT_EQUAL(next, relay.getState());
+    }
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    testBenchSensor().setReading(20.0f + SENSOR_CALIBRATION, 45.0f);
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Uptime", relay.getPort());
+    zone = zoneTable.addZone(&config);
+    zoneTable.begin();
+    testBenchRun(ZONE_CONTROL_PERIOD);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_uptime_across_wraps);
+    RUN_TEST(test_timed_write_across_wraps);
+    RUN_TEST(test_characteristic_age_across_wraps);
+    RUN_TEST(test_zone_timers_across_wraps);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
@@ -0,0 +1,228 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+
+/* Local files */
+#include "testBench.h"
+#include "homeKitAccessories/windowSensor.h"
+#include "zones/openWindowDetector.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Heating suspension of the detector tests */
+#define SUSPEND_TIME                            (10U * 60U * 1000U)
+
+/** @brief Number of samples of a trace, 20 minutes */
+#define TRACE_LEN                               (40U)
+
+/** @brief Sample of the trace where the temperature starts to drop, 8 minutes */
+#define TRACE_DROP_START                        (16U)
+
+/** @brief Longest detection delay after the drop starts, 4 minutes */
+#define DETECTION_BUDGET                        (8U)
+
+/** @brief Offset removed by TempHumSensor from the AHT20 readout */
+#define SENSOR_CALIBRATION                      (1.5f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief Filtered zone temperature sampled every OPEN_WINDOW_SAMPLE_PERIOD */
+typedef struct {
+    const char * name;
+    float samples[TRACE_LEN];
+} t_trace;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+/**
+ * @brief Drop events and quiet rooms, as the filtered temperature of a zone
+ * @details
+ *  The room is steady for 8 minutes then follows the profile in the name.
+ *  Readouts carry the AHT20 noise and went through the zone filter.
+ */
+static const t_trace windowOpened[] = {
+    {"1 C in 4 min", {20.98f, 20.99f, 21.02f, 21.01f, 20.99f, 21.01f, 20.99f, 20.99f, 20.98f, 20.99f,
+                      21.01f, 21.01f, 21.01f, 20.99f, 21.01f, 21.00f, 21.00f, 20.93f, 20.84f, 20.69f,
+                      20.57f, 20.45f, 20.33f, 20.20f, 20.07f, 20.02f, 20.01f, 20.00f, 20.01f, 19.99f,
+                      20.00f, 20.01f, 20.01f, 20.01f, 20.01f, 19.99f, 19.99f, 20.00f, 20.01f, 20.00f}},
+    {"2 C in 6 min", {21.00f, 21.01f, 21.00f, 21.00f, 20.98f, 20.97f, 20.98f, 20.99f, 21.01f, 21.00f,
+                      21.02f, 21.03f, 21.01f, 21.00f, 20.99f, 21.00f, 21.00f, 20.91f, 20.76f, 20.59f,
+                      20.42f, 20.25f, 20.07f, 19.88f, 19.75f, 19.58f, 19.40f, 19.24f, 19.08f, 19.00f,
+                      19.00f, 18.99f, 19.00f, 18.99f, 19.00f, 18.99f, 19.01f, 18.98f, 19.00f, 18.98f}},
+};
+
+static const t_trace windowClosed[] = {
+    {"steady room", {20.98f, 21.00f, 21.00f, 21.00f, 20.99f, 20.99f, 20.98f, 20.99f, 20.98f, 21.00f,
+                     21.00f, 21.00f, 20.99f, 20.99f, 21.00f, 21.02f, 20.99f, 20.99f, 21.01f, 21.00f,
+                     21.01f, 21.00f, 21.02f, 21.01f, 21.02f, 21.00f, 21.00f, 20.99f, 21.02f, 21.00f,
+                     21.01f, 21.02f, 21.00f, 20.99f, 21.00f, 20.99f, 20.99f, 20.99f, 21.02f, 21.00f}},
+    {"0.5 C per hour", {20.96f, 20.99f, 21.00f, 20.99f, 20.99f, 20.98f, 20.98f, 20.98f, 20.96f, 20.96f,
+                        20.96f, 20.95f, 20.96f, 20.93f, 20.92f, 20.94f, 20.94f, 20.94f, 20.92f, 20.90f,
+                        20.92f, 20.92f, 20.91f, 20.93f, 20.92f, 20.89f, 20.88f, 20.87f, 20.88f, 20.87f,
+                        20.87f, 20.85f, 20.87f, 20.86f, 20.88f, 20.86f, 20.85f, 20.86f, 20.85f, 20.83f}},
+    {"0.5 C in 5 min", {20.98f, 20.99f, 21.02f, 21.01f, 21.00f, 21.00f, 21.01f, 20.98f, 21.00f, 20.99f,
+                        20.99f, 21.00f, 21.01f, 21.00f, 21.01f, 20.99f, 21.01f, 20.97f, 20.94f, 20.87f,
+                        20.81f, 20.78f, 20.73f, 20.67f, 20.63f, 20.57f, 20.52f, 20.50f, 20.51f, 20.50f,
+                        20.50f, 20.51f, 20.50f, 20.50f, 20.50f, 20.51f, 20.50f, 20.50f, 20.49f, 20.50f}},
+    {"1 C in 10 min", {20.96f, 20.99f, 21.00f, 21.01f, 20.99f, 20.99f, 20.99f, 21.00f, 21.01f, 21.00f,
+                       21.00f, 20.99f, 20.98f, 20.98f, 21.00f, 21.01f, 20.98f, 20.96f, 20.93f, 20.86f,
+                       20.80f, 20.77f, 20.73f, 20.67f, 20.62f, 20.55f, 20.51f, 20.47f, 20.41f, 20.39f,
+                       20.34f, 20.28f, 20.22f, 20.17f, 20.11f, 20.07f, 20.02f, 19.99f, 20.01f, 19.98f}},
+};
+
+static FakeRelay relay;
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/**
+ * @brief Replay a trace into a detector
+ *
+ * @return Index of the sample that raised the detection, TRACE_LEN if none did
+ */
+static uint32_t replay(OpenWindowDetector & detector, const t_trace & trace, uint64_t * const now) {
+    uint32_t detectedAt = TRACE_LEN;
+
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        if ((detector.addSample(trace.samples[i], *now) == true) && (detectedAt == TRACE_LEN)) {
+            detectedAt = i;
+        }
+        (void)detector.update(*now);
+        *now += OPEN_WINDOW_SAMPLE_PERIOD;
+    }
+
+    return (detectedAt);
+}
+
+static float characteristic(const uint32_t aid, const HapChar & type) {
+    SpanCharacteristic * found = testBenchFind(aid, type);
+    TEST_ASSERT_NOT_NULL(found);
+    return (found->getVal<float>());
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* Drops of an opened window are detected within the budget, once */
+void test_drops_detected(void) {
+    for (const t_trace & trace : windowOpened) {
+        OpenWindowDetector detector(SUSPEND_TIME);
+        uint64_t now = 0U;
+
+        uint32_t detectedAt = replay(detector, trace, &now);
+        TEST_ASSERT_TRUE_MESSAGE(detectedAt > TRACE_DROP_START, trace.name);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(TRACE_DROP_START + DETECTION_BUDGET, detectedAt, trace.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(1U, detector.getNbEvents(), trace.name);
+    }
+}
+
+/* Steady rooms, night cooling and slow drops never suspend heating */
+void test_quiet_rooms_not_flagged(void) {
+    for (const t_trace & trace : windowClosed) {
+        OpenWindowDetector detector(SUSPEND_TIME);
+        uint64_t now = 0U;
+
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(TRACE_LEN, replay(detector, trace, &now), trace.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0U, detector.getNbEvents(), trace.name);
+    }
+}
+
+/* The suspension lasts its time after the last dropping sample, then heating resumes */
+void test_suspension_ends(void) {
+    OpenWindowDetector detector(SUSPEND_TIME);
+    uint64_t now = 0U;
+    uint64_t lastDrop = 0U;
+
+    for (uint32_t i = 0; i < TRACE_LEN; i++) {
+        (void)detector.addSample(windowOpened[1].samples[i], now);
+        if (detector.getSlope() <= -OPEN_WINDOW_DROP_RATE) {
+            lastDrop = now;
+        }
+        now += OPEN_WINDOW_SAMPLE_PERIOD;
+    }
+    TEST_ASSERT_TRUE(detector.isOpen());
+
+    TEST_ASSERT_FALSE(detector.update(lastDrop + SUSPEND_TIME - 1U));
+    TEST_ASSERT_TRUE(detector.update(lastDrop + SUSPEND_TIME));
+    TEST_ASSERT_FALSE(detector.isOpen());
+}
+
+/* A gap in the samples restarts the window, a drop spread over the gap is not flagged */
+void test_gap_restarts_window(void) {
+    OpenWindowDetector detector(SUSPEND_TIME);
+    uint64_t now = 0U;
+
+    for (uint32_t i = 0; i < OPEN_WINDOW_NB_SAMPLES - 1U; i++) {
+        (void)detector.addSample(21.0f, now);
+        now += OPEN_WINDOW_SAMPLE_PERIOD;
+    }
+    now += 2U * OPEN_WINDOW_SAMPLE_PERIOD;
+    (void)detector.addSample(19.0f, now);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, detector.getSlope());
+    TEST_ASSERT_FALSE(detector.isOpen());
+}
+
+/* End to end: the zone opens the relay and shows the contact open while the window is open */
+void test_zone_suspends_heating(void) {
+    testBenchSensor().setReading(20.0f + SENSOR_CALIBRATION, 45.0f);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature, "22.0"));
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "1"));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_CLOSE); },
+                                                        60U * 1000U));
+    testBenchRun(5U * 60U * 1000U);
+    TEST_ASSERT_EQUAL(E_WINDOW_CLOSED, (int)characteristic(TEST_BENCH_AID_SENSOR, hapChars.ContactSensorState));
+
+    /* 2 °C in 6 minutes, the readout follows every control pass */
+    uint64_t start = Utils::uptime();
+    uint32_t elapsed = testBenchRunUntil([start]() {
+        float drop = 2.0f * (float)(Utils::uptime() - start) / (6.0f * 60.0f * 1000.0f);
+        testBenchSensor().setReading(20.0f - ((drop < 2.0f) ? drop : 2.0f) + SENSOR_CALIBRATION, 45.0f);
+        return (relay.getState() == E_ESP01S_RELAY_OPEN);
+    }, 10U * 60U * 1000U);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(6U * 60U * 1000U, elapsed);
+    TEST_ASSERT_EQUAL(E_WINDOW_OPEN, (int)characteristic(TEST_BENCH_AID_SENSOR, hapChars.ContactSensorState));
+    TEST_ASSERT_EQUAL(0, (int)characteristic(TEST_BENCH_AID_THERMOSTAT, hapChars.CurrentHeatingCoolingState));
+
+    /* The room is cold but heating stays off for the suspension, then resumes */
+    testBenchRun((config.openWindowMinutes - 1U) * 60U * 1000U);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, relay.getState());
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_CLOSE); },
+                                                        10U * 60U * 1000U));
+    TEST_ASSERT_EQUAL(E_WINDOW_CLOSED, (int)characteristic(TEST_BENCH_AID_SENSOR, hapChars.ContactSensorState));
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Window", relay.getPort());
+    config.openWindowMinutes = 10U;
+    zone = zoneTable.addZone(&config);
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_drops_detected);
+    RUN_TEST(test_quiet_rooms_not_flagged);
+    RUN_TEST(test_suspension_ends);
+    RUN_TEST(test_gap_restarts_window);
+    RUN_TEST(test_zone_suspends_heating);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
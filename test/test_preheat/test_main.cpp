@@ -0,0 +1,251 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+
+/* Local files */
+#include "testBench.h"
+#include "esp_sntp.h"
+#include "roomSimulator.h"
+#include "zones/preheatModel.h"
+#include "zones/weeklySchedule.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Step of the room simulation */
+#define ROOM_STEP                               (10U * 1000U)
+
+/** @brief Milliseconds in a day */
+#define DAY                                     (24U * 3600U * 1000U)
+
+/** @brief Midnight UTC, Monday 4 January 2021, past SCHEDULE_MIN_VALID_TIME */
+#define START_EPOCH                             (1609718400L)
+
+/** @brief Program: 16 °C at night, 20 °C from 06:30 to 22:00 */
+#define NIGHT_SETPOINT                          (16.0f)
+#define DAY_SETPOINT                            (20.0f)
+#define MORNING_MINUTE                          (6U * 60U + 30U)
+#define EVENING_MINUTE                          (22U * 60U)
+
+/** @brief Morning window searched for the arrival, the room is at the night setpoint before */
+#define ARRIVAL_SEARCH_START                    (3U * 60U)
+#define ARRIVAL_SEARCH_END                      (12U * 60U)
+
+/** @brief Days of each run, the adaptive one learns during the first days */
+#define BASELINE_DAYS                           (2U)
+#define ADAPTIVE_DAYS                           (7U)
+#define LEARNED_DAYS                            (3U)
+
+/**
+ * @brief Mean arrival error accepted once learned, minutes
+ * @details
+ *  Most heating intervals long enough to learn from are the night holding cycles, where the
+ *  room loses less heat than on the way up to the day setpoint. The learned rate is a bit
+ *  high and the room arrives late, by about a tenth of the ramp.
+ */
+#define ARRIVAL_BUDGET                          (25.0f)
+
+/** @brief Delay of the bang-bang baseline that the request reported, at least */
+#define BASELINE_MIN_DELAY                      (30.0f)
+
+/** @brief Extra energy accepted for reaching the setpoint on time, share of the baseline daily energy */
+#define EXTRA_ENERGY_BUDGET                     (0.15f)
+
+/************************************************
+ *  Typedef definition
+ ***********************************************/
+/** @brief One simulated day */
+typedef struct {
+    float arrivalError;                 /**< Minutes from the morning transition to the room reaching the setpoint, negative if early */
+    float energyWh;                     /**< Heater energy over the day */
+    float earlyWh;                      /**< Heater energy spent holding the setpoint before the transition */
+} t_preheatDay;
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay heater;
+static RoomSimulator room(testBenchSensor(), heater);
+static t_zoneConfig config;
+static t_zone * zone;
+
+/** @brief Same program as the baseline applies by hand */
+static const t_schedulePeriod program[] = {
+    {SCHEDULE_EVERYDAY, 0U, SCHEDULE_SETPOINT(NIGHT_SETPOINT)},
+    {SCHEDULE_EVERYDAY, MORNING_MINUTE, SCHEDULE_SETPOINT(DAY_SETPOINT)},
+    {SCHEDULE_EVERYDAY, EVENING_MINUTE, SCHEDULE_SETPOINT(NIGHT_SETPOINT)},
+};
+
+/** @brief Cold house, an hour or two of heating from the night to the day setpoint */
+static const t_roomModel house = {NIGHT_SETPOINT, 4.0f, 3.0f, 10.0f, 3.5f, 0.0f};
+
+/** @brief Baseline results, compared with by the adaptive run */
+static t_preheatDay baseline[BASELINE_DAYS];
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static void write(const HapChar & type, const float value) {
+    char text[16];
+    snprintf(text, sizeof(text), "%.1f", value);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, type, text));
+}
+
+/** @brief Minute of the day of the wall clock, UTC */
+static uint32_t minuteOfDay(void) {
+    return ((uint32_t)((time(NULL) % (24 * 3600)) / 60));
+}
+
+/**
+ * @brief Run the room and the zone for one day from midnight
+ *
+ * @param manual        Set the target at the transitions as a user would, instead of the schedule
+ *
+ * @return What the day cost and when the room got warm
+ */
+static t_preheatDay simulateDay(const bool manual) {
+    t_preheatDay day = {NAN, 0.0f, 0.0f};
+    time_t midnight = time(NULL) - (time(NULL) % (24 * 3600));
+    time_t morning = midnight + MORNING_MINUTE * 60;
+    uint32_t lastMinute = minuteOfDay();
+    bool arrived = false;
+
+    for (uint32_t t = 0U; t < DAY; t += ROOM_STEP) {
+        bool heating = (heater.getState() == E_ESP01S_RELAY_CLOSE);
+        room.step(ROOM_STEP);
+        testBenchRun(ROOM_STEP);
+
+        uint32_t minute = minuteOfDay();
+        if (manual && (lastMinute < MORNING_MINUTE) && (minute >= MORNING_MINUTE)) {
+            write(hapChars.TargetTemperature, DAY_SETPOINT);
+        }
+        if (manual && (lastMinute < EVENING_MINUTE) && (minute >= EVENING_MINUTE)) {
+            write(hapChars.TargetTemperature, NIGHT_SETPOINT);
+        }
+        lastMinute = minute;
+
+        float wh = heating ? config.heaterPowerW * ROOM_STEP / (3600.0f * 1000.0f) : 0.0f;
+        day.energyWh += wh;
+        if (arrived && (time(NULL) < morning)) {
+            day.earlyWh += wh;
+        }
+        if ((arrived == false) && (minute >= ARRIVAL_SEARCH_START) && (minute < ARRIVAL_SEARCH_END) &&
+            (room.getTemperature() >= DAY_SETPOINT)) {
+            arrived = true;
+            day.arrivalError = (time(NULL) - morning) / 60.0f;
+        }
+    }
+
+    return (day);
+}
+
+static void report(const char * const name, const t_preheatDay * const days, const uint32_t nbDays) {
+    const t_preheatRates & rates = zone->preheat->getRates();
+
+    printf("%s, learned heat-up %.2f °C/h, cool-down %.2f °C/h\n", name, rates.heatRate, rates.coolRate);
+    printf("  day  arrival (min)  energy (Wh)  held early (Wh)\n");
+    for (uint32_t i = 0U; i < nbDays; i++) {
+        printf("  %3u  %13.1f  %11.0f  %15.0f\n", (unsigned int)(i + 1U), days[i].arrivalError, days[i].energyWh, days[i].earlyWh);
+    }
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* Bang-bang at the scheduled time, the room gets warm well after it */
+void test_baseline_arrives_late(void) {
+    write(hapChars.TargetTemperature, NIGHT_SETPOINT);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "1"));
+
+    for (uint32_t i = 0U; i < BASELINE_DAYS; i++) {
+        baseline[i] = simulateDay(true);
+    }
+    report("Baseline, target set at the transitions", baseline, BASELINE_DAYS);
+
+    for (uint32_t i = 0U; i < BASELINE_DAYS; i++) {
+        TEST_ASSERT_FALSE(isnan(baseline[i].arrivalError));
+        TEST_ASSERT_GREATER_OR_EQUAL_FLOAT(BASELINE_MIN_DELAY, baseline[i].arrivalError);
+    }
+}
+
+/* The schedule starts heating early from the learned heat-up rate, the room is warm on time for little extra energy */
+void test_preheat_arrives_on_time(void) {
+    t_preheatDay days[ADAPTIVE_DAYS];
+    float error = 0.0f;
+    float energy = 0.0f;
+    float baselineEnergy = 0.0f;
+
+    TEST_ASSERT_TRUE(zoneTable.setSchedule(zone->index, program, sizeof(program) / sizeof(program[0])));
+    for (uint32_t i = 0U; i < ADAPTIVE_DAYS; i++) {
+        days[i] = simulateDay(false);
+    }
+    report("Pre-heat from the learned rate", days, ADAPTIVE_DAYS);
+
+    for (uint32_t i = ADAPTIVE_DAYS - LEARNED_DAYS; i < ADAPTIVE_DAYS; i++) {
+        TEST_ASSERT_FALSE(isnan(days[i].arrivalError));
+        error += fabsf(days[i].arrivalError) / LEARNED_DAYS;
+        energy += days[i].energyWh / LEARNED_DAYS;
+    }
+    for (uint32_t i = 0U; i < BASELINE_DAYS; i++) {
+        baselineEnergy += baseline[i].energyWh / BASELINE_DAYS;
+    }
+    printf("learned days: mean arrival error %.1f min, extra energy %.0f Wh/day (%+.1f %%)\n",
+           error, energy - baselineEnergy, 100.0f * (energy - baselineEnergy) / baselineEnergy);
+
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(ARRIVAL_BUDGET, error);
+    TEST_ASSERT_LESS_OR_EQUAL_FLOAT(EXTRA_ENERGY_BUDGET * baselineEnergy, energy - baselineEnergy);
+}
+
+/* The learned rates survive a reboot */
+void test_rates_persisted(void) {
+    PreheatModel restored;
+
+    /* Thermostat off and room frozen, nothing more to learn */
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "0"));
+    testBenchRun(PREHEAT_SAMPLE_PERIOD);
+    t_preheatRates learned = zone->preheat->getRates();
+
+    /* Past the NVS write period, the next temperature update saves them */
+    testBenchRun(PREHEAT_SAVE_PERIOD + PREHEAT_SAMPLE_PERIOD);
+    restored.load("zone0");
+
+    TEST_ASSERT_NOT_EQUAL(PREHEAT_DEFAULT_HEAT_RATE, restored.getRates().heatRate);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, learned.heatRate, restored.getRates().heatRate);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, learned.coolRate, restored.getRates().coolRate);
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    configTzTime("UTC0", "pool.ntp.org");
+    nativeSetTime(START_EPOCH);
+    heater.setFallback(E_FAKE_RELAY_ANSWER);
+    heater.begin();
+    room.begin(house);
+    testBenchBegin();
+    config = testBenchZoneConfig("Preheat", heater.getPort());
+    zone = zoneTable.addZone(&config);
+    if (zone == NULL) {
+        return (1);
+    }
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_baseline_arrives_late);
+    RUN_TEST(test_preheat_arrives_on_time);
+    RUN_TEST(test_rates_persisted);
+    int failures = UNITY_END();
+
+    heater.end();
+    return (failures);
+}
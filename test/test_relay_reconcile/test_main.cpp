@@ -0,0 +1,200 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <vector>
+
+/* Local files */
+#include "testBench.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Time to bring the relay back to open and clear the fault between tests */
+#define SETTLE_TIMEOUT                          (5U * 60U * 1000U)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay relay;
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static t_zoneSnapshot snapshot(void) {
+    t_zoneSnapshot current;
+    zoneControl.getSnapshot(zone->index, &current);
+    return (current);
+}
+
+static void request(const t_esp01sRelayState state) {
+    TEST_ASSERT_TRUE(zoneControl.requestRelay(zone->index, E_ZONE_CHANNEL_HEATER, state));
+}
+
+/** @brief Delay expected after the nth failure in a row, see ZoneControl::retryLater() */
+static uint32_t backoff(const uint32_t failures) {
+    uint32_t delay = RELAY_RETRY_MIN_DELAY;
+
+    for (uint32_t i = 1U; (i < failures) && (delay < RELAY_RETRY_MAX_DELAY); i++) {
+        delay *= 2U;
+    }
+
+    return ((delay < RELAY_RETRY_MAX_DELAY) ? delay : RELAY_RETRY_MAX_DELAY);
+}
+
+/** @brief Relay answering, open and confirmed, no fault, whatever the previous test left */
+static void settle(void) {
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+    relay.setJsonStatus(false);
+    request(E_ESP01S_RELAY_OPEN);
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_OPEN) &&
+                                                                      (snapshot().relayState == E_ESP01S_RELAY_OPEN) &&
+                                                                      (snapshot().relayFault == false); },
+                                                        SETTLE_TIMEOUT));
+    relay.reset();
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+    settle();
+}
+
+void tearDown(void) {
+}
+
+/* Slow answers within the response timeout are not errors */
+void test_delayed_answers_accepted(void) {
+    uint32_t errors = snapshot().relayErrors;
+    relay.setFallback(E_FAKE_RELAY_ANSWER, HTTP_RESPONSE_TIMEOUT / 2U);
+    request(E_ESP01S_RELAY_CLOSE);
+
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (snapshot().relayState == E_ESP01S_RELAY_CLOSE); },
+                                                        2U * ZONE_CONTROL_PERIOD));
+    testBenchRun(GET_STATUS_REFRESH_TIME_IN_MS + ZONE_CONTROL_PERIOD);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countCommands());
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countStatusRequests());
+    TEST_ASSERT_EQUAL_UINT32(errors, snapshot().relayErrors);
+    TEST_ASSERT_FALSE(snapshot().relayFault);
+}
+
+/* An answer past the response timeout fails the exchange: HomeKit keeps the confirmed state and the command is sent again */
+void test_late_answer_retried(void) {
+    uint32_t errors = snapshot().relayErrors;
+    relay.push(E_FAKE_RELAY_ANSWER, 2U * HTTP_RESPONSE_TIMEOUT);
+    request(E_ESP01S_RELAY_CLOSE);
+
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.countCommands() == 1U); }, 2U * ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_UINT32(errors + 1U, snapshot().relayErrors);
+
+    /* The relay acts on the command after the client gave up, the zone has not seen it */
+    delay(2U * HTTP_RESPONSE_TIMEOUT);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, relay.getState());
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, snapshot().relayState);
+
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (snapshot().relayState == E_ESP01S_RELAY_CLOSE); },
+                                                        backoff(1U) + 2U * ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_UINT32(2U, relay.countCommands(E_ESP01S_RELAY_CLOSE));
+    TEST_ASSERT_EQUAL_UINT32(errors + 1U, snapshot().relayErrors);
+}
+
+/* Cut short status answers are errors: the confirmed state holds until a whole answer shows the relay changed */
+void test_corrupted_status_keeps_state(void) {
+    uint32_t errors = snapshot().relayErrors;
+    relay.setJsonStatus(true);
+    relay.push(E_FAKE_RELAY_CORRUPT);
+    relay.push(E_FAKE_RELAY_CORRUPT);
+    relay.setState(E_ESP01S_RELAY_CLOSE);
+
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.countStatusRequests() == 2U); },
+                                                        2U * GET_STATUS_REFRESH_TIME_IN_MS + 2U * ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_UINT32(errors + 2U, snapshot().relayErrors);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, snapshot().relayState);
+    TEST_ASSERT_EQUAL_UINT32(0U, relay.countCommands());
+
+    /* The next whole answer reports the relay closed, the zone opens it again */
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.countCommands(E_ESP01S_RELAY_OPEN) == 1U); },
+                                                        GET_STATUS_REFRESH_TIME_IN_MS + 2U * ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_UINT32(3U, relay.countStatusRequests());
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, relay.getState());
+}
+
+/* A relay dropping every connection is retried with a doubling delay, faulted, then commanded to its safe state */
+void test_dropped_exchanges_back_off(void) {
+    relay.setFallback(E_FAKE_RELAY_DROP);
+    testBenchRun(GET_STATUS_REFRESH_TIME_IN_MS + 10U * 60U * 1000U);
+
+    /* Status queries keep their own period when it is longer than the retry delay */
+    std::vector<t_fakeRelayRequest> requests = relay.getRequests();
+    TEST_ASSERT_GREATER_THAN_UINT32(RELAY_FAULT_THRESHOLD + 2U, requests.size());
+    for (size_t i = 1U; i < requests.size(); i++) {
+        uint32_t expected = backoff(i);
+        if ((requests[i].command == false) && (expected < GET_STATUS_REFRESH_TIME_IN_MS)) {
+            expected = GET_STATUS_REFRESH_TIME_IN_MS;
+        }
+        TEST_ASSERT_UINT32_WITHIN_MESSAGE(2U * ZONE_CONTROL_PERIOD, expected, (uint32_t)(requests[i].time - requests[i - 1U].time),
+                                          "retry delay");
+    }
+
+    /* Status queries until the fault, then the safe state is what the zone asks for */
+    for (size_t i = 0U; i < requests.size(); i++) {
+        TEST_ASSERT_EQUAL(i >= RELAY_FAULT_THRESHOLD, requests[i].command);
+        if (requests[i].command) {
+            TEST_ASSERT_EQUAL(config.relaySafeState, requests[i].state);
+        }
+    }
+    TEST_ASSERT_TRUE(snapshot().relayFault);
+    TEST_ASSERT_EQUAL(1, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.StatusFault)->getVal());
+
+    /* Bounded traffic: at most one exchange per RELAY_RETRY_MAX_DELAY once the backoff is maxed out */
+    relay.reset();
+    testBenchRun(30U * 60U * 1000U);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(30U * 60U * 1000U / RELAY_RETRY_MAX_DELAY + 1U, relay.getRequests().size());
+}
+
+/* The relay answering again gets the safe state first, then the fault clears and the thermostat decides again */
+void test_recovery_applies_safe_state(void) {
+    relay.setFallback(E_FAKE_RELAY_DROP);
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (snapshot().relayFault == true); }, SETTLE_TIMEOUT));
+    relay.reset();
+
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (snapshot().relayFault == false); },
+                                                        RELAY_RETRY_MAX_DELAY + 10U * ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_TRUE(relay.getRequests().front().command);
+    TEST_ASSERT_EQUAL(config.relaySafeState, relay.getRequests().front().state);
+
+    /* The thermostat is off, it opens the relay once it sees the confirmed safe state */
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_OPEN); },
+                                                        2U * GET_STATUS_REFRESH_TIME_IN_MS));
+    TEST_ASSERT_EQUAL(0, testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.StatusFault)->getVal());
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    testBenchSensor().setReading(21.5f, 45.0f);
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Reconcile", relay.getPort());
+    /* Not the default, so the safe state is told apart from the thermostat request */
+    config.relaySafeState = E_ESP01S_RELAY_CLOSE;
+    zone = zoneTable.addZone(&config);
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_delayed_answers_accepted);
+    RUN_TEST(test_late_answer_retried);
+    RUN_TEST(test_corrupted_status_keeps_state);
+    RUN_TEST(test_dropped_exchanges_back_off);
+    RUN_TEST(test_recovery_applies_safe_state);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
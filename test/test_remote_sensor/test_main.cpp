@@ -0,0 +1,215 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <math.h>
+
+/* Local files */
+#include "testBench.h"
+#include "devices/remoteSensor.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Sensor nodes, the zone one is bound through the zone configuration */
+#define NODE_ZONE_MAC                           "24:0A:C4:00:00:01"
+#define NODE_A_MAC                              "24:0A:C4:00:00:0A"
+#define NODE_B_MAC                              "24:0A:C4:00:00:0B"
+#define NODE_UNKNOWN_MAC                        "24:0A:C4:00:00:FF"
+
+/** @brief Time for the zone filter to settle on a new remote temperature */
+#define ZONE_SETTLE_TIME                        (2U * 60U * 1000U)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay relay;
+static t_zoneConfig config;
+static RemoteSensor * nodeA;
+static RemoteSensor * nodeB;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static t_remoteSensorFrame frame(const uint16_t sequence, const float temperature, const float humidity) {
+    t_remoteSensorFrame raw = {};
+
+    raw.version = REMOTE_SENSOR_FRAME_VERSION;
+    raw.flags = isnan(humidity) ? 0U : REMOTE_SENSOR_FLAG_HUMIDITY_VALID;
+    raw.sequence = sequence;
+    raw.temperature = (int16_t)lroundf(temperature * 100.0f);
+    raw.humidity = isnan(humidity) ? 0U : (uint16_t)lroundf(humidity * 100.0f);
+    raw.batteryMv = 3000U;
+
+    return (raw);
+}
+
+/** @brief Deliver a frame as the ESP-NOW radio of the bridge would */
+static void transmit(const char * const mac, const t_remoteSensorFrame & raw, const int len = sizeof(t_remoteSensorFrame)) {
+    uint8_t address[6];
+
+    sscanf(mac, "%hhx:%hhx:%hhx:%hhx:%hhx:%hhx", &address[0], &address[1], &address[2], &address[3], &address[4], &address[5]);
+    nativeEspNowReceive(address, (const uint8_t *)&raw, len);
+}
+
+static float zoneTemperature(void) {
+    return (testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.CurrentTemperature)->getVal<float>());
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+    /* Nothing left queued by the previous test */
+    (void)nodeA->receive();
+    (void)nodeB->receive();
+}
+
+void tearDown(void) {
+}
+
+/* Values in 1/100 units, humidity only when flagged, battery as reported */
+void test_decode_valid_frame(void) {
+    t_remoteSensorFrame raw = frame(1U, -12.34f, 56.78f);
+    t_remoteSensorSample sample;
+
+    raw.flags |= REMOTE_SENSOR_FLAG_LOW_BATTERY;
+    raw.batteryMv = 2150U;
+    TEST_ASSERT_TRUE(RemoteSensor::decodeFrame(&raw, &sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -12.34f, sample.temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 56.78f, sample.humidity);
+    TEST_ASSERT_EQUAL_UINT16(2150U, sample.batteryMv);
+    TEST_ASSERT_TRUE(sample.lowBattery);
+
+    raw = frame(2U, 21.5f, NAN);
+    TEST_ASSERT_TRUE(RemoteSensor::decodeFrame(&raw, &sample));
+    TEST_ASSERT_TRUE(isnan(sample.humidity));
+    TEST_ASSERT_FALSE(sample.lowBattery);
+}
+
+/* Unknown version and values outside of the AHT20 range are rejected */
+void test_decode_rejects_invalid_frame(void) {
+    t_remoteSensorFrame raw = frame(1U, 21.5f, 45.0f);
+    t_remoteSensorSample sample;
+
+    raw.version = REMOTE_SENSOR_FRAME_VERSION + 1U;
+    TEST_ASSERT_FALSE(RemoteSensor::decodeFrame(&raw, &sample));
+
+    raw = frame(1U, -40.01f, 45.0f);
+    TEST_ASSERT_FALSE(RemoteSensor::decodeFrame(&raw, &sample));
+    raw = frame(1U, 85.01f, 45.0f);
+    TEST_ASSERT_FALSE(RemoteSensor::decodeFrame(&raw, &sample));
+    raw = frame(1U, 21.5f, 100.01f);
+    TEST_ASSERT_FALSE(RemoteSensor::decodeFrame(&raw, &sample));
+
+    raw = frame(1U, 85.0f, 100.0f);
+    TEST_ASSERT_TRUE(RemoteSensor::decodeFrame(&raw, &sample));
+}
+
+/* Each node only gets its own frames, unknown senders and wrong sizes are ignored */
+void test_frames_demuxed_by_mac(void) {
+    t_remoteSensorSample sample;
+
+    transmit(NODE_A_MAC, frame(10U, 19.0f, 40.0f));
+    transmit(NODE_B_MAC, frame(10U, 23.0f, 60.0f));
+    transmit(NODE_UNKNOWN_MAC, frame(11U, 30.0f, 70.0f));
+    transmit(NODE_A_MAC, frame(11U, 30.0f, 70.0f), sizeof(t_remoteSensorFrame) - 1);
+
+    TEST_ASSERT_EQUAL_UINT8(1U, nodeA->receive());
+    TEST_ASSERT_EQUAL_UINT8(1U, nodeB->receive());
+    TEST_ASSERT_TRUE(nodeA->getSample(&sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 19.0f, sample.temperature);
+    TEST_ASSERT_TRUE(nodeB->getSample(&sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 23.0f, sample.temperature);
+}
+
+/* A frame resent after a lost ESP-NOW ack is stored once, invalid frames are counted as dropped */
+void test_repeated_sequence_dropped(void) {
+    t_remoteSensorSample sample;
+    uint32_t dropped = nodeA->getNbDropped();
+
+    transmit(NODE_A_MAC, frame(20U, 20.0f, 40.0f));
+    transmit(NODE_A_MAC, frame(20U, 20.0f, 40.0f));
+    transmit(NODE_A_MAC, frame(21U, 95.0f, 40.0f));
+    transmit(NODE_A_MAC, frame(22U, 20.5f, 40.0f));
+
+    TEST_ASSERT_EQUAL_UINT8(2U, nodeA->receive());
+    TEST_ASSERT_EQUAL_UINT32(dropped + 2U, nodeA->getNbDropped());
+    TEST_ASSERT_TRUE(nodeA->getSample(&sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.5f, sample.temperature);
+}
+
+/* A burst longer than the queue keeps the oldest frames, the newest are lost until the next drain */
+void test_burst_beyond_queue_depth(void) {
+    t_remoteSensorSample sample;
+
+    for (uint16_t i = 0U; i < REMOTE_SENSOR_QUEUE_DEPTH + 2U; i++) {
+        transmit(NODE_A_MAC, frame(30U + i, 20.0f + i, 40.0f));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(REMOTE_SENSOR_QUEUE_DEPTH, nodeA->receive());
+    TEST_ASSERT_TRUE(nodeA->getSample(&sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 20.0f + REMOTE_SENSOR_QUEUE_DEPTH - 1U, sample.temperature);
+}
+
+/* The last sample is reported stale once the node stays silent for REMOTE_SENSOR_STALE_TIME */
+void test_sample_goes_stale(void) {
+    t_remoteSensorSample sample;
+
+    transmit(NODE_B_MAC, frame(40U, 22.0f, 50.0f));
+    TEST_ASSERT_EQUAL_UINT8(1U, nodeB->receive());
+
+    nativeAdvanceClock(REMOTE_SENSOR_STALE_TIME);
+    TEST_ASSERT_TRUE(nodeB->getSample(&sample));
+    nativeAdvanceClock(1000U);
+    TEST_ASSERT_FALSE(nodeB->getSample(&sample));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.0f, sample.temperature);
+
+    transmit(NODE_B_MAC, frame(41U, 22.5f, 50.0f));
+    TEST_ASSERT_EQUAL_UINT8(1U, nodeB->receive());
+    TEST_ASSERT_TRUE(nodeB->getSample(&sample));
+}
+
+/* A zone bound to a node follows its frames, holds its temperature while the node is silent, then resumes */
+void test_zone_follows_remote_node(void) {
+    transmit(NODE_ZONE_MAC, frame(1U, 19.5f, 45.0f));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (fabsf(zoneTemperature() - 19.5f) < 0.05f); },
+                                                        ZONE_SETTLE_TIME));
+
+    testBenchRun(REMOTE_SENSOR_STALE_TIME + ZONE_SETTLE_TIME);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 19.5f, zoneTemperature());
+
+    transmit(NODE_ZONE_MAC, frame(2U, 22.0f, 45.0f));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (fabsf(zoneTemperature() - 22.0f) < 0.05f); },
+                                                        ZONE_SETTLE_TIME));
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Remote", relay.getPort());
+    config.sensorSource = E_ZONE_SENSOR_REMOTE;
+    config.remoteSensorMac = NODE_ZONE_MAC;
+    (void)zoneTable.addZone(&config);
+    zoneTable.begin();
+
+    /* Nodes bound to no zone, only the tests drain them */
+    nodeA = new RemoteSensor(NODE_A_MAC);
+    nodeB = new RemoteSensor(NODE_B_MAC);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_valid_frame);
+    RUN_TEST(test_decode_rejects_invalid_frame);
+    RUN_TEST(test_frames_demuxed_by_mac);
+    RUN_TEST(test_repeated_sequence_dropped);
+    RUN_TEST(test_burst_beyond_queue_depth);
+    RUN_TEST(test_sample_goes_stale);
+    RUN_TEST(test_zone_follows_remote_node);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
@@ -0,0 +1,259 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <math.h>
+
+/* Local files */
+#include "testBench.h"
+#include "esp_sntp.h"
+#include "zones/weeklySchedule.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Central European time, DST from the last Sunday of March 02:00 to the last Sunday of October 03:00 */
+#define TEST_TIMEZONE                           "CET-1CEST,M3.5.0,M10.5.0/3"
+
+/** @brief Sensor offset removed by TempHumSensor */
+#define SENSOR_CALIBRATION                      (1.5f)
+
+/** @brief Room temperature, above every setpoint of the program so pre-heat never starts early */
+#define ROOM_TEMPERATURE                        (20.0f)
+
+/** @brief Step of the simulated clock while following the program */
+#define FOLLOW_STEP                             (60U * 1000U)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay relay;
+static t_zoneConfig config;
+static t_zone * zone;
+
+/** @brief Default program, 02:30 falls in the hour skipped in March and repeated in October */
+static const t_schedulePeriod program[] = {
+    {SCHEDULE_EVERYDAY, 0U, SCHEDULE_SETPOINT(16.0)},
+    {SCHEDULE_EVERYDAY, 2U * 60U + 30U, SCHEDULE_SETPOINT(17.0)},
+    {SCHEDULE_WEEKDAYS, 7U * 60U, SCHEDULE_SETPOINT(19.0)},
+    {SCHEDULE_WEEKEND, 8U * 60U, SCHEDULE_SETPOINT(19.5)},
+    {SCHEDULE_EVERYDAY, 22U * 60U, SCHEDULE_SETPOINT(16.5)},
+};
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+/** @brief Start of the program period active at a minute of the week, by scanning every period of every day */
+static uint16_t programStart(const uint16_t minuteOfWeek, int16_t * const setpoint) {
+    int32_t best = -1;
+    int32_t last = -1;
+    int16_t bestSetpoint = 0;
+    int16_t lastSetpoint = 0;
+
+    for (size_t i = 0U; i < sizeof(program) / sizeof(program[0]); i++) {
+        for (uint8_t day = 0U; day < 7U; day++) {
+            if ((program[i].dayMask & (1U << day)) == 0U) {
+                continue;
+            }
+            int32_t start = day * 24 * 60 + program[i].startMinute;
+            if ((start <= minuteOfWeek) && (start > best)) {
+                best = start;
+                bestSetpoint = program[i].setpoint;
+            }
+            if (start > last) {
+                last = start;
+                lastSetpoint = program[i].setpoint;
+            }
+        }
+    }
+
+    /* Before the first period of the week, the last one of the previous week holds */
+    if (best < 0) {
+        best = last;
+        bestSetpoint = lastSetpoint;
+    }
+    if (setpoint != NULL) {
+        *setpoint = bestSetpoint;
+    }
+    return ((uint16_t)best);
+}
+
+/** @brief Setpoint the program asks for at the current wall time, in 1/10 °C */
+static int16_t programSetpoint(void) {
+    time_t now = time(NULL);
+    struct tm local;
+    int16_t setpoint;
+
+    localtime_r(&now, &local);
+    (void)programStart(local.tm_wday * 24U * 60U + local.tm_hour * 60U + local.tm_min, &setpoint);
+    return (setpoint);
+}
+
+/** @brief Epoch of a local time, DST resolved by the C library */
+static time_t localEpoch(const int year, const int month, const int day, const int hour, const int minute) {
+    struct tm local = {};
+
+    local.tm_year = year - 1900;
+    local.tm_mon = month - 1;
+    local.tm_mday = day;
+    local.tm_hour = hour;
+    local.tm_min = minute;
+    local.tm_isdst = -1;
+    return (mktime(&local));
+}
+
+static float targetTemperature(void) {
+    return (testBenchFind(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature)->getVal<float>());
+}
+
+static bool followsProgram(void) {
+    return (fabsf(targetTemperature() - programSetpoint() / 10.0f) < 0.01f);
+}
+
+/**
+ * @brief Run the zone for a number of minutes, checking the thermostat follows the program
+ *
+ * @param minutes       Duration in minutes
+ * @param setpoint      Setpoint in 1/10 °C to count
+ *
+ * @return Number of times the thermostat moved to setpoint
+ */
+static uint32_t followProgram(const uint32_t minutes, const int16_t setpoint) {
+    int16_t expected = programSetpoint();
+    uint64_t changedAt = Utils::uptime();
+    float previous = targetTemperature();
+    uint32_t reached = 0U;
+
+    for (uint32_t i = 0U; i < minutes; i++) {
+        testBenchRun(FOLLOW_STEP);
+
+        if (programSetpoint() != expected) {
+            expected = programSetpoint();
+            changedAt = Utils::uptime();
+        }
+
+        /* Either on the program, or within one schedule check of its last change */
+        if (followsProgram() == false) {
+            TEST_ASSERT_LESS_OR_EQUAL_UINT64_MESSAGE(SCHEDULE_MAX_WAIT + FOLLOW_STEP, Utils::uptime() - changedAt, "setpoint late");
+        }
+
+        float current = targetTemperature();
+        if ((current != previous) && (fabsf(current - setpoint / 10.0f) < 0.01f)) {
+            reached++;
+        }
+        previous = current;
+    }
+
+    return (reached);
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* The compiled table gives the same setpoint and next transition as a scan of the program, for every minute of the week */
+void test_lookup_matches_program(void) {
+    WeeklySchedule schedule;
+    TEST_ASSERT_TRUE(schedule.compile(program, sizeof(program) / sizeof(program[0])));
+
+    for (uint16_t minute = 0U; minute < SCHEDULE_MINUTES_PER_WEEK; minute++) {
+        struct tm local = {};
+        local.tm_wday = minute / (24U * 60U);
+        local.tm_hour = (minute / 60U) % 24U;
+        local.tm_min = minute % 60U;
+        local.tm_sec = 30;
+
+        int16_t expected;
+        uint16_t start = programStart(minute, &expected);
+        uint8_t index;
+        TEST_ASSERT_EQUAL_INT16(expected, schedule.getSetpoint(local, &index));
+
+        /* The next transition is the first minute with another active period, Saturday wraps to Sunday */
+        uint32_t toNext = schedule.getSecondsToNext(local);
+        TEST_ASSERT_EQUAL_UINT32(30U, toNext % 60U);
+        uint16_t next = (minute + (toNext + 30U) / 60U) % SCHEDULE_MINUTES_PER_WEEK;
+        uint16_t before = (next + SCHEDULE_MINUTES_PER_WEEK - 1U) % SCHEDULE_MINUTES_PER_WEEK;
+        TEST_ASSERT_NOT_EQUAL(start, programStart(next, NULL));
+        TEST_ASSERT_EQUAL_UINT16(start, programStart(before, NULL));
+    }
+}
+
+/* Until SNTP sets the clock the program is not applied, once set it is within one schedule check */
+void test_applied_once_clock_set(void) {
+    float initial = targetTemperature();
+
+    testBenchRun(2U * SCHEDULE_MAX_WAIT);
+    TEST_ASSERT_EQUAL_FLOAT(initial, targetTemperature());
+
+    /* Wednesday 10:00 */
+    nativeSetTime(localEpoch(2026, 10, 21, 10, 0));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil(followsProgram, SCHEDULE_MAX_WAIT + ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_FLOAT(19.0f, targetTemperature());
+}
+
+/* An SNTP correction stepping the clock either way is picked up within one schedule check */
+void test_clock_step(void) {
+    nativeSetTime(localEpoch(2026, 10, 21, 23, 0));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil(followsProgram, SCHEDULE_MAX_WAIT + ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_FLOAT(16.5f, targetTemperature());
+
+    nativeSetTime(localEpoch(2026, 10, 21, 12, 0));
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil(followsProgram, SCHEDULE_MAX_WAIT + ZONE_CONTROL_PERIOD));
+    TEST_ASSERT_EQUAL_FLOAT(19.0f, targetTemperature());
+}
+
+/* 02:00 CET jumps to 03:00 CEST: the skipped 02:30 period still applies, once */
+void test_dst_spring_forward(void) {
+    nativeSetTime(localEpoch(2026, 3, 28, 21, 0));
+    testBenchRunUntil(followsProgram, SCHEDULE_MAX_WAIT + ZONE_CONTROL_PERIOD);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, followProgram(12U * 60U, SCHEDULE_SETPOINT(17.0)));
+    TEST_ASSERT_TRUE(followsProgram());
+}
+
+/* 03:00 CEST goes back to 02:00 CET: the program follows local time through the repeated hour */
+void test_dst_fall_back(void) {
+    nativeSetTime(localEpoch(2026, 10, 24, 21, 0));
+    testBenchRunUntil(followsProgram, SCHEDULE_MAX_WAIT + ZONE_CONTROL_PERIOD);
+
+    /* 02:30 comes twice, once in CEST and once in CET */
+    TEST_ASSERT_EQUAL_UINT32(2U, followProgram(13U * 60U, SCHEDULE_SETPOINT(17.0)));
+    TEST_ASSERT_TRUE(followsProgram());
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    /* Booted without SNTP, the clock starts at the epoch */
+    configTzTime(TEST_TIMEZONE, "pool.ntp.org");
+    nativeSetTime(0);
+    testBenchSensor().setReading(ROOM_TEMPERATURE + SENSOR_CALIBRATION, 45.0f);
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Schedule", relay.getPort());
+    config.schedule = program;
+    config.nbSchedulePeriods = sizeof(program) / sizeof(program[0]);
+    zone = zoneTable.addZone(&config);
+    if (zone == NULL) {
+        return (1);
+    }
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_lookup_matches_program);
+    RUN_TEST(test_applied_once_clock_set);
+    RUN_TEST(test_clock_step);
+    RUN_TEST(test_dst_spring_forward);
+    RUN_TEST(test_dst_fall_back);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
@@ -0,0 +1,290 @@
+/************************************************
+ *  Includes
+ ***********************************************/
+#include <unity.h>
+#include <chrono>
+#include <math.h>
+
+/* Local files */
+#include "testBench.h"
+#include "devices/deviceInfo.h"
+
+/************************************************
+ *  Defines / Macros
+ ***********************************************/
+/** @brief Longest time from a HomeKit write to the relay command, two control passes */
+#define LATENCY_BUDGET_COMMAND                  (2U * ZONE_CONTROL_PERIOD)
+
+/** @brief Longest time for a temperature change to reach the relay: filter, sensor and thermostat periods */
+#define LATENCY_BUDGET_TEMPERATURE              (90U * 1000U)
+
+/** @brief Thermostat state refresh period, from homeKitAccessories/thermostat.h which defines characteristics */
+#define THERMOSTAT_REFRESH_TIME                 (30U * 1000U)
+
+/** @brief Room temperature between tests */
+#define ROOM_TEMPERATURE                        (20.0f)
+
+/** @brief Offset removed by TempHumSensor from the AHT20 readout */
+#define SENSOR_CALIBRATION                      (1.5f)
+
+/************************************************
+ *  Private variables
+ ***********************************************/
+static FakeRelay relay;
+static t_zoneConfig config;
+static t_zone * zone;
+
+/************************************************
+ *  Static function implementation
+ ***********************************************/
+static float characteristic(const uint32_t aid, const HapChar & type) {
+    SpanCharacteristic * found = testBenchFind(aid, type);
+    TEST_ASSERT_NOT_NULL(found);
+    return (found->getVal<float>());
+}
+
+static t_zoneSnapshot snapshot(void) {
+    t_zoneSnapshot current;
+    zoneControl.getSnapshot(zone->index, &current);
+    return (current);
+}
+
+/** @brief Room at temperature (as the thermostat sees it), thermostat heating to target */
+static void heatTo(const float room, const float target) {
+    char value[16];
+
+    testBenchSensor().setReading(room + SENSOR_CALIBRATION, 45.0f);
+    snprintf(value, sizeof(value), "%.1f", target);
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetTemperature, value));
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "1"));
+}
+
+/** @brief Thermostat off, relay open and room back to 20 °C, whatever the previous test left */
+static void settle(void) {
+    TEST_ASSERT_TRUE(testBenchWrite(TEST_BENCH_AID_THERMOSTAT, hapChars.TargetHeatingCoolingState, "0"));
+    testBenchSensor().setReading(ROOM_TEMPERATURE + SENSOR_CALIBRATION, 45.0f);
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_OPEN) &&
+                                                                      (snapshot().relayFault == false) &&
+                                                                      (fabsf(snapshot().averageTemp - ROOM_TEMPERATURE) < 0.05f); },
+                                                        5U * 60U * 1000U));
+
+    /* Let the thermostat see the settled temperature */
+    testBenchRun(THERMOSTAT_REFRESH_TIME + ZONE_CONTROL_PERIOD);
+    relay.reset();
+}
+
+/************************************************
+ *  Test cases
+ ***********************************************/
+void setUp(void) {
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+    testBenchSensor().setFault(E_MOCK_AHT20_OK);
+}
+
+void tearDown(void) {
+}
+
+/* The first pass queries the relay and reads the sensor, nothing is commanded */
+void test_discovery(void) {
+    testBenchRun(ZONE_CONTROL_PERIOD);
+
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countStatusRequests());
+    TEST_ASSERT_EQUAL_UINT32(0U, relay.countCommands());
+    TEST_ASSERT_EQUAL_UINT32(1U, snapshot().nbReadings);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, ROOM_TEMPERATURE, snapshot().lastReading);
+}
+
+/* A HomeKit request for heat reaches the relay in one command, within two passes */
+void test_heat_request_latency(void) {
+    settle();
+    uint64_t start = Utils::uptime();
+    heatTo(19.0f, 22.0f);
+
+    uint32_t elapsed = testBenchRunUntil([]() { return (relay.countCommands() > 0U); }, 10U * 1000U);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LATENCY_BUDGET_COMMAND, elapsed);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LATENCY_BUDGET_COMMAND, (uint32_t)(relay.getRequests().back().time - start));
+
+    /* Nothing more once confirmed, the thermostat shows the heater on */
+    testBenchRun(20U * 1000U);
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countCommands(E_ESP01S_RELAY_CLOSE));
+    TEST_ASSERT_EQUAL_UINT32(0U, relay.countCommands(E_ESP01S_RELAY_OPEN));
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, relay.getState());
+    TEST_ASSERT_EQUAL(1, (int)characteristic(TEST_BENCH_AID_THERMOSTAT, hapChars.CurrentHeatingCoolingState));
+    TEST_ASSERT_EQUAL(1, (int)characteristic(TEST_BENCH_AID_RELAY, hapChars.On));
+}
+
+/* Warming the room past the setpoint opens the relay once */
+void test_heat_stops_when_warm(void) {
+    settle();
+    heatTo(19.0f, 22.0f);
+    testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_CLOSE); }, 10U * 1000U);
+    relay.reset();
+
+    testBenchSensor().setReading(24.0f + SENSOR_CALIBRATION, 45.0f);
+    uint32_t elapsed = testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_OPEN); }, 5U * 60U * 1000U);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LATENCY_BUDGET_TEMPERATURE, elapsed);
+
+    testBenchRun(60U * 1000U);
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countCommands());
+    TEST_ASSERT_EQUAL(0, (int)characteristic(TEST_BENCH_AID_THERMOSTAT, hapChars.CurrentHeatingCoolingState));
+}
+
+/* Error answers are retried with backoff until the relay takes the command */
+void test_error_answers_retried(void) {
+    settle();
+    relay.push(E_FAKE_RELAY_ERROR);
+    relay.push(E_FAKE_RELAY_ERROR);
+    relay.push(E_FAKE_RELAY_ERROR);
+    heatTo(19.0f, 22.0f);
+
+    uint32_t elapsed = testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_CLOSE); }, 60U * 1000U);
+
+    /* 1 s, 2 s and 4 s of backoff */
+    TEST_ASSERT_UINT32_WITHIN(2U * ZONE_CONTROL_PERIOD, 7U * 1000U, elapsed);
+    TEST_ASSERT_EQUAL_UINT32(4U, relay.countCommands(E_ESP01S_RELAY_CLOSE));
+    TEST_ASSERT_EQUAL_UINT32(3U, snapshot().relayErrors);
+    TEST_ASSERT_FALSE(snapshot().relayFault);
+}
+
+/* A command applied by the relay but never answered is sent again, the relay ends closed */
+void test_lost_answer(void) {
+    settle();
+    relay.push(E_FAKE_RELAY_LOST);
+    heatTo(19.0f, 22.0f);
+
+    testBenchRun(10U * 1000U);
+    TEST_ASSERT_EQUAL_UINT32(2U, relay.countCommands(E_ESP01S_RELAY_CLOSE));
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, relay.getState());
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, snapshot().relayState);
+}
+
+/* A hanging relay costs one response timeout per try, then the zone is faulted and recovers */
+void test_hanging_relay_faults_and_recovers(void) {
+    settle();
+    relay.setFallback(E_FAKE_RELAY_HANG);
+    heatTo(19.0f, 22.0f);
+
+    auto start = std::chrono::steady_clock::now();
+    testBenchRunUntil([]() { return (snapshot().relayFault == true); }, 2U * 60U * 1000U);
+    auto spent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    TEST_ASSERT_EQUAL_UINT32(RELAY_FAULT_THRESHOLD, relay.countCommands());
+    TEST_ASSERT_LESS_OR_EQUAL((RELAY_FAULT_THRESHOLD + 1U) * (HTTP_RESPONSE_TIMEOUT + HTTP_CONNECT_TIMEOUT), spent);
+    TEST_ASSERT_EQUAL(1, (int)characteristic(TEST_BENCH_AID_THERMOSTAT, hapChars.StatusFault));
+
+    /* Backoff bounds the traffic while the relay is down */
+    relay.reset();
+    testBenchRun(2U * RELAY_RETRY_MAX_DELAY);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(4U, relay.getRequests().size());
+
+    /* Once back, the fault clears and the thermostat heats again */
+    relay.setFallback(E_FAKE_RELAY_ANSWER);
+    testBenchRunUntil([]() { return (snapshot().relayFault == false); }, 2U * RELAY_RETRY_MAX_DELAY);
+    testBenchRun(60U * 1000U);
+    TEST_ASSERT_EQUAL(0, (int)characteristic(TEST_BENCH_AID_THERMOSTAT, hapChars.StatusFault));
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, relay.getState());
+}
+
+/* A garbage status answer is an error, the confirmed state is kept */
+void test_garbage_status(void) {
+    settle();
+    uint32_t errors = snapshot().relayErrors;
+    relay.setFallback(E_FAKE_RELAY_GARBAGE);
+
+    TEST_ASSERT_NOT_EQUAL(UINT32_MAX, testBenchRunUntil([]() { return (relay.countStatusRequests() > 0U); },
+                                                        GET_STATUS_REFRESH_TIME_IN_MS + LATENCY_BUDGET_COMMAND));
+    testBenchRun(RELAY_RETRY_MIN_DELAY);
+    TEST_ASSERT_EQUAL_UINT32(1U, relay.countStatusRequests());
+    TEST_ASSERT_EQUAL_UINT32(0U, relay.countCommands());
+    TEST_ASSERT_EQUAL_UINT32(errors + 1U, snapshot().relayErrors);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, snapshot().relayState);
+}
+
+/* A relay rebooted closed is found by the periodic status query and opened again */
+void test_relay_reboot_reconciled(void) {
+    settle();
+    relay.setState(E_ESP01S_RELAY_CLOSE);
+
+    uint32_t elapsed = testBenchRunUntil([]() { return (relay.countCommands(E_ESP01S_RELAY_OPEN) > 0U); },
+                                         2U * GET_STATUS_REFRESH_TIME_IN_MS);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(GET_STATUS_REFRESH_TIME_IN_MS + LATENCY_BUDGET_COMMAND, elapsed);
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_OPEN, relay.getState());
+}
+
+/* I2C NACKs raise the sensor fault, the last temperature holds until the sensor answers again */
+void test_sensor_nack(void) {
+    settle();
+    testBenchRun(TEMPERATURE_SENSOR_POLLING_TIME * 2U);
+    float before = snapshot().averageTemp;
+    uint32_t errors = snapshot().sensorErrors;
+
+    testBenchSensor().setFault(E_MOCK_AHT20_NACK, 3U);
+    testBenchSensor().setReading(30.0f, 45.0f);
+    testBenchRunUntil([]() { return (snapshot().sensorFault == true); }, TEMPERATURE_SENSOR_POLLING_TIME * 2U);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, before, snapshot().averageTemp);
+
+    testBenchRunUntil([]() { return (snapshot().sensorFault == false); }, TEMPERATURE_SENSOR_POLLING_TIME * 10U);
+    TEST_ASSERT_FALSE(snapshot().sensorFault);
+    TEST_ASSERT_GREATER_THAN_UINT32(errors, snapshot().sensorErrors);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 30.0f - SENSOR_CALIBRATION, snapshot().lastReading);
+}
+
+/* A stuck busy bit times out in the driver, the pass is bounded and the sensor recovers */
+void test_sensor_stuck_busy(void) {
+    settle();
+    uint32_t errors = snapshot().sensorErrors;
+    testBenchSensor().setFault(E_MOCK_AHT20_BUSY, 2U);
+
+    auto start = std::chrono::steady_clock::now();
+    testBenchRun(TEMPERATURE_SENSOR_POLLING_TIME * 4U);
+    auto spent = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+    TEST_ASSERT_EQUAL_UINT32(errors + 2U, snapshot().sensorErrors);
+    TEST_ASSERT_FALSE(snapshot().sensorFault);
+    TEST_ASSERT_LESS_OR_EQUAL(2U * 2U * AHTX0_BUSY_TIMEOUT_MS + 1000U, spent);
+}
+
+/* Glitched readouts are dropped, they never reach the average nor the relay */
+void test_sensor_glitch(void) {
+    settle();
+    heatTo(19.0f, 22.0f);
+    testBenchRunUntil([]() { return (relay.getState() == E_ESP01S_RELAY_CLOSE); }, 10U * 1000U);
+    relay.reset();
+
+    float before = snapshot().averageTemp;
+    testBenchSensor().setFault(E_MOCK_AHT20_GLITCH);
+    testBenchRun(THERMOSTAT_REFRESH_TIME * 3U);
+    TEST_ASSERT_TRUE(snapshot().sensorFault);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, before, snapshot().averageTemp);
+    TEST_ASSERT_EQUAL_UINT32(0U, relay.countCommands());
+    TEST_ASSERT_EQUAL(E_ESP01S_RELAY_CLOSE, relay.getState());
+}
+
+int main(int argc, char ** argv) {
+    (void)argc;
+    (void)argv;
+
+    testBenchSensor().setReading(ROOM_TEMPERATURE + SENSOR_CALIBRATION, 45.0f);
+    relay.begin();
+    testBenchBegin();
+    config = testBenchZoneConfig("Bench", relay.getPort());
+    zone = zoneTable.addZone(&config);
+    zoneTable.begin();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_discovery);
+    RUN_TEST(test_heat_request_latency);
+    RUN_TEST(test_heat_stops_when_warm);
+    RUN_TEST(test_error_answers_retried);
+    RUN_TEST(test_lost_answer);
+    RUN_TEST(test_hanging_relay_faults_and_recovers);
+    RUN_TEST(test_garbage_status);
+    RUN_TEST(test_relay_reboot_reconciled);
+    RUN_TEST(test_sensor_nack);
+    RUN_TEST(test_sensor_stuck_busy);
+    RUN_TEST(test_sensor_glitch);
+    int failures = UNITY_END();
+
+    relay.end();
+    return (failures);
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+"""Decode the binary history export (GET /history?format=bin) into CSV.
+
+Usage: curl -s "http://<bridge>/history?zone=0&tier=1h&format=bin" | tools/historyDecode.py
+"""
+import sys
+
+NO_HUMIDITY = 0xFFFF
+
+
+def varint(data, pos):
+    value, shift = 0, 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, pos
+
+
+def zigzag(data, pos):
+    value, pos = varint(data, pos)
+    return (value >> 1) ^ -(value & 1), pos
+
+
+def decode(data):
+    if data[:4] != b"HST1":
+        raise ValueError("not a history export")
+    zone, pos = varint(data, 4)
+    period, pos = varint(data, pos)
+    time = temperature = humidity = setpoint = 0
+    while pos < len(data):
+        delta, pos = varint(data, pos)
+        time += delta * period
+        delta, pos = zigzag(data, pos)
+        temperature += delta
+        delta, pos = zigzag(data, pos)
+        humidity += delta
+        delta, pos = zigzag(data, pos)
+        setpoint += delta
+        duty = data[pos]
+        pos += 1
+        yield zone, time, temperature / 100, None if humidity == NO_HUMIDITY else humidity / 10, setpoint / 10, duty
+
+
+if __name__ == "__main__":
+    print("zone,time,temperature,humidity,setpoint,relay_duty")
+    for zone, time, temperature, humidity, setpoint, duty in decode(sys.stdin.buffer.read()):
+        print(f"{zone},{time},{temperature:.2f},{'' if humidity is None else f'{humidity:.1f}'},{setpoint:.1f},{duty}")